@@ -0,0 +1,294 @@
+/**
+ * Microbenchmarks of the reaction network kernels.
+ *
+ * For each parameter file given on the command line, the network is loaded
+ * the same way as in Xolotl (from the HDF5 file or generated from netParam,
+ * with the grouping options) and the following operations are timed in
+ * isolation at a single grid point:
+ *   - computeAllFluxes
+ *   - computeAllPartials
+ *   - setTemperature
+ *   - updateConcentrationsFromArray
+ *
+ * The results are printed on the standard output as CSV (default) or JSON,
+ * one record per network and kernel, with the time per call, per reaction,
+ * and an estimate of the floating point throughput for the flux and partial
+ * derivative kernels.
+ *
+ * The paths in the shipped parameter files are relative to the source
+ * directory, run it from there:
+ *   xolotlBench [--format csv|json] [--minTime seconds] benchmarks/params_*.txt
+ */
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <mpi.h>
+#include <Options.h>
+#include <IReactionNetwork.h>
+#include <IReactionHandlerFactory.h>
+#include <DummyHandlerRegistry.h>
+
+using namespace std;
+
+/**
+ * The result of the timing of one kernel on one network.
+ */
+struct BenchResult {
+	//! The name of the parameter file
+	string paramFile;
+	//! The name of the kernel
+	string kernel;
+	//! The number of degrees of freedom
+	int dof;
+	//! The number of reactions
+	int nReactions;
+	//! The number of partial derivatives
+	size_t nPartials;
+	//! The number of calls that were timed
+	long nCalls;
+	//! The average time per call in ns
+	double nsPerCall;
+	//! The estimated number of floating point operations per call, 0 if unknown
+	double flopsPerCall;
+};
+
+//! This operation prints proper usage instructions
+void printUsage() {
+	cerr << "Usage:" << endl;
+	cerr << "\txolotlBench [--format csv|json] [--minTime seconds] "
+			"<parameter file> [<parameter file> ...]" << endl;
+}
+
+/**
+ * Call the kernel repeatedly for at least the given time and return the
+ * average time per call.
+ *
+ * @param kernel The kernel
+ * @param minTime The minimum time of the measure in s
+ * @param nCalls Set to the number of calls that were timed
+ * @return The average time per call in ns
+ */
+template<typename F>
+double timeKernel(F kernel, double minTime, long& nCalls) {
+	using Clock = std::chrono::steady_clock;
+
+	// Warm up
+	kernel();
+
+	// Double the number of calls until the measure is long enough
+	long n = 1;
+	while (true) {
+		auto start = Clock::now();
+		for (long k = 0; k < n; k++) {
+			kernel();
+		}
+		double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+		if (elapsed >= minTime || n >= (1L << 30)) {
+			nCalls = n;
+			return elapsed * 1.0e9 / (double) n;
+		}
+		n *= 2;
+	}
+}
+
+/**
+ * Load the network described by the parameter file and time its kernels.
+ *
+ * @param paramFile The name of the parameter file
+ * @param minTime The minimum time of each measure in s
+ * @param results The vector where the results are added
+ * @return True if the network could be benchmarked
+ */
+bool benchNetwork(const string& paramFile, double minTime,
+		vector<BenchResult>& results) {
+	// Read the parameters
+	xolotlCore::Options opts;
+	char programName[] = "xolotlBench";
+	vector<char> fileName(paramFile.begin(), paramFile.end());
+	fileName.push_back('\0');
+	char *argv[2] = { programName, fileName.data() };
+	opts.readParams(2, argv);
+	if (!opts.shouldRun())
+		return false;
+
+	// Load the network like Xolotl does
+	auto registry = std::make_shared<xolotlPerf::DummyHandlerRegistry>();
+	auto networkFactory =
+			xolotlFactory::IReactionHandlerFactory::createNetworkFactory(
+					opts.getMaterial());
+	networkFactory->initializeReactionNetwork(opts, registry);
+	auto& network = networkFactory->getNetworkHandler();
+
+	// Finish setting it up as in the solver handlers
+	network.reinitializeConnectivities();
+	const int dof = network.getDOF();
+	xolotlCore::IReactionNetwork::SparseFillMap dfill;
+	network.getDiagonalFill(dfill);
+	std::vector<int> reactionSize(dof);
+	std::vector<size_t> reactionStartingIdx(dof);
+	auto nPartials = network.initPartialsSizes(reactionSize,
+			reactionStartingIdx);
+	std::vector<int> reactionIndices(nPartials);
+	network.initPartialsIndices(reactionSize, reactionStartingIdx,
+			reactionIndices);
+	std::vector<double> reactionVals(nPartials);
+	network.addGridPoints(1);
+	double temperature = opts.getConstTemperature();
+	network.setTemperature(temperature, 0);
+
+	// Use some arbitrary positive concentrations, the temperature is last
+	std::vector<double> concs(dof + 1, 0.0), updatedConcs(dof + 1, 0.0);
+	for (int i = 0; i < dof; i++) {
+		concs[i] = 1.0e-6 * (double) (1 + i % 7);
+	}
+	concs[dof] = temperature;
+	const int nReactions = network.getNReactions();
+
+	// Time the kernels
+	auto addResult = [&](const string& name, double nsPerCall, long nCalls,
+			double flopsPerCall) {
+		results.push_back( { paramFile, name, dof, nReactions, nPartials, nCalls,
+				nsPerCall, flopsPerCall });
+	};
+	long nCalls = 0;
+	double ns = 0.0;
+
+	// Each flux term multiplies the rate with one or two concentrations and
+	// adds the result to two fluxes
+	ns = timeKernel([&]() {
+		network.computeAllFluxes(concs.data(), updatedConcs.data(), 0);
+	}, minTime, nCalls);
+	addResult("computeAllFluxes", ns, nCalls, 4.0 * nReactions);
+
+	// Each partial derivative is a product and a sum
+	ns = timeKernel([&]() {
+		network.computeAllPartials(concs.data(), reactionStartingIdx,
+				reactionIndices, reactionVals, 0);
+	}, minTime, nCalls);
+	addResult("computeAllPartials", ns, nCalls, 2.0 * nPartials);
+
+	// Alternate between two temperatures so the rates are always recomputed
+	bool shift = false;
+	ns = timeKernel([&]() {
+		shift = !shift;
+		network.setTemperature(temperature + (shift ? 1.0 : 0.0), 0);
+	}, minTime, nCalls);
+	addResult("setTemperature", ns, nCalls, 0.0);
+
+	ns = timeKernel([&]() {
+		network.updateConcentrationsFromArray(concs.data());
+	}, minTime, nCalls);
+	addResult("updateConcentrationsFromArray", ns, nCalls, 0.0);
+
+	return true;
+}
+
+/**
+ * Print the results as CSV.
+ *
+ * @param results The results
+ */
+void printCSV(const vector<BenchResult>& results) {
+	cout << "paramFile,kernel,dof,nReactions,nPartials,nCalls,nsPerCall,"
+			"nsPerReaction,GFLOPs" << endl;
+	cout << std::setprecision(6);
+	for (auto const& result : results) {
+		cout << result.paramFile << "," << result.kernel << "," << result.dof
+				<< "," << result.nReactions << "," << result.nPartials << ","
+				<< result.nCalls << "," << result.nsPerCall << ","
+				<< result.nsPerCall / std::max(result.nReactions, 1) << ",";
+		if (result.flopsPerCall > 0.0)
+			cout << result.flopsPerCall / result.nsPerCall;
+		cout << endl;
+	}
+
+	return;
+}
+
+/**
+ * Print the results as JSON.
+ *
+ * @param results The results
+ */
+void printJSON(const vector<BenchResult>& results) {
+	cout << std::setprecision(6);
+	cout << "[" << endl;
+	for (size_t k = 0; k < results.size(); k++) {
+		auto const& result = results[k];
+		cout << "  {\"paramFile\": \"" << result.paramFile
+				<< "\", \"kernel\": \"" << result.kernel << "\", \"dof\": "
+				<< result.dof << ", \"nReactions\": " << result.nReactions
+				<< ", \"nPartials\": " << result.nPartials << ", \"nCalls\": "
+				<< result.nCalls << ", \"nsPerCall\": " << result.nsPerCall
+				<< ", \"nsPerReaction\": "
+				<< result.nsPerCall / std::max(result.nReactions, 1)
+				<< ", \"GFLOPs\": ";
+		if (result.flopsPerCall > 0.0)
+			cout << result.flopsPerCall / result.nsPerCall;
+		else
+			cout << "null";
+		cout << "}" << (k + 1 < results.size() ? "," : "") << endl;
+	}
+	cout << "]" << endl;
+
+	return;
+}
+
+//! Main program
+int main(int argc, char **argv) {
+	// Read the arguments
+	string format = "csv";
+	double minTime = 0.2;
+	vector<string> paramFiles;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--format") == 0 && i + 1 < argc)
+			format = argv[++i];
+		else if (strcmp(argv[i], "--minTime") == 0 && i + 1 < argc)
+			minTime = atof(argv[++i]);
+		else
+			paramFiles.push_back(argv[i]);
+	}
+	if (paramFiles.empty() || (format != "csv" && format != "json")) {
+		printUsage();
+		return EXIT_FAILURE;
+	}
+
+	MPI_Init(&argc, &argv);
+
+	// Benchmark each network, the messages of the loaders go to the
+	// standard output so redirect it while loading
+	vector<BenchResult> results;
+	int exitCode = EXIT_SUCCESS;
+	auto coutBuffer = cout.rdbuf();
+	std::ostringstream loaderMessages;
+	for (auto const& paramFile : paramFiles) {
+		cout.rdbuf(loaderMessages.rdbuf());
+		bool ok = false;
+		try {
+			ok = benchNetwork(paramFile, minTime, results);
+		} catch (const std::string& error) {
+			cerr << error << endl;
+		}
+		cout.rdbuf(coutBuffer);
+		if (!ok) {
+			cerr << "xolotlBench: unable to benchmark " << paramFile << endl;
+			exitCode = EXIT_FAILURE;
+		}
+	}
+
+	// Print the results
+	if (format == "json")
+		printJSON(results);
+	else
+		printCSV(results);
+
+	MPI_Finalize();
+
+	return exitCode;
+}
@@ -20,6 +20,7 @@
 #include <ISolverHandler.h>
 #include <IReactionHandlerFactory.h>
 #include <ctime>
+#include "xolotlSolver/monitor/Monitor.h"
 
 using namespace std;
 using std::shared_ptr;
@@ -210,7 +211,11 @@ int main(int argc, char **argv) {
 	// with overlapping Timer scopes.
 	// We do this before our own parsing of the command line,
 	// because it may change the command line.
-	MPI_Init(&argc, &argv);
+	// The asynchronous checkpoints call MPI from a background thread, the
+	// checkpoint writer falls back on synchronous writes if this level of
+	// thread support is not provided.
+	int threadSupport;
+	MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &threadSupport);
 
 	try {
 		// Check the command line arguments.
@@ -242,6 +247,22 @@ int main(int argc, char **argv) {
 		ret = EXIT_FAILURE;
 	}
 
+	// The solver already waited for the last checkpoint unless an exception
+	// interrupted it, the background thread must be joined before
+	// MPI_Finalize.
+	try {
+		xolotlSolver::finalizeCheckpointWriter();
+	} catch (const std::exception &e) {
+		std::cerr << e.what() << std::endl;
+		ret = EXIT_FAILURE;
+	} catch (const std::string &error) {
+		std::cerr << error << std::endl;
+		ret = EXIT_FAILURE;
+	} catch (...) {
+		std::cerr << "Unrecognized exception seen." << std::endl;
+		ret = EXIT_FAILURE;
+	}
+
 	// Clean up.
 	MPI_Finalize();
 
@@ -118,7 +118,11 @@ BOOST_AUTO_TEST_CASE(goodParamFile) {
 			<< "biasFactor=2.0" << std::endl << "hydrogenFactor=0.5"
 			<< std::endl << "xenonDiffusivity=3.0" << std::endl
 			<< "fissionYield=0.3" << std::endl << "migrationThreshold=1.0"
-			<< std::endl;
+			<< std::endl << "threads=4" << std::endl
+			<< "jacobian=matrixFreeBlock" << std::endl
+			<< "jacobianReuse=1.0e-3 0.5 4" << std::endl << "rateCache=0.5"
+			<< std::endl << "networkCache=netCache" << std::endl
+			<< "preconditioner=blockLU" << std::endl;
 	goodParamFile.close();
 
 	string pathToFile("param_good.txt");
@@ -229,6 +233,27 @@ BOOST_AUTO_TEST_CASE(goodParamFile) {
 	// Check the migration threshold option
 	BOOST_REQUIRE_EQUAL(opts.getMigrationThreshold(), 1.0);
 
+	// Check the number of threads option
+	BOOST_REQUIRE_EQUAL(opts.getNThreads(), 4);
+
+	// Check the Jacobian option
+	BOOST_REQUIRE_EQUAL(opts.getJacobianType(), "matrixFreeBlock");
+
+	// Check the Jacobian reuse option
+	auto jacobianReuse = opts.getJacobianReuse();
+	BOOST_REQUIRE_EQUAL(std::get<0>(jacobianReuse), 1.0e-3);
+	BOOST_REQUIRE_EQUAL(std::get<1>(jacobianReuse), 0.5);
+	BOOST_REQUIRE_EQUAL(std::get<2>(jacobianReuse), 4);
+
+	// Check the rate cache option
+	BOOST_REQUIRE_EQUAL(opts.getRateCacheBinWidth(), 0.5);
+
+	// Check the network cache option
+	BOOST_REQUIRE_EQUAL(opts.getNetworkCacheDirectory(), "netCache");
+
+	// Check the preconditioner option
+	BOOST_REQUIRE_EQUAL(opts.getPreconditioner(), "blockLU");
+
 	// Check the physical processes option
 	auto map = opts.getProcesses();
 	BOOST_REQUIRE_EQUAL(map["diff"], true);
@@ -365,6 +390,68 @@ BOOST_AUTO_TEST_CASE(wrongVizHandler) {
 	std::remove(tempFile.c_str());
 }
 
+BOOST_AUTO_TEST_CASE(wrongJacobian) {
+	xolotlCore::Options opts;
+
+	// Create a parameter file with a wrong Jacobian type
+	std::ofstream paramFile("param_jacobian_wrong.txt");
+	paramFile << "jacobian=bogus" << std::endl;
+	paramFile.close();
+
+	string pathToFile("param_jacobian_wrong.txt");
+	string filename = pathToFile;
+	const char *fname = filename.c_str();
+
+	// Build a command line with a parameter file containing a wrong Jacobian option
+	char *args[3];
+	args[0] = const_cast<char*>("./xolotl");
+	args[1] = const_cast<char*>(fname);
+	args[2] = NULL;
+	char **fargv = args;
+
+	// Attempt to read the parameter file
+	opts.readParams(2, fargv);
+
+	// Xolotl should not be able to run with a wrong Jacobian parameter
+	BOOST_REQUIRE_EQUAL(opts.shouldRun(), false);
+	BOOST_REQUIRE_EQUAL(opts.getExitCode(), EXIT_FAILURE);
+
+	// Remove the created file
+	std::string tempFile = "param_jacobian_wrong.txt";
+	std::remove(tempFile.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(wrongPreconditioner) {
+	xolotlCore::Options opts;
+
+	// Create a parameter file with a wrong preconditioner
+	std::ofstream paramFile("param_preconditioner_wrong.txt");
+	paramFile << "preconditioner=bogus" << std::endl;
+	paramFile.close();
+
+	string pathToFile("param_preconditioner_wrong.txt");
+	string filename = pathToFile;
+	const char *fname = filename.c_str();
+
+	// Build a command line with a parameter file containing a wrong preconditioner option
+	char *args[3];
+	args[0] = const_cast<char*>("./xolotl");
+	args[1] = const_cast<char*>(fname);
+	args[2] = NULL;
+	char **fargv = args;
+
+	// Attempt to read the parameter file
+	opts.readParams(2, fargv);
+
+	// Xolotl should not be able to run with a wrong preconditioner parameter
+	BOOST_REQUIRE_EQUAL(opts.shouldRun(), false);
+	BOOST_REQUIRE_EQUAL(opts.getExitCode(), EXIT_FAILURE);
+
+	// Remove the created file
+	std::string tempFile = "param_preconditioner_wrong.txt";
+	std::remove(tempFile.c_str());
+}
+
 BOOST_AUTO_TEST_CASE(goodParamFileWithProfiles) {
 	// Create a file with temperature profile data
 	// First column with the time and the second with
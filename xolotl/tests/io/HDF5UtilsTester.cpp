@@ -6,9 +6,14 @@
 #include <PSIClusterReactionNetwork.h>
 #include <DummyHandlerRegistry.h>
 #include <HDF5NetworkLoader.h>
+#include <FeClusterNetworkLoader.h>
 #include <XolotlConfig.h>
 #include <mpi.h>
 #include <memory>
+#include <fstream>
+#include <functional>
+#include <cmath>
+#include <algorithm>
 #include <Options.h>
 #include "xolotlCore/io/XFile.h"
 #include "tests/utils/MPIFixture.h"
@@ -240,6 +245,8 @@ BOOST_AUTO_TEST_CASE(checkIO) {
 		auto networkGroup =
 				testFile.getGroup<xolotlCore::XFile::NetworkGroup>();
 		BOOST_REQUIRE(networkGroup);
+		BOOST_REQUIRE_EQUAL(networkGroup->getLayoutVersion(),
+				XFile::NetworkGroup::columnarLayoutVersion);
 		int normalSize = 0, superSize = 0;
 		networkGroup->readNetworkSize(normalSize, superSize);
 		// Get all the reactants
@@ -249,15 +256,13 @@ BOOST_AUTO_TEST_CASE(checkIO) {
 			// Get the i-th reactant in the network
 			auto& reactant = (PSICluster&) it;
 			int id = reactant.getId() - 1;
-			// Open the cluster group
-			XFile::ClusterGroup clusterGroup(*networkGroup, id);
 
 			if (id < normalSize) {
 				// Normal cluster
 				// Read the composition
 				double formationEnergy = 0.0, migrationEnergy = 0.0,
 						diffusionFactor = 0.0;
-				auto comp = clusterGroup.readCluster(formationEnergy,
+				auto comp = networkGroup->readCluster(id, formationEnergy,
 						migrationEnergy, diffusionFactor);
 				// Check the composition
 				auto& composition = reactant.getComposition();
@@ -546,4 +551,403 @@ BOOST_AUTO_TEST_CASE(checkSurface3D) {
 	}
 }
 
+/**
+ * Order the values of two reactions, a value that is not a number comes
+ * after all the others.
+ *
+ * @param reaction The first reaction
+ * @param otherReaction The second reaction
+ * @return True if the first reaction comes first
+ */
+bool reactionComesFirst(const std::vector<double>& reaction,
+		const std::vector<double>& otherReaction) {
+	for (int i = 0; i < reaction.size() && i < otherReaction.size(); i++) {
+		bool isNan = std::isnan(reaction[i]), otherIsNan = std::isnan(
+				otherReaction[i]);
+		if (isNan && otherIsNan)
+			continue;
+		if (isNan || otherIsNan)
+			return otherIsNan;
+		if (reaction[i] != otherReaction[i])
+			return reaction[i] < otherReaction[i];
+	}
+
+	return reaction.size() < otherReaction.size();
+}
+
+/**
+ * Check that two lists of reactions have the same ids and coefficients. The
+ * order of the reactions of a cluster can change from one load to the
+ * next, so they are compared in sorted order. The coefficients that are
+ * not a number in one list have to be not a number in the other one.
+ *
+ * @param reactions The reactions of a cluster of the original network
+ * @param convertedReactions The ones of the same cluster once converted
+ */
+void checkSameReactions(std::vector<std::vector<double> > reactions,
+		std::vector<std::vector<double> > convertedReactions) {
+	BOOST_REQUIRE_EQUAL(convertedReactions.size(), reactions.size());
+	std::sort(reactions.begin(), reactions.end(), reactionComesFirst);
+	std::sort(convertedReactions.begin(), convertedReactions.end(),
+			reactionComesFirst);
+	for (int i = 0; i < reactions.size(); i++) {
+		BOOST_REQUIRE_EQUAL(convertedReactions[i].size(), reactions[i].size());
+		for (int j = 0; j < reactions[i].size(); j++) {
+			if (std::isnan(reactions[i][j]))
+				BOOST_REQUIRE(std::isnan(convertedReactions[i][j]));
+			else
+				BOOST_REQUIRE_EQUAL(convertedReactions[i][j], reactions[i][j]);
+		}
+	}
+}
+
+/**
+ * Convert a copy of a network file written with the per-cluster layout to
+ * the columnar one, and check that the converted file describes the same
+ * network.
+ *
+ * @param loader The loader of this kind of network
+ * @param pathToFile The path of the network file in the source directory
+ * @param checkSuperCluster Compare the data of the super cluster of the
+ * given id in the original and converted network groups
+ */
+void checkConversion(NetworkLoader& loader, const std::string& pathToFile,
+		const std::function<
+				void(const XFile::NetworkGroup&, const XFile::NetworkGroup&,
+						int)>& checkSuperCluster) {
+	// Copy the network file
+	string sourceDir(XolotlSourceDirectory);
+	const std::string testFileName = "test_conversion.h5";
+	{
+		std::ifstream src(sourceDir + pathToFile, std::ios::binary);
+		std::ofstream dst(testFileName, std::ios::binary);
+		dst << src.rdbuf();
+	}
+
+	// Convert it
+	{
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadWrite);
+		auto networkGroup =
+				testFile.getGroup<xolotlCore::XFile::NetworkGroup>();
+		BOOST_REQUIRE(networkGroup);
+		BOOST_REQUIRE_EQUAL(networkGroup->getLayoutVersion(), 1);
+		networkGroup->convertToColumnar();
+		BOOST_REQUIRE_EQUAL(networkGroup->getLayoutVersion(),
+				XFile::NetworkGroup::columnarLayoutVersion);
+	}
+
+	// Compare the cluster data of both groups
+	{
+		xolotlCore::XFile file(sourceDir + pathToFile,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadOnly);
+		auto networkGroup = file.getGroup<xolotlCore::XFile::NetworkGroup>();
+		BOOST_REQUIRE(networkGroup);
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadOnly);
+		auto convertedGroup =
+				testFile.getGroup<xolotlCore::XFile::NetworkGroup>();
+		BOOST_REQUIRE(convertedGroup);
+
+		int normalSize = 0, superSize = 0, convertedNormalSize = 0,
+				convertedSuperSize = 0;
+		networkGroup->readNetworkSize(normalSize, superSize);
+		convertedGroup->readNetworkSize(convertedNormalSize,
+				convertedSuperSize);
+		BOOST_REQUIRE_EQUAL(convertedNormalSize, normalSize);
+		BOOST_REQUIRE_EQUAL(convertedSuperSize, superSize);
+
+		for (int id = 0; id < normalSize; id++) {
+			double formationEnergy = 0.0, migrationEnergy = 0.0,
+					diffusionFactor = 0.0;
+			auto comp = networkGroup->readCluster(id, formationEnergy,
+					migrationEnergy, diffusionFactor);
+			double convertedFormationEnergy = 0.0, convertedMigrationEnergy =
+					0.0, convertedDiffusionFactor = 0.0;
+			auto convertedComp = convertedGroup->readCluster(id,
+					convertedFormationEnergy, convertedMigrationEnergy,
+					convertedDiffusionFactor);
+			BOOST_REQUIRE(convertedComp == comp);
+			BOOST_REQUIRE_EQUAL(convertedFormationEnergy, formationEnergy);
+			BOOST_REQUIRE_EQUAL(convertedMigrationEnergy, migrationEnergy);
+			BOOST_REQUIRE_EQUAL(convertedDiffusionFactor, diffusionFactor);
+		}
+		for (int id = normalSize; id < normalSize + superSize; id++) {
+			checkSuperCluster(*networkGroup, *convertedGroup, id);
+		}
+	}
+
+	// Load both networks
+	Options opts;
+	loader.setFilename(sourceDir + pathToFile);
+	auto network = loader.load(opts);
+	loader.setFilename(testFileName);
+	auto convertedNetwork = loader.load(opts);
+
+	// Check that they have the same clusters and reactions
+	BOOST_REQUIRE_EQUAL(convertedNetwork->size(), network->size());
+	BOOST_REQUIRE_EQUAL(convertedNetwork->getSuperSize(),
+			network->getSuperSize());
+	BOOST_REQUIRE_EQUAL(convertedNetwork->getNReactions(),
+			network->getNReactions());
+	auto& reactants = network->getAll();
+	auto& convertedReactants = convertedNetwork->getAll();
+	for (int i = 0; i < reactants.size(); i++) {
+		IReactant& reactant = reactants.at(i);
+		IReactant& convertedReactant = convertedReactants.at(i);
+		BOOST_REQUIRE_EQUAL(convertedReactant.getName(), reactant.getName());
+		BOOST_REQUIRE_EQUAL(convertedReactant.getFormationEnergy(),
+				reactant.getFormationEnergy());
+		BOOST_REQUIRE_EQUAL(convertedReactant.getMigrationEnergy(),
+				reactant.getMigrationEnergy());
+		BOOST_REQUIRE_EQUAL(convertedReactant.getDiffusionFactor(),
+				reactant.getDiffusionFactor());
+		checkSameReactions(reactant.getProdVector(),
+				convertedReactant.getProdVector());
+		checkSameReactions(reactant.getCombVector(),
+				convertedReactant.getCombVector());
+		checkSameReactions(reactant.getDissoVector(),
+				convertedReactant.getDissoVector());
+		checkSameReactions(reactant.getEmitVector(),
+				convertedReactant.getEmitVector());
+	}
+}
+
+/**
+ * Method checking the conversion of a PSI network from the per-cluster
+ * layout to the columnar one.
+ */
+BOOST_AUTO_TEST_CASE(checkNetworkConversion) {
+	HDF5NetworkLoader loader = HDF5NetworkLoader(
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+	checkConversion(loader, "/tests/testfiles/tungsten_diminutive.h5",
+			[](const XFile::NetworkGroup& networkGroup,
+					const XFile::NetworkGroup& convertedGroup, int id) {
+				BOOST_REQUIRE(convertedGroup.readPSISuperCluster(id)
+						== networkGroup.readPSISuperCluster(id));
+			});
+}
+
+/**
+ * Method checking the conversion of a Fe network, with super clusters,
+ * from the per-cluster layout to the columnar one.
+ */
+BOOST_AUTO_TEST_CASE(checkFeNetworkConversion) {
+	FeClusterNetworkLoader loader = FeClusterNetworkLoader(
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+	checkConversion(loader, "/tests/testfiles/iron_diminutive.h5",
+			[](const XFile::NetworkGroup& networkGroup,
+					const XFile::NetworkGroup& convertedGroup, int id) {
+				auto bounds = networkGroup.readFeSuperCluster(id);
+				auto convertedBounds = convertedGroup.readFeSuperCluster(id);
+				for (int i = 0; i < bounds.size(); i++) {
+					BOOST_REQUIRE_EQUAL(convertedBounds[i], bounds[i]);
+				}
+			});
+}
+
+/**
+ * Method checking the writing and reading of the compressed concentrations.
+ */
+BOOST_AUTO_TEST_CASE(checkCompressedConcentrations) {
+
+	const std::string testFileName = "test_compressed.h5";
+	{
+		// Set the number of grid points and step size
+		int nGrid = 5;
+		double stepSize = 0.5;
+		std::vector<double> grid;
+		for (int i = 0; i < nGrid + 2; i++)
+			grid.push_back((double) i * stepSize);
+
+		xolotlCore::XFile testFile(testFileName, grid, createTestNetworkComps(),
+		MPI_COMM_WORLD);
+	}
+
+	// Determine our part of the grid
+	int commRank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &commRank);
+	const int nGridPointsPerRank = 3;
+	int baseX = commRank * nGridPointsPerRank;
+
+	// Some sparse concentrations, the second grid point is empty
+	XFile::TimestepGroup::Concs1DType myConcs(nGridPointsPerRank);
+	for (int i = 0; i < nGridPointsPerRank; i++) {
+		if (i == 1)
+			continue;
+		for (int l = 0; l < 200; l += (l % 7) + 1) {
+			myConcs[i].emplace_back(l,
+					1.0e-3 * std::exp(-0.1 * l) * (1.0 + 0.1 * (baseX + i)));
+		}
+	}
+
+	// Write it exactly in the first timestep, with a tolerance in the second
+	const double tolerance = 1.0e-4;
+	{
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadWrite);
+		auto concGroup =
+				testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+		auto tsGroup = concGroup->addTimestepGroup(0, 1.0, 0.0, 1.0);
+		tsGroup->writeCompressedConcentrations(testFile, baseX, myConcs);
+		tsGroup = concGroup->addTimestepGroup(1, 2.0, 1.0, 1.0);
+		tsGroup->writeCompressedConcentrations(testFile, baseX, myConcs,
+				tolerance);
+	}
+
+	// Read them back
+	{
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadOnly);
+		auto concGroup =
+				testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+
+		auto tsGroup = concGroup->getTimestepGroup(0);
+		BOOST_REQUIRE(tsGroup);
+		auto readConcs = tsGroup->readConcentrations(testFile, baseX,
+				nGridPointsPerRank);
+		BOOST_REQUIRE_EQUAL(readConcs.size(), myConcs.size());
+		for (int i = 0; i < nGridPointsPerRank; i++) {
+			BOOST_REQUIRE_EQUAL(readConcs[i].size(), myConcs[i].size());
+			for (int j = 0; j < myConcs[i].size(); j++) {
+				BOOST_REQUIRE_EQUAL(readConcs[i][j].first, myConcs[i][j].first);
+				BOOST_REQUIRE_EQUAL(readConcs[i][j].second,
+						myConcs[i][j].second);
+			}
+		}
+
+		tsGroup = concGroup->getLastTimestepGroup();
+		BOOST_REQUIRE(tsGroup);
+		readConcs = tsGroup->readConcentrations(testFile, baseX,
+				nGridPointsPerRank);
+		BOOST_REQUIRE_EQUAL(readConcs.size(), myConcs.size());
+		for (int i = 0; i < nGridPointsPerRank; i++) {
+			BOOST_REQUIRE_EQUAL(readConcs[i].size(), myConcs[i].size());
+			for (int j = 0; j < myConcs[i].size(); j++) {
+				BOOST_REQUIRE_EQUAL(readConcs[i][j].first, myConcs[i][j].first);
+				BOOST_REQUIRE_SMALL(
+						std::fabs(readConcs[i][j].second - myConcs[i][j].second)
+								/ myConcs[i][j].second, tolerance);
+			}
+		}
+
+		// Stream them in small chunks
+		XFile::TimestepGroup::Concs1DType streamedConcs(nGridPointsPerRank);
+		tsGroup->readConcentrations(testFile, baseX, nGridPointsPerRank,
+				[&streamedConcs, baseX](int x, int index, double value) {
+					streamedConcs[x - baseX].emplace_back(index, value);
+				}, 5);
+		for (int i = 0; i < nGridPointsPerRank; i++) {
+			BOOST_REQUIRE_EQUAL(streamedConcs[i].size(), readConcs[i].size());
+			for (int j = 0; j < readConcs[i].size(); j++) {
+				BOOST_REQUIRE_EQUAL(streamedConcs[i][j].first,
+						readConcs[i][j].first);
+				BOOST_REQUIRE_EQUAL(streamedConcs[i][j].second,
+						readConcs[i][j].second);
+			}
+		}
+	}
+}
+
+/**
+ * Method checking the reconstruction of the incremental timesteps.
+ */
+BOOST_AUTO_TEST_CASE(checkIncrementalConcentrations) {
+
+	const std::string testFileName = "test_incremental.h5";
+	{
+		// Set the number of grid points and step size
+		int nGrid = 5;
+		double stepSize = 0.5;
+		std::vector<double> grid;
+		for (int i = 0; i < nGrid + 2; i++)
+			grid.push_back((double) i * stepSize);
+
+		xolotlCore::XFile testFile(testFileName, grid, createTestNetworkComps(),
+		MPI_COMM_WORLD);
+	}
+
+	// Determine our part of the grid
+	int commRank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &commRank);
+	const int nGridPointsPerRank = 3;
+	int baseX = commRank * nGridPointsPerRank;
+
+	// The full concentrations
+	XFile::TimestepGroup::Concs1DType fullConcs(nGridPointsPerRank);
+	for (int i = 0; i < nGridPointsPerRank; i++) {
+		for (int l = 0; l < 10; l++) {
+			fullConcs[i].emplace_back(l, 1.0 + l + baseX + i);
+		}
+	}
+
+	// Only the last grid point changed, with fewer concentrations
+	XFile::TimestepGroup::Concs1DType changedConcs(nGridPointsPerRank);
+	changedConcs[2].emplace_back(3, 5.0);
+	changedConcs[2].emplace_back(9, 7.0);
+
+	// Nothing changed
+	XFile::TimestepGroup::Concs1DType emptyConcs(nGridPointsPerRank);
+
+	{
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadWrite);
+		auto concGroup =
+				testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+		auto tsGroup = concGroup->addTimestepGroup(0, 1.0, 0.0, 1.0);
+		tsGroup->writeConcentrations(testFile, baseX, fullConcs);
+		tsGroup = concGroup->addTimestepGroup(1, 2.0, 1.0, 1.0);
+		tsGroup->writeCompressedConcentrations(testFile, baseX, changedConcs);
+		tsGroup->writeBaseTimeStep(0);
+		tsGroup = concGroup->addTimestepGroup(2, 3.0, 2.0, 1.0);
+		tsGroup->writeConcentrations(testFile, baseX, emptyConcs);
+		tsGroup->writeBaseTimeStep(0);
+	}
+
+	{
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadOnly);
+		auto concGroup =
+				testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+
+		// The full timestep
+		auto tsGroup = concGroup->getTimestepGroup(0);
+		BOOST_REQUIRE(tsGroup);
+		BOOST_REQUIRE_EQUAL(tsGroup->readBaseTimeStep(), -1);
+
+		// The changed grid point replaces the full one
+		tsGroup = concGroup->getTimestepGroup(1);
+		BOOST_REQUIRE(tsGroup);
+		BOOST_REQUIRE_EQUAL(tsGroup->readBaseTimeStep(), 0);
+		auto readConcs = tsGroup->readConcentrations(testFile, baseX,
+				nGridPointsPerRank);
+		BOOST_REQUIRE_EQUAL(readConcs.size(), nGridPointsPerRank);
+		for (int i = 0; i < nGridPointsPerRank; i++) {
+			auto const& expected = (i == 2) ? changedConcs[i] : fullConcs[i];
+			BOOST_REQUIRE_EQUAL(readConcs[i].size(), expected.size());
+			for (int j = 0; j < expected.size(); j++) {
+				BOOST_REQUIRE_EQUAL(readConcs[i][j].first, expected[j].first);
+				BOOST_REQUIRE_EQUAL(readConcs[i][j].second, expected[j].second);
+			}
+		}
+
+		// Everything comes from the full timestep
+		tsGroup = concGroup->getLastTimestepGroup();
+		BOOST_REQUIRE(tsGroup);
+		readConcs = tsGroup->readConcentrations(testFile, baseX,
+				nGridPointsPerRank);
+		for (int i = 0; i < nGridPointsPerRank; i++) {
+			BOOST_REQUIRE_EQUAL(readConcs[i].size(), fullConcs[i].size());
+			for (int j = 0; j < fullConcs[i].size(); j++) {
+				BOOST_REQUIRE_EQUAL(readConcs[i][j].second,
+						fullConcs[i][j].second);
+			}
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -178,6 +178,33 @@ BOOST_AUTO_TEST_CASE(checkModifiedTrapMutation) {
 	BOOST_REQUIRE_CLOSE(val[4], 5.53624e+14, 0.01);
 	BOOST_REQUIRE_CLOSE(val[5], 5.53624e+14, 0.01);
 
+	// Move the surface by one grid point, the trap-mutations must be the
+	// same as the ones of a new handler
+	trapMutationHandler.initializeIndex1D(surfacePos + 1, *network,
+			advectionHandlers, grid, 11, 0);
+	W100TrapMutationHandler movedHandler;
+	movedHandler.initialize(*network, 11);
+	movedHandler.initializeIndex1D(surfacePos + 1, *network,
+			advectionHandlers, grid, 11, 0);
+	int movedIndices[3 * nHelium];
+	double movedVal[3 * nHelium];
+	for (int xi = 0; xi < 11; xi++) {
+		nMutating = trapMutationHandler.computePartialsForTrapMutation(
+				*network, valPointer, indicesPointer, xi);
+		int nMoved = movedHandler.computePartialsForTrapMutation(*network,
+				movedVal, movedIndices, xi);
+		BOOST_REQUIRE_EQUAL(nMutating, nMoved);
+		for (int n = 0; n < 3 * nMutating; n++) {
+			BOOST_REQUIRE_EQUAL(indices[n], movedIndices[n]);
+			BOOST_REQUIRE_CLOSE(val[n], movedVal[n], 0.01);
+		}
+	}
+
+	// No trap-mutation on the left side of the surface
+	nMutating = trapMutationHandler.computePartialsForTrapMutation(*network,
+			valPointer, indicesPointer, 1);
+	BOOST_REQUIRE_EQUAL(nMutating, 0);
+
 	// Remove the created file
 	std::string tempFile = "param.txt";
 	std::remove(tempFile.c_str());
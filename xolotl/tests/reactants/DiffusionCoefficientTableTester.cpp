@@ -0,0 +1,108 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Regression
+
+#include <boost/test/unit_test.hpp>
+#include <DiffusionCoefficientTable.h>
+#include <Constants.h>
+#include <math.h>
+
+using namespace std;
+using namespace xolotlCore;
+
+/**
+ * This suite is responsible for testing the DiffusionCoefficientTable.
+ */
+BOOST_AUTO_TEST_SUITE(DiffusionCoefficientTable_testSuite)
+
+/**
+ * Method checking the computation of the coefficients.
+ */
+BOOST_AUTO_TEST_CASE(checkArrhenius) {
+	// Create a table with two diffusing reactants and one that doesn't
+	DiffusionCoefficientTable table;
+	BOOST_REQUIRE_EQUAL(table.addColumn(1.0e11, 0.13), 0);
+	BOOST_REQUIRE_EQUAL(table.addColumn(0.0, 0.5), 1);
+	BOOST_REQUIRE_EQUAL(table.addColumn(2.0e10, 1.3), 2);
+	table.addGridPoints(3);
+	BOOST_REQUIRE_EQUAL(table.getNumberOfColumns(), 3);
+	BOOST_REQUIRE_EQUAL(table.getNumberOfGridPoints(), 3);
+
+	// Compute the second grid point
+	table.setTemperature(1000.0, 1);
+	BOOST_REQUIRE(!table.isComputed(1));
+	table.computeArrhenius(1);
+	BOOST_REQUIRE(table.isComputed(1));
+	const double *row = table.getRow(1);
+	BOOST_REQUIRE_CLOSE(row[0],
+			1.0e11 * exp(-0.13 / (xolotlCore::kBoltzmann * 1000.0)), 1.0e-10);
+	BOOST_REQUIRE_EQUAL(row[1], 0.0);
+	BOOST_REQUIRE_CLOSE(row[2],
+			2.0e10 * exp(-1.3 / (xolotlCore::kBoltzmann * 1000.0)), 1.0e-10);
+
+	// The other grid points are not computed
+	BOOST_REQUIRE_EQUAL(table.getRow(0)[0], 0.0);
+	BOOST_REQUIRE_EQUAL(table.getRow(2)[2], 0.0);
+
+	// Changing the temperature or a column needs a new computation
+	table.setTemperature(1200.0, 1);
+	BOOST_REQUIRE(!table.isComputed(1));
+	table.computeArrhenius(1);
+	table.setColumn(2, 2.0e10, 1.3);
+	BOOST_REQUIRE(table.isComputed(1));
+	table.setColumn(2, 2.0e10, 1.2);
+	BOOST_REQUIRE(!table.isComputed(1));
+
+	return;
+}
+
+/**
+ * Method checking the addition and removal of grid points at the surface.
+ */
+BOOST_AUTO_TEST_CASE(checkGridPoints) {
+	// Create a table with one column
+	DiffusionCoefficientTable table;
+	table.addColumn(1.0, 0.0);
+	table.addGridPoints(4);
+	for (int i = 0; i < 4; i++) {
+		table.setTemperature(100.0 * (i + 1), i);
+		table.getRow(i)[0] = (double) i;
+	}
+
+	// Add grid points one at a time at the surface
+	for (int n = 1; n <= 10; n++) {
+		table.addGridPoints(1);
+		BOOST_REQUIRE_EQUAL(table.getNumberOfGridPoints(), 4 + n);
+		BOOST_REQUIRE_EQUAL(table.getTemperature(0), 0.0);
+		BOOST_REQUIRE_EQUAL(table.getRow(0)[0], 0.0);
+		BOOST_REQUIRE(!table.isComputed(0));
+		for (int i = 0; i < 4; i++) {
+			BOOST_REQUIRE_EQUAL(table.getTemperature(n + i), 100.0 * (i + 1));
+			BOOST_REQUIRE_EQUAL(table.getRow(n + i)[0], (double) i);
+		}
+	}
+
+	// Add a column, the values are kept
+	BOOST_REQUIRE_EQUAL(table.addColumn(1.0, 0.0), 1);
+	for (int i = 0; i < 4; i++) {
+		BOOST_REQUIRE_EQUAL(table.getRow(10 + i)[0], (double) i);
+		BOOST_REQUIRE_EQUAL(table.getRow(10 + i)[1], 0.0);
+	}
+
+	// Remove the grid points at the surface
+	table.addGridPoints(-11);
+	BOOST_REQUIRE_EQUAL(table.getNumberOfGridPoints(), 3);
+	for (int i = 0; i < 3; i++) {
+		BOOST_REQUIRE_EQUAL(table.getTemperature(i), 100.0 * (i + 2));
+		BOOST_REQUIRE_EQUAL(table.getRow(i)[0], (double) (i + 1));
+	}
+
+	// Add them back
+	table.addGridPoints(2);
+	BOOST_REQUIRE_EQUAL(table.getNumberOfGridPoints(), 5);
+	BOOST_REQUIRE_EQUAL(table.getTemperature(1), 0.0);
+	BOOST_REQUIRE_EQUAL(table.getTemperature(2), 200.0);
+
+	return;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -11,6 +11,7 @@
 #include <DummyHandlerRegistry.h>
 #include <Constants.h>
 #include <Options.h>
+#include "tests/utils/NetworkTestUtils.h"
 #include <fstream>
 #include <iostream>
 
@@ -269,4 +270,52 @@ BOOST_AUTO_TEST_CASE(checkReactionRadius) {
 	return;
 }
 
+/**
+ * This operation checks that the weights of the totals give the same totals
+ * as the ones computed from the clusters.
+ */
+BOOST_AUTO_TEST_CASE(checkTotalWeights) {
+	// Read the options
+	Options opts;
+	testUtils::readOptions(opts, "netParam=6 0 0 6 1\n");
+
+	// Create the network loader
+	FeClusterNetworkLoader loader = FeClusterNetworkLoader(
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+	// Set grouping parameters
+	loader.setVMin(4);
+	loader.setHeWidth(2);
+	loader.setVWidth(2);
+	// Load the network
+	auto network = loader.generate(opts);
+
+	// Fill two concentration arrays, moments included
+	const int dof = network->getDOF();
+	std::vector<double> concs(dof, 0.0), otherConcs(dof, 0.0);
+	for (int i = 0; i < dof - 1; i++) {
+		concs[i] = 1.0e-3 * (double) ((i % 7) + 1) - 2.0e-4 * (double) (i % 3);
+		otherConcs[i] = 1.0e-2 * (double) ((i % 5) + 1);
+	}
+	const double *points[2] = { concs.data(), otherConcs.data() };
+
+	// Check each total against the one computed from the clusters
+	using TotalType = IReactionNetwork::TotalType;
+	for (auto const& values : points) {
+		network->updateConcentrationsFromArray(const_cast<double *>(values));
+
+		BOOST_REQUIRE_CLOSE(network->getTotal(TotalType::HeAtom, values),
+				network->getTotalAtomConcentration(0), 1.0e-10);
+		BOOST_REQUIRE_CLOSE(network->getTotal(TotalType::DAtom, values),
+				network->getTotalAtomConcentration(1), 1.0e-10);
+		BOOST_REQUIRE_CLOSE(network->getTotal(TotalType::TrappedHeAtom, values),
+				network->getTotalTrappedAtomConcentration(0), 1.0e-10);
+		BOOST_REQUIRE_CLOSE(network->getTotal(TotalType::V, values),
+				network->getTotalVConcentration(), 1.0e-10);
+		BOOST_REQUIRE_CLOSE(network->getTotal(TotalType::I, values),
+				network->getTotalIConcentration(), 1.0e-10);
+	}
+
+	return;
+}
+
 BOOST_AUTO_TEST_SUITE_END()
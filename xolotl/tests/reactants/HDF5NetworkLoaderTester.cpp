@@ -9,6 +9,8 @@
 #include <mpi.h>
 #include <memory>
 #include <Options.h>
+#include "tests/utils/NetworkTestUtils.h"
+#include "xolotlCore/io/NetworkCache.h"
 #include "tests/utils/MPIFixture.h"
 
 using namespace std;
@@ -99,4 +101,58 @@ BOOST_AUTO_TEST_CASE(checkLoad) {
 	return;
 }
 
+/**
+ * Method checking that a generated network is added to the cache and that
+ * the network loaded from the cache is the same.
+ */
+BOOST_AUTO_TEST_CASE(checkCache) {
+	// Start from an empty cache
+	std::string cacheDir("networkCacheTest");
+	fs::remove_all(cacheDir);
+
+	// Read the options
+	Options opts;
+	testUtils::readOptions(opts,
+			"netParam=8 0 0 5 2\nnetworkCache=" + cacheDir + "\n");
+
+	// Create the loader with grouping
+	HDF5NetworkLoader loader = HDF5NetworkLoader(
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+	loader.setVMin(4);
+	loader.setWidth(4, 0);
+	loader.setWidth(1, 3);
+
+	// The first network is generated and written in the cache
+	auto network = loader.generate(opts);
+	int nFiles = 0;
+	for (auto const& entry : fs::directory_iterator(cacheDir)) {
+		BOOST_REQUIRE_EQUAL(entry.path().extension().string(), ".h5");
+		nFiles++;
+	}
+	BOOST_REQUIRE_EQUAL(nFiles, 1);
+
+	// The second one is loaded from the cache
+	auto cachedNetwork = loader.generate(opts);
+	BOOST_REQUIRE_EQUAL(cachedNetwork->size(), network->size());
+	BOOST_REQUIRE_EQUAL(cachedNetwork->getSuperSize(),
+			network->getSuperSize());
+
+	// Compare the fluxes of both networks
+	testUtils::compareNetworkFluxes(*network, *cachedNetwork, 1.0e-8);
+
+	// Other options use another file
+	loader.setWidth(2, 3);
+	loader.generate(opts);
+	nFiles = 0;
+	for (auto const& entry : fs::directory_iterator(cacheDir)) {
+		nFiles++;
+	}
+	BOOST_REQUIRE_EQUAL(nFiles, 2);
+
+	// Remove the cache
+	fs::remove_all(cacheDir);
+
+	return;
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -10,6 +10,7 @@
 #include <PSIClusterReactionNetwork.h>
 #include <Options.h>
 #include "tests/utils/MPIFixture.h"
+#include "tests/utils/NetworkTestUtils.h"
 #include <fstream>
 #include <iostream>
 
@@ -158,4 +159,37 @@ BOOST_AUTO_TEST_CASE(checkGenerate) {
 	return;
 }
 
+/**
+ * Method checking that the network generated with several threads is the
+ * same as the one generated with a single one.
+ */
+BOOST_AUTO_TEST_CASE(checkGenerateThreads) {
+	// Generate the grouped network with 1 and 4 threads
+	std::vector<std::unique_ptr<IReactionNetwork> > networks;
+	for (int nThreads : { 1, 4 }) {
+		// Read the options
+		Options opts;
+		testUtils::readOptions(opts,
+				"netParam=8 0 0 5 2\nthreads=" + std::to_string(nThreads)
+						+ "\n");
+
+		// Create the loader
+		PSIClusterNetworkLoader loader = PSIClusterNetworkLoader(
+				std::make_shared<xolotlPerf::DummyHandlerRegistry>());
+		// Set grouping parameters
+		loader.setVMin(4);
+		loader.setWidth(4, 0);
+		loader.setWidth(1, 3);
+
+		// Generate the network from the options
+		networks.push_back(loader.generate(opts));
+	}
+	BOOST_REQUIRE_EQUAL(networks[1]->size(), networks[0]->size());
+
+	// The reactions are defined in the same order so the fluxes are equal
+	testUtils::compareNetworkFluxes(*networks[0], *networks[1], 0.0);
+
+	return;
+}
+
 BOOST_AUTO_TEST_SUITE_END()
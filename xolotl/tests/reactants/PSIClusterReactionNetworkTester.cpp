@@ -263,4 +263,99 @@ BOOST_AUTO_TEST_CASE(checkArrayOperations) {
 	return;
 }
 
+/**
+ * This operation checks that the batched rate evaluator gives the same rate
+ * constants as the per-reaction computation.
+ */
+BOOST_AUTO_TEST_CASE(checkRateEvaluator) {
+	// Get the network
+	shared_ptr<ReactionNetwork> network = getSimplePSIReactionNetwork();
+	auto& psiNetwork = static_cast<PSIClusterReactionNetwork&>(*network);
+	const int dof = network->getDOF();
+
+	// Set some concentrations
+	std::vector<double> concs(dof, 0.0);
+	for (int i = 0; i < dof; i++) {
+		concs[i] = 1.0e-3 * (double) (i + 1);
+	}
+	network->updateConcentrationsFromArray(concs.data());
+
+	// Compute the rates with the evaluator and get the fluxes from the
+	// rates stored in the reactions
+	psiNetwork.addGridPoints(1);
+	psiNetwork.setTemperature(1000.0, 0);
+	double biggestRate = network->getBiggestRate();
+	std::vector<double> fluxes(dof, 0.0);
+	network->computeAllFluxes(fluxes.data(), 0);
+
+	// Compute them again reaction by reaction
+	network->ReactionNetwork::computeRateConstants(0);
+	BOOST_REQUIRE_CLOSE(network->getBiggestRate(), biggestRate, 1.0e-10);
+	std::vector<double> refFluxes(dof, 0.0);
+	network->computeAllFluxes(refFluxes.data(), 0);
+	for (int i = 0; i < dof; i++) {
+		BOOST_REQUIRE_CLOSE(refFluxes[i], fluxes[i], 1.0e-10);
+	}
+
+	return;
+}
+
+/**
+ * This operation checks that the rate constants interpolated from the
+ * temperature bin cache match the ones computed directly.
+ */
+BOOST_AUTO_TEST_CASE(checkRateCache) {
+	// Get two identical networks
+	shared_ptr<ReactionNetwork> network = getSimplePSIReactionNetwork();
+	auto& refNetwork = static_cast<PSIClusterReactionNetwork&>(*network);
+	shared_ptr<ReactionNetwork> cachedNetwork = getSimplePSIReactionNetwork();
+	auto& psiNetwork = static_cast<PSIClusterReactionNetwork&>(*cachedNetwork);
+	const int dof = network->getDOF();
+
+	// Use three grid points and bins of 1 K
+	refNetwork.addGridPoints(3);
+	psiNetwork.addGridPoints(3);
+	psiNetwork.setRateCacheBinWidth(1.0);
+
+	// Set some concentrations
+	std::vector<double> concs(dof, 0.0);
+	for (int i = 0; i < dof; i++) {
+		concs[i] = 1.0e-3 * (double) (i + 1);
+	}
+
+	// The first point is on a bin boundary, the other two share its bin
+	double temps[3] = { 1000.0, 1000.25, 1000.75 };
+	for (int xi = 0; xi < 3; xi++) {
+		refNetwork.setTemperature(temps[xi], xi);
+		psiNetwork.setTemperature(temps[xi], xi);
+	}
+	// Only the two bin boundaries were computed
+	BOOST_REQUIRE_EQUAL(psiNetwork.getRateCacheSize(), 2);
+
+	// Compare the fluxes
+	for (int xi = 0; xi < 3; xi++) {
+		std::vector<double> refFluxes(dof, 0.0), fluxes(dof, 0.0);
+		refNetwork.computeAllFluxes(concs.data(), refFluxes.data(), xi);
+		psiNetwork.computeAllFluxes(concs.data(), fluxes.data(), xi);
+		for (int i = 0; i < dof; i++) {
+			BOOST_REQUIRE_CLOSE(refFluxes[i], fluxes[i], 0.01);
+		}
+	}
+
+	// The diffusion coefficients are still computed at the actual temperature
+	for (IReactant& reactant : cachedNetwork->getAll()) {
+		auto& refReactant = refNetwork.getAll().at(reactant.getId() - 1).get();
+		for (int xi = 0; xi < 3; xi++) {
+			BOOST_REQUIRE_CLOSE(refReactant.getDiffusionCoefficient(xi),
+					reactant.getDiffusionCoefficient(xi), 1.0e-10);
+		}
+	}
+
+	// Disabling the cache empties it
+	psiNetwork.setRateCacheBinWidth(0.0);
+	BOOST_REQUIRE_EQUAL(psiNetwork.getRateCacheSize(), 0);
+
+	return;
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -11,7 +11,10 @@
 #include <DummyHandlerRegistry.h>
 #include <Constants.h>
 #include <Options.h>
+#include "tests/utils/NetworkTestUtils.h"
 #include <fstream>
+#include <cmath>
+#include <algorithm>
 #include <iostream>
 
 using namespace std;
@@ -358,6 +361,489 @@ BOOST_AUTO_TEST_CASE(checkGetConcentrations) {
 	return;
 }
 
+/**
+ * This operation checks that the fluxes computed directly from the
+ * concentration array are the same as the ones computed from the state
+ * stored in the clusters.
+ */
+BOOST_AUTO_TEST_CASE(checkFluxesFromArray) {
+	// Create the parameter file
+	std::ofstream paramFile("param.txt");
+	paramFile << "netParam=8 0 0 5 0" << std::endl << "grid=100 0.5"
+			<< std::endl;
+	paramFile.close();
+
+	// Create a fake command line to read the options
+	int argc = 2;
+	char **argv = new char*[3];
+	std::string appName = "fakeXolotlAppNameForTests";
+	argv[0] = new char[appName.length() + 1];
+	strcpy(argv[0], appName.c_str());
+	std::string parameterFile = "param.txt";
+	argv[1] = new char[parameterFile.length() + 1];
+	strcpy(argv[1], parameterFile.c_str());
+	argv[2] = 0; // null-terminate the array
+
+	// Read the options
+	Options opts;
+	opts.readParams(argc, argv);
+
+	// Create the loader
+	PSIClusterNetworkLoader loader = PSIClusterNetworkLoader(
+			std::make_shared<xolotlPerf::DummyHandlerRegistry>());
+	// Set grouping parameters
+	loader.setVMin(4);
+	loader.setWidth(4, 0);
+	loader.setWidth(1, 3);
+
+	// Generate the network from the options
+	auto network = loader.generate(opts);
+	// Add a grid point for the rates
+	network->addGridPoints(1);
+
+	// Set the temperature in the network
+	double temperature = 1000.0;
+	network->setTemperature(temperature, 0);
+	// Recompute Ids and network size and redefine the connectivities
+	network->reinitializeConnectivities();
+
+	// Fill a concentration array, moments included
+	const int dof = network->getDOF();
+	std::vector<double> concs(dof, 0.0);
+	for (int i = 0; i < dof - 1; i++) {
+		concs[i] = 1.0e-3 * (double) ((i % 7) + 1) - 2.0e-4 * (double) (i % 3);
+	}
+
+	// Compute the fluxes with the state stored in the clusters
+	std::vector<double> refFluxes(dof, 0.0);
+	network->updateConcentrationsFromArray(concs.data());
+	network->computeAllFluxes(refFluxes.data(), 0);
+
+	// Reset the state of the clusters to make sure it is not used
+	std::vector<double> zeros(dof, 0.0);
+	network->updateConcentrationsFromArray(zeros.data());
+
+	// Compute the fluxes directly from the array
+	std::vector<double> fluxes(dof, 0.0);
+	network->computeAllFluxes(concs.data(), fluxes.data(), 0);
+
+	// Check all the values
+	for (int i = 0; i < dof; i++) {
+		BOOST_REQUIRE_CLOSE(fluxes[i], refFluxes[i], 1.0e-8);
+	}
+
+	return;
+}
+
+/**
+ * This operation checks that the totals computed from the weights are the
+ * same as the ones computed from the state stored in the clusters.
+ */
+BOOST_AUTO_TEST_CASE(checkTotalWeights) {
+	// Read the options
+	Options opts;
+	testUtils::readOptions(opts, "netParam=8 0 0 5 2\ngrid=100 0.5\n");
+
+	// Create the loader
+	PSIClusterNetworkLoader loader = PSIClusterNetworkLoader(
+			std::make_shared<xolotlPerf::DummyHandlerRegistry>());
+	// Set grouping parameters
+	loader.setVMin(4);
+	loader.setWidth(4, 0);
+	loader.setWidth(1, 3);
+
+	// Generate the network from the options
+	auto network = loader.generate(opts);
+
+	// Fill two concentration arrays, moments included
+	const int dof = network->getDOF();
+	std::vector<double> concs(dof, 0.0), otherConcs(dof, 0.0);
+	for (int i = 0; i < dof - 1; i++) {
+		concs[i] = 1.0e-3 * (double) ((i % 7) + 1) - 2.0e-4 * (double) (i % 3);
+		otherConcs[i] = 1.0e-2 * (double) ((i % 5) + 1);
+	}
+	const double *points[2] = { concs.data(), otherConcs.data() };
+
+	// Check each total against the one computed from the clusters
+	using TotalType = IReactionNetwork::TotalType;
+	for (auto const& values : points) {
+		network->updateConcentrationsFromArray(const_cast<double *>(values));
+
+		BOOST_REQUIRE_CLOSE(network->getTotal(TotalType::HeAtom, values),
+				network->getTotalAtomConcentration(0), 1.0e-10);
+		BOOST_REQUIRE_CLOSE(network->getTotal(TotalType::TrappedHeAtom, values),
+				network->getTotalTrappedAtomConcentration(0), 1.0e-10);
+		BOOST_REQUIRE_CLOSE(network->getTotal(TotalType::V, values),
+				network->getTotalVConcentration(), 1.0e-10);
+		BOOST_REQUIRE_CLOSE(network->getTotal(TotalType::I, values),
+				network->getTotalIConcentration(), 1.0e-10);
+		BOOST_REQUIRE_SMALL(network->getTotal(TotalType::DAtom, values),
+				1.0e-15);
+	}
+
+	// Check the batched version
+	double totals[2] = { 0.0, 0.0 };
+	network->getTotals(TotalType::HeAtom, points, 2, totals);
+	BOOST_REQUIRE_CLOSE(totals[0], network->getTotal(TotalType::HeAtom, points[0]),
+			1.0e-12);
+	BOOST_REQUIRE_CLOSE(totals[1], network->getTotal(TotalType::HeAtom, points[1]),
+			1.0e-12);
+
+	return;
+}
+
+/**
+ * This operation checks that the partial derivatives computed from the
+ * concentration array match the ones computed from the state stored in
+ * the clusters.
+ */
+BOOST_AUTO_TEST_CASE(checkPartialsFromArray) {
+	// Create the parameter file
+	std::ofstream paramFile("param.txt");
+	paramFile << "netParam=8 0 0 5 0" << std::endl << "grid=100 0.5"
+			<< std::endl;
+	paramFile.close();
+
+	// Create a fake command line to read the options
+	int argc = 2;
+	char **argv = new char*[3];
+	std::string appName = "fakeXolotlAppNameForTests";
+	argv[0] = new char[appName.length() + 1];
+	strcpy(argv[0], appName.c_str());
+	std::string parameterFile = "param.txt";
+	argv[1] = new char[parameterFile.length() + 1];
+	strcpy(argv[1], parameterFile.c_str());
+	argv[2] = 0; // null-terminate the array
+
+	// Read the options
+	Options opts;
+	opts.readParams(argc, argv);
+
+	// Create the loader
+	PSIClusterNetworkLoader loader = PSIClusterNetworkLoader(
+			std::make_shared<xolotlPerf::DummyHandlerRegistry>());
+	// Set grouping parameters
+	loader.setVMin(4);
+	loader.setWidth(4, 0);
+	loader.setWidth(1, 3);
+
+	// Generate the network from the options
+	auto network = loader.generate(opts);
+	// Add a grid point for the rates
+	network->addGridPoints(1);
+
+	// Set the temperature in the network
+	double temperature = 1000.0;
+	network->setTemperature(temperature, 0);
+	// Recompute Ids and network size and redefine the connectivities
+	network->reinitializeConnectivities();
+
+	// Set up the network to be able to compute the partial derivatives
+	xolotlCore::IReactionNetwork::SparseFillMap dfill;
+	network->getDiagonalFill(dfill);
+	BOOST_REQUIRE(network->canComputeConcurrently());
+	// Get the dof
+	const int dof = network->getDOF();
+	// Initialize the arrays for the reaction partial derivatives
+	std::vector<int> reactionSize;
+	reactionSize.resize(dof);
+	std::vector<size_t> reactionStartingIdx;
+	reactionStartingIdx.resize(dof);
+	auto nPartials = network->initPartialsSizes(reactionSize,
+			reactionStartingIdx);
+	std::vector<int> reactionIndices;
+	reactionIndices.resize(nPartials);
+	network->initPartialsIndices(reactionSize, reactionStartingIdx,
+			reactionIndices);
+
+	// Fill a concentration array, moments included
+	std::vector<double> concs(dof, 0.0);
+	for (int i = 0; i < dof - 1; i++) {
+		concs[i] = 1.0e-3 * (double) ((i % 7) + 1) - 2.0e-4 * (double) (i % 3);
+	}
+
+	// Compute the partials with the state stored in the clusters
+	std::vector<double> refVals(nPartials, 0.0);
+	network->updateConcentrationsFromArray(concs.data());
+	network->computeAllPartials(reactionStartingIdx, reactionIndices, refVals,
+			0);
+
+	// Reset the state of the clusters to make sure it is not used
+	std::vector<double> zeros(dof, 0.0);
+	network->updateConcentrationsFromArray(zeros.data());
+
+	// Compute the partials directly from the array
+	std::vector<double> vals(nPartials, 1.0);
+	network->computeAllPartials(concs.data(), reactionStartingIdx,
+			reactionIndices, vals, 0);
+
+	// Check all the values, relative to the largest one of each row
+	for (int i = 0; i < dof - 1; i++) {
+		double scale = 0.0;
+		for (int j = 0; j < reactionSize[i]; j++) {
+			scale = std::max(scale,
+					std::fabs(refVals[reactionStartingIdx[i] + j]));
+		}
+		for (int j = 0; j < reactionSize[i]; j++) {
+			auto idx = reactionStartingIdx[i] + j;
+			BOOST_REQUIRE_SMALL(vals[idx] - refVals[idx],
+					std::max(1.0e-10 * scale, 1.0e-30));
+		}
+	}
+
+	return;
+}
+
+/**
+ * This operation checks the product of the partial derivatives with a
+ * vector computed without storing them.
+ */
+BOOST_AUTO_TEST_CASE(checkPartialsAction) {
+	// Create the parameter file
+	std::ofstream paramFile("param.txt");
+	paramFile << "netParam=8 0 0 5 0" << std::endl << "grid=100 0.5"
+			<< std::endl;
+	paramFile.close();
+
+	// Create a fake command line to read the options
+	int argc = 2;
+	char **argv = new char*[3];
+	std::string appName = "fakeXolotlAppNameForTests";
+	argv[0] = new char[appName.length() + 1];
+	strcpy(argv[0], appName.c_str());
+	std::string parameterFile = "param.txt";
+	argv[1] = new char[parameterFile.length() + 1];
+	strcpy(argv[1], parameterFile.c_str());
+	argv[2] = 0; // null-terminate the array
+
+	// Read the options
+	Options opts;
+	opts.readParams(argc, argv);
+
+	// Create the loader
+	PSIClusterNetworkLoader loader = PSIClusterNetworkLoader(
+			std::make_shared<xolotlPerf::DummyHandlerRegistry>());
+	// Set grouping parameters
+	loader.setVMin(4);
+	loader.setWidth(4, 0);
+	loader.setWidth(1, 3);
+
+	// Generate the network from the options
+	auto network = loader.generate(opts);
+	// Add a grid point for the rates
+	network->addGridPoints(1);
+
+	// Set the temperature in the network
+	double temperature = 1000.0;
+	network->setTemperature(temperature, 0);
+	// Recompute Ids and network size and redefine the connectivities
+	network->reinitializeConnectivities();
+
+	// Set up the network to be able to compute the partial derivatives
+	xolotlCore::IReactionNetwork::SparseFillMap dfill;
+	network->getDiagonalFill(dfill);
+	BOOST_REQUIRE(network->canComputeConcurrently());
+	// Get the dof
+	const int dof = network->getDOF();
+	// Initialize the arrays for the reaction partial derivatives
+	std::vector<int> reactionSize;
+	reactionSize.resize(dof);
+	std::vector<size_t> reactionStartingIdx;
+	reactionStartingIdx.resize(dof);
+	auto nPartials = network->initPartialsSizes(reactionSize,
+			reactionStartingIdx);
+	std::vector<int> reactionIndices;
+	reactionIndices.resize(nPartials);
+	network->initPartialsIndices(reactionSize, reactionStartingIdx,
+			reactionIndices);
+
+	// Fill a concentration array and a vector, moments included
+	std::vector<double> concs(dof, 0.0), vec(dof, 0.0);
+	for (int i = 0; i < dof - 1; i++) {
+		concs[i] = 1.0e-3 * (double) ((i % 7) + 1) - 2.0e-4 * (double) (i % 3);
+		vec[i] = 1.0 - 0.3 * (double) (i % 5);
+	}
+
+	// Compute the partials
+	std::vector<double> vals(nPartials, 0.0);
+	network->computeAllPartials(concs.data(), reactionStartingIdx,
+			reactionIndices, vals, 0);
+
+	// Two ways of grouping the DOFs: one per block, and the moments with
+	// their super cluster
+	std::vector<int> diagonalIds(dof), clusterIds(dof);
+	for (int i = 0; i < dof; i++) {
+		diagonalIds[i] = i;
+		clusterIds[i] = i;
+	}
+	for (auto const& currReactant : network->getAll()) {
+		for (int axis = 0; axis < 4; axis++) {
+			clusterIds[currReactant.get().getMomentId(axis) - 1] =
+					currReactant.get().getId() - 1;
+		}
+	}
+
+	for (auto const& blockIds : { diagonalIds, clusterIds }) {
+		// Multiply the partials outside of the blocks
+		std::vector<double> refResult(dof, 0.0);
+		for (int i = 0; i < dof - 1; i++) {
+			for (int j = 0; j < reactionSize[i]; j++) {
+				auto idx = reactionStartingIdx[i] + j;
+				if (blockIds[reactionIndices[idx]] != blockIds[i])
+					refResult[i] += vals[idx] * vec[reactionIndices[idx]];
+			}
+		}
+
+		// Compute the product directly
+		std::vector<double> result(dof, 0.0), workspace(nPartials, 0.0);
+		network->computeAllPartialsAction(concs.data(), vec.data(),
+				result.data(), blockIds, reactionStartingIdx, reactionIndices,
+				workspace, 0);
+
+		// Check all the values, relative to the largest partial of each row
+		for (int i = 0; i < dof - 1; i++) {
+			double scale = 0.0;
+			for (int j = 0; j < reactionSize[i]; j++) {
+				scale = std::max(scale,
+						std::fabs(vals[reactionStartingIdx[i] + j]));
+			}
+			BOOST_REQUIRE_SMALL(result[i] - refResult[i],
+					std::max(1.0e-10 * scale, 1.0e-30));
+		}
+	}
+
+	return;
+}
+
+/**
+ * This operation checks that the reaction table gives the same results
+ * once it is shared by the processes of the node.
+ */
+BOOST_AUTO_TEST_CASE(checkSharedReactionTable) {
+	// Create the parameter file
+	std::ofstream paramFile("param.txt");
+	paramFile << "netParam=8 0 0 5 0" << std::endl << "grid=100 0.5"
+			<< std::endl;
+	paramFile.close();
+
+	// Create a fake command line to read the options
+	int argc = 2;
+	char **argv = new char*[3];
+	std::string appName = "fakeXolotlAppNameForTests";
+	argv[0] = new char[appName.length() + 1];
+	strcpy(argv[0], appName.c_str());
+	std::string parameterFile = "param.txt";
+	argv[1] = new char[parameterFile.length() + 1];
+	strcpy(argv[1], parameterFile.c_str());
+	argv[2] = 0; // null-terminate the array
+
+	// Read the options
+	Options opts;
+	opts.readParams(argc, argv);
+
+	// Create the loader
+	PSIClusterNetworkLoader loader = PSIClusterNetworkLoader(
+			std::make_shared<xolotlPerf::DummyHandlerRegistry>());
+	// Set grouping parameters
+	loader.setVMin(4);
+	loader.setWidth(4, 0);
+	loader.setWidth(1, 3);
+
+	// Generate the network from the options
+	auto network = loader.generate(opts);
+	// Add a grid point for the rates
+	network->addGridPoints(1);
+
+	// Set the temperature in the network
+	double temperature = 1000.0;
+	network->setTemperature(temperature, 0);
+	// Recompute Ids and network size and redefine the connectivities
+	network->reinitializeConnectivities();
+
+	// Set up the network to be able to compute the partial derivatives
+	xolotlCore::IReactionNetwork::SparseFillMap dfill;
+	network->getDiagonalFill(dfill);
+	// Get the dof
+	const int dof = network->getDOF();
+	// Initialize the arrays for the reaction partial derivatives
+	std::vector<int> reactionSize;
+	reactionSize.resize(dof);
+	std::vector<size_t> reactionStartingIdx;
+	reactionStartingIdx.resize(dof);
+	auto nPartials = network->initPartialsSizes(reactionSize,
+			reactionStartingIdx);
+	std::vector<int> reactionIndices;
+	reactionIndices.resize(nPartials);
+	network->initPartialsIndices(reactionSize, reactionStartingIdx,
+			reactionIndices);
+
+	// Fill a concentration array, moments included
+	std::vector<double> concs(dof, 0.0);
+	for (int i = 0; i < dof - 1; i++) {
+		concs[i] = 1.0e-3 * (double) ((i % 7) + 1) - 2.0e-4 * (double) (i % 3);
+	}
+
+	// Compute the fluxes and partials with the private table
+	auto const& table =
+			static_cast<PSIClusterReactionNetwork&>(*network).getReactionTable();
+	BOOST_REQUIRE(!table.isShared());
+	int nTerms = table.getNTerms();
+	std::vector<double> refFluxes(dof, 0.0);
+	network->computeAllFluxes(concs.data(), refFluxes.data(), 0);
+	std::vector<double> refVals(nPartials, 0.0);
+	network->computeAllPartials(concs.data(), reactionStartingIdx,
+			reactionIndices, refVals, 0);
+
+	// Get a cluster that combines with others
+	IReactant::Composition composition;
+	composition[toCompIdx(Species::He)] = 1;
+	auto cluster = network->get(ReactantType::He, composition);
+	BOOST_REQUIRE(!cluster->getCombVector().empty());
+
+	// Share the table
+	network->shareReadOnlyData();
+	BOOST_REQUIRE(table.isShared());
+	BOOST_REQUIRE_EQUAL(table.getNTerms(), nTerms);
+
+	// The clusters don't keep their own copy of the reactions
+	BOOST_REQUIRE(cluster->getCombVector().empty());
+	std::vector<double> fluxes(dof, 0.0);
+	BOOST_REQUIRE_THROW(network->computeAllFluxes(fluxes.data(), 0),
+			std::string);
+	BOOST_REQUIRE_THROW(network->reinitializeConnectivities(), std::string);
+
+	// Compute them again
+	network->computeAllFluxes(concs.data(), fluxes.data(), 0);
+	std::vector<double> vals(nPartials, 0.0);
+	network->computeAllPartials(concs.data(), reactionStartingIdx,
+			reactionIndices, vals, 0);
+
+	// The values have to be identical
+	for (int i = 0; i < dof; i++) {
+		BOOST_REQUIRE_EQUAL(fluxes[i], refFluxes[i]);
+	}
+	for (int i = 0; i < nPartials; i++) {
+		BOOST_REQUIRE_EQUAL(vals[i], refVals[i]);
+	}
+
+	// The rates are still private to the process and computed from the
+	// shared evaluator, compare them with a network that is not shared
+	auto refNetwork = loader.generate(opts);
+	refNetwork->addGridPoints(1);
+	refNetwork->setTemperature(temperature + 100.0, 0);
+	refNetwork->reinitializeConnectivities();
+	std::fill(refFluxes.begin(), refFluxes.end(), 0.0);
+	refNetwork->computeAllFluxes(concs.data(), refFluxes.data(), 0);
+	network->setTemperature(temperature + 100.0, 0);
+	std::fill(fluxes.begin(), fluxes.end(), 0.0);
+	network->computeAllFluxes(concs.data(), fluxes.data(), 0);
+	for (int i = 0; i < dof; i++) {
+		BOOST_REQUIRE_EQUAL(fluxes[i], refFluxes[i]);
+	}
+
+	return;
+}
+
 /**
  * This operation checks the boundary methods for PSISuperCluster.
  */
@@ -0,0 +1,257 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Regression
+
+#include <boost/test/unit_test.hpp>
+#include <BlockLUPreconditioner.h>
+#include <petscksp.h>
+#include <string.h>
+#include <string>
+
+using namespace std;
+using namespace xolotlSolver;
+
+/**
+ * Create the matrix with the given number of grid points on each process,
+ * every process only sets its own rows. The blocks of the
+ * grid points are not symmetric and their elimination creates fill-in. The
+ * first row of each block can be left without diagonal to need row
+ * exchanges, and the grid points can be coupled to their neighbors.
+ *
+ * @param dof The number of degrees of freedom at each grid point
+ * @param nPoints The number of grid points on each process
+ * @param zeroDiagonal Whether the first row of each block has no diagonal
+ * @param coupling The value coupling the neighboring grid points
+ * @return The assembled matrix
+ */
+Mat createMatrix(PetscInt dof, PetscInt nPoints, bool zeroDiagonal,
+		PetscScalar coupling) {
+	PetscErrorCode ierr;
+	const PetscInt n = dof * nPoints;
+	Mat A;
+	ierr = MatCreate(PETSC_COMM_WORLD, &A);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = MatSetSizes(A, n, n, PETSC_DETERMINE, PETSC_DETERMINE);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = MatSetBlockSize(A, dof);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = MatSetType(A, MATAIJ);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = MatSeqAIJSetPreallocation(A, 6, NULL);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = MatMPIAIJSetPreallocation(A, 6, NULL, 2, NULL);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	// The grid points owned by this process
+	PetscInt rowStart, rowEnd, nGlobalRows;
+	ierr = MatGetOwnershipRange(A, &rowStart, &rowEnd);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = MatGetSize(A, &nGlobalRows, NULL);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	const PetscInt nGlobalPoints = nGlobalRows / dof;
+
+	for (PetscInt p = rowStart / dof; p < rowEnd / dof; p++) {
+		for (PetscInt i = 0; i < dof; i++) {
+			PetscInt row = p * dof + i;
+			PetscScalar diag =
+					(zeroDiagonal && i == 0) ?
+							0.0 : 4.0 + (PetscScalar) (i % 3) + 0.1 * p;
+			ierr = MatSetValue(A, row, row, diag, ADD_VALUES);
+			BOOST_REQUIRE_EQUAL(ierr, 0);
+			ierr = MatSetValue(A, row, p * dof + (i + 1) % dof, -1.0,
+					ADD_VALUES);
+			BOOST_REQUIRE_EQUAL(ierr, 0);
+			ierr = MatSetValue(A, row, p * dof + (7 * i + 3) % dof, 0.5,
+					ADD_VALUES);
+			BOOST_REQUIRE_EQUAL(ierr, 0);
+			if (i > 0) {
+				ierr = MatSetValue(A, row, p * dof, 0.3, ADD_VALUES);
+				BOOST_REQUIRE_EQUAL(ierr, 0);
+			}
+
+			// The coupling with the neighbors
+			if (coupling != 0.0 && p > 0) {
+				ierr = MatSetValue(A, row, row - dof, coupling, ADD_VALUES);
+				BOOST_REQUIRE_EQUAL(ierr, 0);
+			}
+			if (coupling != 0.0 && p < nGlobalPoints - 1) {
+				ierr = MatSetValue(A, row, row + dof, coupling, ADD_VALUES);
+				BOOST_REQUIRE_EQUAL(ierr, 0);
+			}
+		}
+	}
+	ierr = MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	return A;
+}
+
+/**
+ * Apply the block LU preconditioner of the given matrix and compare the
+ * result with the one of a direct solve (a dense LU with partial pivoting).
+ *
+ * @param A The matrix
+ * @return The norm of the difference relative to the norm of the solution
+ */
+PetscReal compareWithDirectSolve(Mat A) {
+	PetscErrorCode ierr;
+
+	// The right-hand side
+	Vec b, x, y;
+	ierr = MatCreateVecs(A, &x, &b);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = VecDuplicate(x, &y);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	PetscInt start, end;
+	ierr = VecGetOwnershipRange(b, &start, &end);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	for (PetscInt i = start; i < end; i++) {
+		ierr = VecSetValue(b, i, 1.0 + 0.25 * (PetscScalar) (i % 5),
+				INSERT_VALUES);
+		BOOST_REQUIRE_EQUAL(ierr, 0);
+	}
+	ierr = VecAssemblyBegin(b);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = VecAssemblyEnd(b);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	// Apply the block LU preconditioner, it has to outlive the PC
+	BlockLUPreconditioner blockPreconditioner(1);
+	PC pc;
+	ierr = PCCreate(PETSC_COMM_WORLD, &pc);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = PCSetOperators(pc, A, A);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = blockPreconditioner.attach(pc);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = PCSetUp(pc);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = PCApply(pc, b, y);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = PCDestroy(&pc);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	// Solve directly with a dense copy of the matrix
+	Mat denseA;
+	ierr = MatConvert(A, MATDENSE, MAT_INITIAL_MATRIX, &denseA);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	KSP ksp;
+	ierr = KSPCreate(PETSC_COMM_WORLD, &ksp);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = KSPSetOperators(ksp, denseA, denseA);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = KSPSetType(ksp, KSPPREONLY);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	PC directPc;
+	ierr = KSPGetPC(ksp, &directPc);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = PCSetType(directPc, PCLU);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = KSPSolve(ksp, b, x);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	// Compare
+	PetscReal solutionNorm, differenceNorm;
+	ierr = VecNorm(x, NORM_2, &solutionNorm);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = VecAXPY(y, -1.0, x);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = VecNorm(y, NORM_2, &differenceNorm);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	ierr = KSPDestroy(&ksp);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = MatDestroy(&denseA);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = VecDestroy(&b);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = VecDestroy(&x);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = VecDestroy(&y);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	return differenceNorm / solutionNorm;
+}
+
+/**
+ * The test suite configuration
+ */
+BOOST_AUTO_TEST_SUITE (BlockLUPreconditionerTester_testSuite)
+
+/**
+ * This operation checks the dense LU, with row exchanges, of blocks
+ * smaller than -blocklu_dense_max.
+ */
+BOOST_AUTO_TEST_CASE(checkDenseBlocks) {
+	// Create a fake command line to initialize PETSc
+	int argc = 1;
+	char **argv = new char*[2];
+	std::string appName = "fakeXolotlAppNameForTests";
+	argv[0] = new char[appName.length() + 1];
+	strcpy(argv[0], appName.c_str());
+	argv[1] = 0; // null-terminate the array
+	PetscErrorCode ierr = PetscInitialize(&argc, &argv, NULL, NULL);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	// Blocks of 6 below the default -blocklu_dense_max, the first row of
+	// each block needs a row exchange
+	Mat A = createMatrix(6, 3, true, 0.0);
+	BOOST_REQUIRE_SMALL(compareWithDirectSolve(A), 1.0e-10);
+	ierr = MatDestroy(&A);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	return;
+}
+
+/**
+ * This operation checks the symbolic and numeric sparse LU of blocks
+ * bigger than -blocklu_dense_max.
+ */
+BOOST_AUTO_TEST_CASE(checkSparseBlocks) {
+	// Blocks of 6 above -blocklu_dense_max
+	PetscErrorCode ierr = PetscOptionsSetValue(NULL, "-blocklu_dense_max",
+			"4");
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	Mat A = createMatrix(6, 3, false, 0.0);
+	BOOST_REQUIRE_SMALL(compareWithDirectSolve(A), 1.0e-10);
+	ierr = MatDestroy(&A);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	ierr = PetscOptionsClearValue(NULL, "-blocklu_dense_max");
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	return;
+}
+
+/**
+ * This operation checks that the corrections with the residual take the
+ * coupling between grid points into account.
+ */
+BOOST_AUTO_TEST_CASE(checkCorrections) {
+	// Weakly coupled grid points, the block solve alone is not enough
+	Mat A = createMatrix(6, 4, false, -0.01);
+	PetscErrorCode ierr = PetscOptionsSetValue(NULL, "-blocklu_sweeps",
+			"0");
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	BOOST_REQUIRE_GT(compareWithDirectSolve(A), 1.0e-6);
+
+	// But the corrections converge to the solution
+	ierr = PetscOptionsSetValue(NULL, "-blocklu_sweeps", "10");
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	BOOST_REQUIRE_SMALL(compareWithDirectSolve(A), 1.0e-10);
+
+	ierr = PetscOptionsClearValue(NULL, "-blocklu_sweeps");
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = MatDestroy(&A);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	// Finalize PETSc
+	ierr = PetscFinalize();
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	return;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -459,6 +459,260 @@ BOOST_AUTO_TEST_CASE(checkPetscSolver2DHandler) {
 	std::remove(tempFile.c_str());
 }
 
+/**
+ * Compute the right hand side and the diagonal part of the Jacobian with the
+ * given 2D solver handler, the temperature at each grid point being given by
+ * its row.
+ *
+ * @param handler The solver handler, its solver context is already created
+ * @param da The distributed array
+ * @param C The concentrations
+ * @param rowTemperatures The temperature of each row
+ * @param F The right hand side
+ * @param JW The product of the Jacobian with a vector of ones
+ */
+void computeWithRowTemperatures(xolotlSolver::ISolverHandler &handler, DM &da,
+		Vec &C, const std::vector<double> &rowTemperatures, Vec &F, Vec &JW) {
+	PetscErrorCode ierr;
+	const int dof = handler.getNetwork().getDOF();
+
+	// Set the temperatures
+	PetscScalar ***concs = nullptr;
+	PetscInt xs, xm, ys, ym;
+	ierr = DMDAGetCorners(da, &xs, &ys, NULL, &xm, &ym, NULL);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = DMDAVecGetArrayDOF(da, C, &concs);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	for (PetscInt j = ys; j < ys + ym; j++) {
+		for (PetscInt i = xs; i < xs + xm; i++) {
+			concs[j][i][dof - 1] = rowTemperatures[j];
+		}
+	}
+	ierr = DMDAVecRestoreArrayDOF(da, C, &concs);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	// The handler only needs the distributed array from the time stepper
+	TS ts;
+	ierr = TSCreate(PETSC_COMM_WORLD, &ts);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = TSSetDM(ts, da);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	Vec localC;
+	ierr = DMGetLocalVector(da, &localC);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = DMGlobalToLocalBegin(da, C, INSERT_VALUES, localC);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = DMGlobalToLocalEnd(da, C, INSERT_VALUES, localC);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	// The right hand side
+	ierr = VecSet(F, 0.0);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	handler.updateConcentration(ts, localC, F, 1.0);
+
+	// The diagonal part of the Jacobian
+	Mat J;
+	ierr = DMCreateMatrix(da, &J);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = MatSetOption(J, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	handler.computeDiagonalJacobian(ts, localC, J, 1.0);
+	ierr = MatAssemblyBegin(J, MAT_FINAL_ASSEMBLY);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = MatAssemblyEnd(J, MAT_FINAL_ASSEMBLY);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	Vec W;
+	ierr = VecDuplicate(C, &W);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = VecSet(W, 1.0);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = MatMult(J, W, JW);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	ierr = VecDestroy(&W);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = MatDestroy(&J);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = DMRestoreLocalVector(da, &localC);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = TSDestroy(&ts);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	return;
+}
+
+/**
+ * This operation checks that the reactions of each grid point use the rates
+ * of its own temperature in 2D when the temperature changes along Y. The
+ * right hand side and the Jacobian of each row must be the same as when the
+ * whole grid is at the temperature of this row.
+ */
+BOOST_AUTO_TEST_CASE(checkLateralTemperature2D) {
+	// Create the parameter file, only with the reactions and the heat
+	// equation to get the temperature from the solution
+	std::ofstream paramFile("param.txt");
+	paramFile << "vizHandler=dummy" << std::endl << "petscArgs=" << std::endl
+			<< "heat=1.0e-1 1000" << std::endl << "perfHandler=dummy"
+			<< std::endl << "flux=4.0e5" << std::endl << "material=W100"
+			<< std::endl << "dimensions=2" << std::endl << "process=reaction"
+			<< std::endl << "voidPortion=0.0" << std::endl
+			<< "netParam=8 0 0 2 6" << std::endl << "grid=10 0.5 4 1.0"
+			<< std::endl << "threads=2" << std::endl;
+	paramFile.close();
+
+	// Create a fake command line to read the options
+	int argc = 2;
+	char **argv = new char*[3];
+	std::string appName = "fakeXolotlAppNameForTests";
+	argv[0] = new char[appName.length() + 1];
+	strcpy(argv[0], appName.c_str());
+	std::string parameterFile = "param.txt";
+	argv[1] = new char[parameterFile.length() + 1];
+	strcpy(argv[1], parameterFile.c_str());
+	argv[2] = 0; // null-terminate the array
+
+	// Read the options
+	Options opts;
+	opts.readParams(argc, argv);
+
+	// Create the material factory
+	auto materialFactory =
+			xolotlFactory::IMaterialFactory::createMaterialFactory(opts);
+
+	// Initialize and get the temperature handler
+	bool tempInitOK = xolotlFactory::initializeTempHandler(opts);
+	BOOST_REQUIRE(tempInitOK);
+	auto tempHandler = xolotlFactory::getTemperatureHandler();
+
+	// Create the network handler factory
+	auto networkFactory =
+			xolotlFactory::IReactionHandlerFactory::createNetworkFactory(
+					opts.getMaterial());
+	networkFactory->initializeReactionNetwork(opts,
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+	// Get the network
+	auto &network = networkFactory->getNetworkHandler();
+
+	// Create a solver handler and initialize it
+	auto rawSolverHandler = new xolotlSolver::PetscSolver2DHandler(network);
+	auto theSolverHandler = std::unique_ptr<xolotlSolver::ISolverHandler>(
+			rawSolverHandler);
+	theSolverHandler->initializeHandlers(materialFactory, tempHandler, opts);
+
+	// Create the solver, only to initialize PETSc
+	std::unique_ptr<xolotlSolver::PetscSolver> solver(
+			new xolotlSolver::PetscSolver(*theSolverHandler,
+					make_shared<xolotlPerf::DummyHandlerRegistry>()));
+	solver->setCommandLineOptions(opts.getPetscArg());
+	solver->initialize();
+
+	// Create the solver context and the concentrations
+	PetscErrorCode ierr;
+	DM da;
+	theSolverHandler->createSolverContext(da);
+	Vec C;
+	ierr = DMCreateGlobalVector(da, &C);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	theSolverHandler->initializeConcentration(da, C);
+	const int dof = network.getDOF();
+	PetscInt xs, xm, ys, ym, nY;
+	ierr = DMDAGetCorners(da, &xs, &ys, NULL, &xm, &ym, NULL);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = DMDAGetInfo(da, NULL, NULL, &nY, NULL, NULL, NULL, NULL, NULL,
+			NULL, NULL, NULL, NULL, NULL);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	PetscScalar ***concs = nullptr;
+	ierr = DMDAVecGetArrayDOF(da, C, &concs);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	for (PetscInt j = ys; j < ys + ym; j++) {
+		for (PetscInt i = xs; i < xs + xm; i++) {
+			for (int n = 0; n < dof - 1; n++) {
+				concs[j][i][n] = 1.0e-3 * ((n % 7) + 1);
+			}
+		}
+	}
+	ierr = DMDAVecRestoreArrayDOF(da, C, &concs);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+
+	// Compute with a temperature changing along Y
+	std::vector<double> rowTemperatures;
+	for (PetscInt j = 0; j < nY; j++) {
+		rowTemperatures.push_back(900.0 + 100.0 * j);
+	}
+	Vec F, JW, rowF, rowJW;
+	ierr = VecDuplicate(C, &F);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = VecDuplicate(C, &JW);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = VecDuplicate(C, &rowF);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = VecDuplicate(C, &rowJW);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	computeWithRowTemperatures(*theSolverHandler, da, C, rowTemperatures, F,
+			JW);
+
+	// Compare each row with the whole grid at its temperature
+	PetscScalar ***fs = nullptr, ***jws = nullptr, ***rowFs = nullptr,
+			***rowJWs = nullptr;
+	for (PetscInt row = 0; row < nY; row++) {
+		std::vector<double> uniformTemperatures(nY, rowTemperatures[row]);
+		computeWithRowTemperatures(*theSolverHandler, da, C,
+				uniformTemperatures, rowF, rowJW);
+
+		// Only the row owned by this process
+		if (row < ys || row >= ys + ym)
+			continue;
+
+		ierr = DMDAVecGetArrayDOFRead(da, F, &fs);
+		BOOST_REQUIRE_EQUAL(ierr, 0);
+		ierr = DMDAVecGetArrayDOFRead(da, JW, &jws);
+		BOOST_REQUIRE_EQUAL(ierr, 0);
+		ierr = DMDAVecGetArrayDOFRead(da, rowF, &rowFs);
+		BOOST_REQUIRE_EQUAL(ierr, 0);
+		ierr = DMDAVecGetArrayDOFRead(da, rowJW, &rowJWs);
+		BOOST_REQUIRE_EQUAL(ierr, 0);
+		// The temperature itself diffuses along Y, only check the clusters
+		for (PetscInt i = xs; i < xs + xm; i++) {
+			for (int n = 0; n < dof - 1; n++) {
+				BOOST_REQUIRE_CLOSE(fs[row][i][n], rowFs[row][i][n], 1.0e-10);
+				BOOST_REQUIRE_CLOSE(jws[row][i][n], rowJWs[row][i][n],
+						1.0e-10);
+			}
+		}
+		ierr = DMDAVecRestoreArrayDOFRead(da, F, &fs);
+		BOOST_REQUIRE_EQUAL(ierr, 0);
+		ierr = DMDAVecRestoreArrayDOFRead(da, JW, &jws);
+		BOOST_REQUIRE_EQUAL(ierr, 0);
+		ierr = DMDAVecRestoreArrayDOFRead(da, rowF, &rowFs);
+		BOOST_REQUIRE_EQUAL(ierr, 0);
+		ierr = DMDAVecRestoreArrayDOFRead(da, rowJW, &rowJWs);
+		BOOST_REQUIRE_EQUAL(ierr, 0);
+	}
+
+	// Clean up
+	ierr = VecDestroy(&rowJW);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = VecDestroy(&rowF);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = VecDestroy(&JW);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = VecDestroy(&F);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = VecDestroy(&C);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	ierr = DMDestroy(&da);
+	BOOST_REQUIRE_EQUAL(ierr, 0);
+	solver->finalize();
+	for (int i = 0; i < argc; i++) {
+		delete[] argv[i];
+	}
+	delete[] argv;
+
+	// Remove the created file
+	std::string tempFile = "param.txt";
+	std::remove(tempFile.c_str());
+}
+
 /**
  * This operation checks the concentration of clusters after solving a test case
  * in 3D.
@@ -0,0 +1,87 @@
+#ifndef TESTS_UTILS_NETWORKTESTUTILS_H
+#define TESTS_UTILS_NETWORKTESTUTILS_H
+
+#include <boost/test/unit_test.hpp>
+#include <Options.h>
+#include <IReactionNetwork.h>
+#include <fstream>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace testUtils {
+
+/**
+ * Read the options from the given parameters, as if they were the content
+ * of the parameter file given on the command line. The parameter file is
+ * removed once it is read.
+ *
+ * @param opts The options to fill
+ * @param params The content of the parameter file
+ */
+inline void readOptions(xolotlCore::Options& opts, const std::string& params) {
+	// Create the parameter file
+	std::string parameterFile = "param.txt";
+	std::ofstream paramFile(parameterFile);
+	paramFile << params;
+	paramFile.close();
+
+	// Create a fake command line to read the options
+	std::string appName = "fakeXolotlAppNameForTests";
+	std::vector<char> appArg(appName.begin(), appName.end());
+	appArg.push_back('\0');
+	std::vector<char> fileArg(parameterFile.begin(), parameterFile.end());
+	fileArg.push_back('\0');
+	char *argv[3] = { appArg.data(), fileArg.data(), nullptr };
+	opts.readParams(2, argv);
+
+	// Remove the created file
+	std::remove(parameterFile.c_str());
+
+	return;
+}
+
+/**
+ * Prepare two networks at 1000 K on a single grid point, compute their
+ * fluxes from the same concentrations and check that they are equal.
+ *
+ * @param network The reference network
+ * @param otherNetwork The network to compare with it
+ * @param tolerance The relative tolerance in percent, 0.0 requires the
+ * fluxes to be exactly equal
+ */
+inline void compareNetworkFluxes(xolotlCore::IReactionNetwork& network,
+		xolotlCore::IReactionNetwork& otherNetwork, double tolerance) {
+	BOOST_REQUIRE_EQUAL(otherNetwork.getDOF(), network.getDOF());
+
+	// Fill a concentration array, the last DOF is the temperature
+	const int dof = network.getDOF();
+	std::vector<double> concs(dof, 0.0);
+	for (int i = 0; i < dof - 1; i++) {
+		concs[i] = 1.0e-3 * (double) ((i % 7) + 1);
+	}
+
+	// Compute the fluxes
+	std::vector<double> fluxes(dof, 0.0), otherFluxes(dof, 0.0);
+	for (auto net : { &network, &otherNetwork }) {
+		net->addGridPoints(1);
+		net->setTemperature(1000.0, 0);
+		net->reinitializeConnectivities();
+	}
+	network.computeAllFluxes(concs.data(), fluxes.data(), 0);
+	otherNetwork.computeAllFluxes(concs.data(), otherFluxes.data(), 0);
+
+	// Compare them
+	for (int i = 0; i < dof - 1; i++) {
+		if (tolerance > 0.0)
+			BOOST_REQUIRE_CLOSE(otherFluxes[i], fluxes[i], tolerance);
+		else
+			BOOST_REQUIRE_EQUAL(otherFluxes[i], fluxes[i]);
+	}
+
+	return;
+}
+
+} /* end namespace testUtils */
+
+#endif // TESTS_UTILS_NETWORKTESTUTILS_H
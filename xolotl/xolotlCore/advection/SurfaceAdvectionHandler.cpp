@@ -1,4 +1,5 @@
 // Includes
+#include <algorithm>
 #include "SurfaceAdvectionHandler.h"
 
 namespace xolotlCore {
@@ -8,24 +9,19 @@ void SurfaceAdvectionHandler::initializeAdvectionGrid(
 		std::vector<double> grid, int nx, int xs, int ny, double hy, int ys,
 		int nz, double hz, int zs) {
 
-	// Get the number of advecting clusters
+	// Get the number of advecting clusters and their indices
 	int nAdvec = advectingClusters.size();
-
-	// Initialize the diffusion grid with true everywhere
-	advectionGrid.clear();
-	// Initialize it to True
-	for (int k = 0; k < nz + 2; k++) {
-		std::vector<std::vector<std::vector<bool> > > tempGridTer;
-		for (int j = 0; j < ny + 2; j++) {
-			std::vector<std::vector<bool> > tempGridBis;
-			for (int i = 0; i < nx + 2; i++) {
-				tempGridBis.emplace_back(nAdvec, true);
-			}
-			tempGridTer.push_back(tempGridBis);
-		}
-		advectionGrid.push_back(tempGridTer);
+	advectingIndices.clear();
+	for (IReactant const& cluster : advectingClusters) {
+		advectingIndices.push_back(cluster.getId() - 1);
 	}
 
+	// Initialize the advection grid with true everywhere
+	gridNx = nx + 2;
+	gridNy = ny + 2;
+	advectionGrid.assign((std::size_t) gridNx * gridNy * (nz + 2) * nAdvec,
+			1.0);
+
 	// Initialize the grid position
 	Point<3> gridPosition { 0.0, 0.0, 0.0 };
 
@@ -43,7 +39,7 @@ void SurfaceAdvectionHandler::initializeAdvectionGrid(
 			for (int j = -1; j < ny + 1; j++) {
 				// Set the grid position
 				gridPosition[1] = hy * (double) (j + ys);
-				for (int i = 0; i < nx + 2; i++) {
+				for (int i = 0; i < nx + 1; i++) {
 					// Set the grid position
 					if (i + xs == nx - 1)
 						gridPosition[0] = grid[i + xs]
@@ -54,21 +50,18 @@ void SurfaceAdvectionHandler::initializeAdvectionGrid(
 
 					// Check if we are on a sink
 					if (currAdvecHandler->isPointOnSink(gridPosition)) {
-						// We have to find the corresponding index in the diffusion
-						// index vector
-						for (int m = 0; m < otherAdvecClusters.size(); m++) {
-							// Initialize n the index in the diffusion index vector
-							// TODO can we do this with std::find or std::find_if?
-							int n = 0;
-							while (n < nAdvec) {
-								if (&(advectingClusters[n])
-										== &(otherAdvecClusters[m])) {
-									break;
-								}
-								n++;
-							}
-							// Set this diffusion grid value to false
-							advectionGrid[k + 1][j + 1][i + 1][n] = false;
+						double *gridRow = getGridRow(i + 1, j + 1, k + 1);
+						// We have to find the corresponding index in the
+						// advecting clusters
+						for (IReactant const& otherCluster : otherAdvecClusters) {
+							auto it = std::find_if(advectingClusters.begin(),
+									advectingClusters.end(),
+									[&otherCluster](IReactant const& cluster) {
+										return &cluster == &otherCluster;
+									});
+							// Set this advection grid value to false
+							if (it != advectingClusters.end())
+								gridRow[it - advectingClusters.begin()] = 0.0;
 						}
 					}
 				}
@@ -79,54 +72,71 @@ void SurfaceAdvectionHandler::initializeAdvectionGrid(
 	return;
 }
 
+double *SurfaceAdvectionHandler::fillMobilityRows(int ix,
+		std::vector<double> &mobilityRows) const {
+	// Get the number of advecting clusters
+	const int nAdvec = advectingIndices.size();
+
+	// Divide the diffusion coefficients by the temperature
+	mobilityRows.resize(3 * nAdvec);
+	double *midMobility = mobilityRows.data();
+	for (int n = 0; n < nAdvec; n++) {
+		IReactant const& cluster = advectingClusters[n];
+		midMobility[n] = cluster.getDiffusionCoefficient(ix + 1)
+				/ cluster.getTemperature(ix + 1);
+		midMobility[nAdvec + n] = cluster.getDiffusionCoefficient(ix + 2)
+				/ cluster.getTemperature(ix + 2);
+	}
+
+	return midMobility;
+}
+
 void SurfaceAdvectionHandler::computeAdvection(const IReactionNetwork& network,
 		const Point<3>& pos, double **concVector, double *updatedConcOffset,
 		double hxLeft, double hxRight, int ix, double hy, int iy, double hz,
 		int iz) const {
 
-	// Get the number of advecting cluster
-	int nAdvec = advectingClusters.size();
-
-	// Consider each advecting cluster
-	// TODO Maintaining a separate index assumes that advectingClusters is
-	// visited in same order as advectionGrid array for given point
-	// and the sinkStrengthVector.
-	// Currently true with C++11, but we'd like to be able to visit the
-	// advecting clusters in any order (so that we can parallelize).
-	// Maybe with a zip? or a std::transform?
-	int advClusterIdx = 0;
-	for (IReactant const& currReactant : advectingClusters) {
-		// Get a specific one and its index
-		auto const& cluster = static_cast<IReactant const&>(currReactant);
-		int index = cluster.getId() - 1;
-
+	// Get the number of advecting clusters and their indices
+	const int nAdvec = advectingIndices.size();
+	const int *index = advectingIndices.data();
+
+	// Get the rows of diffusion coefficients over the temperature at the
+	// middle and right grid points, followed by the row for the fluxes
+	std::vector<double> mobilityRows;
+	double *midMobility = fillMobilityRows(ix, mobilityRows);
+	const double *rightMobility = midMobility + nAdvec;
+	double *flux = midMobility + 2 * nAdvec;
+
+	// Get where the clusters are moving
+	const double *midGrid = getGridRow(ix + 1, iy + 1, iz + 1);
+	const double *rightGrid = getGridRow(ix + 2, iy + 1, iz + 1);
+
+	// The factors from the distance to the surface
+	const double midFactor = 3.0
+			/ (xolotlCore::kBoltzmann * hxRight * pow(pos[0] - location, 4));
+	const double rightFactor = 3.0
+			/ (xolotlCore::kBoltzmann * hxRight
+					* pow(pos[0] - location + hxRight, 4));
+
+	// Compute the fluxes as explained in the description of the method
+	const double *midConc = concVector[0];
+	const double *rightConc = concVector[2];
+	const double *sinkStrength = sinkStrengthVector.data();
+	for (int n = 0; n < nAdvec; n++) {
 		// Get the initial concentrations
-		double oldConc = concVector[0][index]
-				* advectionGrid[iz + 1][iy + 1][ix + 1][advClusterIdx]; // middle
-		double oldRightConc = concVector[2][index]
-				* advectionGrid[iz + 1][iy + 1][ix + 2][advClusterIdx]; // right
-
-		// Compute the concentration as explained in the description of the method
-		double conc = (3.0 * sinkStrengthVector[advClusterIdx]
-				* cluster.getDiffusionCoefficient(ix + 1))
-				* ((oldRightConc / pow(pos[0] - location + hxRight, 4))
-						- (oldConc / pow(pos[0] - location, 4)))
-				/ (xolotlCore::kBoltzmann * cluster.getTemperature(ix + 1)
-						* hxRight);
-
-		conc +=
-				(3.0 * sinkStrengthVector[advClusterIdx] * oldConc)
-						* (cluster.getDiffusionCoefficient(ix + 2)
-								/ cluster.getTemperature(ix + 2)
-								- cluster.getDiffusionCoefficient(ix + 1)
-										/ cluster.getTemperature(ix + 1))
-						/ (xolotlCore::kBoltzmann * hxRight
-								* pow(pos[0] - location, 4));
-
-		// Update the concentration of the cluster
-		updatedConcOffset[index] += conc;
-
-		++advClusterIdx;
+		double oldConc = midConc[index[n]] * midGrid[n];
+		double oldRightConc = rightConc[index[n]] * rightGrid[n];
+
+		flux[n] = sinkStrength[n]
+				* (midMobility[n]
+						* (oldRightConc * rightFactor - oldConc * midFactor)
+						+ oldConc * (rightMobility[n] - midMobility[n])
+								* midFactor);
+	}
+
+	// Update the concentrations of the clusters
+	for (int n = 0; n < nAdvec; n++) {
+		updatedConcOffset[index[n]] += flux[n];
 	}
 
 	return;
@@ -137,49 +147,38 @@ void SurfaceAdvectionHandler::computePartialsForAdvection(
 		const Point<3>& pos, double hxLeft, double hxRight, int ix, double hy,
 		int iy, double hz, int iz) const {
 
-	// Get the number of advecting cluster
-	int nAdvec = advectingClusters.size();
-
-	// Consider each advecting cluster.
-	// TODO Maintaining a separate index assumes that advectingClusters is
-	// visited in same order as advectionGrid array for given point
-	// and the sinkStrengthVector.
-	// Currently true with C++11, but we'd like to be able to visit the
-	// advecting clusters in any order (so that we can parallelize).
-	// Maybe with a zip? or a std::transform?
-	int advClusterIdx = 0;
-	for (IReactant const& currReactant : advectingClusters) {
-		// Get a specific one and its index
-		auto const& cluster = static_cast<IReactant const&>(currReactant);
-		int index = cluster.getId() - 1;
-		// Get the diffusion coefficient of the cluster
-		double diffCoeff = cluster.getDiffusionCoefficient(ix + 1);
-		// Get the sink strength value
-		double sinkStrength = sinkStrengthVector[advClusterIdx];
-
+	// Get the number of advecting clusters
+	const int nAdvec = advectingIndices.size();
+
+	// Get the rows of diffusion coefficients over the temperature at the
+	// middle and right grid points
+	std::vector<double> mobilityRows;
+	const double *midMobility = fillMobilityRows(ix, mobilityRows);
+	const double *rightMobility = midMobility + nAdvec;
+
+	// Get where the clusters are moving
+	const double *midGrid = getGridRow(ix + 1, iy + 1, iz + 1);
+	const double *rightGrid = getGridRow(ix + 2, iy + 1, iz + 1);
+
+	// The factors from the distance to the surface
+	const double midFactor = 3.0
+			/ (xolotlCore::kBoltzmann * hxRight * pow(pos[0] - location, 4));
+	const double rightFactor = 3.0
+			/ (xolotlCore::kBoltzmann * hxRight
+					* pow(pos[0] - location + hxRight, 4));
+
+	for (int n = 0; n < nAdvec; n++) {
 		// Set the cluster index that will be used by PetscSolver
 		// to compute the row and column indices for the Jacobian
-		indices[advClusterIdx] = index;
+		indices[n] = advectingIndices[n];
 
 		// Compute the partial derivatives for advection of this cluster as
 		// explained in the description of this method
-		val[advClusterIdx * 2] = -(3.0 * sinkStrength * diffCoeff)
-				/ (xolotlCore::kBoltzmann * cluster.getTemperature(ix + 1)
-						* hxRight * pow(pos[0] - location, 4))
-				* advectionGrid[iz + 1][iy + 1][ix + 1][advClusterIdx]; // middle
-		val[advClusterIdx * 2] += (3.0 * sinkStrength)
-				* (cluster.getDiffusionCoefficient(ix + 2)
-						/ cluster.getTemperature(ix + 2)
-						- cluster.getDiffusionCoefficient(ix + 1)
-								/ cluster.getTemperature(ix + 1))
-				/ (xolotlCore::kBoltzmann * hxRight * pow(pos[0] - location, 4))
-				* advectionGrid[iz + 1][iy + 1][ix + 1][advClusterIdx]; // middle
-		val[(advClusterIdx * 2) + 1] = (3.0 * sinkStrength * diffCoeff)
-				/ (xolotlCore::kBoltzmann * cluster.getTemperature(ix + 1)
-						* hxRight * pow(pos[0] - location + hxRight, 4))
-				* advectionGrid[iz + 1][iy + 1][ix + 2][advClusterIdx]; // right
-
-		++advClusterIdx;
+		val[n * 2] = sinkStrengthVector[n]
+				* (rightMobility[n] - 2.0 * midMobility[n]) * midFactor
+				* midGrid[n]; // middle
+		val[(n * 2) + 1] = sinkStrengthVector[n] * midMobility[n] * rightFactor
+				* rightGrid[n]; // right
 	}
 
 	return;
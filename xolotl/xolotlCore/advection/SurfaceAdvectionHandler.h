@@ -15,14 +15,58 @@ namespace xolotlCore {
 class SurfaceAdvectionHandler: public AdvectionHandler {
 private:
 
-	//! The vector to know which clusters are moving where
-	std::vector<std::vector<std::vector<std::vector<bool> > > > advectionGrid;
+	/**
+	 * Whether each advecting cluster is moving (1.0) or not (0.0) at each
+	 * grid point, including the ghost points, with one row of values for all
+	 * the advecting clusters per grid point and the x direction first.
+	 */
+	std::vector<double> advectionGrid;
+
+	//! The number of grid points of advectionGrid in the x direction
+	int gridNx;
+
+	//! The number of grid points of advectionGrid in the y direction
+	int gridNy;
+
+	//! The indices of the advecting clusters in the network
+	std::vector<int> advectingIndices;
+
+	/**
+	 * Get the row of the advection grid at the given grid point.
+	 *
+	 * @param i The index in the x direction
+	 * @param j The index in the y direction
+	 * @param k The index in the z direction
+	 * @return The values of all the advecting clusters
+	 */
+	double *getGridRow(int i, int j, int k) {
+		return advectionGrid.data()
+				+ ((std::size_t) (k * gridNy + j) * gridNx + i)
+						* advectingIndices.size();
+	}
+	const double *getGridRow(int i, int j, int k) const {
+		return advectionGrid.data()
+				+ ((std::size_t) (k * gridNy + j) * gridNx + i)
+						* advectingIndices.size();
+	}
+
+	/**
+	 * Copy the diffusion coefficients over the temperature of the advecting
+	 * clusters at the grid points ix + 1 and ix + 2 in the given rows, one
+	 * row after the other, followed by a row for the fluxes. The rows belong
+	 * to the caller so that grid points can be computed concurrently.
+	 *
+	 * @param ix The position on the x grid
+	 * @param mobilityRows The rows to fill, resized as needed
+	 * @return The row at ix + 1, the next ones follow
+	 */
+	double *fillMobilityRows(int ix, std::vector<double> &mobilityRows) const;
 
 public:
 
 	//! The Constructor
 	SurfaceAdvectionHandler() :
-			AdvectionHandler() {
+			AdvectionHandler(), gridNx(0), gridNy(0) {
 	}
 
 	//! The Destructor
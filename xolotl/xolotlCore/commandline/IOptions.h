@@ -488,6 +488,54 @@ public:
 	 */
 	virtual double getMigrationThreshold() const = 0;
 
+	/**
+	 * Obtain the number of threads used on each process to loop
+	 * over the grid points and to build the reaction connectivity.
+	 *
+	 * @return The number of threads
+	 */
+	virtual int getNThreads() const = 0;
+
+	/**
+	 * Obtain the way the Jacobian is given to the solver: "assembled",
+	 * "matrixFreeDiagonal", or "matrixFreeBlock".
+	 *
+	 * @return The type of Jacobian
+	 */
+	virtual std::string getJacobianType() const = 0;
+
+	/**
+	 * Obtain the policy used to reuse the Jacobian between evaluations.
+	 *
+	 * @return The largest relative change of the solution, the largest
+	 * temperature change, and the maximum number of consecutive reuses.
+	 * The Jacobian is always recomputed if the last one is 0.
+	 */
+	virtual std::tuple<double, double, int> getJacobianReuse() const = 0;
+
+	/**
+	 * Obtain the width of the temperature bins used to cache the rate
+	 * constants of the network.
+	 *
+	 * @return The width in K, 0.0 if the rates are always computed
+	 */
+	virtual double getRateCacheBinWidth() const = 0;
+
+	/**
+	 * Obtain the directory where the generated networks are cached.
+	 *
+	 * @return The directory, empty if the networks are not cached
+	 */
+	virtual std::string getNetworkCacheDirectory() const = 0;
+
+	/**
+	 * Obtain the preconditioner of the linear solves: "petsc" for the one
+	 * set in the PETSc arguments, or "blockLU".
+	 *
+	 * @return The preconditioner
+	 */
+	virtual std::string getPreconditioner() const = 0;
+
 };
 //end class IOptions
 
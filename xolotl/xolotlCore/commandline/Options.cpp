@@ -29,7 +29,10 @@ Options::Options() :
 				0.0), latticeParameter(-1.0), impurityRadius(-1.0), biasFactor(
 				1.15), hydrogenFactor(0.25), xenonDiffusivity(-1.0), fissionYield(
 				0.25), migrationThreshold(
-				std::numeric_limits<double>::infinity()) {
+				std::numeric_limits<double>::infinity()), nThreads(1), jacobianType(
+				"assembled"), jacobianReuseStateChange(0.0), jacobianReuseTemperatureChange(
+				0.0), jacobianReuseMax(0), rateCacheBinWidth(0.0), networkCacheDirectory(
+				""), preconditioner("petsc") {
 	radiusMinSizes.Init(0);
 
 	return;
@@ -179,7 +182,43 @@ void Options::readParams(int argc, char *argv[]) {
 			"fissionYield", bpo::value<double>(&fissionYield),
 			"This option allows the user to set the number of xenon created for each fission.")(
 			"migrationThreshold", bpo::value<double>(&migrationThreshold),
-			"This option allows the user to set a limit on the migration energy above which the diffusion will be ignored.");
+			"This option allows the user to set a limit on the migration energy above which the diffusion will be ignored.")(
+			"threads", bpo::value<int>(&nThreads)->default_value(1),
+			"The number of threads used on each process to compute the reactions "
+					"at the different grid points and to build the reaction "
+					"connectivity of the network (default is 1).")("jacobian",
+			bpo::value<string>(&jacobianType)->default_value("assembled"),
+			"How the Jacobian is given to PETSc. (default = assembled, available "
+					"assembled,matrixFreeDiagonal,matrixFreeBlock). The matrix-free "
+					"options compute the reaction part of the Jacobian-vector products "
+					"from the network and only assemble the diagonal (or the blocks of "
+					"each cluster and its moments) of the reaction partial derivatives "
+					"for the preconditioner.")("jacobianReuse",
+			bpo::value<string>(),
+			"This option allows the user to reuse the Jacobian between evaluations. "
+					"To do so, simply write the values in order "
+					"maxRelativeStateChange maxTemperatureChange maxReuses . "
+					"The Jacobian is recomputed when the solution or the temperature "
+					"changed more than that since its last evaluation, after the "
+					"given number of consecutive reuses, or after a nonlinear solve failed.")(
+			"rateCache", bpo::value<double>(&rateCacheBinWidth),
+			"This option allows the user to set the width (in K) of the temperature "
+					"bins used to cache the rate constants. The rates are computed once "
+					"for each bin boundary, shared by all the grid points, and linearly "
+					"interpolated in between (default is 0.0, always computing them).")(
+			"networkCache", bpo::value<string>(&networkCacheDirectory),
+			"This option allows the user to set a directory where the generated "
+					"networks are cached, connectivity and coefficients included. "
+					"A network is loaded from there when it was generated with the "
+					"same network options and material (default is empty, no cache).")(
+			"preconditioner",
+			bpo::value<string>(&preconditioner)->default_value("petsc"),
+			"The preconditioner of the linear solves. (default = petsc, available "
+					"petsc,blockLU). petsc uses the one set in petscArgs, blockLU "
+					"factors the block of each grid point and corrects for the "
+					"coupling between grid points (-blocklu_sweeps, default 1). "
+					"The blocks bigger than -blocklu_dense_max (default 128) are "
+					"factored with a sparse LU.");
 
 	bpo::options_description visible("Allowed options");
 	visible.add(desc).add(config);
@@ -540,6 +579,67 @@ void Options::readParams(int argc, char *argv[]) {
 			}
 		}
 
+		// Take care of the number of threads
+		if (nThreads < 1) {
+			std::cerr
+					<< "\nOptions: The number of threads must be at least 1. "
+							"Aborting!\n" << std::endl;
+			shouldRunFlag = false;
+			exitCode = EXIT_FAILURE;
+		}
+
+		// Take care of the Jacobian type
+		if (jacobianType != "assembled" && jacobianType != "matrixFreeDiagonal"
+				&& jacobianType != "matrixFreeBlock") {
+			std::cerr
+					<< "\nOptions: unrecognized argument in the Jacobian option. "
+							"Aborting!\n" << std::endl;
+			shouldRunFlag = false;
+			exitCode = EXIT_FAILURE;
+		}
+
+		// Take care of the preconditioner
+		if (preconditioner != "petsc" && preconditioner != "blockLU") {
+			std::cerr
+					<< "\nOptions: unrecognized argument in the preconditioner option. "
+							"Aborting!\n" << std::endl;
+			shouldRunFlag = false;
+			exitCode = EXIT_FAILURE;
+		}
+
+		// Take care of the Jacobian reuse
+		if (opts.count("jacobianReuse")) {
+			// Build an input stream from the argument string.
+			xolotlCore::TokenizedLineReader<double> reader;
+			auto argSS = std::make_shared<std::istringstream>(
+					opts["jacobianReuse"].as<string>());
+			reader.setInputStream(argSS);
+
+			// Break the argument into tokens.
+			auto tokens = reader.loadLine();
+			if (tokens.size() != 3 || tokens[0] < 0.0 || tokens[1] < 0.0
+					|| tokens[2] < 0.0) {
+				std::cerr
+						<< "\nOptions: The Jacobian reuse needs three positive values. "
+								"Aborting!\n" << std::endl;
+				shouldRunFlag = false;
+				exitCode = EXIT_FAILURE;
+			} else {
+				jacobianReuseStateChange = tokens[0];
+				jacobianReuseTemperatureChange = tokens[1];
+				jacobianReuseMax = (int) tokens[2];
+			}
+		}
+
+		// Take care of the rate cache
+		if (rateCacheBinWidth < 0.0) {
+			std::cerr
+					<< "\nOptions: The rate cache bin width cannot be negative. "
+							"Aborting!\n" << std::endl;
+			shouldRunFlag = false;
+			exitCode = EXIT_FAILURE;
+		}
+
 		// Take care of the flux pulse
 		if (opts.count("pulse")) {
 			// Build an input stream from the argument string.
@@ -320,6 +320,48 @@ protected:
 	 */
 	double migrationThreshold;
 
+	/**
+	 * Number of threads used on each process for the grid point loops.
+	 */
+	int nThreads;
+
+	/**
+	 * How the Jacobian is given to the solver.
+	 */
+	std::string jacobianType;
+
+	/**
+	 * The largest relative change of the solution for which the Jacobian
+	 * is reused.
+	 */
+	double jacobianReuseStateChange;
+
+	/**
+	 * The largest temperature change for which the Jacobian is reused.
+	 */
+	double jacobianReuseTemperatureChange;
+
+	/**
+	 * The maximum number of consecutive Jacobian reuses, 0 to always
+	 * recompute it.
+	 */
+	int jacobianReuseMax;
+
+	/**
+	 * The width of the temperature bins of the rate cache.
+	 */
+	double rateCacheBinWidth;
+
+	/**
+	 * The directory where the generated networks are cached.
+	 */
+	std::string networkCacheDirectory;
+
+	/**
+	 * The preconditioner of the linear solves.
+	 */
+	std::string preconditioner;
+
 public:
 
 	/**
@@ -867,6 +909,55 @@ public:
 		return migrationThreshold;
 	}
 
+	/**
+	 * Obtain the number of threads to use on each process.
+	 * \see IOptions.h
+	 */
+	virtual int getNThreads() const override {
+		return nThreads;
+	}
+
+	/**
+	 * Obtain the type of Jacobian.
+	 * \see IOptions.h
+	 */
+	virtual std::string getJacobianType() const override {
+		return jacobianType;
+	}
+
+	/**
+	 * Obtain the Jacobian reuse policy.
+	 * \see IOptions.h
+	 */
+	virtual std::tuple<double, double, int> getJacobianReuse() const override {
+		return std::make_tuple(jacobianReuseStateChange,
+				jacobianReuseTemperatureChange, jacobianReuseMax);
+	}
+
+	/**
+	 * Obtain the width of the temperature bins of the rate cache.
+	 * \see IOptions.h
+	 */
+	virtual double getRateCacheBinWidth() const override {
+		return rateCacheBinWidth;
+	}
+
+	/**
+	 * Obtain the directory where the generated networks are cached.
+	 * \see IOptions.h
+	 */
+	virtual std::string getNetworkCacheDirectory() const override {
+		return networkCacheDirectory;
+	}
+
+	/**
+	 * Obtain the preconditioner.
+	 * \see IOptions.h
+	 */
+	virtual std::string getPreconditioner() const override {
+		return preconditioner;
+	}
+
 };
 //end class Options
 
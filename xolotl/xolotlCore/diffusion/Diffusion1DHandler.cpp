@@ -9,14 +9,8 @@ void Diffusion1DHandler::initializeDiffusionGrid(
 		std::vector<IAdvectionHandler *> advectionHandlers,
 		std::vector<double> grid, int nx, int xs, int ny, double hy, int ys,
 		int nz, double hz, int zs) {
-	// Get the number of diffusing clusters
-	const int nDiff = diffusingClusters.size();
-
 	// Initialize the diffusion grid with true everywhere
-	diffusionGrid.clear();
-	for (int i = 0; i < nx + 2; i++) {
-		diffusionGrid.emplace_back(nDiff, true);
-	}
+	resetDiffusionGrid(nx + 2);
 
 	// Initialize the grid position
 	Point<3> gridPosition { 0.0, 0.0, 0.0 };
@@ -35,23 +29,8 @@ void Diffusion1DHandler::initializeDiffusionGrid(
 
 			// Check if we are on a sink
 			if (currAdvectionHandler->isPointOnSink(gridPosition)) {
-				// We have to find the corresponding reactant in the diffusion
-				// cluster collection.
-				for (IReactant const& currAdvCluster : advecClusters) {
-
-					// Initialize n the index in the diffusion index vector
-					// TODO use std::find or std::find_if?
-					int n = 0;
-					while (n < nDiff) {
-						IReactant const& currDiffCluster = diffusingClusters[n];
-						if (&currDiffCluster == &currAdvCluster) {
-							break;
-						}
-						n++;
-					}
-					// Set this diffusion grid value to false
-					diffusionGrid[i][n] = false;
-				}
+				// The advecting clusters are not diffusing here
+				removeAdvecting(advecClusters, getGridRow(i));
 			}
 		}
 	}
@@ -62,42 +41,49 @@ void Diffusion1DHandler::initializeDiffusionGrid(
 void Diffusion1DHandler::computeDiffusion(const IReactionNetwork& network,
 		double **concVector, double *updatedConcOffset, double hxLeft,
 		double hxRight, int ix, double, int, double, int) const {
-
-	// Consider each diffusing cluster.
-	// TODO Maintaining a separate index assumes that diffusingClusters is
-	// visited in same order as diffusionGrid array for given point.
-	// Currently true with C++11, but we'd like to be able to visit the
-	// diffusing clusters in any order (so that we can parallelize).
-	// Maybe with a zip? or a std::transform?
-	int diffClusterIdx = 0;
-	for (IReactant const& currReactant : diffusingClusters) {
-
-		auto const& cluster = static_cast<IReactant const&>(currReactant);
-		int index = cluster.getId() - 1;
-
+	// Get the number of diffusing clusters and their indices
+	const int nDiff = diffusingIndices.size();
+	const int *index = diffusingIndices.data();
+
+	// Get the rows of diffusion coefficients at the left, middle, and right
+	// grid points, followed by the row for the fluxes
+	std::vector<double> coefficientRows;
+	double *leftCoef = fillCoefficientRows(ix, coefficientRows);
+	const double *midCoef = leftCoef + nDiff;
+	const double *rightCoef = midCoef + nDiff;
+	double *flux = leftCoef + 3 * nDiff;
+
+	// Get where the clusters are diffusing
+	const double *midGrid = getGridRow(ix + 1);
+	const double *leftGrid = getGridRow(ix);
+	const double *rightGrid = getGridRow(ix + 2);
+
+	// The factors from the grid geometry
+	const double ratio = hxLeft / hxRight;
+	const double factor = 2.0 / (hxLeft * (hxLeft + hxRight));
+	const double gradientFactor = 1.0
+			/ ((hxLeft + hxRight) * (hxLeft + hxRight));
+
+	// Use a simple midpoint stencil to compute the fluxes of all the
+	// diffusing clusters
+	const double *midConc = concVector[0];
+	const double *leftConc = concVector[1];
+	const double *rightConc = concVector[2];
+	for (int n = 0; n < nDiff; n++) {
 		// Get the initial concentrations
-		double oldConc = concVector[0][index]
-				* diffusionGrid[ix + 1][diffClusterIdx];
-		double oldLeftConc = concVector[1][index]
-				* diffusionGrid[ix][diffClusterIdx];
-		double oldRightConc = concVector[2][index]
-				* diffusionGrid[ix + 2][diffClusterIdx];
-
-		// Use a simple midpoint stencil to compute the concentration
-		double conc = (cluster.getDiffusionCoefficient(ix + 1) * 2.0
-				* (oldLeftConc + (hxLeft / hxRight) * oldRightConc
-						- (1.0 + (hxLeft / hxRight)) * oldConc)
-				/ (hxLeft * (hxLeft + hxRight)))
-				+ ((cluster.getDiffusionCoefficient(ix + 2)
-						- cluster.getDiffusionCoefficient(ix))
-						* (oldRightConc - oldLeftConc)
-						/ ((hxLeft + hxRight) * (hxLeft + hxRight)));
-
-		// Update the concentration of the cluster
-		updatedConcOffset[index] += conc;
-
-		// Increase the index
-		diffClusterIdx++;
+		double oldConc = midConc[index[n]] * midGrid[n];
+		double oldLeftConc = leftConc[index[n]] * leftGrid[n];
+		double oldRightConc = rightConc[index[n]] * rightGrid[n];
+
+		flux[n] = midCoef[n] * factor
+				* (oldLeftConc + ratio * oldRightConc - (1.0 + ratio) * oldConc)
+				+ (rightCoef[n] - leftCoef[n]) * (oldRightConc - oldLeftConc)
+						* gradientFactor;
+	}
+
+	// Update the concentrations of the clusters
+	for (int n = 0; n < nDiff; n++) {
+		updatedConcOffset[index[n]] += flux[n];
 	}
 
 	return;
@@ -106,43 +92,40 @@ void Diffusion1DHandler::computeDiffusion(const IReactionNetwork& network,
 void Diffusion1DHandler::computePartialsForDiffusion(
 		const IReactionNetwork& network, double *val, int *indices,
 		double hxLeft, double hxRight, int ix, double, int, double, int) const {
-
-	// Loop on them
-	// TODO Maintaining a separate index assumes that diffusingClusters is
-	// visited in same order as diffusionGrid array for given point.
-	// Currently true with C++11, but we'd like to be able to visit the
-	// diffusing clusters in any order (so that we can parallelize).
-	// Maybe with a zip? or a std::transform?
-	int diffClusterIdx = 0;
-	for (IReactant const& currReactant : diffusingClusters) {
-
-		auto const& cluster = static_cast<IReactant const&>(currReactant);
-
-		int index = cluster.getId() - 1;
-
+	// Get the number of diffusing clusters
+	const int nDiff = diffusingIndices.size();
+
+	// Get the rows of diffusion coefficients at the left, middle, and right
+	// grid points
+	std::vector<double> coefficientRows;
+	const double *leftCoef = fillCoefficientRows(ix, coefficientRows);
+	const double *midCoef = leftCoef + nDiff;
+	const double *rightCoef = midCoef + nDiff;
+
+	// Get where the clusters are diffusing
+	const double *midGrid = getGridRow(ix + 1);
+	const double *leftGrid = getGridRow(ix);
+	const double *rightGrid = getGridRow(ix + 2);
+
+	// The factors from the grid geometry
+	const double midFactor = -2.0 / (hxLeft * hxRight);
+	const double leftFactor = 2.0 / (hxLeft * (hxLeft + hxRight));
+	const double rightFactor = 2.0 / (hxRight * (hxLeft + hxRight));
+	const double gradientFactor = 1.0
+			/ ((hxLeft + hxRight) * (hxLeft + hxRight));
+
+	for (int n = 0; n < nDiff; n++) {
 		// Set the cluster index, the PetscSolver will use it to compute
 		// the row and column indices for the Jacobian
-		indices[diffClusterIdx] = index;
+		indices[n] = diffusingIndices[n];
 
 		// Compute the partial derivatives for diffusion of this cluster
 		// for the middle, left, and right grid point
-		val[diffClusterIdx * 3] = -2.0 * cluster.getDiffusionCoefficient(ix + 1)
-				/ (hxLeft * hxRight) * diffusionGrid[ix + 1][diffClusterIdx]; // middle
-		val[(diffClusterIdx * 3) + 1] = (cluster.getDiffusionCoefficient(ix)
-				* 2.0 / (hxLeft * (hxLeft + hxRight))
-				+ (cluster.getDiffusionCoefficient(ix)
-						- cluster.getDiffusionCoefficient(ix + 2))
-						/ ((hxLeft + hxRight) * (hxLeft + hxRight)))
-				* diffusionGrid[ix][diffClusterIdx]; // left
-		val[(diffClusterIdx * 3) + 2] = (cluster.getDiffusionCoefficient(ix)
-				* 2.0 / (hxRight * (hxLeft + hxRight))
-				+ (cluster.getDiffusionCoefficient(ix + 2)
-						- cluster.getDiffusionCoefficient(ix))
-						/ ((hxLeft + hxRight) * (hxLeft + hxRight)))
-				* diffusionGrid[ix + 2][diffClusterIdx]; // right
-
-		// Increase the index
-		diffClusterIdx++;
+		val[n * 3] = midFactor * midCoef[n] * midGrid[n]; // middle
+		val[(n * 3) + 1] = (leftCoef[n] * leftFactor
+				+ (leftCoef[n] - rightCoef[n]) * gradientFactor) * leftGrid[n]; // left
+		val[(n * 3) + 2] = (leftCoef[n] * rightFactor
+				+ (rightCoef[n] - leftCoef[n]) * gradientFactor) * rightGrid[n]; // right
 	}
 
 	return;
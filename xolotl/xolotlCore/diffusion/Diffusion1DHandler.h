@@ -11,11 +11,6 @@ namespace xolotlCore {
  * mobile clusters in 1D.
  */
 class Diffusion1DHandler: public DiffusionHandler {
-private:
-
-	//! The vector to know which clusters are diffusing where
-	std::vector<std::vector<bool> > diffusionGrid;
-
 public:
 
 	//! The Constructor
@@ -11,11 +11,6 @@ namespace xolotlCore {
  * mobile clusters in 2D.
  */
 class Diffusion2DHandler: public DiffusionHandler {
-private:
-
-	//! The vector to know which clusters are diffusing where
-	std::vector<std::vector<std::vector<bool> > > diffusionGrid;
-
 public:
 
 	//! The Constructor
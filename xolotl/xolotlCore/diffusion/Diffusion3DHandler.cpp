@@ -7,23 +7,8 @@ void Diffusion3DHandler::initializeDiffusionGrid(
 		std::vector<IAdvectionHandler *> advectionHandlers,
 		std::vector<double> grid, int nx, int xs, int ny, double hy, int ys,
 		int nz, double hz, int zs) {
-	// Get the number of diffusing clusters
-	int nDiff = diffusingClusters.size();
-
 	// Initialize the diffusion grid with true everywhere
-	diffusionGrid.clear();
-	// Initialize it to True
-	for (int k = 0; k < nz + 2; k++) {
-		std::vector<std::vector<std::vector<bool> > > tempGridTer;
-		for (int j = 0; j < ny + 2; j++) {
-			std::vector<std::vector<bool> > tempGridBis;
-			for (int i = 0; i < nx + 2; i++) {
-				tempGridBis.emplace_back(nDiff, true);
-			}
-			tempGridTer.push_back(tempGridBis);
-		}
-		diffusionGrid.push_back(tempGridTer);
-	}
+	resetDiffusionGrid(nx + 2, ny + 2, nz + 2);
 
 	// Initialize the grid position
 	Point<3> gridPosition { 0.0, 0.0, 0.0 };
@@ -48,23 +33,9 @@ void Diffusion3DHandler::initializeDiffusionGrid(
 
 					// Check if we are on a sink
 					if (currAdvectionHandler->isPointOnSink(gridPosition)) {
-						// We have to find the corresponding reactant in the diffusion
-						// cluster collection.
-						for (IReactant const& currAdvCluster : advecClusters) {
-							// Initialize n the index in the diffusion index vector
-							// TODO use std::find or std::find_if?
-							int n = 0;
-							while (n < nDiff) {
-								IReactant const& currDiffCluster =
-										diffusingClusters[n];
-								if (&currDiffCluster == &currAdvCluster) {
-									break;
-								}
-								n++;
-							}
-							// Set this diffusion grid value to false
-							diffusionGrid[k + 1][j + 1][i][n] = false;
-						}
+						// The advecting clusters are not diffusing here
+						removeAdvecting(advecClusters,
+								getGridRow(i, j + 1, k + 1));
 					}
 				}
 			}
@@ -77,52 +48,65 @@ void Diffusion3DHandler::initializeDiffusionGrid(
 void Diffusion3DHandler::computeDiffusion(const IReactionNetwork& network,
 		double **concVector, double *updatedConcOffset, double hxLeft,
 		double hxRight, int ix, double sy, int iy, double sz, int iz) const {
-
-	// Loop on them
-	// TODO Maintaining a separate index assumes that diffusingClusters is
-	// visited in same order as diffusionGrid array for given point.
-	// Currently true with C++11, but we'd like to be able to visit the
-	// diffusing clusters in any order (so that we can parallelize).
-	// Maybe with a zip? or a std::transform?
-	int diffClusterIdx = 0;
-	for (IReactant const& currReactant : diffusingClusters) {
-		// Get the diffusing cluster and its index
-		auto const& cluster = static_cast<IReactant const&>(currReactant);
-		int index = cluster.getId() - 1;
-
+	// Get the number of diffusing clusters and their indices
+	const int nDiff = diffusingIndices.size();
+	const int *index = diffusingIndices.data();
+
+	// Get the rows of diffusion coefficients at the left, middle, and right
+	// grid points, followed by the row for the fluxes
+	std::vector<double> coefficientRows;
+	double *leftCoef = fillCoefficientRows(ix, coefficientRows);
+	const double *midCoef = leftCoef + nDiff;
+	const double *rightCoef = midCoef + nDiff;
+	double *flux = leftCoef + 3 * nDiff;
+
+	// Get where the clusters are diffusing
+	const double *midGrid = getGridRow(ix + 1, iy + 1, iz + 1);
+	const double *leftGrid = getGridRow(ix, iy + 1, iz + 1);
+	const double *rightGrid = getGridRow(ix + 2, iy + 1, iz + 1);
+	const double *bottomGrid = getGridRow(ix + 1, iy, iz + 1);
+	const double *topGrid = getGridRow(ix + 1, iy + 2, iz + 1);
+	const double *frontGrid = getGridRow(ix + 1, iy + 1, iz);
+	const double *backGrid = getGridRow(ix + 1, iy + 1, iz + 2);
+
+	// The factors from the grid geometry
+	const double ratio = hxLeft / hxRight;
+	const double factor = 2.0 / (hxLeft * (hxLeft + hxRight));
+	const double gradientFactor = 1.0
+			/ ((hxLeft + hxRight) * (hxLeft + hxRight));
+
+	// Use a simple midpoint stencil to compute the fluxes of all the
+	// diffusing clusters
+	const double *midConc = concVector[0];
+	const double *leftConc = concVector[1];
+	const double *rightConc = concVector[2];
+	const double *bottomConc = concVector[3];
+	const double *topConc = concVector[4];
+	const double *frontConc = concVector[5];
+	const double *backConc = concVector[6];
+	for (int n = 0; n < nDiff; n++) {
 		// Get the initial concentrations
-		double oldConc = concVector[0][index]
-				* diffusionGrid[iz + 1][iy + 1][ix + 1][diffClusterIdx]; // middle
-		double oldLeftConc = concVector[1][index]
-				* diffusionGrid[iz + 1][iy + 1][ix][diffClusterIdx]; // left
-		double oldRightConc = concVector[2][index]
-				* diffusionGrid[iz + 1][iy + 1][ix + 2][diffClusterIdx]; // right
-		double oldBottomConc = concVector[3][index]
-				* diffusionGrid[iz + 1][iy][ix + 1][diffClusterIdx]; // bottom
-		double oldTopConc = concVector[4][index]
-				* diffusionGrid[iz + 1][iy + 2][ix + 1][diffClusterIdx]; // top
-		double oldFrontConc = concVector[5][index]
-				* diffusionGrid[iz][iy + 1][ix + 1][diffClusterIdx]; // front
-		double oldBackConc = concVector[6][index]
-				* diffusionGrid[iz + 2][iy + 1][ix + 1][diffClusterIdx]; // back
-
-		// Use a simple midpoint stencil to compute the concentration
-		double conc = cluster.getDiffusionCoefficient(ix + 1)
-				* (2.0
-						* (oldLeftConc + (hxLeft / hxRight) * oldRightConc
-								- (1.0 + (hxLeft / hxRight)) * oldConc)
-						/ (hxLeft * (hxLeft + hxRight))
+		double oldConc = midConc[index[n]] * midGrid[n];
+		double oldLeftConc = leftConc[index[n]] * leftGrid[n];
+		double oldRightConc = rightConc[index[n]] * rightGrid[n];
+		double oldBottomConc = bottomConc[index[n]] * bottomGrid[n];
+		double oldTopConc = topConc[index[n]] * topGrid[n];
+		double oldFrontConc = frontConc[index[n]] * frontGrid[n];
+		double oldBackConc = backConc[index[n]] * backGrid[n];
+
+		flux[n] = midCoef[n]
+				* (factor
+						* (oldLeftConc + ratio * oldRightConc
+								- (1.0 + ratio) * oldConc)
 						+ sy * (oldBottomConc + oldTopConc - 2.0 * oldConc)
 						+ sz * (oldFrontConc + oldBackConc - 2.0 * oldConc))
-				+ ((cluster.getDiffusionCoefficient(ix + 2)
-						- cluster.getDiffusionCoefficient(ix))
-						* (oldRightConc - oldLeftConc)
-						/ ((hxLeft + hxRight) * (hxLeft + hxRight)));
-
-		// Update the concentration of the cluster
-		updatedConcOffset[index] += conc;
+				+ (rightCoef[n] - leftCoef[n]) * (oldRightConc - oldLeftConc)
+						* gradientFactor;
+	}
 
-		++diffClusterIdx;
+	// Update the concentrations of the clusters
+	for (int n = 0; n < nDiff; n++) {
+		updatedConcOffset[index[n]] += flux[n];
 	}
 
 	return;
@@ -132,53 +116,48 @@ void Diffusion3DHandler::computePartialsForDiffusion(
 		const IReactionNetwork& network, double *val, int *indices,
 		double hxLeft, double hxRight, int ix, double sy, int iy, double sz,
 		int iz) const {
-
-	// Consider each diffusing cluster.
-	// TODO Maintaining a separate index assumes that diffusingClusters is
-	// visited in same order as diffusionGrid array for given point.
-	// Currently true with C++11, but we'd like to be able to visit the
-	// diffusing clusters in any order (so that we can parallelize).
-	// Maybe with a zip? or a std::transform?
-	int diffClusterIdx = 0;
-	for (IReactant const& currReactant : diffusingClusters) {
-		// Get the diffusing cluster and its index
-		auto const& cluster = static_cast<IReactant const&>(currReactant);
-		int index = cluster.getId() - 1;
-		// Get the diffusion coefficient of the cluster
-		double diffCoeff = cluster.getDiffusionCoefficient(ix + 1);
-
+	// Get the number of diffusing clusters
+	const int nDiff = diffusingIndices.size();
+
+	// Get the rows of diffusion coefficients at the left, middle, and right
+	// grid points
+	std::vector<double> coefficientRows;
+	const double *leftCoef = fillCoefficientRows(ix, coefficientRows);
+	const double *midCoef = leftCoef + nDiff;
+	const double *rightCoef = midCoef + nDiff;
+
+	// Get where the clusters are diffusing
+	const double *midGrid = getGridRow(ix + 1, iy + 1, iz + 1);
+	const double *leftGrid = getGridRow(ix, iy + 1, iz + 1);
+	const double *rightGrid = getGridRow(ix + 2, iy + 1, iz + 1);
+	const double *bottomGrid = getGridRow(ix + 1, iy, iz + 1);
+	const double *topGrid = getGridRow(ix + 1, iy + 2, iz + 1);
+	const double *frontGrid = getGridRow(ix + 1, iy + 1, iz);
+	const double *backGrid = getGridRow(ix + 1, iy + 1, iz + 2);
+
+	// The factors from the grid geometry
+	const double midFactor = -2.0 * ((1.0 / (hxLeft * hxRight)) + sy + sz);
+	const double leftFactor = 2.0 / (hxLeft * (hxLeft + hxRight));
+	const double rightFactor = 2.0 / (hxRight * (hxLeft + hxRight));
+	const double gradientFactor = 1.0
+			/ ((hxLeft + hxRight) * (hxLeft + hxRight));
+
+	for (int n = 0; n < nDiff; n++) {
 		// Set the cluster index, the PetscSolver will use it to compute
 		// the row and column indices for the Jacobian
-		indices[diffClusterIdx] = index;
+		indices[n] = diffusingIndices[n];
 
 		// Compute the partial derivatives for diffusion of this cluster
 		// for the middle, left, right, bottom, top, front, and back grid point
-		val[diffClusterIdx * 7] = -2.0 * cluster.getDiffusionCoefficient(ix + 1)
-				* ((1.0 / (hxLeft * hxRight)) + sy + sz)
-				* diffusionGrid[iz + 1][iy + 1][ix + 1][diffClusterIdx]; // middle
-		val[(diffClusterIdx * 7) + 1] = (cluster.getDiffusionCoefficient(ix + 1)
-				* 2.0 / (hxLeft * (hxLeft + hxRight))
-				+ (cluster.getDiffusionCoefficient(ix)
-						- cluster.getDiffusionCoefficient(ix + 2))
-						/ ((hxLeft + hxRight) * (hxLeft + hxRight)))
-				* diffusionGrid[iz + 1][iy + 1][ix][diffClusterIdx]; // left
-		val[(diffClusterIdx * 7) + 2] = (cluster.getDiffusionCoefficient(ix + 1)
-				* 2.0 / (hxRight * (hxLeft + hxRight))
-				+ (cluster.getDiffusionCoefficient(ix + 2)
-						- cluster.getDiffusionCoefficient(ix))
-						/ ((hxLeft + hxRight) * (hxLeft + hxRight)))
-				* diffusionGrid[iz + 1][iy + 1][ix + 2][diffClusterIdx]; // right
-		val[(diffClusterIdx * 7) + 3] = cluster.getDiffusionCoefficient(ix + 1)
-				* sy * diffusionGrid[iz + 1][iy][ix + 1][diffClusterIdx]; // bottom
-		val[(diffClusterIdx * 7) + 4] = cluster.getDiffusionCoefficient(ix + 1)
-				* sy * diffusionGrid[iz + 1][iy + 2][ix + 1][diffClusterIdx]; // top
-		val[(diffClusterIdx * 7) + 5] = cluster.getDiffusionCoefficient(ix + 1)
-				* sz * diffusionGrid[iz][iy + 1][ix + 1][diffClusterIdx]; // front
-		val[(diffClusterIdx * 7) + 6] = cluster.getDiffusionCoefficient(ix + 1)
-				* sz * diffusionGrid[iz + 2][iy + 1][ix + 1][diffClusterIdx]; // back
-
-		// Increase the index
-		diffClusterIdx++;
+		val[n * 7] = midFactor * midCoef[n] * midGrid[n]; // middle
+		val[(n * 7) + 1] = (midCoef[n] * leftFactor
+				+ (leftCoef[n] - rightCoef[n]) * gradientFactor) * leftGrid[n]; // left
+		val[(n * 7) + 2] = (midCoef[n] * rightFactor
+				+ (rightCoef[n] - leftCoef[n]) * gradientFactor) * rightGrid[n]; // right
+		val[(n * 7) + 3] = midCoef[n] * sy * bottomGrid[n]; // bottom
+		val[(n * 7) + 4] = midCoef[n] * sy * topGrid[n]; // top
+		val[(n * 7) + 5] = midCoef[n] * sz * frontGrid[n]; // front
+		val[(n * 7) + 6] = midCoef[n] * sz * backGrid[n]; // back
 	}
 
 	return;
@@ -11,11 +11,6 @@ namespace xolotlCore {
  * clusters in 3D.
  */
 class Diffusion3DHandler: public DiffusionHandler {
-private:
-
-	//! The vector to know which clusters are diffusing where
-	std::vector<std::vector<std::vector<std::vector<bool> > > > diffusionGrid;
-
 public:
 
 	//! The Constructor
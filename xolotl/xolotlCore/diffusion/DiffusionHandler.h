@@ -4,6 +4,7 @@
 // Includes
 #include "IDiffusionHandler.h"
 #include <MathUtils.h>
+#include <algorithm>
 
 namespace xolotlCore {
 
@@ -18,14 +19,111 @@ protected:
 	//! Collection of diffusing clusters.
 	IReactant::ConstRefVector diffusingClusters;
 
+	//! The indices of the diffusing clusters in the network
+	std::vector<int> diffusingIndices;
+
 	//! Migration energy threshold
 	double migrationThreshold;
 
+	/**
+	 * Whether each diffusing cluster is diffusing (1.0) or not (0.0) at each
+	 * grid point, including the ghost points, with one row of values for all
+	 * the diffusing clusters per grid point and the x direction first.
+	 */
+	std::vector<double> diffusionGrid;
+
+	//! The number of grid points of diffusionGrid in the x direction
+	int gridNx;
+
+	//! The number of grid points of diffusionGrid in the y direction
+	int gridNy;
+
+	/**
+	 * Set all the values of the diffusion grid to 1.0.
+	 *
+	 * @param nx The number of grid points in the x direction
+	 * @param ny The number of grid points in the y direction
+	 * @param nz The number of grid points in the z direction
+	 */
+	void resetDiffusionGrid(int nx, int ny = 1, int nz = 1) {
+		gridNx = nx;
+		gridNy = ny;
+		diffusionGrid.assign((std::size_t) nx * ny * nz
+				* diffusingIndices.size(), 1.0);
+	}
+
+	/**
+	 * Get the row of the diffusion grid at the given grid point.
+	 *
+	 * @param i The index in the x direction
+	 * @param j The index in the y direction
+	 * @param k The index in the z direction
+	 * @return The values of all the diffusing clusters
+	 */
+	double *getGridRow(int i, int j = 0, int k = 0) {
+		return diffusionGrid.data()
+				+ ((std::size_t) (k * gridNy + j) * gridNx + i)
+						* diffusingIndices.size();
+	}
+	const double *getGridRow(int i, int j = 0, int k = 0) const {
+		return diffusionGrid.data()
+				+ ((std::size_t) (k * gridNy + j) * gridNx + i)
+						* diffusingIndices.size();
+	}
+
+	/**
+	 * Set the given advecting clusters as not diffusing in the row of a grid
+	 * point of the diffusion grid.
+	 *
+	 * @param advecClusters The advecting clusters
+	 * @param gridRow The row
+	 */
+	void removeAdvecting(const IReactant::ConstRefVector &advecClusters,
+			double *gridRow) const {
+		for (IReactant const &currAdvCluster : advecClusters) {
+			// Find it in the diffusing clusters
+			auto it = std::find_if(diffusingClusters.begin(),
+					diffusingClusters.end(),
+					[&currAdvCluster](IReactant const &currDiffCluster) {
+						return &currDiffCluster == &currAdvCluster;
+					});
+			if (it != diffusingClusters.end())
+				gridRow[it - diffusingClusters.begin()] = 0.0;
+		}
+
+		return;
+	}
+
+	/**
+	 * Copy the diffusion coefficients of the diffusing clusters at the grid
+	 * points ix, ix + 1, and ix + 2 in the given rows, one row after the
+	 * other, followed by a row for the fluxes. The rows belong to the caller
+	 * so that grid points can be computed concurrently.
+	 *
+	 * @param ix The position on the x grid
+	 * @param coefficientRows The rows to fill, resized as needed
+	 * @return The row at ix, the next ones follow
+	 */
+	double *fillCoefficientRows(int ix,
+			std::vector<double> &coefficientRows) const {
+		const int nDiff = diffusingIndices.size();
+		coefficientRows.resize(4 * nDiff);
+		double *leftCoef = coefficientRows.data();
+		for (int n = 0; n < nDiff; n++) {
+			IReactant const &cluster = diffusingClusters[n];
+			leftCoef[n] = cluster.getDiffusionCoefficient(ix);
+			leftCoef[nDiff + n] = cluster.getDiffusionCoefficient(ix + 1);
+			leftCoef[2 * nDiff + n] = cluster.getDiffusionCoefficient(ix + 2);
+		}
+
+		return leftCoef;
+	}
+
 public:
 
 	//! The Constructor
 	DiffusionHandler(double threshold) :
-			migrationThreshold(threshold) {
+			migrationThreshold(threshold), gridNx(0), gridNy(0) {
 	}
 
 	//! The Destructor
@@ -48,6 +146,7 @@ public:
 
 		// Clear the index vector
 		diffusingClusters.clear();
+		diffusingIndices.clear();
 
 		// Consider each cluster.
 		for (IReactant const &currReactant : network.getAll()) {
@@ -68,6 +167,7 @@ public:
 
 			// Get its id
 			int index = cluster.getId() - 1;
+			diffusingIndices.push_back(index);
 			// Set the ofill value to 1 for this cluster
 			ofillMap[index].emplace_back(index);
 		}
@@ -212,10 +212,11 @@ public:
         DataSetTBase(void) = delete;
         DataSetTBase(const DataSetTBase<T>& other) = delete;
 
-        // Create data set.
+        // Create data set, with the given dataset creation property list.
         DataSetTBase(const HDF5Object& loc,
                         std::string dsetName,
-                        const DataSpace& dspace);
+                        const DataSpace& dspace,
+                        hid_t dcplId = H5P_DEFAULT);
 
         // Open existing data set.
         DataSetTBase(const HDF5Object& loc, std::string dsetName);
@@ -286,6 +287,9 @@ public:
         /// Suffix to add to data set names for starting indices dataset.
         static const std::string startIndicesDatasetNameSuffix;
 
+        /// Number of items per chunk of the compressed data sets.
+        static const hsize_t compressedChunkSize;
+
         /// The MPI communicator used to access the file.
         MPI_Comm comm;
 
@@ -340,19 +344,20 @@ public:
          */
         static std::unique_ptr<SimpleDataSpace<1>> buildDataSpace(
                                             MPI_Comm _comm,
-                                            const Ragged2DType& data);
+                                            const Ragged2DType& data,
+                                            bool extendable);
 
         /**
-         * Read our part of the indexing metadata describing our
-         * part of the flattened data set.
+         * Build the creation property list of the flattened data set.
+         * The compressed data sets are chunked, and go through the
+         * shuffle and deflate filters.
          *
-         * @param baseX Index of the first X point we own.
-         * @param numX Number of X points we own.
-         * @return A vector containing the starting indices for 
-         *              grid points we own
+         * @param compressionLevel The deflate level, 0 for an uncompressed
+         *              contiguous data set.
+         * @return The dataset creation property list.
          */
-        std::vector<uint32_t> readStartingIndices(int baseX, int numX) const;
-
+        static std::unique_ptr<PropertyList> buildCreationPropertyList(
+                                            int compressionLevel);
 
         /**
          * Write our part of the indexing metadata describing our
@@ -411,12 +416,15 @@ public:
          * @param dsetName The name of the dataset.
          * @param baseX Index of the first X point we own.
          * @param data The data to be written.
+         * @param compressionLevel The deflate level (1-9) of the flattened
+         *              data set, 0 to write it uncompressed.
          */
         RaggedDataSet2D(MPI_Comm comm,
                         const HDF5Object& loc,
                         std::string dsetName,
                         int baseX,
-                        const Ragged2DType& data);
+                        const Ragged2DType& data,
+                        int compressionLevel = 0);
 
         /**
          * Open an existing data set.
@@ -437,6 +445,32 @@ public:
          * @return The data associated with X points in [baseX,baseX+numXs).
          */
         Ragged2DType read(int baseX, int numX) const;
+
+        /**
+         * Read our part of the indexing metadata describing our
+         * part of the flattened data set.
+         *
+         * @param baseX Index of the first X point we own.
+         * @param numX Number of X points we own.
+         * @return A vector containing the starting indices for 
+         *              grid points we own, plus one past so that we can
+         *              compute the total number of values we own.
+         */
+        std::vector<uint32_t> readStartingIndices(int baseX, int numX) const;
+
+        /**
+         * Read a contiguous part of the flattened data set with a
+         * collective read. All the processes must call it, possibly
+         * with no item to read.
+         *
+         * @param globalBaseIdx Index of the first item to read within
+         *              the flattened data set.
+         * @param numItems Number of items to read.
+         * @param data Where to store the items, must have room for
+         *              numItems.
+         */
+        void readItems(uint32_t globalBaseIdx, uint32_t numItems,
+                        T* data) const;
     };
 
 
@@ -3,5 +3,6 @@
 namespace xolotlCore {
 
 const std::string HDF5File::RaggedDataSetBase::startIndicesDatasetNameSuffix = "_startingIndices";
+const hsize_t HDF5File::RaggedDataSetBase::compressedChunkSize = 16384;
 
 } // namespace xolotlCore
@@ -2,6 +2,7 @@
 #define XCORE_HDF5FILE_DATASET_H
 
 #include <numeric>
+#include <algorithm>
 #include "boost/range/counting_range.hpp"
 #include "xolotlCore/DoInOrder.h"
 
@@ -11,7 +12,8 @@ namespace xolotlCore
 template<typename T>
 HDF5File::DataSetTBase<T>::DataSetTBase(const HDF5Object& loc,
                                     std::string dsetName,
-                                    const DataSpace& dspace)
+                                    const DataSpace& dspace,
+                                    hid_t dcplId)
   : DataSetBase(loc, dsetName)
 {
     setId(H5Dcreate(loc.getId(),
@@ -19,7 +21,7 @@ HDF5File::DataSetTBase<T>::DataSetTBase(const HDF5Object& loc,
                         TypeInFile<T>().getId(),
                         dspace.getId(),
                         H5P_DEFAULT,
-                        H5P_DEFAULT,
+                        dcplId,
                         H5P_DEFAULT));
     if(getId() < 0)
     {
@@ -182,9 +184,12 @@ HDF5File::RaggedDataSet2D<T>::RaggedDataSet2D(MPI_Comm _comm,
                                     const HDF5Object& loc,
                                     std::string dsetName,
                                     int baseX,
-                                    const Ragged2DType& data)
+                                    const Ragged2DType& data,
+                                    int compressionLevel)
   : RaggedDataSetBase(_comm),
-    DataSetTBase<T>(loc, dsetName, *(buildDataSpace(_comm, data))) {
+    DataSetTBase<T>(loc, dsetName,
+                    *(buildDataSpace(_comm, data, compressionLevel > 0)),
+                    buildCreationPropertyList(compressionLevel)->getId()) {
 
     // We assume the gridpoint values are indices into the gridpoint array,
     // so non-negative and base 0.
@@ -228,7 +233,8 @@ HDF5File::RaggedDataSet2D<T>::findNumItemsByPoint(const Ragged2DType& data) {
 template<typename T>
 std::unique_ptr<HDF5File::SimpleDataSpace<1>>
 HDF5File::RaggedDataSet2D<T>::buildDataSpace(MPI_Comm _comm,
-                                        const Ragged2DType& data) {
+                                        const Ragged2DType& data,
+                                        bool extendable) {
 
     // Build the data space for the flattened data itself.
     // When a file is opened for parallel access, HDF5 seems to require 
@@ -263,11 +269,38 @@ HDF5File::RaggedDataSet2D<T>::buildDataSpace(MPI_Comm _comm,
                     _comm);
 
     // Define the dataspace for the flattened data.
+    // A chunked data set may be smaller than one chunk only if its
+    // dimension is extendable.
     SimpleDataSpace<1>::Dimensions dims { totalNumItems };
-    std::unique_ptr<SimpleDataSpace<1>> dataspace(new SimpleDataSpace<1>(dims));
+    std::unique_ptr<SimpleDataSpace<1>> dataspace;
+    if(extendable) {
+        SimpleDataSpace<1>::Dimensions maxDims { H5S_UNLIMITED };
+        dataspace.reset(new SimpleDataSpace<1>(dims, maxDims));
+    }
+    else {
+        dataspace.reset(new SimpleDataSpace<1>(dims));
+    }
     return std::move(dataspace);
 }
 
+
+template<typename T>
+std::unique_ptr<HDF5File::PropertyList>
+HDF5File::RaggedDataSet2D<T>::buildCreationPropertyList(int compressionLevel) {
+
+    std::unique_ptr<PropertyList> plist(new PropertyList(H5P_DATASET_CREATE));
+    if(compressionLevel > 0) {
+        // Shuffle the bytes before deflating them so that the bytes that
+        // barely change (exponents, high bytes of the indices) end up
+        // next to each other.
+        SimpleDataSpace<1>::Dimensions chunkDims { compressedChunkSize };
+        H5Pset_chunk(plist->getId(), 1, chunkDims.data());
+        H5Pset_shuffle(plist->getId());
+        H5Pset_deflate(plist->getId(), std::min(compressionLevel, 9));
+    }
+    return plist;
+}
+
 inline
 std::ostream&
 operator<<(std::ostream& os, const std::pair<int, double>& p) {
@@ -618,6 +651,48 @@ HDF5File::RaggedDataSet2D<T>::readStartingIndices(int baseX, int numX) const {
 }
 
 
+template<typename T>
+void
+HDF5File::RaggedDataSet2D<T>::readItems(uint32_t globalBaseIdx,
+                                        uint32_t numItems,
+                                        T* data) const {
+
+    // Specify our part of the dataset to read, which may be empty.
+    SimpleDataSpace<1>::Dimensions dataCounts { numItems };
+    SimpleDataSpace<1>::Dimensions dataOffsets { globalBaseIdx };
+    SimpleDataSpace<1> dataMemspace(dataCounts);
+    SimpleDataSpace<1> dataFilespace(*this);
+    if(numItems > 0) {
+        H5Sselect_hyperslab(dataFilespace.getId(),
+                            H5S_SELECT_SET,
+                            dataOffsets.data(),
+                            nullptr,
+                            dataCounts.data(),
+                            nullptr);
+    }
+    else {
+        H5Sselect_none(dataMemspace.getId());
+        H5Sselect_none(dataFilespace.getId());
+    }
+
+    // Read it using a collective operation.
+    PropertyList plist(H5P_DATASET_XFER);
+    H5Pset_dxpl_mpio(plist.getId(), H5FD_MPIO_COLLECTIVE);
+    TypeInMemory<T> dataMemType;
+    auto status = H5Dread(this->getId(),
+                dataMemType.getId(),
+                dataMemspace.getId(),
+                dataFilespace.getId(),
+                plist.getId(),
+                data);
+    if(status < 0) {
+        std::ostringstream estr;
+        estr << "Failed to read dataset " << this->getName();
+        throw HDF5Exception(estr.str());
+    }
+}
+
+
 template<typename T>
 typename HDF5File::RaggedDataSet2D<T>::Ragged2DType
 HDF5File::RaggedDataSet2D<T>::readData(
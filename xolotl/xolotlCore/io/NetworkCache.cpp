@@ -0,0 +1,68 @@
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <unistd.h>
+#include "xolotlCore/io/NetworkCache.h"
+#include "xolotlCore/io/XFile.h"
+
+namespace xolotlCore {
+
+NetworkCache::NetworkCache(const std::string& directory,
+		const std::string& key, MPI_Comm _comm) :
+		comm(_comm) {
+	std::ostringstream name;
+	name << "network-" << std::hex << std::setw(16) << std::setfill('0')
+			<< hash(key) << ".h5";
+	filePath = fs::path(directory) / name.str();
+}
+
+std::uint64_t NetworkCache::hash(const std::string& key) {
+	std::uint64_t value = 14695981039346656037ULL;
+	for (unsigned char c : key) {
+		value ^= c;
+		value *= 1099511628211ULL;
+	}
+
+	return value;
+}
+
+bool NetworkCache::contains() const {
+	int procId;
+	MPI_Comm_rank(comm, &procId);
+
+	int found = 0;
+	if (procId == 0)
+		found = fs::exists(filePath) ? 1 : 0;
+	MPI_Bcast(&found, 1, MPI_INT, 0, comm);
+
+	return found == 1;
+}
+
+void NetworkCache::store(IReactionNetwork& network) const {
+	int procId;
+	MPI_Comm_rank(comm, &procId);
+	if (procId != 0)
+		return;
+
+	// Write in a file only this process knows about
+	fs::path tempPath = filePath;
+	tempPath += ".tmp" + std::to_string(::getpid());
+	try {
+		fs::create_directories(filePath.parent_path());
+		{
+			XFile networkFile(tempPath, network, MPI_COMM_SELF);
+		}
+		fs::rename(tempPath, filePath);
+	} catch (const std::exception& e) {
+		std::cerr << "\nNetworkCache: the network could not be written in "
+				<< filePath << ": " << e.what() << std::endl;
+		try {
+			fs::remove(tempPath);
+		} catch (const std::exception&) {
+		}
+	}
+
+	return;
+}
+
+} /* namespace xolotlCore */
@@ -0,0 +1,88 @@
+#ifndef XCORE_NETWORKCACHE_H
+#define XCORE_NETWORKCACHE_H
+
+#include <string>
+#include <cstdint>
+#include <mpi.h>
+#include "xolotlCore/io/Filesystem.h"
+#include <IReactionNetwork.h>
+
+namespace xolotlCore {
+
+/**
+ * This class manages a directory of connected networks, each written
+ * with its clusters, reactions and coefficients in an HDF5 file named after
+ * the hash of the inputs it was generated from (the key). A network whose
+ * inputs change gets a different file, so there is nothing to invalidate.
+ *
+ * The key must describe everything the network depends on, including a
+ * version that is increased whenever the generation changes.
+ */
+class NetworkCache {
+private:
+
+	/**
+	 * The path of the file for our key.
+	 */
+	fs::path filePath;
+
+	/**
+	 * The communicator of the processes sharing the network.
+	 */
+	MPI_Comm comm;
+
+public:
+
+	NetworkCache() = delete;
+
+	/**
+	 * The constructor.
+	 *
+	 * @param directory The directory of the cache
+	 * @param key The description of the inputs of the network
+	 * @param _comm The communicator of the processes sharing the network
+	 */
+	NetworkCache(const std::string& directory, const std::string& key,
+			MPI_Comm _comm = MPI_COMM_WORLD);
+
+	/**
+	 * Compute the hash of a key (64 bits FNV-1a).
+	 *
+	 * @param key The key
+	 * @return The hash
+	 */
+	static std::uint64_t hash(const std::string& key);
+
+	/**
+	 * Get the path of the file for our key.
+	 *
+	 * @return The path
+	 */
+	const fs::path& getPath() const {
+		return filePath;
+	}
+
+	/**
+	 * Check whether the network for our key is in the cache. The first
+	 * process checks and broadcasts the answer so all of them agree.
+	 * It must be called by all the processes.
+	 *
+	 * @return True if it is
+	 */
+	bool contains() const;
+
+	/**
+	 * Write the network for our key in the cache. The first process
+	 * writes it in a temporary file that is renamed when it is complete,
+	 * so that other runs never see a partial file. The other processes
+	 * do nothing. A failure is reported but is not fatal, the network is
+	 * simply not cached.
+	 *
+	 * @param network The network
+	 */
+	void store(IReactionNetwork& network) const;
+};
+
+} /* namespace xolotlCore */
+
+#endif // XCORE_NETWORKCACHE_H
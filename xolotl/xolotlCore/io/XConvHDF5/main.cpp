@@ -31,7 +31,9 @@ int main(int argc, char* argv[]) {
 		bool shouldRun = true;
 		bpo::options_description desc("Supported options");
 		desc.add_options()("help", "show this help message")("infile",
-				bpo::value<std::string>(), "input file name");
+				bpo::value<std::string>(), "input file name")("network",
+				"convert the network to the columnar layout instead of the "
+						"concentrations");
 
 		bpo::variables_map opts;
 		bpo::store(bpo::parse_command_line(argc, argv, desc), opts);
@@ -57,50 +59,68 @@ int main(int argc, char* argv[]) {
 			xcore::XFile xfile(fname,
 			MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadWrite);
 
-			// Determine the number of grid points.
-			auto headerGroup = xfile.getGroup<xcore::XFile::HeaderGroup>();
-			assert(headerGroup);
-			xcore::HDF5File::Attribute<int> nxAttr(*headerGroup, "nx");
-			auto nx = nxAttr.get();
-
-			// Determine the last timestep written to the file.
-			auto concGroup = xfile.getGroup<xcore::XFile::ConcentrationGroup>();
-			assert(concGroup);
-			xcore::HDF5File::Attribute<int> lastTimestepAttr(*concGroup,
-					"lastTimeStep");
-			auto lastTimeStep = lastTimestepAttr.get();
-
-			std::cout << "nx: " << nx << '\n' << "last time step: "
-					<< lastTimeStep << std::endl;
-
-			// Open the timestep group associated with the
-			// last written timestep.
-			auto tsGroup = concGroup->getLastTimestepGroup();
-			assert(tsGroup);
-
-			// Convert the last written timestep's concentrations to
-			// the new representation.
-			xcore::XFile::TimestepGroup::Concs1DType allConcs(nx);
-			for (auto x = 0; x < nx; ++x) {
-				// Read the concentrations for the current position.
-				std::ostringstream dsNameStr;
-				dsNameStr << "position_" << x << "-1_-1";
-				std::string dsName = dsNameStr.str();
-				std::cout << "Reading conc data for gridpoint " << x
-						<< " from dataset " << dsName << std::endl;
-				auto oldData = tsGroup->readGridPoint(x);
-				auto nConcs = oldData.size();
-
-				// Store into our ragged 2D representation.
-				for (auto i = 0; i < nConcs; ++i) {
-					auto l = oldData[i][0];
-					auto conc = oldData[i][1];
-					allConcs[x].emplace_back(l, conc);
+			// Convert the network from the per-cluster layout
+			// to the columnar one.
+			if (opts.count("network")) {
+				auto networkGroup =
+						xfile.getGroup<xcore::XFile::NetworkGroup>();
+				if (not networkGroup) {
+					throw std::runtime_error("No network in " + fname);
+				}
+				std::cout << "network layout version: "
+						<< networkGroup->getLayoutVersion() << std::endl;
+				networkGroup->convertToColumnar();
+				std::cout << "converted to layout version "
+						<< networkGroup->getLayoutVersion()
+						<< ", run h5repack to reclaim the space of the "
+								"cluster groups" << std::endl;
+			} else {
+
+				// Determine the number of grid points.
+				auto headerGroup = xfile.getGroup<xcore::XFile::HeaderGroup>();
+				assert(headerGroup);
+				xcore::HDF5File::Attribute<int> nxAttr(*headerGroup, "nx");
+				auto nx = nxAttr.get();
+
+				// Determine the last timestep written to the file.
+				auto concGroup = xfile.getGroup<xcore::XFile::ConcentrationGroup>();
+				assert(concGroup);
+				xcore::HDF5File::Attribute<int> lastTimestepAttr(*concGroup,
+						"lastTimeStep");
+				auto lastTimeStep = lastTimestepAttr.get();
+
+				std::cout << "nx: " << nx << '\n' << "last time step: "
+						<< lastTimeStep << std::endl;
+
+				// Open the timestep group associated with the
+				// last written timestep.
+				auto tsGroup = concGroup->getLastTimestepGroup();
+				assert(tsGroup);
+
+				// Convert the last written timestep's concentrations to
+				// the new representation.
+				xcore::XFile::TimestepGroup::Concs1DType allConcs(nx);
+				for (auto x = 0; x < nx; ++x) {
+					// Read the concentrations for the current position.
+					std::ostringstream dsNameStr;
+					dsNameStr << "position_" << x << "-1_-1";
+					std::string dsName = dsNameStr.str();
+					std::cout << "Reading conc data for gridpoint " << x
+							<< " from dataset " << dsName << std::endl;
+					auto oldData = tsGroup->readGridPoint(x);
+					auto nConcs = oldData.size();
+
+					// Store into our ragged 2D representation.
+					for (auto i = 0; i < nConcs; ++i) {
+						auto l = oldData[i][0];
+						auto conc = oldData[i][1];
+						allConcs[x].emplace_back(l, conc);
+					}
 				}
-			}
 
-			// Write the dataset to the file.
-			tsGroup->writeConcentrations(xfile, 0, allConcs);
+				// Write the dataset to the file.
+				tsGroup->writeConcentrations(xfile, 0, allConcs);
+			}
 		}
 	} catch (std::exception& e) {
 		std::cerr << e.what() << std::endl;
@@ -2,6 +2,10 @@
 #include <sstream>
 #include <iterator>
 #include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <algorithm>
 #include "hdf5.h"
 #include "mpi.h"
 #include "xolotlCore/io/XFile.h"
@@ -47,6 +51,13 @@ XFile::XFile(fs::path _path, const std::vector<double>& grid,
 	ConcentrationGroup concGroup(*this, true);
 }
 
+XFile::XFile(fs::path _path, IReactionNetwork& network, MPI_Comm _comm,
+		AccessMode _mode) :
+		HDF5File(_path, EnsureCreateAccessMode(_mode), _comm, true) {
+	// Create and write the network group.
+	NetworkGroup networkGroup(*this, network);
+}
+
 XFile::XFile(fs::path _path, MPI_Comm _comm, AccessMode _mode) :
 		HDF5File(_path, EnsureOpenAccessMode(_mode), _comm, true) {
 
@@ -223,15 +234,266 @@ const fs::path XFile::NetworkGroup::path = "/networkGroup";
 const std::string XFile::NetworkGroup::normalSizeAttrName = "normalSize";
 const std::string XFile::NetworkGroup::superSizeAttrName = "superSize";
 const std::string XFile::NetworkGroup::phaseSpaceAttrName = "phaseSpace";
+const std::string XFile::NetworkGroup::layoutVersionAttrName = "layoutVersion";
+const std::string XFile::NetworkGroup::compositionDataName = "composition";
+const std::string XFile::NetworkGroup::energyDataName = "energy";
+const std::string XFile::NetworkGroup::superDataName = "superData";
+const std::string XFile::NetworkGroup::heVListDataName = "heVList";
+const std::array<std::string, 4> XFile::NetworkGroup::reactionDataNames = { {
+		"prod", "comb", "disso", "emit" } };
+const int XFile::NetworkGroup::columnarLayoutVersion;
+const int XFile::NetworkGroup::energyDataSize;
+const int XFile::NetworkGroup::superDataSize;
+
+namespace {
+
+/**
+ * Get the number of mantissa bits needed to represent the values with the
+ * given relative tolerance.
+ *
+ * @param tolerance The relative tolerance, 0.0 for the exact values.
+ * @return The number of mantissa bits to keep.
+ */
+int mantissaBits(double tolerance) {
+	if (!(tolerance > 0.0))
+		return std::numeric_limits<double>::digits - 1;
+
+	// The rounding error is at most 2^-(nBits+1) in relative terms
+	int nBits = (int) std::ceil(-std::log2(tolerance)) - 1;
+	return std::max(1,
+			std::min(nBits, std::numeric_limits<double>::digits - 1));
+}
+
+/**
+ * Round the mantissa of the value to the given number of bits. The low bits
+ * that are zeroed compress well.
+ *
+ * @param value The value.
+ * @param nBits The number of mantissa bits to keep.
+ * @return The rounded value.
+ */
+double roundMantissa(double value, int nBits) {
+	const int nDropped = std::numeric_limits<double>::digits - 1 - nBits;
+	if (nDropped <= 0 || !std::isfinite(value))
+		return value;
+
+	// Round to the nearest, a carry into the exponent is still correct
+	uint64_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	bits += (uint64_t) 1 << (nDropped - 1);
+	bits &= ~(((uint64_t) 1 << nDropped) - 1);
+	std::memcpy(&value, &bits, sizeof(bits));
+
+	return value;
+}
+
+// The kinds of reactions, in the order of the reaction tables.
+enum ReactionKind {
+	production = 0, combination = 1, dissociation = 2, emission = 3
+};
+
+/**
+ * Create a dataset in the given group and write the data in it.
+ *
+ * @param groupId The group.
+ * @param name The name of the dataset.
+ * @param fileType The type of the data in the file.
+ * @param memType The type of the data in memory.
+ * @param dims The dimensions of the dataset.
+ * @param data The data.
+ */
+void writeDataset(hid_t groupId, const std::string& name, hid_t fileType,
+		hid_t memType, const std::vector<hsize_t>& dims, const void *data) {
+	hid_t dataspaceId = H5Screate_simple(dims.size(), dims.data(), nullptr);
+	hid_t datasetId = H5Dcreate2(groupId, name.c_str(), fileType, dataspaceId,
+	H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+	// Empty datasets have nothing to write
+	if (H5Sget_simple_extent_npoints(dataspaceId) > 0) {
+		H5Dwrite(datasetId, memType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+	}
+	H5Dclose(datasetId);
+	H5Sclose(dataspaceId);
+}
+
+/**
+ * Read a whole dataset of the given group. Every process reads all of it
+ * with a collective read.
+ *
+ * @param groupId The group.
+ * @param name The name of the dataset.
+ * @param memType The type of the data in memory.
+ * @param data The vector to fill.
+ */
+template<typename T>
+void readDataset(hid_t groupId, const std::string& name, hid_t memType,
+		std::vector<T>& data) {
+	hid_t datasetId = H5Dopen(groupId, name.c_str(), H5P_DEFAULT);
+	hid_t dataspaceId = H5Dget_space(datasetId);
+	data.resize(H5Sget_simple_extent_npoints(dataspaceId));
+	if (!data.empty()) {
+		HDF5File::PropertyList plist(H5P_DATASET_XFER);
+		H5Pset_dxpl_mpio(plist.getId(), H5FD_MPIO_COLLECTIVE);
+		H5Dread(datasetId, memType, H5S_ALL, H5S_ALL, plist.getId(),
+				data.data());
+	}
+	H5Sclose(dataspaceId);
+	H5Dclose(datasetId);
+}
+
+/**
+ * Append the rows of a reaction dataset of the per-cluster layout to the
+ * given vector.
+ *
+ * @param groupId The cluster group.
+ * @param name The name of the dataset.
+ * @param rows The vector where the rows are appended.
+ * @return The width of the rows, 0 if the dataset does not exist.
+ */
+int readClusterRows(hid_t groupId, const std::string& name,
+		std::vector<double>& rows) {
+	if (H5Lexists(groupId, name.c_str(), H5P_DEFAULT) <= 0)
+		return 0;
+
+	hid_t datasetId = H5Dopen(groupId, name.c_str(), H5P_DEFAULT);
+	hid_t dataspaceId = H5Dget_space(datasetId);
+	std::array<hsize_t, 2> dims;
+	H5Sget_simple_extent_dims(dataspaceId, dims.data(), nullptr);
+	auto start = rows.size();
+	rows.resize(start + dims[0] * dims[1]);
+	if (dims[0] * dims[1] > 0) {
+		H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+				rows.data() + start);
+	}
+	H5Sclose(dataspaceId);
+	H5Dclose(datasetId);
+
+	return dims[1];
+}
+
+/**
+ * Create the reactions of one kind of a cluster from their rows, add them
+ * to the network and to the cluster.
+ *
+ * @param network The network.
+ * @param cluster The cluster.
+ * @param kind The kind of the reactions.
+ * @param rows The rows: the ids of the other reactants, then the
+ * coefficients.
+ * @param nRows The number of rows.
+ * @param width The width of the rows.
+ */
+void addReactions(IReactionNetwork& network, IReactant& cluster,
+		ReactionKind kind, const double *rows, int nRows, int width) {
+	// Get all the reactants
+	auto& allReactants = network.getAll();
+
+	// The coefficients start after the ids
+	int nIds = (kind == combination) ? 1 : 2;
+	std::vector<double> coefs;
+
+	for (int i = 0; i < nRows; i++) {
+		const double *row = rows + i * width;
+		coefs.assign(row + nIds, row + width);
+		// Some networks are written without the coefficients
+		if (coefs.empty())
+			coefs.push_back(0.0);
+		auto& firstReactant = allReactants.at((int) row[0]);
+
+		switch (kind) {
+		case production: {
+			// The cluster is produced by the 2 reactants
+			auto& secondReactant = allReactants.at((int) row[1]);
+			std::unique_ptr<ProductionReaction> reaction(
+					new ProductionReaction(firstReactant, secondReactant));
+			auto& prref = network.add(std::move(reaction));
+			cluster.resultFrom(prref, coefs.data());
+			break;
+		}
+		case combination: {
+			// The cluster combines with the reactant
+			std::unique_ptr<ProductionReaction> reaction(
+					new ProductionReaction(firstReactant, cluster));
+			auto& prref = network.add(std::move(reaction));
+			cluster.participateIn(prref, coefs.data());
+			break;
+		}
+		case dissociation: {
+			// The first reactant dissociates into the cluster and the
+			// second reactant
+			auto& secondReactant = allReactants.at((int) row[1]);
+			std::unique_ptr<ProductionReaction> reaction(
+					new ProductionReaction(cluster, secondReactant));
+			auto& prref = network.add(std::move(reaction));
+			std::unique_ptr<DissociationReaction> dissociationReaction(
+					new DissociationReaction(firstReactant, prref.first,
+							prref.second, &prref));
+			auto& drref = network.add(std::move(dissociationReaction));
+			cluster.participateIn(drref, coefs.data());
+			break;
+		}
+		case emission: {
+			// The cluster dissociates into the 2 reactants
+			auto& secondReactant = allReactants.at((int) row[1]);
+			std::unique_ptr<ProductionReaction> reaction(
+					new ProductionReaction(firstReactant, secondReactant));
+			auto& prref = network.add(std::move(reaction));
+			std::unique_ptr<DissociationReaction> dissociationReaction(
+					new DissociationReaction(cluster, prref.first,
+							prref.second, &prref));
+			auto& drref = network.add(std::move(dissociationReaction));
+			cluster.emitFrom(drref, coefs.data());
+			break;
+		}
+		}
+	}
+
+	return;
+}
+
+/**
+ * Set the type of an alloy super cluster from its index in the file.
+ *
+ * @param typeIndex The index of the type in the file.
+ * @param type The type to set, left unchanged if the index is unknown.
+ */
+void setAlloyType(int typeIndex, ReactantType &type) {
+	switch (typeIndex) {
+	case 1:
+		type = ReactantType::Void;
+		break;
+	case 2:
+		type = ReactantType::Frank;
+		break;
+	case 3:
+		type = ReactantType::Perfect;
+		break;
+	case 4:
+		type = ReactantType::Faulted;
+		break;
+	default:
+		std::cout << "Type not recognized for alloy super cluster: "
+				<< typeIndex << std::endl;
+		break;
+	}
+
+	return;
+}
+
+} // namespace
 
 XFile::NetworkGroup::NetworkGroup(const XFile& file) :
-		HDF5File::Group(file, NetworkGroup::path, false) {
+		HDF5File::Group(file, NetworkGroup::path, false), layoutVersion(1) {
+	// Base class opened the group.
 
-	// Base class opened the group, so nothing else to do.
+	// Files written before the columnar layout have no version attribute
+	if (H5Aexists(getId(), layoutVersionAttrName.c_str()) > 0) {
+		Attribute<int> layoutVersionAttr(*this, layoutVersionAttrName);
+		layoutVersion = layoutVersionAttr.get();
+	}
 }
 
 XFile::NetworkGroup::NetworkGroup(const XFile& file, IReactionNetwork& network) :
-		HDF5File::Group(file, NetworkGroup::path, true) {
+		HDF5File::Group(file, NetworkGroup::path, true), layoutVersion(1) {
 	// Base class created the group.
 
 	// Get the sizes information
@@ -260,14 +522,168 @@ XFile::NetworkGroup::NetworkGroup(const XFile& file, IReactionNetwork& network)
 	auto status = H5Awrite(attrId, H5T_STD_I32LE, &list);
 	status = H5Aclose(attrId);
 
-	// Loop on all the clusters
+	// Order the clusters by id
 	auto& allReactants = network.getAll();
-	std::for_each(allReactants.begin(), allReactants.end(),
-			[this](IReactant& currReactant) {
-				// Create and initialize the cluster group
-				int id = currReactant.getId() - 1;
-				ClusterGroup clusterGroup(*this, currReactant);
-			});
+	int nClusters = allReactants.size();
+	std::vector<IReactant*> clusters(nClusters, nullptr);
+	for (IReactant& currReactant : allReactants) {
+		clusters[currReactant.getId() - 1] = &currReactant;
+	}
+
+	// Fill the columns, one row per cluster
+	Columns cols;
+	cols.compSize = IReactant::Composition().size();
+	cols.composition.assign(nClusters * cols.compSize, 0);
+	cols.energy.assign(nClusters * energyDataSize, 0.0);
+	cols.superData.assign(nClusters * superDataSize, 0);
+	for (int k = 0; k < 4; k++) {
+		cols.offsets[k].push_back(0);
+	}
+	for (int id = 0; id < nClusters; id++) {
+		auto& cluster = *clusters[id];
+		int *superData = &cols.superData[id * superDataSize];
+
+		// Super PSI cluster case
+		if (cluster.getType() == ReactantType::PSISuper) {
+			// Save where its coordinates start and how many there are
+			auto& currCluster = static_cast<PSISuperCluster&>(cluster);
+			auto& heVList = currCluster.getCoordList();
+			superData[0] = cols.heVList.size() / 4;
+			superData[1] = heVList.size();
+			for (auto const& coord : heVList) {
+				cols.heVList.push_back(std::get<0>(coord));
+				cols.heVList.push_back(std::get<1>(coord));
+				cols.heVList.push_back(std::get<2>(coord));
+				cols.heVList.push_back(std::get<3>(coord));
+			}
+		}
+		// Super Fe cluster case
+		else if (cluster.getType() == ReactantType::FeSuper) {
+			auto& currCluster = static_cast<FeSuperCluster&>(cluster);
+			auto bounds = currCluster.getBounds();
+			for (int j = 0; j < 4; j++) {
+				superData[j] = bounds[j];
+			}
+		}
+		// Super NE cluster case
+		else if (cluster.getType() == ReactantType::NESuper) {
+			auto& currCluster = static_cast<NESuperCluster&>(cluster);
+			superData[0] = currCluster.getNTot();
+			superData[1] = currCluster.getAverage()
+					+ (double) (currCluster.getNTot() - 1) / 2.0;
+		}
+		// Super Alloy cluster case
+		else if (cluster.getType() == ReactantType::VoidSuper
+				|| cluster.getType() == ReactantType::FrankSuper
+				|| cluster.getType() == ReactantType::PerfectSuper
+				|| cluster.getType() == ReactantType::FaultedSuper) {
+			auto& currCluster = static_cast<AlloySuperCluster&>(cluster);
+			int nTot = currCluster.getSectionWidth();
+			superData[0] = nTot;
+			superData[1] = currCluster.getSize() + (double) (nTot - 1) / 2.0;
+			if (cluster.getType() == ReactantType::VoidSuper)
+				superData[2] = 1;
+			else if (cluster.getType() == ReactantType::FrankSuper)
+				superData[2] = 2;
+			else if (cluster.getType() == ReactantType::PerfectSuper)
+				superData[2] = 3;
+			else if (cluster.getType() == ReactantType::FaultedSuper)
+				superData[2] = 4;
+		}
+		// Normal cluster case
+		else {
+			auto& comp = cluster.getComposition();
+			for (int j = 0; j < cols.compSize; j++) {
+				cols.composition[id * cols.compSize + j] = comp[j];
+			}
+			cols.energy[id * energyDataSize] = cluster.getFormationEnergy();
+			cols.energy[id * energyDataSize + 1] =
+					cluster.getMigrationEnergy();
+			cols.energy[id * energyDataSize + 2] =
+					cluster.getDiffusionFactor();
+		}
+
+		// Append the rows of each kind of reaction
+		std::array<std::vector<std::vector<double> >, 4> reactionRows = { {
+				cluster.getProdVector(), cluster.getCombVector(),
+				cluster.getDissoVector(), cluster.getEmitVector() } };
+		for (int k = 0; k < 4; k++) {
+			auto const& rows = reactionRows[k];
+			cols.widths[k].push_back(rows.empty() ? 0 : rows[0].size());
+			for (auto const& row : rows) {
+				cols.rows[k].insert(cols.rows[k].end(), row.begin(),
+						row.begin() + cols.widths[k][id]);
+			}
+			cols.offsets[k].push_back(cols.rows[k].size());
+		}
+	}
+
+	// Write them
+	writeColumns(cols);
+}
+
+void XFile::NetworkGroup::writeColumns(const Columns& cols) {
+	hsize_t nClusters = cols.widths[0].size();
+
+	// The cluster properties
+	writeDataset(getId(), compositionDataName, H5T_STD_I32LE, H5T_STD_I32LE,
+			{ nClusters, (hsize_t) cols.compSize }, cols.composition.data());
+	writeDataset(getId(), energyDataName, H5T_IEEE_F64LE, H5T_IEEE_F64LE, {
+			nClusters, (hsize_t) energyDataSize }, cols.energy.data());
+	writeDataset(getId(), superDataName, H5T_STD_I32LE, H5T_STD_I32LE, {
+			nClusters, (hsize_t) superDataSize }, cols.superData.data());
+	writeDataset(getId(), heVListDataName, H5T_STD_I32LE, H5T_STD_I32LE, {
+			(hsize_t) cols.heVList.size() / 4, 4 }, cols.heVList.data());
+
+	// The reaction tables
+	for (int k = 0; k < 4; k++) {
+		writeDataset(getId(), reactionDataNames[k] + "Offsets", H5T_STD_U64LE,
+		H5T_NATIVE_HSIZE, { nClusters + 1 }, cols.offsets[k].data());
+		writeDataset(getId(), reactionDataNames[k] + "Widths", H5T_STD_I32LE,
+		H5T_STD_I32LE, { nClusters }, cols.widths[k].data());
+		writeDataset(getId(), reactionDataNames[k], H5T_IEEE_F64LE,
+		H5T_IEEE_F64LE, { (hsize_t) cols.rows[k].size() },
+				cols.rows[k].data());
+	}
+
+	// Add the layout version attribute
+	layoutVersion = columnarLayoutVersion;
+	XFile::ScalarDataSpace scalarDSpace;
+	Attribute<decltype(layoutVersion)> layoutVersionAttr(*this,
+			layoutVersionAttrName, scalarDSpace);
+	layoutVersionAttr.setTo(layoutVersion);
+
+	return;
+}
+
+const XFile::NetworkGroup::Columns& XFile::NetworkGroup::getColumns() const {
+	if (!columns) {
+		std::unique_ptr<Columns> cols(new Columns);
+
+		// The reaction tables
+		for (int k = 0; k < 4; k++) {
+			readDataset(getId(), reactionDataNames[k] + "Offsets",
+			H5T_NATIVE_HSIZE, cols->offsets[k]);
+			readDataset(getId(), reactionDataNames[k] + "Widths",
+			H5T_STD_I32LE, cols->widths[k]);
+			readDataset(getId(), reactionDataNames[k], H5T_IEEE_F64LE,
+					cols->rows[k]);
+		}
+
+		// The cluster properties
+		readDataset(getId(), compositionDataName, H5T_STD_I32LE,
+				cols->composition);
+		readDataset(getId(), energyDataName, H5T_IEEE_F64LE, cols->energy);
+		readDataset(getId(), superDataName, H5T_STD_I32LE, cols->superData);
+		readDataset(getId(), heVListDataName, H5T_STD_I32LE, cols->heVList);
+		int nClusters = cols->widths[0].size();
+		if (nClusters > 0)
+			cols->compSize = cols->composition.size() / nClusters;
+
+		columns = std::move(cols);
+	}
+
+	return *columns;
 }
 
 Array<int, 5> XFile::NetworkGroup::readNetworkSize(int &normalSize,
@@ -290,17 +706,219 @@ Array<int, 5> XFile::NetworkGroup::readNetworkSize(int &normalSize,
 	return list;
 }
 
+XFile::NetworkGroup::clusterComp XFile::NetworkGroup::readCluster(int id,
+		double &formationEnergy, double &migrationEnergy,
+		double &diffusionFactor) const {
+	// Per-cluster layout
+	if (layoutVersion < columnarLayoutVersion) {
+		ClusterGroup clusterGroup(*this, id);
+		return clusterGroup.readCluster(formationEnergy, migrationEnergy,
+				diffusionFactor);
+	}
+
+	auto const& cols = getColumns();
+	formationEnergy = cols.energy[id * energyDataSize];
+	migrationEnergy = cols.energy[id * energyDataSize + 1];
+	diffusionFactor = cols.energy[id * energyDataSize + 2];
+	auto compBegin = cols.composition.begin() + id * cols.compSize;
+
+	return clusterComp(compBegin, compBegin + cols.compSize);
+}
+
+XFile::NetworkGroup::clusterList XFile::NetworkGroup::readPSISuperCluster(
+		int id) const {
+	// Per-cluster layout
+	if (layoutVersion < columnarLayoutVersion) {
+		ClusterGroup clusterGroup(*this, id);
+		return clusterGroup.readPSISuperCluster();
+	}
+
+	auto const& cols = getColumns();
+	int start = cols.superData[id * superDataSize];
+	int nTot = cols.superData[id * superDataSize + 1];
+	clusterList heVList;
+	for (int j = start; j < start + nTot; j++) {
+		heVList.emplace(cols.heVList[4 * j], cols.heVList[4 * j + 1],
+				cols.heVList[4 * j + 2], cols.heVList[4 * j + 3]);
+	}
+
+	return heVList;
+}
+
+Array<int, 4> XFile::NetworkGroup::readFeSuperCluster(int id) const {
+	// Per-cluster layout
+	if (layoutVersion < columnarLayoutVersion) {
+		ClusterGroup clusterGroup(*this, id);
+		return clusterGroup.readFeSuperCluster();
+	}
+
+	auto const& cols = getColumns();
+	Array<int, 4> bounds;
+	for (int j = 0; j < 4; j++) {
+		bounds[j] = cols.superData[id * superDataSize + j];
+	}
+
+	return bounds;
+}
+
+void XFile::NetworkGroup::readNESuperCluster(int id, int &nTot,
+		int &maxXe) const {
+	// Per-cluster layout
+	if (layoutVersion < columnarLayoutVersion) {
+		ClusterGroup clusterGroup(*this, id);
+		clusterGroup.readNESuperCluster(nTot, maxXe);
+		return;
+	}
+
+	auto const& cols = getColumns();
+	nTot = cols.superData[id * superDataSize];
+	maxXe = cols.superData[id * superDataSize + 1];
+
+	return;
+}
+
+void XFile::NetworkGroup::readAlloySuperCluster(int id, int &nTot,
+		int &maxAtom, ReactantType &type) const {
+	// Per-cluster layout
+	if (layoutVersion < columnarLayoutVersion) {
+		ClusterGroup clusterGroup(*this, id);
+		clusterGroup.readAlloySuperCluster(nTot, maxAtom, type);
+		return;
+	}
+
+	auto const& cols = getColumns();
+	nTot = cols.superData[id * superDataSize];
+	maxAtom = cols.superData[id * superDataSize + 1];
+	setAlloyType(cols.superData[id * superDataSize + 2], type);
+
+	return;
+}
+
 void XFile::NetworkGroup::readReactions(IReactionNetwork& network) const {
 	// Loop on the reactants
 	auto& allReactants = network.getAll();
-	std::for_each(allReactants.begin(), allReactants.end(),
-			[&allReactants, &network, this](IReactant& currReactant) {
-				// Open the corresponding group
-				int id = currReactant.getId() - 1;
-				ClusterGroup clusterGroup(*this, id);
-				// Read and set the reactions
-				clusterGroup.readReactions(network, currReactant);
-			});
+
+	// Per-cluster layout
+	if (layoutVersion < columnarLayoutVersion) {
+		std::for_each(allReactants.begin(), allReactants.end(),
+				[&allReactants, &network, this](IReactant& currReactant) {
+					// Open the corresponding group
+					int id = currReactant.getId() - 1;
+					ClusterGroup clusterGroup(*this, id);
+					// Read and set the reactions
+					clusterGroup.readReactions(network, currReactant);
+				});
+
+		return;
+	}
+
+	auto const& cols = getColumns();
+	for (IReactant& currReactant : allReactants) {
+		int id = currReactant.getId() - 1;
+		for (int k = 0; k < 4; k++) {
+			int width = cols.widths[k][id];
+			if (width == 0)
+				continue;
+			auto start = cols.offsets[k][id];
+			int nRows = (cols.offsets[k][id + 1] - start) / width;
+			addReactions(network, currReactant, (ReactionKind) k,
+					cols.rows[k].data() + start, nRows, width);
+		}
+	}
+
+	return;
+}
+
+void XFile::NetworkGroup::convertToColumnar() {
+	// Nothing to do if it is already converted
+	if (layoutVersion >= columnarLayoutVersion)
+		return;
+
+	int normalSize = 0, superSize = 0;
+	readNetworkSize(normalSize, superSize);
+	int nClusters = normalSize + superSize;
+
+	// Get the number of species from the first cluster
+	Columns cols;
+	if (normalSize > 0) {
+		double formationEnergy = 0.0, migrationEnergy = 0.0,
+				diffusionFactor = 0.0;
+		ClusterGroup clusterGroup(*this, 0);
+		cols.compSize = clusterGroup.readCluster(formationEnergy,
+				migrationEnergy, diffusionFactor).size();
+	}
+	cols.composition.assign(nClusters * cols.compSize, 0);
+	cols.energy.assign(nClusters * energyDataSize, 0.0);
+	cols.superData.assign(nClusters * superDataSize, 0);
+	for (int k = 0; k < 4; k++) {
+		cols.offsets[k].push_back(0);
+	}
+
+	// Read each cluster group
+	for (int id = 0; id < nClusters; id++) {
+		ClusterGroup clusterGroup(*this, id);
+		int *superData = &cols.superData[id * superDataSize];
+
+		// Normal cluster case
+		if (id < normalSize) {
+			double *energy = &cols.energy[id * energyDataSize];
+			auto comp = clusterGroup.readCluster(energy[0], energy[1],
+					energy[2]);
+			std::copy(comp.begin(), comp.end(),
+					cols.composition.begin() + id * cols.compSize);
+		}
+		// Super PSI cluster case
+		else if (H5Lexists(clusterGroup.getId(),
+				ClusterGroup::heVListDataName.c_str(), H5P_DEFAULT) > 0) {
+			auto heVList = clusterGroup.readPSISuperCluster();
+			superData[0] = cols.heVList.size() / 4;
+			superData[1] = heVList.size();
+			for (auto const& coord : heVList) {
+				cols.heVList.push_back(std::get<0>(coord));
+				cols.heVList.push_back(std::get<1>(coord));
+				cols.heVList.push_back(std::get<2>(coord));
+				cols.heVList.push_back(std::get<3>(coord));
+			}
+		}
+		// Super Fe cluster case
+		else if (H5Aexists(clusterGroup.getId(),
+				ClusterGroup::boundsAttrName.c_str()) > 0) {
+			auto bounds = clusterGroup.readFeSuperCluster();
+			std::copy(bounds.begin(), bounds.end(), superData);
+		}
+		// Super NE and alloy cluster cases
+		else {
+			Attribute<int> nTotAttr(clusterGroup, ClusterGroup::nTotAttrName);
+			superData[0] = nTotAttr.get();
+			Attribute<int> numAtomAttr(clusterGroup,
+					ClusterGroup::numAtomAttrName);
+			superData[1] = numAtomAttr.get();
+			if (H5Aexists(clusterGroup.getId(),
+					ClusterGroup::typeAttrName.c_str()) > 0) {
+				Attribute<int> typeAttr(clusterGroup,
+						ClusterGroup::typeAttrName);
+				superData[2] = typeAttr.get();
+			}
+		}
+
+		// Append the rows of each kind of reaction
+		for (int k = 0; k < 4; k++) {
+			cols.widths[k].push_back(
+					readClusterRows(clusterGroup.getId(), reactionDataNames[k],
+							cols.rows[k]));
+			cols.offsets[k].push_back(cols.rows[k].size());
+		}
+	}
+
+	// Remove the cluster groups
+	for (int id = 0; id < nClusters; id++) {
+		H5Ldelete(getId(), ClusterGroup::makeGroupName(id).c_str(),
+		H5P_DEFAULT);
+	}
+
+	// Write the columns
+	writeColumns(cols);
+	columns.reset();
 
 	return;
 }
@@ -337,230 +955,6 @@ XFile::ClusterGroup::ClusterGroup(const NetworkGroup& networkGroup, int id) :
 		HDF5File::Group(networkGroup, makeGroupName(id), false) {
 }
 
-XFile::ClusterGroup::ClusterGroup(const NetworkGroup& networkGroup,
-		IReactant& cluster) :
-		HDF5File::Group(networkGroup, makeGroupName(cluster.getId() - 1), true) {
-	// Super PSI cluster case
-	if (cluster.getType() == ReactantType::PSISuper) {
-		// Write the dataset with the coordinate of each contained cluster
-		auto& currCluster = static_cast<PSISuperCluster&>(cluster);
-		int nTot = currCluster.getNTot();
-		int heVArray[nTot][4];
-		auto& heVList = currCluster.getCoordList();
-		int i = 0;
-		for (auto const& pair : heVList) {
-			heVArray[i][0] = std::get<0>(pair);
-			heVArray[i][1] = std::get<1>(pair);
-			heVArray[i][2] = std::get<2>(pair);
-			heVArray[i][3] = std::get<3>(pair);
-			i++;
-		}
-		// Create the dataspace for the dataset with dimension dim
-		std::array<hsize_t, 2> dim { (hsize_t) nTot, (hsize_t) 4 };
-		XFile::SimpleDataSpace<2> listDSpace(dim);
-		hid_t datasetId = H5Dcreate2(getId(), heVListDataName.c_str(),
-		H5T_STD_I32LE, listDSpace.getId(), H5P_DEFAULT, H5P_DEFAULT,
-		H5P_DEFAULT);
-		// Write in the dataset
-		auto status = H5Dwrite(datasetId, H5T_STD_I32LE, H5S_ALL, H5S_ALL,
-		H5P_DEFAULT, &heVArray);
-		// Close the dataset
-		status = H5Dclose(datasetId);
-	}
-	// Super Fe cluster case
-	else if (cluster.getType() == ReactantType::FeSuper) {
-		// Write the bounds
-		auto& currCluster = static_cast<FeSuperCluster&>(cluster);
-		auto bounds = currCluster.getBounds();
-		std::array<hsize_t, 1> dim { 4 };
-		XFile::SimpleDataSpace<1> boundDSpace(dim);
-		hid_t attrId = H5Acreate2(getId(), boundsAttrName.c_str(),
-		H5T_STD_I32LE, boundDSpace.getId(), H5P_DEFAULT, H5P_DEFAULT);
-		auto status = H5Awrite(attrId, H5T_STD_I32LE, &bounds);
-		status = H5Aclose(attrId);
-	}
-	// Super NE cluster case
-	else if (cluster.getType() == ReactantType::NESuper) {
-		auto& currCluster = static_cast<NESuperCluster&>(cluster);
-		// Build a dataspace for our scalar attributes.
-		XFile::ScalarDataSpace scalarDSpace;
-
-		// Add a nTot attribute.
-		int nTot = currCluster.getNTot();
-		Attribute<decltype(nTot)> nTotAttr(*this, nTotAttrName, scalarDSpace);
-		nTotAttr.setTo(nTot);
-		// Add a numAtom attribute.
-		int numAtom = currCluster.getAverage()
-				+ (double) (currCluster.getNTot() - 1) / 2.0;
-		Attribute<decltype(numAtom)> numAtomAttr(*this, numAtomAttrName,
-				scalarDSpace);
-		numAtomAttr.setTo(numAtom);
-	}
-	// Super Alloy cluster case
-	else if (cluster.getType() == ReactantType::VoidSuper
-			|| cluster.getType() == ReactantType::FrankSuper
-			|| cluster.getType() == ReactantType::PerfectSuper
-			|| cluster.getType() == ReactantType::FaultedSuper) {
-		auto& currCluster = static_cast<AlloySuperCluster&>(cluster);
-		// Build a dataspace for our scalar attributes.
-		XFile::ScalarDataSpace scalarDSpace;
-
-		// Add a nTot attribute.
-		int nTot = currCluster.getSectionWidth();
-		Attribute<decltype(nTot)> nTotAttr(*this, nTotAttrName, scalarDSpace);
-		nTotAttr.setTo(nTot);
-		// Add a numAtom attribute.
-		int numAtom = currCluster.getSize() + (double) (nTot - 1) / 2.0;
-		Attribute<decltype(numAtom)> numAtomAttr(*this, numAtomAttrName,
-				scalarDSpace);
-		numAtomAttr.setTo(numAtom);
-		// Add a type attribute.
-		int type = 0;
-		if (cluster.getType() == ReactantType::VoidSuper)
-			type = 1;
-		else if (cluster.getType() == ReactantType::FrankSuper)
-			type = 2;
-		else if (cluster.getType() == ReactantType::PerfectSuper)
-			type = 3;
-		else if (cluster.getType() == ReactantType::FaultedSuper)
-			type = 4;
-		Attribute<decltype(type)> typeAttr(*this, typeAttrName, scalarDSpace);
-		typeAttr.setTo(type);
-	}
-	// Normal cluster case
-	else {
-		// Write the composition attribute
-		auto& comp = cluster.getComposition();
-		std::array<hsize_t, 1> dim { (hsize_t) comp.size() };
-		int compArray[dim[0]];
-		for (int i = 0; i < dim[0]; i++) {
-			compArray[i] = comp[i];
-		}
-		XFile::SimpleDataSpace<1> compDSpace(dim);
-		hid_t attrId = H5Acreate2(getId(), compositionAttrName.c_str(),
-		H5T_STD_I32LE, compDSpace.getId(), H5P_DEFAULT, H5P_DEFAULT);
-		auto status = H5Awrite(attrId, H5T_STD_I32LE, &compArray);
-		status = H5Aclose(attrId);
-
-		// Build a dataspace for our scalar attributes.
-		XFile::ScalarDataSpace scalarDSpace;
-
-		// Add a formationEnergy attribute.
-		double formationEnergy = cluster.getFormationEnergy();
-		Attribute<decltype(formationEnergy)> formationEnergyAttr(*this,
-				formationEnergyAttrName, scalarDSpace);
-		formationEnergyAttr.setTo(formationEnergy);
-		// Add a migrationEnergy attribute.
-		double migrationEnergy = cluster.getMigrationEnergy();
-		Attribute<decltype(migrationEnergy)> migrationEnergyAttr(*this,
-				migrationEnergyAttrName, scalarDSpace);
-		migrationEnergyAttr.setTo(migrationEnergy);
-		// Add a diffusionFactor attribute.
-		double diffusionFactor = cluster.getDiffusionFactor();
-		Attribute<decltype(diffusionFactor)> diffusionFactorAttr(*this,
-				diffusionFactorAttrName, scalarDSpace);
-		diffusionFactorAttr.setTo(diffusionFactor);
-	}
-
-	// Write a dataset of production reactions
-	auto prodVec = cluster.getProdVector();
-	if (prodVec.size() > 0) {
-		int nReact = prodVec.size();
-		int dataSize = prodVec[0].size();
-		double prodArray[nReact][dataSize];
-		for (int i = 0; i < nReact; i++) {
-			for (int j = 0; j < dataSize; j++) {
-				prodArray[i][j] = prodVec[i][j];
-			}
-		}
-		// Create the dataspace for the dataset with dimension dims
-		std::array<hsize_t, 2> dims { (hsize_t) nReact, (hsize_t) dataSize };
-		XFile::SimpleDataSpace<2> prodDSpace(dims);
-		hid_t datasetId = H5Dcreate2(getId(), productionDataName.c_str(),
-		H5T_IEEE_F64LE, prodDSpace.getId(), H5P_DEFAULT, H5P_DEFAULT,
-		H5P_DEFAULT);
-		// Write in the dataset
-		auto status = H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
-		H5P_DEFAULT, &prodArray);
-		// Close the dataset
-		status = H5Dclose(datasetId);
-	}
-
-	// Write a dataset of combination reactions
-	auto combVec = cluster.getCombVector();
-	if (combVec.size() > 0) {
-		int nReact = combVec.size();
-		int dataSize = combVec[0].size();
-		double combArray[nReact][dataSize];
-		for (int i = 0; i < nReact; i++) {
-			for (int j = 0; j < dataSize; j++) {
-				combArray[i][j] = combVec[i][j];
-			}
-		}
-		// Create the dataspace for the dataset with dimension dims
-		std::array<hsize_t, 2> dims { (hsize_t) nReact, (hsize_t) dataSize };
-		XFile::SimpleDataSpace<2> combDSpace(dims);
-		hid_t datasetId = H5Dcreate2(getId(), combinationDataName.c_str(),
-		H5T_IEEE_F64LE, combDSpace.getId(), H5P_DEFAULT, H5P_DEFAULT,
-		H5P_DEFAULT);
-		// Write in the dataset
-		auto status = H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
-		H5P_DEFAULT, &combArray);
-		// Close the dataset
-		status = H5Dclose(datasetId);
-	}
-
-	// Write a dataset of dissociation reactions
-	auto dissoVec = cluster.getDissoVector();
-	if (dissoVec.size() > 0) {
-		int nReact = dissoVec.size();
-		int dataSize = dissoVec[0].size();
-		double dissoArray[nReact][dataSize];
-		for (int i = 0; i < nReact; i++) {
-			for (int j = 0; j < dataSize; j++) {
-				dissoArray[i][j] = dissoVec[i][j];
-			}
-		}
-		// Create the dataspace for the dataset with dimension dims
-		std::array<hsize_t, 2> dims { (hsize_t) nReact, (hsize_t) dataSize };
-		XFile::SimpleDataSpace<2> dissoDSpace(dims);
-		hid_t datasetId = H5Dcreate2(getId(), dissociationDataName.c_str(),
-		H5T_IEEE_F64LE, dissoDSpace.getId(), H5P_DEFAULT, H5P_DEFAULT,
-		H5P_DEFAULT);
-		// Write in the dataset
-		auto status = H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
-		H5P_DEFAULT, &dissoArray);
-		// Close the dataset
-		status = H5Dclose(datasetId);
-	}
-
-	// Write a dataset of emission reactions
-	auto emitVec = cluster.getEmitVector();
-	if (emitVec.size() > 0) {
-		int nReact = emitVec.size();
-		int dataSize = emitVec[0].size();
-		double emitArray[nReact][dataSize];
-		for (int i = 0; i < nReact; i++) {
-			for (int j = 0; j < dataSize; j++) {
-				emitArray[i][j] = emitVec[i][j];
-			}
-		}
-		// Create the dataspace for the dataset with dimension dims
-		std::array<hsize_t, 2> dims { (hsize_t) nReact, (hsize_t) dataSize };
-		XFile::SimpleDataSpace<2> emitDSpace(dims);
-		hid_t datasetId = H5Dcreate2(getId(), emissionDataName.c_str(),
-		H5T_IEEE_F64LE, emitDSpace.getId(), H5P_DEFAULT, H5P_DEFAULT,
-		H5P_DEFAULT);
-		// Write in the dataset
-		auto status = H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
-		H5P_DEFAULT, &emitArray);
-		// Close the dataset
-		status = H5Dclose(datasetId);
-	}
-
-	return;
-}
-
 std::string XFile::ClusterGroup::makeGroupName(int id) {
 	std::ostringstream namestr;
 	namestr << id;
@@ -659,159 +1053,26 @@ void XFile::ClusterGroup::readAlloySuperCluster(int &nTot, int &maxAtom,
 	Attribute<int> typeAttr(*this, typeAttrName);
 	int typeIndex = typeAttr.get();
 
-	switch (typeIndex) {
-	case 1:
-		type = ReactantType::Void;
-		break;
-	case 2:
-		type = ReactantType::Frank;
-		break;
-	case 3:
-		type = ReactantType::Perfect;
-		break;
-	case 4:
-		type = ReactantType::Faulted;
-		break;
-	default:
-		std::cout << "Type not recognized for alloy super cluster: "
-				<< typeIndex << std::endl;
-		break;
-	}
+	setAlloyType(typeIndex, type);
 
 	return;
 }
 
 void XFile::ClusterGroup::readReactions(IReactionNetwork& network,
 		IReactant &cluster) const {
-	// Get all the reactants
-	auto& allReactants = network.getAll();
-
-	// Read the production dataset
-	bool datasetExist = H5Lexists(getId(), productionDataName.c_str(),
-	H5P_DEFAULT);
-	if (datasetExist) {
-		hid_t datasetId = H5Dopen(getId(), productionDataName.c_str(),
-		H5P_DEFAULT);
-		hid_t dataspaceId = H5Dget_space(datasetId);
-		std::array<hsize_t, 2> dims;
-		herr_t status = H5Sget_simple_extent_dims(dataspaceId, dims.data(),
-		NULL);
-		double prodVec[dims[0]][dims[1]];
-		status = H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
-		H5P_DEFAULT, &prodVec);
-		status = H5Dclose(datasetId);
-		// Loop on the prod vector
-		for (int i = 0; i < dims[0]; i++) {
-			// Get pointers to the 2 reactants
-			auto& firstReactant = allReactants.at(prodVec[i][0]);
-			auto& secondReactant = allReactants.at(prodVec[i][1]);
-
-			// Create and add the reaction to the network
-			std::unique_ptr<ProductionReaction> reaction(
-					new ProductionReaction(firstReactant, secondReactant));
-			auto& prref = network.add(std::move(reaction));
-
-			// Add the reaction to the cluster
-			cluster.resultFrom(prref, &(prodVec[i][2]));
-		}
-	}
-
-	// Read the combination dataset
-	datasetExist = H5Lexists(getId(), combinationDataName.c_str(),
-	H5P_DEFAULT);
-	if (datasetExist) {
-		hid_t datasetId = H5Dopen(getId(), combinationDataName.c_str(),
-		H5P_DEFAULT);
-		hid_t dataspaceId = H5Dget_space(datasetId);
-		std::array<hsize_t, 2> dims;
-		herr_t status = H5Sget_simple_extent_dims(dataspaceId, dims.data(),
-		NULL);
-		double combVec[dims[0]][dims[1]];
-		status = H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
-		H5P_DEFAULT, &combVec);
-		status = H5Dclose(datasetId);
-		// Loop on the prod vector
-		for (int i = 0; i < dims[0]; i++) {
-			// Get pointers to the combining reactant
-			auto& firstReactant = allReactants.at(combVec[i][0]);
-
-			// Create and add the reaction to the network
-			std::unique_ptr<ProductionReaction> reaction(
-					new ProductionReaction(firstReactant, cluster));
-			auto& prref = network.add(std::move(reaction));
-
-			// Add the reaction to the cluster
-			cluster.participateIn(prref, &(combVec[i][1]));
+	// Read each reaction dataset and create its reactions
+	std::array<std::string, 4> names = { { productionDataName,
+			combinationDataName, dissociationDataName, emissionDataName } };
+	for (int k = 0; k < 4; k++) {
+		std::vector<double> rows;
+		int width = readClusterRows(getId(), names[k], rows);
+		if (width > 0) {
+			addReactions(network, cluster, (ReactionKind) k, rows.data(),
+					rows.size() / width, width);
 		}
 	}
 
-	// Read the dissociation dataset
-	datasetExist = H5Lexists(getId(), dissociationDataName.c_str(),
-	H5P_DEFAULT);
-	if (datasetExist) {
-		hid_t datasetId = H5Dopen(getId(), dissociationDataName.c_str(),
-		H5P_DEFAULT);
-		hid_t dataspaceId = H5Dget_space(datasetId);
-		std::array<hsize_t, 2> dims;
-		herr_t status = H5Sget_simple_extent_dims(dataspaceId, dims.data(),
-		NULL);
-		double dissoVec[dims[0]][dims[1]];
-		status = H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
-		H5P_DEFAULT, &dissoVec);
-		status = H5Dclose(datasetId);
-		// Loop on the prod vector
-		for (int i = 0; i < dims[0]; i++) {
-			// Get pointers to the other reactants
-			auto& emittingReactant = allReactants.at(dissoVec[i][0]);
-			auto& secondReactant = allReactants.at(dissoVec[i][1]);
-
-			// Create and add the reaction to the network
-			std::unique_ptr<ProductionReaction> reaction(
-					new ProductionReaction(cluster, secondReactant));
-			auto& prref = network.add(std::move(reaction));
-			std::unique_ptr<DissociationReaction> dissociationReaction(
-					new DissociationReaction(emittingReactant, prref.first,
-							prref.second, &prref));
-			auto& drref = network.add(std::move(dissociationReaction));
-
-			// Add the reaction to the cluster
-			cluster.participateIn(drref, &(dissoVec[i][2]));
-		}
-	}
-
-	// Read the emission dataset
-	datasetExist = H5Lexists(getId(), emissionDataName.c_str(),
-	H5P_DEFAULT);
-	if (datasetExist) {
-		hid_t datasetId = H5Dopen(getId(), emissionDataName.c_str(),
-		H5P_DEFAULT);
-		hid_t dataspaceId = H5Dget_space(datasetId);
-		std::array<hsize_t, 2> dims;
-		herr_t status = H5Sget_simple_extent_dims(dataspaceId, dims.data(),
-		NULL);
-		double emitVec[dims[0]][dims[1]];
-		status = H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
-		H5P_DEFAULT, &emitVec);
-		status = H5Dclose(datasetId);
-		// Loop on the prod vector
-		for (int i = 0; i < dims[0]; i++) {
-			// Get pointers to the other reactants
-			auto& firstReactant = allReactants.at(emitVec[i][0]);
-			auto& secondReactant = allReactants.at(emitVec[i][1]);
-
-			// Create and add the reaction to the network
-			std::unique_ptr<ProductionReaction> reaction(
-					new ProductionReaction(firstReactant, secondReactant));
-			auto& prref = network.add(std::move(reaction));
-			std::unique_ptr<DissociationReaction> dissociationReaction(
-					new DissociationReaction(cluster, prref.first, prref.second,
-							&prref));
-			auto& drref = network.add(std::move(dissociationReaction));
-
-			// Add the reaction to the cluster
-			cluster.emitFrom(drref, &(emitVec[i][2]));
-		}
-	}
+	return;
 }
 
 //----------------------------------------------------------------------------
@@ -917,6 +1178,12 @@ const std::string XFile::TimestepGroup::prevIBulkFluxAttrName =
 		"previousIBulkFlux";
 
 const std::string XFile::TimestepGroup::concDatasetName = "concs";
+const std::string XFile::TimestepGroup::concIndicesDatasetName = "concIndices";
+const std::string XFile::TimestepGroup::concValuesDatasetName = "concValues";
+const std::string XFile::TimestepGroup::concToleranceAttrName =
+		"concTolerance";
+const uint32_t XFile::TimestepGroup::concReadChunkSize = 1 << 20;
+const std::string XFile::TimestepGroup::baseTimeStepAttrName = "baseTimeStep";
 
 std::string XFile::TimestepGroup::makeGroupName(
 		const XFile::ConcentrationGroup& concGroup, int timeStep) {
@@ -1265,12 +1532,176 @@ void XFile::TimestepGroup::writeConcentrations(const XFile& file, int baseX,
 	// defines the dataset *and* writes the given data.
 }
 
+void XFile::TimestepGroup::writeCompressedConcentrations(const XFile& file,
+		int baseX, const Concs1DType& raggedConcs, double tolerance,
+		int compressionLevel) const {
+
+	// Split the indices from the values
+	RaggedDataSet2D<int>::Ragged2DType indices(raggedConcs.size());
+	RaggedDataSet2D<double>::Ragged2DType values(raggedConcs.size());
+	int nBits = mantissaBits(tolerance);
+	for (int i = 0; i < raggedConcs.size(); ++i) {
+		indices[i].reserve(raggedConcs[i].size());
+		values[i].reserve(raggedConcs[i].size());
+		int previousIndex = 0;
+		for (auto const& conc : raggedConcs[i]) {
+			// The indices are increasing, their differences are small
+			indices[i].push_back(conc.first - previousIndex);
+			previousIndex = conc.first;
+			values[i].push_back(roundMantissa(conc.second, nBits));
+		}
+	}
+
+	// Create and write the ragged datasets.
+	RaggedDataSet2D<int> indicesDataset(file.getComm(), *this,
+			concIndicesDatasetName, baseX, indices, compressionLevel);
+	RaggedDataSet2D<double> valuesDataset(file.getComm(), *this,
+			concValuesDatasetName, baseX, values, compressionLevel);
+
+	// Keep the tolerance with them
+	XFile::ScalarDataSpace scalarDSpace;
+	Attribute<double> toleranceAttr(*this, concToleranceAttrName,
+			scalarDSpace);
+	toleranceAttr.setTo(tolerance);
+}
+
 XFile::TimestepGroup::Concs1DType XFile::TimestepGroup::readConcentrations(
 		const XFile& file, int baseX, int numX) const {
 
-	// Open and read the ragged dataset.
+	// Build the ragged representation from the streamed concentrations.
+	Concs1DType ret(numX);
+	readConcentrations(file, baseX, numX,
+			[&ret, baseX](int x, int index, double value) {
+				ret[x - baseX].emplace_back(index, value);
+			});
+	return ret;
+}
+
+void XFile::TimestepGroup::readConcentrations(const XFile& file, int baseX,
+		int numX, const ConcSetter& setter, uint32_t chunkSize) const {
+
+	// An incremental timestep only has the grid points that changed
+	// since its full timestep, read the other ones from there.
+	int baseTimeStep = readBaseTimeStep();
+	if (baseTimeStep >= 0) {
+		ConcentrationGroup concGroup(file);
+		auto baseGroup = concGroup.getTimestepGroup(baseTimeStep);
+		if (not baseGroup) {
+			std::ostringstream estr;
+			estr << "Unable to open the full timestep " << baseTimeStep
+					<< " of the incremental timestep " << getName();
+			throw HDF5Exception(estr.str());
+		}
+
+		auto startingIndices = readConcStartingIndices(file, baseX, numX);
+		baseGroup->streamConcentrations(file, baseX, numX,
+				[&setter, &startingIndices, baseX](int x, int index,
+						double value) {
+					int i = x - baseX;
+					if (startingIndices[i + 1] == startingIndices[i])
+						setter(x, index, value);
+				}, chunkSize);
+	}
+
+	streamConcentrations(file, baseX, numX, setter, chunkSize);
+
+	return;
+}
+
+std::vector<uint32_t> XFile::TimestepGroup::readConcStartingIndices(
+		const XFile& file, int baseX, int numX) const {
+
+	if (H5Lexists(getId(), concIndicesDatasetName.c_str(), H5P_DEFAULT) > 0) {
+		RaggedDataSet2D<int> dataset(file.getComm(), *this,
+				concIndicesDatasetName);
+		return dataset.readStartingIndices(baseX, numX);
+	}
+
 	RaggedDataSet2D<ConcType> dataset(file.getComm(), *this, concDatasetName);
-	return dataset.read(baseX, numX);
+	return dataset.readStartingIndices(baseX, numX);
+}
+
+void XFile::TimestepGroup::streamConcentrations(const XFile& file, int baseX,
+		int numX, const ConcSetter& setter, uint32_t chunkSize) const {
+
+	// Open the datasets of the format that was written.
+	std::unique_ptr<RaggedDataSet2D<ConcType> > dataset;
+	std::unique_ptr<RaggedDataSet2D<int> > indicesDataset;
+	std::unique_ptr<RaggedDataSet2D<double> > valuesDataset;
+	std::vector<uint32_t> startingIndices;
+	if (H5Lexists(getId(), concIndicesDatasetName.c_str(), H5P_DEFAULT) > 0) {
+		indicesDataset.reset(
+				new RaggedDataSet2D<int>(file.getComm(), *this,
+						concIndicesDatasetName));
+		valuesDataset.reset(
+				new RaggedDataSet2D<double>(file.getComm(), *this,
+						concValuesDatasetName));
+		startingIndices = indicesDataset->readStartingIndices(baseX, numX);
+	} else {
+		dataset.reset(
+				new RaggedDataSet2D<ConcType>(file.getComm(), *this,
+						concDatasetName));
+		startingIndices = dataset->readStartingIndices(baseX, numX);
+	}
+
+	// The reads are collective so every process does as many as the
+	// process with the most concentrations.
+	const uint32_t myBaseIdx = startingIndices.front();
+	const uint32_t myNumItems = startingIndices.back() - myBaseIdx;
+	chunkSize = std::max(chunkSize, (uint32_t) 1);
+	uint32_t myNumChunks = (myNumItems + chunkSize - 1) / chunkSize;
+	uint32_t numChunks = 0;
+	MPI_Allreduce(&myNumChunks, &numChunks, 1, MPI_UNSIGNED, MPI_MAX,
+			file.getComm());
+
+	// The buffers for one chunk
+	const uint32_t bufferSize = std::max(std::min(chunkSize, myNumItems),
+			(uint32_t) 1);
+	std::vector<ConcType> concBuffer;
+	std::vector<int> indexBuffer;
+	std::vector<double> valueBuffer;
+	if (dataset) {
+		concBuffer.resize(bufferSize);
+	} else {
+		indexBuffer.resize(bufferSize);
+		valueBuffer.resize(bufferSize);
+	}
+
+	// Read the chunks and pass the concentrations along
+	int point = 0;
+	int index = 0;
+	for (uint32_t chunk = 0; chunk < numChunks; ++chunk) {
+		uint32_t first = std::min(chunk * chunkSize, myNumItems);
+		uint32_t count = std::min(chunkSize, myNumItems - first);
+		if (dataset) {
+			dataset->readItems(myBaseIdx + first, count, concBuffer.data());
+		} else {
+			indicesDataset->readItems(myBaseIdx + first, count,
+					indexBuffer.data());
+			valuesDataset->readItems(myBaseIdx + first, count,
+					valueBuffer.data());
+		}
+
+		for (uint32_t n = 0; n < count; ++n) {
+			// Find the grid point of the item, the delta encoding of the
+			// indices restarts at each one
+			uint32_t item = myBaseIdx + first + n;
+			while (item >= startingIndices[point + 1]) {
+				++point;
+				index = 0;
+			}
+
+			if (dataset) {
+				setter(baseX + point, concBuffer[n].first,
+						concBuffer[n].second);
+			} else {
+				index += indexBuffer[n];
+				setter(baseX + point, index, valueBuffer[n]);
+			}
+		}
+	}
+
+	return;
 }
 
 std::pair<double, double> XFile::TimestepGroup::readTimes(void) const {
@@ -1283,6 +1714,25 @@ std::pair<double, double> XFile::TimestepGroup::readTimes(void) const {
 	return std::make_pair(absTimeAttr.get(), deltaTimeAttr.get());
 }
 
+void XFile::TimestepGroup::writeBaseTimeStep(int baseTimeStep) const {
+
+	// Add the attribute
+	XFile::ScalarDataSpace scalarDSpace;
+	Attribute<int> baseTimeStepAttr(*this, baseTimeStepAttrName,
+			scalarDSpace);
+	baseTimeStepAttr.setTo(baseTimeStep);
+}
+
+int XFile::TimestepGroup::readBaseTimeStep(void) const {
+
+	// The full timesteps do not have the attribute
+	if (H5Aexists(getId(), baseTimeStepAttrName.c_str()) <= 0)
+		return -1;
+
+	Attribute<int> baseTimeStepAttr(*this, baseTimeStepAttrName);
+	return baseTimeStepAttr.get();
+}
+
 double XFile::TimestepGroup::readPreviousTime(void) const {
 
 	// Open and read the previousTime attribute
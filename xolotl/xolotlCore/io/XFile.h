@@ -3,8 +3,11 @@
 
 #include <string>
 #include <vector>
+#include <array>
+#include <memory>
 #include <tuple>
 #include <set>
+#include <functional>
 #include "xolotlCore/io/HDF5File.h"
 #include "xolotlCore/io/HDF5Exception.h"
 #include <IReactionNetwork.h>
@@ -64,6 +67,21 @@ public:
 		// Name of the concentrations data set.
 		static const std::string concDatasetName;
 
+		// Names of the data sets of the compressed concentrations.
+		static const std::string concIndicesDatasetName;
+		static const std::string concValuesDatasetName;
+
+		// Name of the relative tolerance attribute of the compressed
+		// concentrations.
+		static const std::string concToleranceAttrName;
+
+		// Default number of concentrations read at once on restart.
+		static const uint32_t concReadChunkSize;
+
+		// Name of the attribute giving the full timestep an incremental
+		// timestep is based on.
+		static const std::string baseTimeStepAttrName;
+
 		/**
 		 * Construct the group name for the given time step.
 		 *
@@ -93,6 +111,31 @@ public:
 		using ConcType = std::pair<int, double>;
 		using Concs1DType = HDF5File::RaggedDataSet2D<ConcType>::Ragged2DType;
 
+		// Concise name for the function receiving the concentrations
+		// read on restart: grid point, index, value.
+		using ConcSetter = std::function<void(int, int, double)>;
+
+	private:
+		/**
+		 * Read the starting indices of the concentrations of our grid
+		 * points, in either format, plus the one past the last.
+		 *
+		 * @param file The HDF5 file that owns our group.
+		 * @param baseX Index of first grid point we own.
+		 * @param numX Number of grid points we own.
+		 * @return The starting indices.
+		 */
+		std::vector<uint32_t> readConcStartingIndices(const XFile& file,
+				int baseX, int numX) const;
+
+		/**
+		 * Stream the concentrations written in this group only, see
+		 * readConcentrations.
+		 */
+		void streamConcentrations(const XFile& file, int baseX, int numX,
+				const ConcSetter& setter, uint32_t chunkSize) const;
+
+	public:
 		/**
 		 * Construct a TimestepGroup.
 		 * Default and copy constructors explicitly disallowed.
@@ -220,7 +263,27 @@ public:
 				const Concs1DType& concs) const;
 
 		/**
-		 * Read concentration dataset for our grid points in a 1D problem.
+		 * Add the concentration datasets for all grid points in a 1D
+		 * problem, in the compressed format. The indices are delta encoded
+		 * within each grid point and the values are rounded to the given
+		 * relative tolerance. They are written in two chunked ragged
+		 * datasets that go through the shuffle and deflate filters.
+		 *
+		 * @param file The HDF5 file that owns our group.  Needed to support
+		 *              parallel file access.
+		 * @param baseX Index of first grid point we own.
+		 * @param concs Concentrations associated with grid points we own.
+		 * @param tolerance The relative tolerance on the values, 0.0 to
+		 *              keep them exact.
+		 * @param compressionLevel The deflate level, from 1 to 9.
+		 */
+		void writeCompressedConcentrations(const XFile& file, int baseX,
+				const Concs1DType& concs, double tolerance = 0.0,
+				int compressionLevel = 6) const;
+
+		/**
+		 * Read concentration dataset for our grid points in a 1D problem,
+		 * in either format.
 		 * Assumes that grid point slabs are assigned to processes in
 		 * MPI rank order.
 		 *
@@ -235,6 +298,44 @@ public:
 		Concs1DType readConcentrations(const XFile& file, int baseX,
 				int numX) const;
 
+		/**
+		 * Stream the concentrations of our grid points in a 1D problem,
+		 * in either format, to the given function without building the
+		 * ragged representation. They are read in chunks of bounded size
+		 * with collective reads. If this is an incremental timestep, the
+		 * grid points it does not contain are read from its full timestep.
+		 * Assumes that grid point slabs are assigned to processes in
+		 * MPI rank order.
+		 *
+		 * @param file The HDF5 file that owns our group.  Needed to support
+		 *              parallel file access.
+		 * @param baseX Index of first grid point we own.
+		 * @param numX Number of grid points we own.
+		 * @param setter The function called for each concentration with
+		 *              the grid point (from baseX), the index, and the value.
+		 * @param chunkSize The maximum number of concentrations read at once.
+		 */
+		void readConcentrations(const XFile& file, int baseX, int numX,
+				const ConcSetter& setter, uint32_t chunkSize =
+						concReadChunkSize) const;
+
+		/**
+		 * Make this timestep an incremental one: the grid points for which
+		 * no concentration is written are the ones of the given full
+		 * timestep. Since the temperature is always written, a grid point
+		 * cannot be empty otherwise.
+		 *
+		 * @param baseTimeStep The full timestep this one is based on.
+		 */
+		void writeBaseTimeStep(int baseTimeStep) const;
+
+		/**
+		 * Read the full timestep an incremental timestep is based on.
+		 *
+		 * @return The full timestep, -1 if this one is a full timestep.
+		 */
+		int readBaseTimeStep(void) const;
+
 		/**
 		 * Read the times from our timestep group.
 		 *
@@ -452,12 +553,85 @@ public:
 	};
 
 	// A group describing a network within our HDF5 file.
+	//
+	// Two layouts are supported. In the original one (version 1) every
+	// cluster has its own ClusterGroup with its properties as attributes and
+	// its reactions in small datasets. In the columnar one (version 2) the
+	// properties of all the clusters are stored in a few large datasets, one
+	// row per cluster, and the reactions in CSR-like tables: a flat array of
+	// all the reaction rows of a given kind, the offset in it of the rows of
+	// each cluster, and the row width of each cluster.
 	class NetworkGroup: public HDF5File::Group {
+	public:
+		// Concise name for cluster representations.
+		using clusterComp = std::vector<int>;
+		using clusterList = std::set<std::tuple<int, int, int, int> >;
+
+		// The version of the columnar layout.
+		static const int columnarLayoutVersion = 2;
+
 	private:
 		// Names of network attributes.
 		static const std::string normalSizeAttrName;
 		static const std::string superSizeAttrName;
 		static const std::string phaseSpaceAttrName;
+		static const std::string layoutVersionAttrName;
+
+		// Names of the datasets of the columnar layout.
+		static const std::string compositionDataName;
+		static const std::string energyDataName;
+		static const std::string superDataName;
+		static const std::string heVListDataName;
+		static const std::array<std::string, 4> reactionDataNames;
+
+		// Number of values per cluster in the energy and super datasets.
+		static const int energyDataSize = 3;
+		static const int superDataSize = 4;
+
+		// The content of the columnar layout.
+		struct Columns {
+			// Number of species in the compositions.
+			int compSize = 0;
+			// The compositions, compSize per cluster.
+			std::vector<int> composition;
+			// The formation and migration energies and the diffusion
+			// factor, energyDataSize per cluster.
+			std::vector<double> energy;
+			// The super cluster data, superDataSize per cluster: the start and
+			// size of the PSI super cluster in the heVList, the Fe bounds,
+			// or the NE and alloy nTot, numAtom and type.
+			std::vector<int> superData;
+			// The coordinates of the clusters in the PSI super clusters.
+			std::vector<int> heVList;
+			// For each kind of reaction (production, combination,
+			// dissociation, emission), the offset of the rows of each
+			// cluster (one more than the number of clusters), the row width
+			// of each cluster, and the rows.
+			std::array<std::vector<hsize_t>, 4> offsets;
+			std::array<std::vector<int>, 4> widths;
+			std::array<std::vector<double>, 4> rows;
+		};
+
+		// The layout version of the group.
+		int layoutVersion;
+
+		// The columns, read from the file the first time they are needed.
+		mutable std::unique_ptr<Columns> columns;
+
+		/**
+		 * Get the columns, reading them from the file if needed with
+		 * collective reads.
+		 *
+		 * @return The columns.
+		 */
+		const Columns& getColumns() const;
+
+		/**
+		 * Write the columns in our group and set the layout version.
+		 *
+		 * @param cols The columns to write.
+		 */
+		void writeColumns(const Columns& cols);
 
 	public:
 
@@ -491,6 +665,64 @@ public:
 		 */
 		Array<int, 5> readNetworkSize(int &normalSize, int &superSize) const;
 
+		/**
+		 * Get the layout version of our group.
+		 *
+		 * @return 1 for the per-cluster layout, columnarLayoutVersion for
+		 * the columnar one.
+		 */
+		int getLayoutVersion() const {
+			return layoutVersion;
+		}
+
+		/**
+		 * Read the properties of a normal cluster.
+		 *
+		 * @param id The id of the cluster.
+		 * @param formationEnergy The formation energy.
+		 * @param migrationEnergy The migration energy.
+		 * @param diffusionFactor The diffusion factor.
+		 * @return The cluster composition.
+		 */
+		clusterComp readCluster(int id, double &formationEnergy,
+				double &migrationEnergy, double &diffusionFactor) const;
+
+		/**
+		 * Read the properties of a PSI super cluster.
+		 *
+		 * @param id The id of the cluster.
+		 * @return The list of clusters that it contains.
+		 */
+		clusterList readPSISuperCluster(int id) const;
+
+		/**
+		 * Read the properties of a Fe super cluster.
+		 *
+		 * @param id The id of the cluster.
+		 * @return The bounds on the clusters that it contains.
+		 */
+		Array<int, 4> readFeSuperCluster(int id) const;
+
+		/**
+		 * Read the properties of a NE super cluster.
+		 *
+		 * @param id The id of the cluster.
+		 * @param nTot The total number of clusters it contains.
+		 * @param maxXe The maximum value
+		 */
+		void readNESuperCluster(int id, int &nTot, int &maxXe) const;
+
+		/**
+		 * Read the properties of an alloy super cluster.
+		 *
+		 * @param id The id of the cluster.
+		 * @param nTot The total number of clusters it contains.
+		 * @param maxAtom The maximum value
+		 * @param type The type of cluster
+		 */
+		void readAlloySuperCluster(int id, int &nTot, int &maxAtom,
+				ReactantType &type) const;
+
 		/**
 		 * Read the reactions for every cluster.
 		 *
@@ -498,6 +730,14 @@ public:
 		 */
 		void readReactions(IReactionNetwork& network) const;
 
+		/**
+		 * Convert our group from the per-cluster layout to the columnar
+		 * one. The cluster groups are removed, the file needs to be
+		 * repacked (h5repack) to reclaim their space.
+		 * Nothing is done if the group already uses the columnar layout.
+		 */
+		void convertToColumnar();
+
 		/**
 		 * Copy ourself to the given file.
 		 * A NetworkGroup must not already exist in the file.
@@ -507,8 +747,12 @@ public:
 		void copyTo(const XFile& target) const;
 	};
 
-	// A group describing a cluster within our HDF5 file.
+	// A group describing a cluster within our HDF5 file, in the per-cluster
+	// layout. It is only read, to load and convert the older files.
 	class ClusterGroup: public HDF5File::Group {
+		// The network group reads our data directly to convert it.
+		friend class NetworkGroup;
+
 	public:
 		// Concise name for cluster representations.
 		using clusterComp = std::vector<int>;
@@ -543,14 +787,6 @@ public:
 		 */
 		ClusterGroup(const NetworkGroup& networkGroup, int id);
 
-		/**
-		 * Create a cluster group.
-		 *
-		 * @param networkGroup The group in which to write.
-		 * @param cluster The cluster.
-		 */
-		ClusterGroup(const NetworkGroup& networkGroup, IReactant& cluster);
-
 		/**
 		 * Construct the group name for the given time step.
 		 *
@@ -652,6 +888,18 @@ public:
 					0.0,
 			AccessMode mode = AccessMode::CreateOrTruncateIfExists);
 
+	/**
+	 * Create a file containing only a network group.
+	 *
+	 * @param path Path of file to create.
+	 * @param network The network to write.
+	 * @param _comm The MPI communicator used to access the file.
+	 * @param mode Access mode for file.  Only HDF5File Create* modes
+	 *              are supported.
+	 */
+	XFile(fs::path path, IReactionNetwork& network, MPI_Comm _comm,
+			AccessMode mode = AccessMode::CreateOrTruncateIfExists);
+
 	/**
 	 * Open an existing checkpoint or network file.
 	 *
@@ -26,10 +26,6 @@ void TrapMutationHandler::initialize(const IReactionNetwork& network, int nx,
 	// there is no trap-mutation
 	if (!singleInterstitial || !doubleInterstitial || !tripleInterstitial
 			|| knownType.find(ReactantType::He) == knownType.end()) {
-		// Clear the vector of HeV indices created by He undergoing trap-mutation
-		// at each grid point
-		tmBubbles.clear();
-
 		// Change the value of ny and nz in 1D and 2D so that the same loop
 		// works in every case
 		if (nz == 0)
@@ -37,34 +33,13 @@ void TrapMutationHandler::initialize(const IReactionNetwork& network, int nx,
 		if (ny == 0)
 			ny = 1;
 
-		// Loop on the grid points in the Z direction
-		// TODO even with the reserve ops, this might involve lots of
-		// separate memory allocations.
-		tmBubbles.reserve(nz);
-		for (int k = 0; k < nz; k++) {
-			// Create the temporary 2D vector
-			ReactantRefVector2D temp2DVector;
-
-			// Loop on the grid points in the Y direction
-			temp2DVector.reserve(ny);
-			for (int j = 0; j < ny; j++) {
-				// Create the temporary 1D vector
-				ReactantRefVector1D temp1DVector;
-
-				// Loop on the grid points in the depth direction
-				temp1DVector.reserve(nx);
-				for (int i = 0; i < nx; i++) {
-					// Indicate no bubbles at this grid point.
-					temp1DVector.emplace_back();
-				}
-
-				// Give the 1D vector to the 2D vector
-				temp2DVector.emplace_back(temp1DVector);
-			}
+		// No trap-mutation at any grid point
+		depthRecords.clear();
+		sigma3Records.clear();
+		sigma3DistanceVec.clear();
+		clearRecords(nx, ny, nz);
+		tmOffsets.resize(nx * ny * nz + 1, 0);
 
-			// Give the 2D vector to the final vector
-			tmBubbles.emplace_back(temp2DVector);
-		}
 		// Inform the user
 		int procId;
 		MPI_Comm_rank(MPI_COMM_WORLD, &procId);
@@ -119,6 +94,22 @@ void TrapMutationHandler::initialize(const IReactionNetwork& network, int nx,
 	// trap-mutates. Information about desorption is also initialized here.
 	initializeDepthSize(network.getTemperature());
 
+	// Find the bubbles of each depth once
+	depthRecords.clear();
+	for (int l = 0; l < depthVec.size(); l++) {
+		depthRecords.push_back(findRecords(network, l + 1, sizeVec[l]));
+	}
+
+	// Same near the grain boundaries, with a Sigma 3 trap mutation handler
+	// because it is the only one available right now
+	Sigma3TrapMutationHandler sigma3Handler;
+	sigma3DistanceVec = sigma3Handler.getDistanceVector();
+	auto sigma3SizeVec = sigma3Handler.getSizeVector();
+	sigma3Records.clear();
+	for (int l = 0; l < sigma3SizeVec.size(); l++) {
+		sigma3Records.push_back(findRecords(network, l + 1, sigma3SizeVec[l]));
+	}
+
 	// Update the bubble bursting rate
 	updateTrapMutationRate(network);
 
@@ -129,68 +120,29 @@ void TrapMutationHandler::initializeIndex1D(int surfacePos,
 		const IReactionNetwork& network,
 		std::vector<IAdvectionHandler *> advectionHandlers,
 		std::vector<double> grid, int nx, int xs) {
-	// Clear the vector of HeV indices created by He undergoing trap-mutation
-	// at each grid point
-	tmBubbles.clear();
+	// Clear the trap-mutations of every grid point
+	clearRecords(nx, 1);
 
 	// No GB trap mutation handler in 1D for now
 
-	// Create the temporary 2D vector
-	ReactantRefVector2D temp2DVector;
-	// Create the temporary 1D vector
-	ReactantRefVector1D temp1DVector;
-
 	// Loop on the grid points in the depth direction
 	for (int i = 0; i < nx; i++) {
 		// If we are on the left side of the surface there is no
 		// modified trap-mutation
-		if (i + xs <= surfacePos) {
-			temp1DVector.emplace_back();
-			continue;
-		}
+		if (i + xs > surfacePos) {
+			// Get the depth
+			double depth = (grid[i + xs] + grid[i + xs + 1]) / 2.0
+					- grid[surfacePos + 1];
+			double previousDepth = (grid[i + xs - 1] + grid[i + xs]) / 2.0
+					- grid[surfacePos + 1];
 
-		// Get the depth
-		double depth = (grid[i + xs] + grid[i + xs + 1]) / 2.0
-				- grid[surfacePos + 1];
-		double previousDepth = (grid[i + xs - 1] + grid[i + xs]) / 2.0
-				- grid[surfacePos + 1];
-
-		// Loop on the depth vector
-		std::vector<std::reference_wrapper<IReactant> > indices;
-		for (int l = 0; l < depthVec.size(); l++) {
-			// Check if a helium cluster undergo TM at this depth
-			if (std::fabs(depth - depthVec[l]) < 0.01
-					|| (depthVec[l] - 0.01 < depth
-							&& depthVec[l] - 0.01 > previousDepth)) {
-				// Add the bubble of size l+1 to the indices
-				// Loop on the bubbles
-				for (auto const& heVMapItem : network.getAll(
-						ReactantType::PSIMixed)) {
-					// Get the bubble and its composition
-					auto& bubble = static_cast<IReactant&>(*(heVMapItem.second));
-					auto const& comp = bubble.getComposition();
-					// Get the correct bubble
-					if (comp[toCompIdx(Species::He)] == l + 1
-							&& comp[toCompIdx(Species::V)] == sizeVec[l]
-							&& comp[toCompIdx(Species::D)] == 0
-							&& comp[toCompIdx(Species::T)] == 0) {
-						// Add this bubble to the indices
-						indices.emplace_back(bubble);
-					}
-				}
-			}
+			// Add the bubbles of this depth
+			addDepthRecords(depth, previousDepth);
 		}
 
-		// Add indices to the index vector
-		temp1DVector.emplace_back(indices);
+		endGridPoint();
 	}
 
-	// Give the 1D vector to the 2D vector
-	temp2DVector.emplace_back(temp1DVector);
-
-	// Give the 2D vector to the final vector
-	tmBubbles.emplace_back(temp2DVector);
-
 	return;
 }
 
@@ -198,128 +150,35 @@ void TrapMutationHandler::initializeIndex2D(std::vector<int> surfacePos,
 		const IReactionNetwork& network,
 		std::vector<IAdvectionHandler *> advectionHandlers,
 		std::vector<double> grid, int nx, int xs, int ny, double hy, int ys) {
-	// Clear the vector of HeV indices created by He undergoing trap-mutation
-	// at each grid point
-	tmBubbles.clear();
-
-	// Create a Sigma 3 trap mutation handler because it is the
-	// only one available right now
-	auto sigma3Handler = new Sigma3TrapMutationHandler();
-	auto sigma3DistanceVec = sigma3Handler->getDistanceVector();
-	auto sigma3SizeVec = sigma3Handler->getSizeVector();
-
-	// Create the temporary 2D vector
-	ReactantRefVector2D temp2DVector;
+	// Clear the trap-mutations of every grid point
+	clearRecords(nx, ny);
 
 	// Loop on the grid points in the Y direction
-	temp2DVector.reserve(ny);
 	for (int j = 0; j < ny; j++) {
-
-		// Create the temporary 1D vector
-		ReactantRefVector1D temp1DVector;
+		// Get the Y position
+		double yPos = (double) (j + ys) * hy;
 
 		// Loop on the grid points in the depth direction
 		for (int i = 0; i < nx; i++) {
-			// Create the list (vector) of indices at this grid point
-			std::vector<std::reference_wrapper<IReactant> > indices;
-
 			// If we are on the left side of the surface there is no
 			// modified trap-mutation
-			if (i + xs <= surfacePos[j + ys]) {
-				temp1DVector.push_back(indices);
-				continue;
-			}
-
-			// Get the depth
-			double depth = (grid[i + xs] + grid[i + xs + 1]) / 2.0
-					- grid[surfacePos[j + ys] + 1];
-			double previousDepth = (grid[i + xs - 1] + grid[i + xs]) / 2.0
-					- grid[surfacePos[j + ys] + 1];
-
-			// Loop on the depth vector
-			for (int l = 0; l < depthVec.size(); l++) {
-				// Check if a helium cluster undergo TM at this depth
-				if (std::fabs(depth - depthVec[l]) < 0.01
-						|| (depthVec[l] - 0.01 < depth
-								&& depthVec[l] - 0.01 > previousDepth)) {
-					// Add the bubble of size l+1 to the indices
-					// Loop on the bubbles
-					for (auto const& heVMapItem : network.getAll(
-							ReactantType::PSIMixed)) {
-						// Get the bubble and its composition
-						auto& bubble =
-								static_cast<IReactant&>(*(heVMapItem.second));
-						auto const& comp = bubble.getComposition();
-						// Get the correct bubble
-						if (comp[toCompIdx(Species::He)] == l + 1
-								&& comp[toCompIdx(Species::V)] == sizeVec[l]
-								&& comp[toCompIdx(Species::D)] == 0
-								&& comp[toCompIdx(Species::T)] == 0) {
-							// Add this bubble to the indices
-							indices.emplace_back(bubble);
-						}
-					}
-				}
-			}
+			if (i + xs > surfacePos[j + ys]) {
+				// Get the depth
+				double depth = (grid[i + xs] + grid[i + xs + 1]) / 2.0
+						- grid[surfacePos[j + ys] + 1];
+				double previousDepth = (grid[i + xs - 1] + grid[i + xs]) / 2.0
+						- grid[surfacePos[j + ys] + 1];
 
-			// Get the Y position
-			double yPos = (double) (j + ys) * hy;
-			// Loop on the GB advection handlers
-			for (int n = 1; n < advectionHandlers.size(); n++) {
-				// Get the location of the GB
-				double location = advectionHandlers[n]->getLocation();
-				// Get the current distance from the GB
-				double distance = fabs(yPos - location);
-				// Loop on the sigma 3 distance vector
-				for (int l = 0; l < sigma3DistanceVec.size(); l++) {
-					// Check if a helium cluster undergo TM at this depth
-					if (std::fabs(distance - sigma3DistanceVec[l]) < 0.01) {
-						// Add the bubble of size l+1 to the indices
-						// Loop on the bubbles
-						for (auto const& heVMapItem : network.getAll(
-								ReactantType::PSIMixed)) {
-							// Get the bubble and its composition
-							auto& bubble =
-									static_cast<IReactant&>(*(heVMapItem.second));
-							auto const& comp = bubble.getComposition();
-							// Get the correct bubble
-							if (comp[toCompIdx(Species::He)] == l + 1
-									&& comp[toCompIdx(Species::V)]
-											== sigma3SizeVec[l]
-									&& comp[toCompIdx(Species::D)] == 0
-									&& comp[toCompIdx(Species::T)] == 0) {
-								// Check if this bubble is already 
-								// associated with this grid point.
-								auto biter =
-										std::find_if(indices.begin(),
-												indices.end(),
-												[&bubble](const IReactant& testReactant) {
-													return testReactant.getId() == bubble.getId();
-												});
-								if (biter == indices.end()) {
-									// Add this bubble to the indices
-									indices.emplace_back(bubble);
-								}
-							}
-						}
-					}
-				}
+				// Add the bubbles of this depth and the ones of the
+				// grain boundaries
+				addDepthRecords(depth, previousDepth);
+				addGBRecords(yPos, advectionHandlers);
 			}
 
-			// Add indices to the index vector
-			temp1DVector.push_back(indices);
+			endGridPoint();
 		}
-
-		// Give the 1D vector to the 2D vector
-		temp2DVector.push_back(temp1DVector);
 	}
 
-	// Give the 2D vector to the final vector
-	tmBubbles.push_back(temp2DVector);
-
-	// Clear the memory
-	delete sigma3Handler;
-
 	return;
 }
 
@@ -329,132 +188,139 @@ void TrapMutationHandler::initializeIndex3D(
 		std::vector<IAdvectionHandler *> advectionHandlers,
 		std::vector<double> grid, int nx, int xs, int ny, double hy, int ys,
 		int nz, double hz, int zs) {
-	// Clear the vector of HeV indices created by He undergoing trap-mutation
-	// at each grid point
-	tmBubbles.clear();
-
-	// Create a Sigma 3 trap mutation handler because it is the
-	// only one available right now
-	auto sigma3Handler = new Sigma3TrapMutationHandler();
-	auto sigma3DistanceVec = sigma3Handler->getDistanceVector();
-	auto sigma3SizeVec = sigma3Handler->getSizeVector();
+	// Clear the trap-mutations of every grid point
+	clearRecords(nx, ny, nz);
 
 	// Loop on the grid points in the Z direction
-	tmBubbles.reserve(nz);
 	for (int k = 0; k < nz; k++) {
-
-		// Create the temporary 2D vector
-		ReactantRefVector2D temp2DVector;
-
 		// Loop on the grid points in the Y direction
-		temp2DVector.reserve(ny);
 		for (int j = 0; j < ny; j++) {
-			// Create the temporary 1D vector
-			ReactantRefVector1D temp1DVector;
+			// Get the Y position
+			double yPos = (double) (j + ys) * hy;
 
 			// Loop on the grid points in the depth direction
 			for (int i = 0; i < nx; i++) {
-				// Create the list (vector) of indices at this grid point
-				std::vector<std::reference_wrapper<IReactant> > indices;
-
 				// If we are on the left side of the surface there is no
 				// modified trap-mutation
-				if (i + xs <= surfacePos[j + ys][k + zs]) {
-					temp1DVector.emplace_back(indices);
-					continue;
+				if (i + xs > surfacePos[j + ys][k + zs]) {
+					// Get the depth
+					double depth = (grid[i + xs] + grid[i + xs + 1]) / 2.0
+							- grid[surfacePos[j + ys][k + zs] + 1];
+					double previousDepth = (grid[i + xs - 1] + grid[i + xs])
+							/ 2.0 - grid[surfacePos[j + ys][k + zs] + 1];
+
+					// Add the bubbles of this depth and the ones of the
+					// grain boundaries
+					addDepthRecords(depth, previousDepth);
+					addGBRecords(yPos, advectionHandlers);
 				}
 
-				// Get the depth
-				double depth = (grid[i + xs] + grid[i + xs + 1]) / 2.0
-						- grid[surfacePos[j + ys][k + zs] + 1];
-				double previousDepth = (grid[i + xs - 1] + grid[i + xs]) / 2.0
-						- grid[surfacePos[j + ys][k + zs] + 1];
-
-				// Loop on the depth vector
-				for (int l = 0; l < depthVec.size(); l++) {
-					// Check if a helium cluster undergo TM at this depth
-					if (std::fabs(depth - depthVec[l]) < 0.01
-							|| (depthVec[l] - 0.01 < depth
-									&& depthVec[l] - 0.01 > previousDepth)) {
-						// Add the bubble of size l+1 to the indices
-						// Loop on the bubbles
-						for (auto const& heVMapItem : network.getAll(
-								ReactantType::PSIMixed)) {
-							// Get the bubble and its composition
-							auto& bubble =
-									static_cast<IReactant&>(*(heVMapItem.second));
-							auto const& comp = bubble.getComposition();
-							// Get the correct bubble
-							if (comp[toCompIdx(Species::He)] == l + 1
-									&& comp[toCompIdx(Species::V)] == sizeVec[l]
-									&& comp[toCompIdx(Species::D)] == 0
-									&& comp[toCompIdx(Species::T)] == 0) {
-								// Add this bubble to the indices
-								indices.emplace_back(bubble);
-							}
-						}
-					}
-				}
+				endGridPoint();
+			}
+		}
+	}
 
-				// Get the Y position
-				double yPos = (double) (j + ys) * hy;
-				// Loop on the GB advection handlers
-				for (int n = 1; n < advectionHandlers.size(); n++) {
-					// Get the location of the GB
-					double location = advectionHandlers[n]->getLocation();
-					// Get the current distance from the GB
-					double distance = fabs(yPos - location);
-
-					// Loop on the sigma 3 distance vector
-					for (int l = 0; l < sigma3DistanceVec.size(); l++) {
-						// Check if a helium cluster undergo TM at this depth
-						if (std::fabs(distance - sigma3DistanceVec[l]) < 0.01) {
-							// Add the bubble of size l+1 to the indices
-							// Loop on the bubbles
-							for (auto const& heVMapItem : network.getAll(
-									ReactantType::PSIMixed)) {
-								// Get the bubble and its composition
-								auto& bubble =
-										static_cast<IReactant&>(*(heVMapItem.second));
-								auto const& comp = bubble.getComposition();
-								// Get the correct bubble
-								if (comp[toCompIdx(Species::He)] == l + 1
-										&& comp[toCompIdx(Species::V)]
-												== sigma3SizeVec[l]
-										&& comp[toCompIdx(Species::D)] == 0
-										&& comp[toCompIdx(Species::T)] == 0) {
-									// Check if this bubble is already
-									// associated with this grid point.
-									auto biter =
-											std::find_if(indices.begin(),
-													indices.end(),
-													[&bubble](const IReactant& testReactant) {
-														return testReactant.getId() == bubble.getId();
-													});
-									if (biter == indices.end()) {
-										// Add this bubble to the indices
-										indices.emplace_back(bubble);
-									}
-								}
-							}
-						}
-					}
-				}
+	return;
+}
 
-				// Add indices to the index vector
-				temp1DVector.push_back(indices);
-			}
+void TrapMutationHandler::clearRecords(int nx, int ny, int nz) {
+	tmRecords.clear();
+	tmOffsets.clear();
+	tmOffsets.reserve(nx * ny * nz + 1);
+	tmOffsets.push_back(0);
+	tmNx = nx;
+	tmNy = ny;
+
+	return;
+}
+
+std::vector<TrapMutationHandler::MutationRecord> TrapMutationHandler::findRecords(
+		const IReactionNetwork& network, int heSize, int vSize) const {
+	std::vector<MutationRecord> records;
+
+	// Get the helium cluster and the interstitial cluster with the same
+	// number of I as the number of vacancies in the bubble
+	auto heCluster = (IReactant *) network.get(Species::He, heSize);
+	auto iCluster = network.get(Species::I, vSize);
+	if (!heCluster || !iCluster)
+		return records;
+
+	// Loop on the bubbles
+	for (auto const& heVMapItem : network.getAll(ReactantType::PSIMixed)) {
+		// Get the bubble and its composition
+		auto& bubble = static_cast<IReactant&>(*(heVMapItem.second));
+		auto const& comp = bubble.getComposition();
+		// Get the correct bubble
+		if (comp[toCompIdx(Species::He)] == heSize
+				&& comp[toCompIdx(Species::V)] == vSize
+				&& comp[toCompIdx(Species::D)] == 0
+				&& comp[toCompIdx(Species::T)] == 0) {
+			// Save the indices
+			MutationRecord record;
+			record.heIndex = heCluster->getId() - 1;
+			record.bubbleIndex = bubble.getId() - 1;
+			record.iIndex = iCluster->getId() - 1;
+			record.heSize = heSize;
+			record.heCluster = heCluster;
+			records.push_back(record);
+		}
+	}
 
-			// Give the 1D vector to the 2D vector
-			temp2DVector.push_back(temp1DVector);
+	return records;
+}
+
+void TrapMutationHandler::addDepthRecords(double depth, double previousDepth) {
+	// Loop on the depth vector
+	for (int l = 0; l < depthRecords.size(); l++) {
+		// Check if a helium cluster undergo TM at this depth
+		if (std::fabs(depth - depthVec[l]) < 0.01
+				|| (depthVec[l] - 0.01 < depth
+						&& depthVec[l] - 0.01 > previousDepth)) {
+			// Add the bubbles of size l+1
+			tmRecords.insert(tmRecords.end(), depthRecords[l].begin(),
+					depthRecords[l].end());
 		}
+	}
+
+	return;
+}
 
-		// Give the 2D vector to the final vector
-		tmBubbles.push_back(temp2DVector);
+void TrapMutationHandler::addGBRecords(double yPos,
+		const std::vector<IAdvectionHandler *>& advectionHandlers) {
+	// Loop on the GB advection handlers
+	for (int n = 1; n < advectionHandlers.size(); n++) {
+		// Get the location of the GB
+		double location = advectionHandlers[n]->getLocation();
+		// Get the current distance from the GB
+		double distance = fabs(yPos - location);
+		// Loop on the sigma 3 distance vector
+		for (int l = 0; l < sigma3Records.size(); l++) {
+			// Check if a helium cluster undergo TM at this distance
+			if (std::fabs(distance - sigma3DistanceVec[l]) >= 0.01)
+				continue;
+
+			// Add the bubbles of size l+1
+			for (auto const& record : sigma3Records[l]) {
+				// Check if this bubble is already associated with this
+				// grid point
+				auto riter = std::find_if(
+						tmRecords.begin() + tmOffsets.back(), tmRecords.end(),
+						[&record](const MutationRecord& testRecord) {
+							return testRecord.bubbleIndex == record.bubbleIndex;
+						});
+				if (riter == tmRecords.end()) {
+					tmRecords.push_back(record);
+				}
+			}
+		}
 	}
 
-	// Clear the memory
-	delete sigma3Handler;
+	return;
+}
+
+void TrapMutationHandler::endGridPoint() {
+	// Close the range of this grid point
+	tmOffsets.push_back(tmRecords.size());
 
 	return;
 }
@@ -488,34 +354,21 @@ void TrapMutationHandler::computeTrapMutation(const IReactionNetwork& network,
 	// Initialize the rate of the reaction
 	double rate = 0.0;
 
-	// Loop on the list
-	for (IReactant const& currReactant : tmBubbles[zk][yj][xi]) {
-
-		// Get the stored bubble and its ID
-		auto const& bubble = static_cast<IReactant const&>(currReactant);
-		auto bubbleIndex = bubble.getId() - 1;
-
-		// Get the helium cluster with the same number of He and its ID
-		// Note this composition has nonzero entries for both He and I,
-		// so we can't use the network's get function that takes a composition.
-		auto& comp = bubble.getComposition();
-		auto heCluster = (IReactant *) network.get(Species::He,
-				comp[toCompIdx(Species::He)]);
-		auto heIndex = heCluster->getId() - 1;
-
-		// Get the interstitial cluster with the same number of I as the number
-		// of vacancies in the bubble and its ID
-		auto iCluster = (IReactant *) network.get(Species::I,
-				comp[toCompIdx(Species::V)]);
-		auto iIndex = iCluster->getId() - 1;
+	// Loop on the trap-mutations at this grid point
+	int p = (zk * tmNy + yj) * tmNx + xi;
+	for (int n = tmOffsets[p]; n < tmOffsets[p + 1]; n++) {
+		auto const& record = tmRecords[n];
+		auto heIndex = record.heIndex;
+		auto bubbleIndex = record.bubbleIndex;
+		auto iIndex = record.iIndex;
 
 		// Get the initial concentration of helium
 		double oldConc = concOffset[heIndex];
 
 		// Check the desorption
-		if (comp[toCompIdx(Species::He)] == desorp.size) {
+		if (record.heSize == desorp.size) {
 			// Get the left side rate (combination + emission)
-			double totalRate = heCluster->getLeftSideRate(xi + 1);
+			double totalRate = record.heCluster->getLeftSideRate(xi + 1);
 			// Define the trap-mutation rate taking into account the desorption
 			rate = kDis * totalRate * (1.0 - desorp.portion) / desorp.portion;
 		} else {
@@ -541,31 +394,18 @@ int TrapMutationHandler::computePartialsForTrapMutation(
 	// Consider all bubbles at this grid point.
 	// TODO Relying on convention for indices in indices/vals arrays is
 	// error prone - could be done with multiple parallel arrays.
+	int p = (zk * tmNy + yj) * tmNx + xi;
 	uint32_t i = 0;
-	for (IReactant const& currReactant : tmBubbles[zk][yj][xi]) {
-
-		// Get the stored bubble and its ID
-		auto const& bubble = static_cast<IReactant const&>(currReactant);
-		auto bubbleIndex = bubble.getId() - 1;
-
-		// Get the helium cluster with the same number of He and its ID
-		// Note this composition has non-zero entries for both He and I.
-		// so we can't use the network's get function that takes a composition.
-		auto const& comp = bubble.getComposition();
-		auto heCluster = (IReactant *) network.get(Species::He,
-				comp[toCompIdx(Species::He)]);
-		auto heIndex = heCluster->getId() - 1;
-
-		// Get the interstitial cluster with the same number of I as the number
-		// of vacancies in the bubble and its ID
-		auto iCluster = (IReactant *) network.get(Species::I,
-				comp[toCompIdx(Species::V)]);
-		auto iIndex = iCluster->getId() - 1;
+	for (int n = tmOffsets[p]; n < tmOffsets[p + 1]; n++) {
+		auto const& record = tmRecords[n];
+		auto heIndex = record.heIndex;
+		auto bubbleIndex = record.bubbleIndex;
+		auto iIndex = record.iIndex;
 
 		// Check the desorption
-		if (comp[toCompIdx(Species::He)] == desorp.size) {
+		if (record.heSize == desorp.size) {
 			// Get the left side rate (combination + emission)
-			double totalRate = heCluster->getLeftSideRate(xi + 1);
+			double totalRate = record.heCluster->getLeftSideRate(xi + 1);
 			// Define the trap-mutation rate taking into account the desorption
 			rate = kDis * totalRate * (1.0 - desorp.portion) / desorp.portion;
 		} else {
@@ -589,7 +429,7 @@ int TrapMutationHandler::computePartialsForTrapMutation(
 		++i;
 	}
 
-	return (tmBubbles[zk][yj][xi]).size();
+	return tmOffsets[p + 1] - tmOffsets[p];
 }
 
 }/* end namespace xolotlCore */
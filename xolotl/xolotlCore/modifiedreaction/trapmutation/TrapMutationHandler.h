@@ -56,15 +56,105 @@ protected:
 	bool attenuation;
 
 	/**
-	 * The vector containing the indices of the bubbles created through modified
-	 * trap-mutation for each grid point. The difference between this vector and depthVec
-	 * is that this one is used for the actual computation whereas the other one is
-	 * defined by the user. tmBubbles is created with the depthVec information.
+	 * A modified trap-mutation at a grid point, He_i --> (He_i)(V_j) + I_j,
+	 * with the indices of its clusters resolved once.
 	 */
-	using ReactantRefVector1D = std::vector<IReactant::RefVector>;
-	using ReactantRefVector2D = std::vector<ReactantRefVector1D>;
-	using ReactantRefVector3D = std::vector<ReactantRefVector2D>;
-	ReactantRefVector3D tmBubbles;
+	struct MutationRecord {
+		//! The index of the helium cluster
+		int heIndex;
+		//! The index of the bubble created
+		int bubbleIndex;
+		//! The index of the interstitial cluster created
+		int iIndex;
+		//! The number of helium, the rank in depthVec plus one
+		int heSize;
+		//! The helium cluster, for the desorption rate
+		IReactant *heCluster;
+	};
+
+	/**
+	 * The trap-mutations happening at each grid point, the ones of a grid
+	 * point are contiguous. They are defined from depthVec and sizeVec
+	 * by the initializeIndex methods.
+	 */
+	std::vector<MutationRecord> tmRecords;
+
+	/**
+	 * The trap-mutations of the grid point (xi, yj, zk) are the ones from
+	 * tmOffsets[p] to tmOffsets[p + 1] excluded in tmRecords, with
+	 * p = (zk * tmNy + yj) * tmNx + xi.
+	 */
+	std::vector<int> tmOffsets;
+
+	//! The number of grid points in the depth direction in tmOffsets
+	int tmNx;
+
+	//! The number of grid points in the Y direction in tmOffsets
+	int tmNy;
+
+	/**
+	 * Remove all the trap-mutations before defining them again, grid point
+	 * after grid point, in the order of tmOffsets.
+	 *
+	 * @param nx The number of grid points in the depth direction
+	 * @param ny The number of grid points in the Y direction
+	 * @param nz The number of grid points in the Z direction
+	 */
+	void clearRecords(int nx, int ny, int nz = 1);
+
+	/**
+	 * The trap-mutations of the helium clusters of each size l+1 into the
+	 * bubbles of sizeVec[l], happening at the depth depthVec[l]. They are
+	 * found once in the network by initialize so that the grid points can
+	 * be defined again without searching it when the surface moves.
+	 */
+	std::vector<std::vector<MutationRecord> > depthRecords;
+
+	/**
+	 * The trap-mutations of the helium clusters of each size l+1 happening
+	 * at the distance sigma3DistanceVec[l] from the sigma 3 grain boundaries.
+	 */
+	std::vector<std::vector<MutationRecord> > sigma3Records;
+
+	//! The distances from the sigma 3 grain boundaries
+	std::vector<double> sigma3DistanceVec;
+
+	/**
+	 * Find the trap-mutations of the helium clusters of the given size
+	 * into the bubbles with the given number of vacancies.
+	 *
+	 * @param network The network
+	 * @param heSize The number of helium
+	 * @param vSize The number of vacancies of the bubbles
+	 * @return The trap-mutations, empty if the clusters are not in the network
+	 */
+	std::vector<MutationRecord> findRecords(const IReactionNetwork& network,
+			int heSize, int vSize) const;
+
+	/**
+	 * Add the trap-mutations happening at the given depth to the grid point
+	 * being defined.
+	 *
+	 * @param depth The depth of the grid point
+	 * @param previousDepth The depth of the previous grid point
+	 */
+	void addDepthRecords(double depth, double previousDepth);
+
+	/**
+	 * Add the trap-mutations due to the grain boundaries to the grid point
+	 * being defined, if they are not there already.
+	 *
+	 * @param yPos The position of the grid point in the Y direction
+	 * @param advectionHandlers The advection handlers, the ones of the grain
+	 * boundaries are after the first one
+	 */
+	void addGBRecords(double yPos,
+			const std::vector<IAdvectionHandler *>& advectionHandlers);
+
+	/**
+	 * End the definition of the current grid point and start the next one.
+	 */
+	void endGridPoint();
 
 	/**
 	 * The desorption information
@@ -91,7 +181,8 @@ public:
 	 * The constructor
 	 */
 	TrapMutationHandler() :
-			kMutation(0.0), kDis(1.0), attenuation(true), desorp(0, 0.0) {
+			kMutation(0.0), kDis(1.0), attenuation(true), tmNx(0), tmNy(0), desorp(
+					0, 0.0) {
 	}
 
 	/**
@@ -113,8 +204,8 @@ public:
 
 	/**
 	 * This method defines which trap-mutation is allowed at each grid point.
-	 * The stored indices correspond to the HeV bubbles, and more precisely to their
-	 * rank in the bubbles vector obtained with bubbles = network->getAll(heVType).
+	 * It only uses the bubbles found by initialize and does not search the
+	 * network, so it is cheap to call again each time the surface moves.
 	 *
 	 * \see ITrapMutationHandler.h
 	 */
@@ -124,8 +215,8 @@ public:
 
 	/**
 	 * This method defines which trap-mutation is allowed at each grid point.
-	 * The stored indices correspond to the HeV bubbles, and more precisely to their
-	 * rank in the bubbles vector obtained with bubbles = network->getAll(heVType).
+	 * It only uses the bubbles found by initialize and does not search the
+	 * network, so it is cheap to call again each time the surface moves.
 	 *
 	 * \see ITrapMutationHandler.h
 	 */
@@ -137,8 +228,8 @@ public:
 
 	/**
 	 * This method defines which trap-mutation is allowed at each grid point.
-	 * The stored indices correspond to the HeV bubbles, and more precisely to their
-	 * rank in the bubbles vector obtained with bubbles = network->getAll(heVType).
+	 * It only uses the bubbles found by initialize and does not search the
+	 * network, so it is cheap to call again each time the surface moves.
 	 *
 	 * \see ITrapMutationHandler.h
 	 */
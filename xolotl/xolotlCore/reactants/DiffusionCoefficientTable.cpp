@@ -0,0 +1,114 @@
+#include "DiffusionCoefficientTable.h"
+#include <Constants.h>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+using namespace xolotlCore;
+
+void DiffusionCoefficientTable::reallocate(int nFree, int newRowSize) {
+	// Create the new storage
+	const int capacity = nFree + nRows;
+	std::vector<double> newTemperatures(capacity, 0.0);
+	std::vector<double> newComputed(capacity,
+			std::numeric_limits<double>::quiet_NaN());
+	std::vector<double> newCoefficients((std::size_t) capacity * newRowSize,
+			0.0);
+
+	// Copy the rows
+	for (int r = 0; r < nRows; r++) {
+		newTemperatures[nFree + r] = temperatures[firstRow + r];
+		newComputed[nFree + r] = computedTemperatures[firstRow + r];
+		std::copy(getRow(r), getRow(r) + nColumns,
+				newCoefficients.begin() + (std::size_t) (nFree + r) * newRowSize);
+	}
+
+	temperatures.swap(newTemperatures);
+	computedTemperatures.swap(newComputed);
+	coefficients.swap(newCoefficients);
+	firstRow = nFree;
+	rowSize = newRowSize;
+
+	return;
+}
+
+void DiffusionCoefficientTable::invalidate() {
+	std::fill(computedTemperatures.begin(), computedTemperatures.end(),
+			std::numeric_limits<double>::quiet_NaN());
+
+	return;
+}
+
+int DiffusionCoefficientTable::addColumn(double factor, double energy) {
+	// Widen the existing rows when they are full
+	if (nColumns == rowSize)
+		reallocate(firstRow, std::max(2 * rowSize, 1));
+
+	// The new column starts with zeros
+	for (int r = 0; r < nRows; r++) {
+		getRow(r)[nColumns] = 0.0;
+	}
+	nColumns++;
+	diffusionFactors.push_back(factor);
+	migrationEnergies.push_back(energy);
+
+	// The rows don't know the new column yet
+	invalidate();
+
+	return nColumns - 1;
+}
+
+void DiffusionCoefficientTable::setColumn(int column, double factor,
+		double energy) {
+	if (diffusionFactors[column] == factor
+			&& migrationEnergies[column] == energy)
+		return;
+
+	diffusionFactors[column] = factor;
+	migrationEnergies[column] = energy;
+	invalidate();
+
+	return;
+}
+
+void DiffusionCoefficientTable::addGridPoints(int i) {
+	if (i > 0) {
+		// Keep as many free rows as used ones when growing, so that adding
+		// grid points one at a time only moves the rows a few times
+		if (firstRow < i)
+			reallocate(nRows + 2 * i, rowSize);
+
+		// The new rows are in front of the first one
+		firstRow -= i;
+		nRows += i;
+		for (int r = 0; r < i; r++) {
+			temperatures[firstRow + r] = 0.0;
+			computedTemperatures[firstRow + r] =
+					std::numeric_limits<double>::quiet_NaN();
+			std::fill(getRow(r), getRow(r) + nColumns, 0.0);
+		}
+	} else {
+		// Forget the first rows
+		i = std::min(-i, nRows);
+		firstRow += i;
+		nRows -= i;
+	}
+
+	return;
+}
+
+void DiffusionCoefficientTable::computeArrhenius(int i) {
+	// Get the row and the columns
+	double *row = getRow(i);
+	const double *factor = diffusionFactors.data();
+	const double *energy = migrationEnergies.data();
+	const double scale = -1.0 / (xolotlCore::kBoltzmann * getTemperature(i));
+
+	// Compute all the columns at once
+	for (int c = 0; c < nColumns; c++) {
+		row[c] = (factor[c] > 0.0) ? factor[c] * exp(energy[c] * scale) : 0.0;
+	}
+	setComputed(i);
+
+	return;
+}
@@ -0,0 +1,205 @@
+#ifndef DIFFUSIONCOEFFICIENTTABLE_H
+#define DIFFUSIONCOEFFICIENTTABLE_H
+
+#include <vector>
+#include <cstddef>
+
+namespace xolotlCore {
+
+/**
+ * This class stores the temperature of each grid point and the diffusion
+ * coefficients of the diffusing reactants at each grid point, with one row
+ * of coefficients per grid point and one column per diffusing reactant.
+ *
+ * The rows are stored one after the other with free rows before the first
+ * one, so that grid points can be added or removed at the surface without
+ * moving the other ones. Each row remembers the temperature at which it
+ * was computed, to be recomputed only when the temperature changes. The
+ * rows have room for more columns than needed, doubled when it is full, so
+ * that adding the reactants one at a time only moves the rows a few times.
+ */
+class DiffusionCoefficientTable {
+
+private:
+
+	//! The number of diffusing reactants
+	int nColumns;
+
+	//! The number of columns each row has room for
+	int rowSize;
+
+	//! The number of grid points
+	int nRows;
+
+	//! The position of the first grid point in the storage
+	int firstRow;
+
+	//! The temperature of each row of the storage
+	std::vector<double> temperatures;
+
+	//! The temperature at which each row of the storage was computed
+	std::vector<double> computedTemperatures;
+
+	//! The diffusion coefficients, row after row
+	std::vector<double> coefficients;
+
+	//! The diffusion factor of each column
+	std::vector<double> diffusionFactors;
+
+	//! The migration energy of each column
+	std::vector<double> migrationEnergies;
+
+	/**
+	 * Move the rows to new storage with the given number of free rows
+	 * before the first one and room for the given number of columns.
+	 *
+	 * @param nFree The number of free rows
+	 * @param newRowSize The number of columns each row has room for
+	 */
+	void reallocate(int nFree, int newRowSize);
+
+public:
+
+	/**
+	 * The constructor.
+	 */
+	DiffusionCoefficientTable() :
+			nColumns(0), rowSize(0), nRows(0), firstRow(0) {
+	}
+
+	/**
+	 * Add a column for a diffusing reactant, filled with zeros.
+	 *
+	 * @param factor The diffusion factor of the reactant
+	 * @param energy The migration energy of the reactant
+	 * @return The index of the column
+	 */
+	int addColumn(double factor, double energy);
+
+	/**
+	 * Change the diffusion factor and migration energy of a column.
+	 *
+	 * @param column The index of the column
+	 * @param factor The diffusion factor of the reactant
+	 * @param energy The migration energy of the reactant
+	 */
+	void setColumn(int column, double factor, double energy);
+
+	/**
+	 * Forget the temperatures at which all the rows were computed, for them
+	 * to be recomputed when something else than the temperature changed.
+	 */
+	void invalidate();
+
+	/**
+	 * Add grid points at the surface (at the beginning of the grid) or
+	 * remove them if the value is negative.
+	 *
+	 * @param i The number of grid points to add or remove
+	 */
+	void addGridPoints(int i);
+
+	/**
+	 * Get the number of diffusing reactants.
+	 *
+	 * @return The number of columns
+	 */
+	int getNumberOfColumns() const {
+		return nColumns;
+	}
+
+	/**
+	 * Get the number of grid points.
+	 *
+	 * @return The number of rows
+	 */
+	int getNumberOfGridPoints() const {
+		return nRows;
+	}
+
+	/**
+	 * Get the diffusion factors of all the columns.
+	 *
+	 * @return The diffusion factors
+	 */
+	const double *getDiffusionFactors() const {
+		return diffusionFactors.data();
+	}
+
+	/**
+	 * Get the migration energies of all the columns.
+	 *
+	 * @return The migration energies
+	 */
+	const double *getMigrationEnergies() const {
+		return migrationEnergies.data();
+	}
+
+	/**
+	 * Get the temperature at a grid point.
+	 *
+	 * @param i The location on the grid
+	 * @return The temperature
+	 */
+	double getTemperature(int i) const {
+		return temperatures[firstRow + i];
+	}
+
+	/**
+	 * Set the temperature at a grid point. The row is not recomputed.
+	 *
+	 * @param temp The temperature
+	 * @param i The location on the grid
+	 */
+	void setTemperature(double temp, int i) {
+		temperatures[firstRow + i] = temp;
+	}
+
+	/**
+	 * Whether the row of a grid point was computed at its current
+	 * temperature since the columns last changed.
+	 *
+	 * @param i The location on the grid
+	 * @return True if it doesn't need to be recomputed
+	 */
+	bool isComputed(int i) const {
+		return computedTemperatures[firstRow + i] == temperatures[firstRow + i];
+	}
+
+	/**
+	 * Note that the row of a grid point was computed at its current
+	 * temperature.
+	 *
+	 * @param i The location on the grid
+	 */
+	void setComputed(int i) {
+		computedTemperatures[firstRow + i] = temperatures[firstRow + i];
+	}
+
+	/**
+	 * Get the diffusion coefficients of all the columns at a grid point.
+	 *
+	 * @param i The location on the grid
+	 * @return The row of coefficients
+	 */
+	double *getRow(int i) {
+		return coefficients.data() + (std::size_t) (firstRow + i) * rowSize;
+	}
+	const double *getRow(int i) const {
+		return coefficients.data() + (std::size_t) (firstRow + i) * rowSize;
+	}
+
+	/**
+	 * Compute the diffusion coefficients of all the columns at a grid point
+	 * with the Arrhenius equation and its current temperature. The columns
+	 * with a zero diffusion factor are set to zero.
+	 *
+	 * @param i The location on the grid
+	 */
+	void computeArrhenius(int i);
+
+};
+//end class DiffusionCoefficientTable
+
+} /* end namespace xolotlCore */
+#endif
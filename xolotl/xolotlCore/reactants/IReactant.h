@@ -18,6 +18,7 @@ namespace xolotlCore {
 class IReactionNetwork;
 class ProductionReaction;
 class DissociationReaction;
+class DiffusionCoefficientTable;
 
 static int defaultInit[4] = { 0, 0, 0, 0 };
 
@@ -298,6 +299,15 @@ public:
 	 */
 	virtual void addGridPoints(int i) = 0;
 
+	/**
+	 * Use the given table for the temperature and the diffusion coefficient
+	 * at each grid point. The network gives its own to its reactants.
+	 *
+	 * @param table The table of the network
+	 */
+	virtual void setDiffusionTable(
+			std::shared_ptr<DiffusionCoefficientTable> table) = 0;
+
 	/**
 	 * This operation returns a list that represents the connectivity
 	 * between this reactant and other reactants in the network.
@@ -38,6 +38,17 @@ public:
 	 */
 	using SparseFillMap = std::unordered_map<int, std::vector<int>>;
 
+	/**
+	 * The totals that can be computed from weight vectors, see
+	 * getTotalWeights(). The trapped atoms are the ones contained in bubbles.
+	 */
+	enum class TotalType {
+		HeAtom, DAtom, TAtom, TrappedHeAtom, TrappedDAtom, TrappedTAtom, V, I
+	};
+
+	//! The number of TotalType values
+	static constexpr int numTotalTypes = 8;
+
 	/**
 	 * The destructor.
 	 */
@@ -273,6 +284,40 @@ public:
 	 */
 	virtual double getTotalIConcentration() = 0;
 
+	/**
+	 * Get the weights of the given total: the total at a grid point is the
+	 * dot product of the weights and the concentrations (including the
+	 * moments) at this grid point. They are computed when the network is
+	 * reinitialized and give the same totals as getTotalAtomConcentration()
+	 * and the other getters of the total concentrations.
+	 *
+	 * @param type The total
+	 * @return The weights, one per degree of freedom
+	 */
+	virtual const std::vector<double>& getTotalWeights(
+			TotalType type) const = 0;
+
+	/**
+	 * Compute the given total from the concentrations at a grid point,
+	 * without updating the concentrations of the network.
+	 *
+	 * @param type The total
+	 * @param concs The concentrations at the grid point
+	 * @return The total concentration
+	 */
+	virtual double getTotal(TotalType type, const double *concs) const = 0;
+
+	/**
+	 * Compute the given total at several grid points.
+	 *
+	 * @param type The total
+	 * @param concs The concentrations at each grid point
+	 * @param n The number of grid points
+	 * @param totals The total concentration at each grid point
+	 */
+	virtual void getTotals(TotalType type, const double * const *concs, int n,
+			double *totals) const = 0;
+
 	/**
 	 * Calculate all the rate constants for the reactions and dissociations of the network.
 	 * Need to be called only when the temperature changes.
@@ -298,6 +343,22 @@ public:
 	 */
 	virtual void computeAllFluxes(double *updatedConcOffset, int i = 0) = 0;
 
+	/**
+	 * Compute the fluxes generated by all the reactions
+	 * for all the clusters and their momentum, reading the concentrations
+	 * directly from the given array instead of the state stored in each
+	 * reactant. The network does not need to be updated with
+	 * updateConcentrationsFromArray() before calling this method.
+	 *
+	 * @param concOffset The pointer to the array of the concentration at the grid
+	 * point where the fluxes are computed
+	 * @param updatedConcOffset The pointer to the array of the concentration at the grid
+	 * point where the fluxes are computed used to find the next solution
+	 * @param i The location on the grid in the depth direction
+	 */
+	virtual void computeAllFluxes(double *concOffset, double *updatedConcOffset,
+			int i) = 0;
+
 	/**
 	 * Determine the number of partials for each cluster
 	 * and their starting locations within the vectors used
@@ -338,6 +399,68 @@ public:
 			const std::vector<int>& indices, std::vector<double>& vals, int i =
 					0) const = 0;
 
+	/**
+	 * Compute the partial derivatives generated by all the reactions
+	 * for all the clusters and their momentum, reading the concentrations
+	 * directly from the given array instead of the state stored in each
+	 * reactant.
+	 *
+	 * @param concOffset The pointer to the array of the concentration at the grid
+	 * point where the partials are computed
+	 * @param startingIdx Starting index of items owned by each reactant
+	 *      within the partials values array and the indices array.
+	 * @param indices The indices of the clusters for the partial derivatives.
+	 * @param vals The values of partials for the reactions
+	 * @param i The location on the grid in the depth direction
+	 */
+	virtual void computeAllPartials(double *concOffset,
+			const std::vector<size_t>& startingIdx,
+			const std::vector<int>& indices, std::vector<double>& vals,
+			int i) = 0;
+
+	/**
+	 * Can the fluxes and partial derivatives be computed from the
+	 * concentration arrays by several threads at the same time? It is only
+	 * the case if the network doesn't store any state while computing them.
+	 *
+	 * @return True if the computation is stateless
+	 */
+	virtual bool canComputeConcurrently() const = 0;
+
+	/**
+	 * Compute the product of the partial derivatives generated by all the
+	 * reactions with the given vector and add it to the result. The partial
+	 * derivatives between two DOFs with the same block id are left out of
+	 * the product.
+	 *
+	 * @param concOffset The pointer to the array of the concentration at the grid
+	 * point where the product is computed
+	 * @param vecOffset The pointer to the vector multiplied at this grid point
+	 * @param resultOffset The pointer to the array where the product is added
+	 * @param blockIds The block id of each DOF
+	 * @param startingIdx Starting index of items owned by each reactant
+	 *      within the partials values array and the indices array.
+	 * @param indices The indices of the clusters for the partial derivatives.
+	 * @param vals A workspace for the values of partials, of the same size as
+	 *      indices
+	 * @param i The location on the grid in the depth direction
+	 */
+	virtual void computeAllPartialsAction(double *concOffset,
+			const double *vecOffset, double *resultOffset,
+			const std::vector<int>& blockIds,
+			const std::vector<size_t>& startingIdx,
+			const std::vector<int>& indices, std::vector<double>& vals,
+			int i) = 0;
+
+	/**
+	 * Store the read-only data used to compute the fluxes and partial
+	 * derivatives once per node, in memory shared by all the processes of
+	 * the node. This method is collective on MPI_COMM_WORLD and should be
+	 * called once the diagonal fill is known. The memory is freed when the
+	 * network is destroyed, which is collective on the node as well.
+	 */
+	virtual void shareReadOnlyData() = 0;
+
 	/**
 	 * This operation returns the biggest production rate in the network.
 	 *
@@ -345,6 +468,14 @@ public:
 	 */
 	virtual double getBiggestRate() const = 0;
 
+	/**
+	 * This operation returns the number of production and dissociation
+	 * reactions in the network.
+	 *
+	 * @return The number of reactions
+	 */
+	virtual int getNReactions() const = 0;
+
 	/**
 	 * Are dissociations enabled?
 	 *
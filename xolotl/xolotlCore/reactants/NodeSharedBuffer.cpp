@@ -0,0 +1,69 @@
+#include "NodeSharedBuffer.h"
+#include <string>
+
+using namespace xolotlCore;
+
+void NodeSharedBuffer::allocate(MPI_Comm comm, std::size_t nBytes) {
+	// Free the previous window
+	release();
+
+	// Every process has to ask for the same size
+	unsigned long localSize = nBytes, minSize = 0, maxSize = 0;
+	MPI_Allreduce(&localSize, &minSize, 1, MPI_UNSIGNED_LONG, MPI_MIN, comm);
+	MPI_Allreduce(&localSize, &maxSize, 1, MPI_UNSIGNED_LONG, MPI_MAX, comm);
+	if (minSize != maxSize) {
+		throw std::string(
+				"\nNodeSharedBuffer: the processes don't agree on the size "
+						"of the shared buffer.");
+	}
+
+	// Group the processes that can share memory
+	MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+			&nodeComm);
+	MPI_Comm_rank(nodeComm, &nodeRank);
+
+	// Only the first process of the node gets the memory
+	size = nBytes;
+	MPI_Aint localBytes = (nodeRank == 0) ? (MPI_Aint) size : 0;
+	MPI_Win_allocate_shared(localBytes, 1, MPI_INFO_NULL, nodeComm, &base,
+			&window);
+
+	// The other processes point to it
+	if (nodeRank != 0) {
+		MPI_Aint sharedBytes = 0;
+		int dispUnit = 0;
+		MPI_Win_shared_query(window, 0, &sharedBytes, &dispUnit, &base);
+	}
+
+	return;
+}
+
+void NodeSharedBuffer::synchronize() {
+	if (window == MPI_WIN_NULL)
+		return;
+
+	// Make the writes of the first process visible to the node
+	MPI_Win_fence(0, window);
+
+	return;
+}
+
+void NodeSharedBuffer::release() {
+	if (window == MPI_WIN_NULL)
+		return;
+
+	// The memory is already gone if MPI was finalized
+	int finalized = 0;
+	MPI_Finalized(&finalized);
+	if (!finalized) {
+		MPI_Win_free(&window);
+		MPI_Comm_free(&nodeComm);
+	}
+	window = MPI_WIN_NULL;
+	nodeComm = MPI_COMM_NULL;
+	base = nullptr;
+	size = 0;
+	nodeRank = 0;
+
+	return;
+}
@@ -0,0 +1,153 @@
+#ifndef NODESHAREDBUFFER_H
+#define NODESHAREDBUFFER_H
+
+#include <mpi.h>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+namespace xolotlCore {
+
+/**
+ * This class owns a read-only buffer that is stored once per node in an
+ * MPI-3 shared memory window and read by all the processes of the node.
+ *
+ * The buffer is filled by the first process of each node, the other
+ * processes only get a pointer to it.
+ */
+class NodeSharedBuffer {
+
+private:
+
+	//! The communicator of the processes sharing the node
+	MPI_Comm nodeComm;
+
+	//! The shared memory window
+	MPI_Win window;
+
+	//! The start of the buffer
+	char *base;
+
+	//! The size of the buffer in bytes
+	std::size_t size;
+
+	//! The rank in the node communicator
+	int nodeRank;
+
+	/**
+	 * The copy constructor is not allowed, the window can only be freed once.
+	 */
+	NodeSharedBuffer(const NodeSharedBuffer& other) = delete;
+
+	/**
+	 * The copy assignment is not allowed.
+	 */
+	NodeSharedBuffer& operator=(const NodeSharedBuffer& other) = delete;
+
+public:
+
+	/**
+	 * The constructor.
+	 */
+	NodeSharedBuffer() :
+			nodeComm(MPI_COMM_NULL), window(MPI_WIN_NULL), base(nullptr), size(
+					0), nodeRank(0) {
+	}
+
+	/**
+	 * The destructor frees the window if MPI is still running.
+	 */
+	~NodeSharedBuffer() {
+		release();
+	}
+
+	/**
+	 * Allocate the buffer on each node. This method is collective on the
+	 * given communicator and every process has to ask for the same size.
+	 *
+	 * @param comm The communicator of the processes using the buffer
+	 * @param nBytes The size of the buffer in bytes
+	 */
+	void allocate(MPI_Comm comm, std::size_t nBytes);
+
+	/**
+	 * Make the content written by the first process of the node visible
+	 * to all the others. This method is collective on the node.
+	 */
+	void synchronize();
+
+	/**
+	 * Free the window. This method is collective on the node unless MPI
+	 * was already finalized.
+	 */
+	void release();
+
+	/**
+	 * Does this process have to fill the buffer?
+	 *
+	 * @return True for the first process of each node
+	 */
+	bool isNodeMaster() const {
+		return nodeRank == 0;
+	}
+
+	/**
+	 * Was the buffer allocated?
+	 *
+	 * @return True if allocate() was called since the last release()
+	 */
+	bool isAllocated() const {
+		return window != MPI_WIN_NULL;
+	}
+
+	/**
+	 * Get the start of the buffer, only the first process of the node
+	 * should write in it.
+	 *
+	 * @return The pointer to the buffer
+	 */
+	char *data() const {
+		return base;
+	}
+
+	/**
+	 * Get the size of the buffer.
+	 *
+	 * @return The size in bytes
+	 */
+	std::size_t getSize() const {
+		return size;
+	}
+
+	/**
+	 * Place an array in a packed buffer, or get its position in it. The
+	 * private array is released once the pointer points to the buffer.
+	 *
+	 * @param vec The array
+	 * @param ptr The pointer to the array in the buffer
+	 * @param total The size of the buffer so far, updated
+	 * @param base The start of the buffer, nullptr to only compute the size
+	 * @param write Should the array be copied in the buffer?
+	 */
+	template<typename T>
+	static void packArray(std::vector<T>& vec, const T*& ptr,
+			std::size_t& total, char *base, bool write) {
+		// Keep every array aligned on 8 bytes
+		std::size_t offset = (total + 7) / 8 * 8;
+		total = offset + vec.size() * sizeof(T);
+		if (!base)
+			return;
+
+		T *dest = reinterpret_cast<T*>(base + offset);
+		if (write)
+			std::copy(vec.begin(), vec.end(), dest);
+		ptr = dest;
+		std::vector<T>().swap(vec);
+
+		return;
+	}
+};
+//end class NodeSharedBuffer
+
+} /* namespace xolotlCore */
+#endif
@@ -13,8 +13,8 @@ namespace xolotlCore {
 Reactant::Reactant(IReactionNetwork& _network,
 		std::shared_ptr<xolotlPerf::IHandlerRegistry> registry,
 		const std::string& _name) :
-		concentration(0.0), id(0), type(ReactantType::Invalid), network(
-				_network), handlerRegistry(registry), size(0), formationEnergy(
+		concentration(0.0), id(0), type(ReactantType::Invalid), inNetworkTable(
+				false), diffusionColumn(-1), network(_network), handlerRegistry(registry), size(0), formationEnergy(
 				0.0), diffusionFactor(0.0), migrationEnergy(0.0), name(_name), reactionRadius(
 				0.0) {
 
@@ -22,32 +22,32 @@ Reactant::Reactant(IReactionNetwork& _network,
 
 void Reactant::recomputeDiffusionCoefficient(double temp, int i) {
 	// Return zero if the diffusion factor is zero.
-	if (!xolotlCore::equal(diffusionFactor, 0.0)) {
+	if (diffusionColumn >= 0 && !xolotlCore::equal(diffusionFactor, 0.0)) {
 		// Otherwise use the Arrhenius equation to compute the diffusion
 		// coefficient
 		double k_b = xolotlCore::kBoltzmann;
 		double kernel = -1.0 * migrationEnergy / (k_b * temp);
-		diffusionCoefficient[i] = diffusionFactor * exp(kernel);
+		diffusionTable->getRow(i)[diffusionColumn] = diffusionFactor
+				* exp(kernel);
 	}
 
 	return;
 }
 
 void Reactant::addGridPoints(int i) {
-	// Add grid points
-	if (i > 0) {
-		while (i > 0) {
-			diffusionCoefficient.emplace(diffusionCoefficient.begin(), 0.0);
-			temperature.emplace(temperature.begin(), 0.0);
-
-			// Decrease i
-			i--;
-		}
-	} else {
-		diffusionCoefficient.erase(diffusionCoefficient.begin(),
-				diffusionCoefficient.begin() - i);
-		temperature.erase(temperature.begin(), temperature.begin() - i);
-	}
+	// Create a table if the reactant is not in a network
+	if (!diffusionTable)
+		diffusionTable = std::make_shared<DiffusionCoefficientTable>();
+
+	// Get a column in the table
+	if (diffusionColumn < 0)
+		diffusionColumn = diffusionTable->addColumn(diffusionFactor,
+				migrationEnergy);
+
+	// The network adds the grid points to its table itself
+	if (!inNetworkTable)
+		diffusionTable->addGridPoints(i);
+
 	return;
 }
 
@@ -64,7 +64,7 @@ std::vector<int> Reactant::getConnectivity() const {
 }
 
 void Reactant::setTemperature(double temp, int i) {
-	temperature[i] = temp;
+	diffusionTable->setTemperature(temp, i);
 
 	// Recompute the diffusion coefficient
 	recomputeDiffusionCoefficient(temp, i);
@@ -73,6 +73,9 @@ void Reactant::setTemperature(double temp, int i) {
 void Reactant::setDiffusionFactor(const double factor) {
 	// Set the diffusion factor
 	diffusionFactor = factor;
+	if (diffusionColumn >= 0)
+		diffusionTable->setColumn(diffusionColumn, diffusionFactor,
+				migrationEnergy);
 
 	return;
 }
@@ -80,6 +83,9 @@ void Reactant::setDiffusionFactor(const double factor) {
 void Reactant::setMigrationEnergy(const double energy) {
 	// Set the migration energy
 	migrationEnergy = energy;
+	if (diffusionColumn >= 0)
+		diffusionTable->setColumn(diffusionColumn, diffusionFactor,
+				migrationEnergy);
 
 	return;
 }
@@ -9,6 +9,7 @@
 #include "IReactionNetwork.h"
 #include "ProductionReaction.h"
 #include "DissociationReaction.h"
+#include "DiffusionCoefficientTable.h"
 
 namespace xolotlPerf {
 class IHandlerRegistry;
@@ -92,10 +93,23 @@ protected:
 	int momId[4] = { };
 
 	/**
-	 * The temperature at which the cluster currently exists. The diffusion
-	 * coefficient is recomputed each time the temperature is changed.
+	 * The table of the temperature and of the diffusion coefficients at each
+	 * grid point. It is the one of the network once the reactant is added to
+	 * it, otherwise the reactant creates its own when grid points are added.
 	 */
-	std::vector<double> temperature;
+	std::shared_ptr<DiffusionCoefficientTable> diffusionTable;
+
+	/**
+	 * Whether diffusionTable is the one of the network, which is then
+	 * responsible for adding and removing its grid points.
+	 */
+	bool inNetworkTable;
+
+	/**
+	 * The column of this reactant in diffusionTable, -1 until it gets one
+	 * when grid points are added.
+	 */
+	int diffusionColumn;
 
 	/**
 	 * The reaction network that includes this reactant.
@@ -125,13 +139,6 @@ protected:
 	 */
 	double diffusionFactor;
 
-	/**
-	 * The diffusion coefficient computed from the diffusion factor using an
-	 * Arrhenius rate equation. It is re-computed every time the temperature is
-	 * updated.
-	 */
-	std::vector<double> diffusionCoefficient;
-
 	/**
 	 * The formation energy of this cluster. It will be used to compute the
 	 * binding energies appearing in the dissociation constant calculation.
@@ -205,12 +212,14 @@ public:
 	 */
 	Reactant(Reactant &other) :
 			concentration(other.concentration), name(other.name), type(
-					other.type), id(other.id), temperature(other.temperature), network(
-					other.network), handlerRegistry(other.handlerRegistry), size(
-					other.size), composition(other.composition), formationEnergy(
+					other.type), id(other.id), diffusionTable(
+					other.diffusionTable), inNetworkTable(
+					other.inNetworkTable), diffusionColumn(
+					other.diffusionColumn), network(other.network), handlerRegistry(
+					other.handlerRegistry), size(other.size), composition(
+					other.composition), formationEnergy(
 					other.formationEnergy), diffusionFactor(
-					other.diffusionFactor), diffusionCoefficient(
-					other.diffusionCoefficient), migrationEnergy(
+					other.diffusionFactor), migrationEnergy(
 					other.migrationEnergy), reactionRadius(
 					other.reactionRadius), reactionConnectivitySet(
 					other.reactionConnectivitySet), dissociationConnectivitySet(
@@ -527,6 +536,19 @@ public:
 	 */
 	virtual void addGridPoints(int i) override;
 
+	/**
+	 * Use the given table for the temperature and the diffusion coefficient
+	 * at each grid point.
+	 *
+	 * @param table The table of the network
+	 */
+	void setDiffusionTable(std::shared_ptr<DiffusionCoefficientTable> table)
+			override {
+		diffusionTable = table;
+		inNetworkTable = true;
+		diffusionColumn = -1;
+	}
+
 	/**
 	 * This operation returns a list that represents the connectivity
 	 * between this reactant and other reactants in the network.
@@ -671,7 +693,7 @@ public:
 	 * @return The temperature.
 	 */
 	double getTemperature(int i) const override {
-		return temperature[i];
+		return diffusionTable->getTemperature(i);
 	}
 
 	/**
@@ -728,7 +750,10 @@ public:
 	 * @return The diffusion coefficient
 	 */
 	double getDiffusionCoefficient(int i) const override {
-		return diffusionCoefficient[i];
+		if (diffusionColumn < 0)
+			return 0.0;
+
+		return diffusionTable->getRow(i)[diffusionColumn];
 	}
 
 	/**
@@ -11,6 +11,9 @@ ReactionNetwork::ReactionNetwork(
 		knownReactantTypes(_knownReactantTypes), handlerRegistry(_registry), temperature(
 				0.0), dissociationsEnabled(true) {
 
+	// Create the table shared by the reactants
+	diffusionTable = std::make_shared<DiffusionCoefficientTable>();
+
 	// Ensure our per-type cluster map can store Reactants of the types
 	// we support.
 	for (auto const& currType : knownReactantTypes) {
@@ -48,6 +51,9 @@ void ReactionNetwork::add(std::unique_ptr<IReactant> reactant) {
 		maxClusterSizeMap[reactant->getType()] = std::max(reactant->getSize(),
 				maxClusterSizeMap[reactant->getType()]);
 
+		// Give it the table of the diffusion coefficients
+		reactant->setDiffusionTable(diffusionTable);
+
 		// Note the reactant in our flat list of all reactants.
 		allReactants.emplace_back(*reactant);
 
@@ -129,18 +135,59 @@ void ReactionNetwork::updateConcentrationsFromArray(double * concentrations) {
 	return;
 }
 
+void ReactionNetwork::computeTotalWeights() {
+	// The default getters of the totals return zero
+	int dof = getDOF();
+	for (auto& weights : totalWeights)
+		weights.assign(dof, 0.0);
+
+	return;
+}
+
+double ReactionNetwork::getTotal(TotalType type,
+		const double *concs) const {
+	auto const& weights = totalWeights[(int) type];
+	if (weights.empty()) {
+		throw std::string(
+				"\nReactionNetwork::getTotal: the weights of the totals are "
+						"not computed, the network must be reinitialized first.");
+	}
+	int n = weights.size();
+
+	// Independent partial sums so that the loop can be vectorized
+	double sums[4] = { 0.0, 0.0, 0.0, 0.0 };
+	int l = 0;
+	for (; l + 3 < n; l += 4) {
+		sums[0] += weights[l] * concs[l];
+		sums[1] += weights[l + 1] * concs[l + 1];
+		sums[2] += weights[l + 2] * concs[l + 2];
+		sums[3] += weights[l + 3] * concs[l + 3];
+	}
+	for (; l < n; l++) {
+		sums[0] += weights[l] * concs[l];
+	}
+
+	return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+void ReactionNetwork::getTotals(TotalType type, const double * const *concs,
+		int n, double *totals) const {
+	for (int i = 0; i < n; i++) {
+		totals[i] = getTotal(type, concs[i]);
+	}
+
+	return;
+}
+
 void ReactionNetwork::setTemperature(double temp, int i) {
 	// Set the temperature
 	temperature = temp;
 
-	// Update the temperature for all of the clusters
-	std::for_each(allReactants.begin(), allReactants.end(),
-			[&temp,&i](IReactant& currReactant) {
-
-				// This part will set the temperature in each reactant
-				// and recompute the diffusion coefficient
-				currReactant.setTemperature(temp, i);
-			});
+	// Update the temperature for all of the clusters and recompute their
+	// diffusion coefficients only if it changed
+	diffusionTable->setTemperature(temp, i);
+	if (!diffusionTable->isComputed(i))
+		recomputeDiffusionCoefficients(i);
 
 	return;
 }
@@ -272,7 +319,10 @@ void ReactionNetwork::computeRateConstants(int i) {
 }
 
 void ReactionNetwork::addGridPoints(int i) {
-	// Add grid points to the diffusing clusters first
+	// Add grid points to the table of the diffusion coefficients
+	diffusionTable->addGridPoints(i);
+
+	// Give a column of the table to the new diffusing clusters
 	for (IReactant& currReactant : allReactants) {
 		currReactant.addGridPoints(i);
 	}
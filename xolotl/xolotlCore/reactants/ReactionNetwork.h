@@ -3,6 +3,7 @@
 
 // Includes
 #include <map>
+#include <array>
 #include <unordered_map>
 #include <algorithm>
 #include <cassert>
@@ -139,6 +140,11 @@ protected:
 	std::unique_ptr<DissociationReaction> >;
 	DissociationReactionMap dissociationReactionMap;
 
+	/**
+	 * The weights of each total, see getTotalWeights().
+	 */
+	std::array<std::vector<double>, numTotalTypes> totalWeights;
+
 	/**
 	 * A map for storing the dfill configuration and accelerating the formation of
 	 * the Jacobian. Its keys are reactant/cluster ids and its values are integer
@@ -158,6 +164,23 @@ protected:
 	 */
 	double temperature;
 
+	/**
+	 * The temperature and the diffusion coefficients of the diffusing
+	 * reactants at each grid point, shared with the reactants.
+	 */
+	std::shared_ptr<DiffusionCoefficientTable> diffusionTable;
+
+	/**
+	 * Recompute the diffusion coefficients of all the diffusing reactants
+	 * at a grid point from its temperature. The base class uses the
+	 * Arrhenius equation.
+	 *
+	 * @param i The location on the grid in the depth direction
+	 */
+	virtual void recomputeDiffusionCoefficients(int i) {
+		diffusionTable->computeArrhenius(i);
+	}
+
 	/**
 	 * The biggest rate for this cluster
 	 */
@@ -269,6 +292,16 @@ protected:
 				std::numeric_limits<std::size_t>::max();
 	}
 
+	/**
+	 * Compute the weights of the totals, see getTotalWeights(). The weights
+	 * must give the same totals as the getters of the total concentrations
+	 * (getTotalAtomConcentration(), ...) of the network. This default gives
+	 * zero weights like the default getters, the daughter classes defining
+	 * their own getters override it. It is called at the end of
+	 * reinitializeNetwork(), once the ids are known.
+	 */
+	virtual void computeTotalWeights();
+
 public:
 
 	/**
@@ -299,7 +332,8 @@ public:
 
 	/**
 	 * This operation sets the temperature at which the reactants currently
-	 * exists. It calls setTemperature() on each reactant.
+	 * exists. It sets it in the table shared with the reactants and
+	 * recomputes their diffusion coefficients if it changed.
 	 *
 	 * This is the simplest way to set the temperature for all reactants.
 	 *
@@ -574,6 +608,36 @@ public:
 		return 0.0;
 	}
 
+	/**
+	 * Get the weights of the given total.
+	 *
+	 * @param type The total
+	 * @return The weights, empty until the network is reinitialized
+	 */
+	const std::vector<double>& getTotalWeights(TotalType type) const override {
+		return totalWeights[(int) type];
+	}
+
+	/**
+	 * Compute the given total from the concentrations at a grid point.
+	 *
+	 * @param type The total
+	 * @param concs The concentrations at the grid point
+	 * @return The total concentration
+	 */
+	double getTotal(TotalType type, const double *concs) const override;
+
+	/**
+	 * Compute the given total at several grid points.
+	 *
+	 * @param type The total
+	 * @param concs The concentrations at each grid point
+	 * @param n The number of grid points
+	 * @param totals The total concentration at each grid point
+	 */
+	void getTotals(TotalType type, const double * const *concs, int n,
+			double *totals) const override;
+
 	/**
 	 * Calculate all the rate constants for the reactions and dissociations of the network.
 	 * Need to be called only when the temperature changes.
@@ -585,7 +649,8 @@ public:
 	virtual void computeRateConstants(int i) override;
 
 	/**
-	 * Add grid points to the vector of rates or remove them if the value is negative.
+	 * Add grid points to the vector of rates and to the table of diffusion
+	 * coefficients or remove them if the value is negative.
 	 *
 	 * @param i The number of grid point to add or remove
 	 */
@@ -607,6 +672,119 @@ public:
 		return;
 	}
 
+	/**
+	 * Compute the fluxes generated by all the reactions
+	 * for all the clusters and their momentum, from the given array.
+	 *
+	 * The default implementation copies the concentrations into the
+	 * reactants and calls the method above, subclasses can override it
+	 * with a stateless version.
+	 *
+	 * @param concOffset The pointer to the array of the concentration at the grid
+	 * point where the fluxes are computed
+	 * @param updatedConcOffset The pointer to the array of the concentration at the grid
+	 * point where the fluxes are computed used to find the next solution
+	 * @param i The location on the grid in the depth direction
+	 */
+	virtual void computeAllFluxes(double *concOffset, double *updatedConcOffset,
+			int i) override {
+		updateConcentrationsFromArray(concOffset);
+		computeAllFluxes(updatedConcOffset, i);
+		return;
+	}
+
+	// The stateful version is implemented in the subclasses
+	using IReactionNetwork::computeAllPartials;
+
+	/**
+	 * Compute the partial derivatives generated by all the reactions
+	 * for all the clusters and their momentum, from the given array.
+	 *
+	 * The default implementation copies the concentrations into the
+	 * reactants and calls computeAllPartials(), subclasses can override it
+	 * with a stateless version.
+	 *
+	 * @param concOffset The pointer to the array of the concentration at the grid
+	 * point where the partials are computed
+	 * @param startingIdx Starting index of items owned by each reactant
+	 *      within the partials values array and the indices array.
+	 * @param indices The indices of the clusters for the partial derivatives.
+	 * @param vals The values of partials for the reactions
+	 * @param i The location on the grid in the depth direction
+	 */
+	virtual void computeAllPartials(double *concOffset,
+			const std::vector<size_t>& startingIdx,
+			const std::vector<int>& indices, std::vector<double>& vals,
+			int i) override {
+		updateConcentrationsFromArray(concOffset);
+		computeAllPartials(startingIdx, indices, vals, i);
+		return;
+	}
+
+	/**
+	 * Can the fluxes and partial derivatives be computed from the
+	 * concentration arrays by several threads at the same time?
+	 *
+	 * The default implementation copies the concentrations into the
+	 * reactants so it is not possible.
+	 *
+	 * @return False
+	 */
+	virtual bool canComputeConcurrently() const override {
+		return false;
+	}
+
+	/**
+	 * Compute the product of the partial derivatives generated by all the
+	 * reactions with the given vector and add it to the result, leaving out
+	 * the partial derivatives between two DOFs of the same block.
+	 *
+	 * The default implementation computes all the partial derivatives in
+	 * the workspace and multiplies them.
+	 *
+	 * @param concOffset The pointer to the array of the concentration at the grid
+	 * point where the product is computed
+	 * @param vecOffset The pointer to the vector multiplied at this grid point
+	 * @param resultOffset The pointer to the array where the product is added
+	 * @param blockIds The block id of each DOF
+	 * @param startingIdx Starting index of items owned by each reactant
+	 *      within the partials values array and the indices array.
+	 * @param indices The indices of the clusters for the partial derivatives.
+	 * @param vals A workspace for the values of partials
+	 * @param i The location on the grid in the depth direction
+	 */
+	virtual void computeAllPartialsAction(double *concOffset,
+			const double *vecOffset, double *resultOffset,
+			const std::vector<int>& blockIds,
+			const std::vector<size_t>& startingIdx,
+			const std::vector<int>& indices, std::vector<double>& vals,
+			int i) override {
+		std::fill(vals.begin(), vals.end(), 0.0);
+		computeAllPartials(concOffset, startingIdx, indices, vals, i);
+
+		// The items of each reactant end where the next ones start
+		const int nRows = startingIdx.size();
+		for (int row = 0; row < nRows; row++) {
+			auto end = (row + 1 < nRows) ? startingIdx[row + 1] : indices.size();
+			for (auto k = startingIdx[row]; k < end; k++) {
+				if (blockIds[indices[k]] != blockIds[row])
+					resultOffset[row] += vals[k] * vecOffset[indices[k]];
+			}
+		}
+
+		return;
+	}
+
+	/**
+	 * Store the read-only data used to compute the fluxes and partial
+	 * derivatives once per node.
+	 *
+	 * The default implementation keeps everything private to the process.
+	 */
+	virtual void shareReadOnlyData() override {
+		return;
+	}
+
 	/**
 	 * This operation returns the biggest production rate in the network.
 	 *
@@ -616,6 +794,16 @@ public:
 		return biggestRate;
 	}
 
+	/**
+	 * This operation returns the number of production and dissociation
+	 * reactions in the network.
+	 *
+	 * @return The number of reactions
+	 */
+	int getNReactions() const override {
+		return productionReactionMap.size() + dissociationReactionMap.size();
+	}
+
 	/**
 	 * Are dissociations enabled?
 	 * @return true if reactions are enabled, false otherwise.
@@ -133,14 +133,11 @@ std::unique_ptr<IReactionNetwork> AlloyClusterNetworkLoader::load(
 
 	// Loop on the clusters
 	for (int i = 0; i < normalSize + superSize; i++) {
-		// Open the cluster group
-		XFile::ClusterGroup clusterGroup(*networkGroup, i);
-
 		if (i < normalSize) {
 			// Normal cluster
 			// Read the composition
-			auto comp = clusterGroup.readCluster(formationEnergy,
-					migrationEnergy, diffusionFactor);
+			auto comp = networkGroup->readCluster(i,
+					formationEnergy, migrationEnergy, diffusionFactor);
 			numV = comp[toCompIdx(Species::V)];
 			numI = comp[toCompIdx(Species::I)];
 			numFaulted = comp[toCompIdx(Species::Faulted)];
@@ -164,7 +161,7 @@ std::unique_ptr<IReactionNetwork> AlloyClusterNetworkLoader::load(
 			// Super cluster
 			int nTot = 0, maxAtom = 0;
 			ReactantType type;
-			clusterGroup.readAlloySuperCluster(nTot, maxAtom, type);
+			networkGroup->readAlloySuperCluster(i, nTot, maxAtom, type);
 
 			// Create the cluster
 			auto nextCluster = createAlloySuperCluster(nTot, maxAtom, type,
@@ -363,6 +363,9 @@ void AlloyClusterReactionNetwork::reinitializeNetwork() {
 				}
 			});
 
+	// The ids are known now
+	computeTotalWeights();
+
 	return;
 }
 
@@ -137,14 +137,11 @@ std::unique_ptr<IReactionNetwork> FeClusterNetworkLoader::load(
 
 	// Loop on the clusters
 	for (int i = 0; i < normalSize + superSize; i++) {
-		// Open the cluster group
-		XFile::ClusterGroup clusterGroup(*networkGroup, i);
-
 		if (i < normalSize) {
 			// Normal cluster
 			// Read the composition
-			auto comp = clusterGroup.readCluster(formationEnergy,
-					migrationEnergy, diffusionFactor);
+			auto comp = networkGroup->readCluster(i,
+					formationEnergy, migrationEnergy, diffusionFactor);
 			numHe = comp[toCompIdx(Species::He)];
 			numV = comp[toCompIdx(Species::V)];
 			numI = comp[toCompIdx(Species::I)];
@@ -166,7 +163,7 @@ std::unique_ptr<IReactionNetwork> FeClusterNetworkLoader::load(
 			network->add(std::move(nextCluster));
 		} else {
 			// Super cluster
-			auto bounds = clusterGroup.readFeSuperCluster();
+			auto bounds = networkGroup->readFeSuperCluster(i);
 
 			// Create the cluster
 			auto nextCluster = createFeSuperCluster(bounds, *network);
@@ -585,6 +585,84 @@ void FeClusterReactionNetwork::reinitializeNetwork() {
 				}
 			});
 
+	// The ids are known now
+	computeTotalWeights();
+
+	return;
+}
+
+void FeClusterReactionNetwork::computeTotalWeights() {
+	// Start from zero weights
+	int dof = getDOF();
+	for (auto& weights : totalWeights)
+		weights.assign(dof, 0.0);
+	auto& heWeights = totalWeights[(int) TotalType::HeAtom];
+	auto& trappedWeights = totalWeights[(int) TotalType::TrappedHeAtom];
+	auto& vWeights = totalWeights[(int) TotalType::V];
+	auto& iWeights = totalWeights[(int) TotalType::I];
+
+	// The single species clusters
+	for (auto const& currMapItem : getAll(ReactantType::He)) {
+		auto const& cluster = *(currMapItem.second);
+		heWeights[cluster.getId() - 1] += (double) cluster.getSize();
+	}
+	for (auto const& currMapItem : getAll(ReactantType::V)) {
+		auto const& cluster = *(currMapItem.second);
+		vWeights[cluster.getId() - 1] += (double) cluster.getSize();
+	}
+	for (auto const& currMapItem : getAll(ReactantType::I)) {
+		auto const& cluster = *(currMapItem.second);
+		iWeights[cluster.getId() - 1] += (double) cluster.getSize();
+	}
+
+	// The mixed clusters
+	for (auto const& currMapItem : getAll(ReactantType::HeV)) {
+		auto const& cluster = *(currMapItem.second);
+		auto& comp = cluster.getComposition();
+		double heContent = comp[toCompIdx(Species::He)];
+		heWeights[cluster.getId() - 1] += heContent;
+		trappedWeights[cluster.getId() - 1] += heContent;
+		vWeights[cluster.getId() - 1] += comp[toCompIdx(Species::V)];
+	}
+
+	// The super clusters, the concentration of each member is the zeroth
+	// moment plus the distances times the helium and vacancy moments
+	for (auto const& currMapItem : getAll(ReactantType::FeSuper)) {
+		auto const& cluster =
+				static_cast<FeSuperCluster&>(*(currMapItem.second));
+		double heZeroth = 0.0, heFirst[2] = { 0.0, 0.0 };
+		double vZeroth = 0.0, vFirst[2] = { 0.0, 0.0 };
+		for (auto const& i : cluster.getHeBounds()) {
+			for (auto const& j : cluster.getVBounds()) {
+				double heDistance = cluster.getHeDistance(i);
+				double vDistance = cluster.getVDistance(j);
+				heZeroth += (double) i;
+				heFirst[0] += heDistance * (double) i;
+				heFirst[1] += vDistance * (double) i;
+				vZeroth += (double) j;
+				vFirst[0] += heDistance * (double) j;
+				vFirst[1] += vDistance * (double) j;
+			}
+		}
+
+		// Add them to the totals
+		auto addContent = [&cluster](std::vector<double>& currWeights,
+				double zeroth, const double first[2]) {
+			currWeights[cluster.getId() - 1] += zeroth;
+			currWeights[cluster.getMomentId(0) - 1] += first[0];
+			currWeights[cluster.getMomentId(1) - 1] += first[1];
+		};
+		addContent(heWeights, heZeroth, heFirst);
+		addContent(trappedWeights, heZeroth, heFirst);
+		addContent(vWeights, vZeroth, vFirst);
+	}
+
+	// The other atoms are counted as helium
+	totalWeights[(int) TotalType::DAtom] = heWeights;
+	totalWeights[(int) TotalType::TAtom] = heWeights;
+	totalWeights[(int) TotalType::TrappedDAtom] = trappedWeights;
+	totalWeights[(int) TotalType::TrappedTAtom] = trappedWeights;
+
 	return;
 }
 
@@ -197,6 +197,14 @@ private:
 	void checkForDissociation(IReactant& emittingReactant,
 			ProductionReaction& reaction, int a[4] = { }, int b[4] = { });
 
+	/**
+	 * Compute the weights of the totals from the clusters, their compositions
+	 * and, for the super clusters, the contribution of the moments to the
+	 * content of their members. Like getTotalAtomConcentration(), the totals
+	 * of all the atoms are the helium one.
+	 */
+	void computeTotalWeights() override;
+
 public:
 
 	/**
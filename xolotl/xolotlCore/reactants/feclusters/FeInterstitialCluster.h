@@ -102,7 +102,8 @@ public:
 		// Compute the loss to dislocation sinks
 		if (size < 2) {
 			// bias * k^2 * D * C
-			flux += sinkStrength * diffusionCoefficient[i] * concentration;
+			flux += sinkStrength * Reactant::getDiffusionCoefficient(i)
+					* concentration;
 		}
 
 		return flux;
@@ -125,7 +126,8 @@ public:
 		// Compute the loss to dislocation sinks
 		if (size < 2) {
 			// bias * k^2 * D * C
-			partials[id - 1] -= sinkStrength * diffusionCoefficient[i];
+			partials[id - 1] -= sinkStrength
+					* Reactant::getDiffusionCoefficient(i);
 		}
 
 		return;
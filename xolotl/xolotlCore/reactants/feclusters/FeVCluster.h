@@ -99,7 +99,7 @@ public:
 		// Compute the loss to dislocation sinks
 		if (size < 5) {
 			// k^2 * D * C
-			flux += sinkStrength * diffusionCoefficient[i]
+			flux += sinkStrength * Reactant::getDiffusionCoefficient(i)
 					* concentration;
 		}
 
@@ -123,7 +123,8 @@ public:
 		// Compute the loss to dislocation sinks
 		if (size < 5) {
 			// k^2 * D * C
-			partials[id - 1] -= sinkStrength * diffusionCoefficient[i];
+			partials[id - 1] -= sinkStrength
+					* Reactant::getDiffusionCoefficient(i);
 		}
 
 		return;
@@ -6,23 +6,14 @@
 
 using namespace xolotlCore;
 
-void NECluster::recomputeDiffusionCoefficient(double temp, int i) {
-	// Return zero if the diffusion factor is zero.
-	if (xolotlCore::equal(diffusionFactor, 0.0))
-		return;
-
-	// If the diffusivity is given
-	if (migrationEnergy < 0.0) {
-		diffusionCoefficient[i] = diffusionFactor;
-		return;
-	}
-
+double NECluster::computeDiffusionCoefficient(double temp,
+		double fissionRate) {
 	// Intrinsic diffusion
 	double kernel = -3.04 / (xolotlCore::kBoltzmann * temp);
 	double D3 = 7.6e8 * exp(kernel); // nm2/s
 
-	// We need the fission rate now
-	double fissionRate = network.getFissionRate() * 1.0e27; // #/m3/s
+	// We need the fission rate in #/m3/s
+	fissionRate *= 1.0e27;
 
 	// Athermal diffusion
 	double D1 = (8e-40 * fissionRate) * 1.0e18; // nm2/s
@@ -31,7 +22,22 @@ void NECluster::recomputeDiffusionCoefficient(double temp, int i) {
 	kernel = -1.2 / (xolotlCore::kBoltzmann * temp);
 	double D2 = (5.6e-25 * sqrt(fissionRate) * exp(kernel)) * 1.0e18; // nm2/s
 
-	diffusionCoefficient[i] = D1 + D2 + D3;
+	return D1 + D2 + D3;
+}
+
+void NECluster::recomputeDiffusionCoefficient(double temp, int i) {
+	// Return zero if the diffusion factor is zero.
+	if (diffusionColumn < 0 || xolotlCore::equal(diffusionFactor, 0.0))
+		return;
+
+	// If the diffusivity is given
+	if (migrationEnergy < 0.0) {
+		diffusionTable->getRow(i)[diffusionColumn] = diffusionFactor;
+		return;
+	}
+
+	diffusionTable->getRow(i)[diffusionColumn] = computeDiffusionCoefficient(
+			temp, network.getFissionRate());
 
 	return;
 }
@@ -204,6 +204,17 @@ public:
 	virtual ~NECluster() {
 	}
 
+	/**
+	 * Compute the diffusion coefficient of the clusters that don't have a
+	 * given diffusivity (negative migration energy) as the sum of the
+	 * intrinsic, athermal, and radiation-enhanced diffusions.
+	 *
+	 * @param temp The temperature
+	 * @param fissionRate The fission rate of the network
+	 * @return The diffusion coefficient
+	 */
+	static double computeDiffusionCoefficient(double temp, double fissionRate);
+
 	/**
 	 * Note that we result from the given reaction.
 	 * Assumes the reaction is already in our network.
@@ -130,14 +130,11 @@ std::unique_ptr<IReactionNetwork> NEClusterNetworkLoader::load(
 
 	// Loop on the clusters
 	for (int i = 0; i < normalSize + superSize; i++) {
-		// Open the cluster group
-		XFile::ClusterGroup clusterGroup(*networkGroup, i);
-
 		if (i < normalSize) {
 			// Normal cluster
 			// Read the composition
-			auto comp = clusterGroup.readCluster(formationEnergy,
-					migrationEnergy, diffusionFactor);
+			auto comp = networkGroup->readCluster(i,
+					formationEnergy, migrationEnergy, diffusionFactor);
 			numXe = comp[toCompIdx(Species::Xe)];
 
 			// Create the cluster
@@ -163,7 +160,7 @@ std::unique_ptr<IReactionNetwork> NEClusterNetworkLoader::load(
 		} else {
 			// Super cluster
 			int nTot = 0, maxXe = 0;
-			clusterGroup.readNESuperCluster(nTot, maxXe);
+			networkGroup->readNESuperCluster(i, nTot, maxXe);
 
 			// Create the cluster
 			auto nextCluster = createNESuperCluster(nTot, maxXe, *network);
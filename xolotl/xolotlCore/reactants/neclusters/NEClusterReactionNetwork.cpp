@@ -161,6 +161,26 @@ void NEClusterReactionNetwork::checkForDissociation(
 	return;
 }
 
+void NEClusterReactionNetwork::recomputeDiffusionCoefficients(int i) {
+	// Get the row and the columns
+	double *row = diffusionTable->getRow(i);
+	const double *factor = diffusionTable->getDiffusionFactors();
+	const double *energy = diffusionTable->getMigrationEnergies();
+	const int nColumns = diffusionTable->getNumberOfColumns();
+
+	// The diffusion coefficient is the same for all the clusters without a
+	// given diffusivity
+	double coef = NECluster::computeDiffusionCoefficient(
+			diffusionTable->getTemperature(i), fissionRate);
+
+	for (int c = 0; c < nColumns; c++) {
+		row[c] = (factor[c] > 0.0) ? ((energy[c] < 0.0) ? factor[c] : coef) : 0.0;
+	}
+	diffusionTable->setComputed(i);
+
+	return;
+}
+
 void NEClusterReactionNetwork::setTemperature(double temp, int i) {
 	ReactionNetwork::setTemperature(temp, i);
 
@@ -198,6 +218,42 @@ void NEClusterReactionNetwork::reinitializeNetwork() {
 				}
 			});
 
+	// The ids are known now
+	computeTotalWeights();
+
+	return;
+}
+
+void NEClusterReactionNetwork::computeTotalWeights() {
+	// Start from zero weights
+	int dof = getDOF();
+	for (auto& weights : totalWeights)
+		weights.assign(dof, 0.0);
+	auto& xeWeights = totalWeights[(int) TotalType::HeAtom];
+
+	// The xenon clusters
+	for (auto const& currMapItem : getAll(ReactantType::Xe)) {
+		auto const& cluster = *(currMapItem.second);
+		xeWeights[cluster.getId() - 1] += (double) cluster.getSize();
+	}
+
+	// The super clusters, the concentration of each member is the zeroth
+	// moment plus the distance times the first moment
+	for (auto const& currMapItem : getAll(ReactantType::NESuper)) {
+		auto const& cluster =
+				static_cast<NESuperCluster&>(*(currMapItem.second));
+		int nTot = cluster.getNTot();
+		double zeroth = 0.0, first = 0.0;
+		for (int k = 0; k < nTot; k++) {
+			int index = (int) (cluster.getAverage() - (double) nTot / 2.0) + k
+					+ 1;
+			zeroth += (double) index;
+			first += cluster.getDistance(index) * (double) index;
+		}
+		xeWeights[cluster.getId() - 1] += zeroth;
+		xeWeights[cluster.getMomentId() - 1] += first;
+	}
+
 	return;
 }
 
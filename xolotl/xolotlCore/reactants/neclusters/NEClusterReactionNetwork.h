@@ -103,6 +103,24 @@ private:
 		return true;
 	}
 
+protected:
+
+	/**
+	 * Recompute the diffusion coefficients of all the diffusing reactants
+	 * at a grid point from its temperature and the fission rate.
+	 *
+	 * @param i The location on the grid in the depth direction
+	 */
+	void recomputeDiffusionCoefficients(int i) override;
+
+	/**
+	 * Compute the weights of the totals from the clusters and, for the super
+	 * clusters, the contribution of the moment to the content of their
+	 * members. Like getTotalAtomConcentration(), the xenon is the first atom
+	 * (the helium one) and the other totals are zero.
+	 */
+	void computeTotalWeights() override;
+
 public:
 
 	/**
@@ -230,6 +248,8 @@ public:
 	 */
 	void setFissionRate(double rate) override {
 		fissionRate = rate;
+		// The diffusion coefficients depend on it
+		diffusionTable->invalidate();
 		return;
 	}
 
@@ -3,9 +3,11 @@
 #include <limits>
 #include <algorithm>
 #include <vector>
+#include <sstream>
 #include "PSIClusterReactionNetwork.h"
 #include <xolotlPerf.h>
 #include "xolotlCore/io/XFile.h"
+#include "xolotlCore/io/NetworkCache.h"
 
 namespace xolotlCore {
 
@@ -46,16 +48,16 @@ std::unique_ptr<IReactionNetwork> HDF5NetworkLoader::load(
 	// Set the hydrogan radius factor
 	hydrogenRadiusFactor = options.getHydrogenFactor();
 
+	// Set the rate cache
+	network->setRateCacheBinWidth(options.getRateCacheBinWidth());
+
 	// Loop on the clusters
 	for (int i = 0; i < normalSize + superSize; i++) {
-		// Open the cluster group
-		XFile::ClusterGroup clusterGroup(*networkGroup, i);
-
 		if (i < normalSize) {
 			// Normal cluster
 			// Read the composition
-			auto comp = clusterGroup.readCluster(formationEnergy,
-					migrationEnergy, diffusionFactor);
+			auto comp = networkGroup->readCluster(i,
+					formationEnergy, migrationEnergy, diffusionFactor);
 			numHe = comp[toCompIdx(Species::He)];
 			numD = comp[toCompIdx(Species::D)];
 			numT = comp[toCompIdx(Species::T)];
@@ -76,7 +78,7 @@ std::unique_ptr<IReactionNetwork> HDF5NetworkLoader::load(
 			pushPSICluster(network, reactants, nextCluster);
 		} else {
 			// Super cluster
-			auto list = clusterGroup.readPSISuperCluster();
+			auto list = networkGroup->readPSISuperCluster(i);
 
 			// Create the cluster
 			auto nextCluster = createPSISuperCluster(list, *network);
@@ -115,5 +117,50 @@ std::unique_ptr<IReactionNetwork> HDF5NetworkLoader::load(
 	return std::move(network);
 }
 
+std::unique_ptr<IReactionNetwork> HDF5NetworkLoader::generate(
+		const IOptions& options) {
+	// Without cache
+	auto directory = options.getNetworkCacheDirectory();
+	if (directory.empty())
+		return PSIClusterNetworkLoader::generate(options);
+
+	// Load the network from the cache if it is there
+	NetworkCache cache(directory, getCacheKey(options));
+	if (cache.contains()) {
+		auto networkName = fileName;
+		fileName = cache.getPath().string();
+		auto network = load(options);
+		fileName = networkName;
+
+		return network;
+	}
+
+	// Generate it and add it to the cache
+	auto network = PSIClusterNetworkLoader::generate(options);
+	cache.store(*network);
+
+	return network;
+}
+
+std::string HDF5NetworkLoader::getCacheKey(const IOptions& options) const {
+	std::ostringstream key;
+	key.precision(17);
+	key << "PSI generation=" << generationVersion << " layout="
+			<< XFile::NetworkGroup::columnarLayoutVersion << " material="
+			<< options.getMaterial() << " maxHe=" << options.getMaxImpurity()
+			<< " maxD=" << options.getMaxD() << " maxT=" << options.getMaxT()
+			<< " maxV=" << options.getMaxV() << " maxI=" << options.getMaxI()
+			<< " phaseCut=" << options.usePhaseCut() << " dummyReactions="
+			<< dummyReactions << " vMin=" << vMin << " widths="
+			<< sectionWidth[0] << "," << sectionWidth[1] << ","
+			<< sectionWidth[2] << "," << sectionWidth[3] << " lattice="
+			<< options.getLatticeParameter() << " impurityRadius="
+			<< options.getImpurityRadius() << " biasFactor="
+			<< options.getBiasFactor() << " hydrogenFactor="
+			<< options.getHydrogenFactor();
+
+	return key.str();
+}
+
 } // namespace xolotlCore
 
@@ -19,6 +19,23 @@ private:
 	HDF5NetworkLoader() {
 	}
 
+	/**
+	 * The version of the generation of the networks, part of the keys of
+	 * the cache. It must be increased whenever a change of the generation
+	 * (energies, grouping, reactions, coefficients) changes the networks
+	 * for the same options.
+	 */
+	static const int generationVersion = 1;
+
+	/**
+	 * Build the description of everything a generated network depends on,
+	 * used as the key of the cache.
+	 *
+	 * @param options The options
+	 * @return The key
+	 */
+	std::string getCacheKey(const IOptions& options) const;
+
 public:
 
 	/**
@@ -43,6 +60,18 @@ public:
 	 */
 	std::unique_ptr<IReactionNetwork> load(const IOptions& options) override;
 
+	/**
+	 * This operation will generate the reaction network from the options,
+	 * or load it from the cache if the cache directory is set and the same
+	 * network was already generated. A network that is generated is then
+	 * added to the cache.
+	 *
+	 * @param options The options
+	 * @return The reaction network.
+	 */
+	std::unique_ptr<IReactionNetwork> generate(const IOptions& options)
+			override;
+
 };
 
 } /* namespace xolotlCore */
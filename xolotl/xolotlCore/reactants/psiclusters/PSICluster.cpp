@@ -763,6 +763,125 @@ void PSICluster::updateFromNetwork() {
 	return;
 }
 
+void PSICluster::computeTotalFlux(double *concOffset,
+		double *updatedConcOffset, int xi) const {
+	// Initial declarations
+	double lA[5] = { }, lB[5] = { };
+	double productionFlux = 0.0, combinationFlux = 0.0, dissociationFlux = 0.0,
+			emissionFlux = 0.0;
+	double conc = concOffset[id - 1];
+
+	// Sum production flux over all reacting pairs
+	for (auto const& currPair : reactingPairs) {
+		getMomentsFromArray(currPair.first, concOffset, lA);
+		getMomentsFromArray(currPair.second, concOffset, lB);
+		double sum = 0.0;
+		for (int j = 0; j < psDim; j++) {
+			for (int i = 0; i < psDim; i++) {
+				sum += currPair.coefs[i][j] * lA[i] * lB[j];
+			}
+		}
+		productionFlux += currPair.reaction.kConstant[xi] * sum;
+	}
+
+	// Sum combination flux over all clusters that combine with us
+	for (auto const& cc : combiningReactants) {
+		getMomentsFromArray(cc.combining, concOffset, lB);
+		double sum = 0.0;
+		for (int i = 0; i < psDim; i++) {
+			sum += cc.coefs[i] * lB[i];
+		}
+		combinationFlux += cc.reaction.kConstant[xi] * sum;
+	}
+
+	// Sum dissociation flux over all our dissociating clusters
+	for (auto const& currPair : dissociatingPairs) {
+		getMomentsFromArray(currPair.first, concOffset, lA);
+		double sum = 0.0;
+		for (int i = 0; i < psDim; i++) {
+			sum += currPair.coefs[i][0] * lA[i];
+		}
+		dissociationFlux += currPair.reaction.kConstant[xi] * sum;
+	}
+
+	// Sum rate constants from all emission pair reactions
+	for (auto const& currPair : emissionPairs) {
+		emissionFlux += currPair.reaction.kConstant[xi] * currPair.coefs[0][0];
+	}
+
+	// Update the concentration of the cluster
+	updatedConcOffset[id - 1] += productionFlux - combinationFlux * conc
+			+ dissociationFlux - emissionFlux * conc;
+
+	return;
+}
+
+void PSICluster::releaseReactingPairs() {
+	// Swap with empty vectors to give the memory back
+	std::vector<ClusterPair>().swap(reactingPairs);
+	std::vector<CombiningCluster>().swap(combiningReactants);
+	std::vector<ClusterPair>().swap(dissociatingPairs);
+	std::vector<ClusterPair>().swap(emissionPairs);
+
+	return;
+}
+
+void PSICluster::addToReactionTable(PSIReactionTable& table) const {
+	// Initial declarations
+	int selfIds[5] = { }, idsA[5] = { }, idsB[5] = { };
+	double coefs[25] = { };
+	getMomentIds(*this, selfIds);
+
+	// This cluster is the only output
+	table.startRow(selfIds, 1);
+
+	// Production: coefs[a][b]
+	for (auto const& currPair : reactingPairs) {
+		getMomentIds(currPair.first, idsA);
+		getMomentIds(currPair.second, idsB);
+		for (int a = 0; a < psDim; a++) {
+			for (int b = 0; b < psDim; b++) {
+				coefs[a * psDim + b] = currPair.coefs[a][b];
+			}
+		}
+		table.addTwoBodyTerm(PSIReactionTable::TermKind::Production,
+				currPair.reaction, idsA, idsB, coefs);
+	}
+
+	// Combination: only the concentration of this cluster is used
+	for (auto const& cc : combiningReactants) {
+		getMomentIds(cc.combining, idsB);
+		for (int a = 0; a < psDim; a++) {
+			for (int b = 0; b < psDim; b++) {
+				coefs[a * psDim + b] = (a == 0) ? cc.coefs[b] : 0.0;
+			}
+		}
+		table.addTwoBodyTerm(PSIReactionTable::TermKind::Combination,
+				cc.reaction, selfIds, idsB, coefs);
+	}
+
+	// Dissociation: coefs[a][0]
+	for (auto const& currPair : dissociatingPairs) {
+		getMomentIds(currPair.first, idsA);
+		for (int a = 0; a < psDim; a++) {
+			coefs[a] = currPair.coefs[a][0];
+		}
+		table.addOneBodyTerm(PSIReactionTable::TermKind::Dissociation,
+				currPair.reaction, idsA, coefs);
+	}
+
+	// Emission: only the concentration of this cluster is used
+	for (auto const& currPair : emissionPairs) {
+		for (int a = 0; a < psDim; a++) {
+			coefs[a] = (a == 0) ? currPair.coefs[0][0] : 0.0;
+		}
+		table.addOneBodyTerm(PSIReactionTable::TermKind::Emission,
+				currPair.reaction, selfIds, coefs);
+	}
+
+	return;
+}
+
 double PSICluster::getDissociationFlux(int xi) const {
 
 	// Sum dissociation flux over all our dissociating clusters.
@@ -4,6 +4,7 @@
 // Includes
 #include <Reactant.h>
 #include "IntegerRange.h"
+#include "PSIReactionTable.h"
 
 namespace xolotlPerf {
 class ITimer;
@@ -225,6 +226,43 @@ protected:
 	void dumpCoefficients(std::ostream& os, ClusterPair const& curr) const;
 	void dumpCoefficients(std::ostream& os, CombiningCluster const& curr) const;
 
+	/**
+	 * Read the concentration and the moments of the given cluster
+	 * directly from a concentration array. The moments are only non-zero
+	 * for super clusters.
+	 *
+	 * @param cluster The cluster we want the values of.
+	 * @param concOffset The array of concentrations at the grid point.
+	 * @param l The array that will be filled with the concentration (l0)
+	 * followed by the first moments, it needs to be of size psDim.
+	 */
+	void getMomentsFromArray(const PSICluster& cluster, double *concOffset,
+			double l[5]) const {
+		l[0] = concOffset[cluster.id - 1];
+		bool isSuper = (cluster.type == ReactantType::PSISuper);
+		for (int i = 1; i < psDim; i++) {
+			l[i] = isSuper ?
+					concOffset[cluster.momId[indexList[i] - 1] - 1] : 0.0;
+		}
+	}
+
+	/**
+	 * Get the DOF indices of the concentration and the moments of the
+	 * given cluster. The moments are set to -1 if the cluster is not a
+	 * super cluster.
+	 *
+	 * @param cluster The cluster we want the indices of.
+	 * @param ids The array that will be filled with the indices, it needs
+	 * to be of size psDim.
+	 */
+	void getMomentIds(const PSICluster& cluster, int ids[5]) const {
+		ids[0] = cluster.id - 1;
+		bool isSuper = (cluster.type == ReactantType::PSISuper);
+		for (int i = 1; i < psDim; i++) {
+			ids[i] = isSuper ? cluster.momId[indexList[i] - 1] - 1 : -1;
+		}
+	}
+
 public:
 
 	/**
@@ -522,6 +560,36 @@ public:
 				+ getDissociationFlux(i) - getEmissionFlux(i);
 	}
 
+	/**
+	 * This operation computes the total flux of this cluster in the current
+	 * network using the concentrations from the given array instead of
+	 * the ones stored in the clusters, and adds it to the updated
+	 * concentrations. It doesn't modify the state of any cluster.
+	 *
+	 * @param concOffset The array of concentrations at the grid point
+	 * @param updatedConcOffset The array where the flux is added
+	 * @param i The location on the grid in the depth direction
+	 */
+	virtual void computeTotalFlux(double *concOffset, double *updatedConcOffset,
+			int i) const;
+
+	/**
+	 * This operation adds the row corresponding to this cluster, with all
+	 * the production and dissociation terms contributing to its flux, to
+	 * the compiled reaction table.
+	 *
+	 * @param table The table to fill
+	 */
+	virtual void addToReactionTable(PSIReactionTable& table) const;
+
+	/**
+	 * This operation releases the effective production and dissociation
+	 * vectors once the compiled reaction table holds their content. The
+	 * connectivity is kept but the flux and partial derivative methods of
+	 * the cluster can't be used anymore.
+	 */
+	virtual void releaseReactingPairs();
+
 	/**
 	 * This operation returns the total change in this cluster due to
 	 * other clusters dissociating into it.
@@ -227,6 +227,12 @@ std::unique_ptr<IReactionNetwork> PSIClusterNetworkLoader::load(
 	// Set the hydrogan radius factor
 	hydrogenRadiusFactor = options.getHydrogenFactor();
 
+	// Set the rate cache
+	network->setRateCacheBinWidth(options.getRateCacheBinWidth());
+
+	// Set the number of threads building the connectivity
+	network->setConnectivityThreads(options.getNThreads());
+
 	std::string error(
 			"PSIClusterNetworkLoader Exception: Insufficient or erroneous data.");
 	int numHe = 0, numV = 0, numI = 0, numW = 0, numD = 0, numT = 0;
@@ -348,6 +354,12 @@ std::unique_ptr<IReactionNetwork> PSIClusterNetworkLoader::generate(
 	// Set the hydrogan radius factor
 	hydrogenRadiusFactor = options.getHydrogenFactor();
 
+	// Set the rate cache
+	network->setRateCacheBinWidth(options.getRateCacheBinWidth());
+
+	// Set the number of threads building the connectivity
+	network->setConnectivityThreads(options.getNThreads());
+
 	// Generate the I clusters
 	for (int i = 1; i <= maxI; ++i) {
 		// Set the composition
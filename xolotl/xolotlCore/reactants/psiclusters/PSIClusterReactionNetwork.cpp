@@ -1,5 +1,8 @@
 #include <cassert>
 #include <iterator>
+#include <cmath>
+#include <thread>
+#include <exception>
 #include "PSIClusterReactionNetwork.h"
 #include "PSICluster.h"
 #include "PSISuperCluster.h"
@@ -171,11 +174,124 @@ void PSIClusterReactionNetwork::defineAnaDissociationReactions(
 	emitting.emitFrom(drref, emitting);
 }
 
+void PSIClusterReactionNetwork::parallelFor(int n,
+		const std::function<void(int)>& body) const {
+	int nThreads = std::min(nConnectivityThreads, n);
+	if (nThreads <= 1) {
+		for (int k = 0; k < n; k++)
+			body(k);
+
+		return;
+	}
+
+	// Each thread takes a contiguous block of indices, the exceptions are
+	// given back to the calling thread
+	std::vector<std::thread> threads;
+	std::vector<std::exception_ptr> errors(nThreads);
+	for (int t = 0; t < nThreads; t++) {
+		threads.emplace_back([&body, &errors, n, nThreads, t]() {
+			try {
+				for (int k = (n * t) / nThreads; k < (n * (t + 1)) / nThreads;
+						k++)
+					body(k);
+			} catch (...) {
+				errors[t] = std::current_exception();
+			}
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	for (auto const& error : errors) {
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+	return;
+}
+
+void PSIClusterReactionNetwork::defineSuperReactions(IReactant& reactant,
+		const int shift[4], const std::vector<PSISuperCluster*>& supers,
+		const OtherProductsFinder& findOtherProducts) {
+	auto& cluster = static_cast<PSICluster&>(reactant);
+	bool mobile = reactant.getDiffusionFactor() > 0.0;
+
+	// Find the reactions with each super cluster, only reading the network
+	std::vector<std::vector<SuperProductCandidate> > candidates(supers.size());
+	std::vector<std::vector<PendingProductionReactionInfo> > otherPrInfos(
+			supers.size());
+	parallelFor(supers.size(),
+			[this, &cluster, mobile, shift, &supers, &findOtherProducts, &candidates, &otherPrInfos](int k) {
+				auto& superCluster = *supers[k];
+
+				// Loop on the potential products
+				for (auto superProdPtr : supers) {
+					auto& superProd = *superProdPtr;
+
+					// Skip if the reactions don't overlap
+					if (!checkOverlap(cluster, superCluster, superProd))
+						continue;
+
+					// Check if the super clusters are full
+					if (superCluster.isFull() && superProd.isFull()) {
+						candidates[k].push_back( {&superProd, true, {}});
+						continue;
+					}
+
+					// Get the coordinates of the reactant and loop on them
+					std::vector<PendingProductionReactionInfo> prInfos;
+					for (auto const& pair : superCluster.getCoordList()) {
+						int a[4] = {std::get<0>(pair) + shift[0],
+							std::get<1>(pair) + shift[1],
+							std::get<2>(pair) + shift[2],
+							std::get<3>(pair) + shift[3]};
+						if (superProd.isIn(a[0], a[1], a[2], a[3])
+								&& (mobile || superCluster.getDiffusionFactor() > 0.0)) {
+							int b[4] = {std::get<0>(pair), std::get<1>(pair),
+								std::get<2>(pair), std::get<3>(pair)};
+							prInfos.emplace_back(superProd, a, b);
+						}
+					}
+					if (prInfos.size() > 0)
+						candidates[k].push_back( {&superProd, false, std::move(prInfos)});
+				}
+
+				// The reactions with normal products
+				if (findOtherProducts)
+					findOtherProducts(superCluster, otherPrInfos[k]);
+			});
+
+	// Define them in the order of the super clusters
+	for (int k = 0; k < (int) supers.size(); k++) {
+		auto& superCluster = *supers[k];
+		for (auto const& candidate : candidates[k]) {
+			if (candidate.analytical)
+				// This method will check if the reaction is possible and then add it to the list
+				defineAnaProductionReactions(reactant, superCluster,
+						*candidate.product);
+			else
+				defineProductionReactions(reactant, superCluster,
+						candidate.prInfos);
+		}
+		if (otherPrInfos[k].size() > 0)
+			defineProductionReactions(reactant, superCluster, otherPrInfos[k]);
+	}
+
+	return;
+}
+
 void PSIClusterReactionNetwork::createReactionConnectivity() {
 	// Initial declarations
 	IReactant::SizeType firstSize = 0, secondSize = 0, productSize = 0, maxI =
 			getAll(ReactantType::I).size();
 
+	// The super clusters, in the order of the network
+	std::vector<PSISuperCluster*> supers;
+	for (auto const& superMapItem : getAll(ReactantType::PSISuper)) {
+		supers.push_back(
+				static_cast<PSISuperCluster*>(superMapItem.second.get()));
+	}
+
 	// Single species clustering (He, D, T, V, I)
 	// X_(a-i) + X_i --> X_a
 	// Make a vector of types
@@ -268,61 +384,8 @@ void PSIClusterReactionNetwork::createReactionConnectivity() {
 		}
 
 		// Consider product with each super cluster
-		for (auto const& superMapItem : getAll(ReactantType::PSISuper)) {
-			auto& superCluster =
-					static_cast<PSISuperCluster&>(*(superMapItem.second));
-
-			// Loop on the potential products
-			for (auto const& superMapItemProd : getAll(ReactantType::PSISuper)) {
-				auto& superProd =
-						static_cast<PSISuperCluster&>(*(superMapItemProd.second));
-
-				// Check if the reactions overlap
-				auto& heCluster = static_cast<PSICluster&>(heReactant);
-				bool overlap = checkOverlap(heCluster, superCluster, superProd);
-
-				// Skip if they don't overlap
-				if (!overlap)
-					continue;
-
-				// Check if the super clusters are full
-				if (superCluster.isFull() && superProd.isFull()) {
-					// This method will check if the reaction is possible and then add it to the list
-					defineAnaProductionReactions(heReactant, superCluster,
-							superProd);
-				} else {
-					std::vector<PendingProductionReactionInfo> prInfos;
-
-					// Get the coordinates of the reactant and loop on them
-					auto coords = superCluster.getCoordList();
-					for (auto const& pair : coords) {
-						// Assume the product can only be a super cluster here
-						int newNumHe = std::get<0>(pair) + firstSize;
-						int newNumD = std::get<1>(pair);
-						int newNumT = std::get<2>(pair);
-						int newNumV = std::get<3>(pair);
-						if (superProd.isIn(newNumHe, newNumD, newNumT, newNumV)
-								&& (heReactant.getDiffusionFactor() > 0.0
-										|| superCluster.getDiffusionFactor()
-												> 0.0)) {
-							// Note that current reactant reacts with
-							// current superCluster to produce product,
-							// according to current parameters.
-							int a[4] = { newNumHe, newNumD, newNumT, newNumV };
-							int b[4] = { std::get<0>(pair), std::get<1>(pair),
-									std::get<2>(pair), std::get<3>(pair) };
-							prInfos.emplace_back(superProd, a, b);
-						}
-					}
-					// Now that we know how current reactant reacts with
-					// current superCluster, create the production
-					// reaction(s) for them.
-					if (prInfos.size() > 0)
-						defineProductionReactions(heReactant, superCluster,
-								prInfos);
-				}
-			}
-		}
+		int shift[4] = { (int) firstSize, 0, 0, 0 };
+		defineSuperReactions(heReactant, shift, supers);
 	}
 
 	// Vacancy absorption by Mixed clusters
@@ -373,60 +436,8 @@ void PSIClusterReactionNetwork::createReactionConnectivity() {
 		}
 
 		// Consider product with each super cluster
-		for (auto const& superMapItem : getAll(ReactantType::PSISuper)) {
-			auto& superCluster =
-					static_cast<PSISuperCluster&>(*(superMapItem.second));
-			// Loop on the potential products
-			for (auto const& superMapItemProd : getAll(ReactantType::PSISuper)) {
-				auto& superProd =
-						static_cast<PSISuperCluster&>(*(superMapItemProd.second));
-
-				// Check if the reactions overlap
-				auto& vCluster = static_cast<PSICluster&>(vReactant);
-				bool overlap = checkOverlap(vCluster, superCluster, superProd);
-
-				// Skip if they don't overlap
-				if (!overlap)
-					continue;
-
-				// Check if the super clusters are full
-				if (superCluster.isFull() && superProd.isFull()) {
-					// This method will check if the reaction is possible and then add it to the list
-					defineAnaProductionReactions(vReactant, superCluster,
-							superProd);
-				} else {
-					std::vector<PendingProductionReactionInfo> prInfos;
-
-					// Get the coordinates of the reactant and loop on them
-					auto coords = superCluster.getCoordList();
-					for (auto const& pair : coords) {
-						// Assume the product can only be a super cluster here
-						int newNumHe = std::get<0>(pair);
-						int newNumD = std::get<1>(pair);
-						int newNumT = std::get<2>(pair);
-						int newNumV = std::get<3>(pair) + firstSize;
-						if (superProd.isIn(newNumHe, newNumD, newNumT, newNumV)
-								&& (vReactant.getDiffusionFactor() > 0.0
-										|| superCluster.getDiffusionFactor()
-												> 0.0)) {
-							// Note that current reactant reacts with
-							// current superCluster to produce product,
-							// according to current parameters.
-							int a[4] = { newNumHe, newNumD, newNumT, newNumV };
-							int b[4] = { std::get<0>(pair), std::get<1>(pair),
-									std::get<2>(pair), std::get<3>(pair) };
-							prInfos.emplace_back(superProd, a, b);
-						}
-					}
-					// Now that we know how current reactant reacts with
-					// current superCluster, create the production
-					// reaction(s) for them.
-					if (prInfos.size() > 0)
-						defineProductionReactions(vReactant, superCluster,
-								prInfos);
-				}
-			}
-		}
+		int shift[4] = { 0, 0, 0, (int) firstSize };
+		defineSuperReactions(vReactant, shift, supers);
 	}
 
 	// Helium-Vacancy clustering
@@ -524,117 +535,61 @@ void PSIClusterReactionNetwork::createReactionConnectivity() {
 			}
 		}
 
-		// Consider product with all super clusters.
-		for (auto const& superMapItem : getAll(ReactantType::PSISuper)) {
-			auto& superCluster =
-					static_cast<PSISuperCluster&>(*(superMapItem.second));
-			std::vector<PendingProductionReactionInfo> prInfos;
-			// Loop on the potential super products
-			for (auto const& superMapItemProd : getAll(ReactantType::PSISuper)) {
-				auto& superProd =
-						static_cast<PSISuperCluster&>(*(superMapItemProd.second));
-
-				// Check if the reactions overlap
-				auto& iCluster = static_cast<PSICluster&>(iReactant);
-				bool overlap = checkOverlap(iCluster, superCluster, superProd);
-
-				// Skip if they don't overlap
-				if (!overlap)
-					continue;
-
-				// Check if the super clusters are full
-				if (superCluster.isFull() && superProd.isFull()) {
-					// This method will check if the reaction is possible and then add it to the list
-					defineAnaProductionReactions(iReactant, superCluster,
-							superProd);
-				} else {
-					std::vector<PendingProductionReactionInfo> prInfos;
-
+		// Consider product with all super clusters, the products are super
+		// clusters or, when all the vacancies are absorbed, normal clusters
+		int shift[4] = { 0, 0, 0, -(int) firstSize };
+		defineSuperReactions(iReactant, shift, supers,
+				[this, &iReactant, firstSize](PSISuperCluster& superCluster,
+						std::vector<PendingProductionReactionInfo>& prInfos) {
 					// Get the coordinates of the reactant and loop on them
-					auto coords = superCluster.getCoordList();
+					auto const& coords = superCluster.getCoordList();
 					for (auto const& pair : coords) {
-						// Assume the product can only be a super cluster here
+						// The product might be mixed or He or D or T
 						int newNumHe = std::get<0>(pair);
 						int newNumD = std::get<1>(pair);
 						int newNumT = std::get<2>(pair);
 						int newNumV = std::get<3>(pair) - firstSize;
-						if (superProd.isIn(newNumHe, newNumD, newNumT, newNumV)
+
+						// Get the product
+						IReactant* product = nullptr;
+						if (newNumV == 0) {
+							// Check if it is a single product
+							if ((newNumHe > 0) + (newNumD > 0) + (newNumT > 0)
+									> 1) {
+								// Nothing happens, no reaction
+								continue;
+							} else {
+								if (newNumHe > 0)
+									// The product is He
+									product = get(Species::He, newNumHe);
+								if (newNumD > 0)
+									// The product is D
+									product = get(Species::D, newNumD);
+								if (newNumT > 0)
+									// The product is T
+									product = get(Species::T, newNumT);
+							}
+						} else {
+							// Create the composition of the potential product
+							IReactant::Composition newComp;
+							newComp[toCompIdx(Species::He)] = newNumHe;
+							newComp[toCompIdx(Species::D)] = newNumD;
+							newComp[toCompIdx(Species::T)] = newNumT;
+							newComp[toCompIdx(Species::V)] = newNumV;
+							product = get(ReactantType::PSIMixed, newComp);
+							// Don't test super product because it was already taken care of
+						}
+						// Check that the reaction can occur
+						if (product
 								&& (iReactant.getDiffusionFactor() > 0.0
-										|| superCluster.getDiffusionFactor()
-												> 0.0)) {
-							// Note that current reactant reacts with
-							// current superCluster to produce product,
-							// according to current parameters.
+										|| superCluster.getDiffusionFactor() > 0.0)) {
 							int a[4] = { newNumHe, newNumD, newNumT, newNumV };
 							int b[4] = { std::get<0>(pair), std::get<1>(pair),
 									std::get<2>(pair), std::get<3>(pair) };
-							prInfos.emplace_back(superProd, a, b);
+							prInfos.emplace_back(*product, a, b);
 						}
 					}
-					// Now that we know how current reactant reacts with
-					// current superCluster, create the production
-					// reaction(s) for them.
-					if (prInfos.size() > 0)
-						defineProductionReactions(iReactant, superCluster,
-								prInfos);
-				}
-			}
-
-			// Get the coordinates of the reactant and loop on them
-			auto coords = superCluster.getCoordList();
-			for (auto const& pair : coords) {
-				// The product might be mixed or He or D or T
-				int newNumHe = std::get<0>(pair);
-				int newNumD = std::get<1>(pair);
-				int newNumT = std::get<2>(pair);
-				int newNumV = std::get<3>(pair) - firstSize;
-
-				// Get the product
-				IReactant* product = nullptr;
-				if (newNumV == 0) {
-					// Check if it is a single product
-					if ((newNumHe > 0) + (newNumD > 0) + (newNumT > 0) > 1) {
-						// Nothing happens, no reaction
-						continue;
-					} else {
-						if (newNumHe > 0)
-							// The product is He
-							product = get(Species::He, newNumHe);
-						if (newNumD > 0)
-							// The product is D
-							product = get(Species::D, newNumD);
-						if (newNumT > 0)
-							// The product is T
-							product = get(Species::T, newNumT);
-					}
-				} else {
-					// Create the composition of the potential product
-					IReactant::Composition newComp;
-					newComp[toCompIdx(Species::He)] = newNumHe;
-					newComp[toCompIdx(Species::D)] = newNumD;
-					newComp[toCompIdx(Species::T)] = newNumT;
-					newComp[toCompIdx(Species::V)] = newNumV;
-					product = get(ReactantType::PSIMixed, newComp);
-					// Don't test super product because it was already taken care of
-				}
-				// Check that the reaction can occur
-				if (product
-						&& (iReactant.getDiffusionFactor() > 0.0
-								|| superCluster.getDiffusionFactor() > 0.0)) {
-					int a[4] = { newNumHe, newNumD, newNumT, newNumV };
-					int b[4] = { std::get<0>(pair), std::get<1>(pair), std::get<
-							2>(pair), std::get<3>(pair) };
-					prInfos.emplace_back(*product, a, b);
-				}
-			}
-
-			// Now that we know how current reactant interacts with
-			// current supercluster, define its production reactions
-			// according to given parameters.
-			if (prInfos.size() > 0)
-				defineProductionReactions(iReactant, superCluster, prInfos);
-
-		}
+				});
 	}
 
 	// Helium clustering leading to trap mutation
@@ -929,60 +884,8 @@ void PSIClusterReactionNetwork::createReactionConnectivity() {
 		}
 
 		// Consider product with each super cluster
-		for (auto const& superMapItem : getAll(ReactantType::PSISuper)) {
-			auto& superCluster =
-					static_cast<PSISuperCluster&>(*(superMapItem.second));
-			// Loop on the potential products
-			for (auto const& superMapItemProd : getAll(ReactantType::PSISuper)) {
-				auto& superProd =
-						static_cast<PSISuperCluster&>(*(superMapItemProd.second));
-
-				// Check if the reactions overlap
-				auto& dCluster = static_cast<PSICluster&>(dReactant);
-				bool overlap = checkOverlap(dCluster, superCluster, superProd);
-
-				// Skip if they don't overlap
-				if (!overlap)
-					continue;
-
-				// Check if the super clusters are full
-				if (superCluster.isFull() && superProd.isFull()) {
-					// This method will check if the reaction is possible and then add it to the list
-					defineAnaProductionReactions(dReactant, superCluster,
-							superProd);
-				} else {
-					std::vector<PendingProductionReactionInfo> prInfos;
-
-					// Get the coordinates of the reactant and loop on them
-					auto coords = superCluster.getCoordList();
-					for (auto const& pair : coords) {
-						// Assume the product can only be a super cluster here
-						int newNumHe = std::get<0>(pair);
-						int newNumD = std::get<1>(pair) + firstSize;
-						int newNumT = std::get<2>(pair);
-						int newNumV = std::get<3>(pair);
-						if (superProd.isIn(newNumHe, newNumD, newNumT, newNumV)
-								&& (dReactant.getDiffusionFactor() > 0.0
-										|| superCluster.getDiffusionFactor()
-												> 0.0)) {
-							// Note that current reactant reacts with
-							// current superCluster to produce product,
-							// according to current parameters.
-							int a[4] = { newNumHe, newNumD, newNumT, newNumV };
-							int b[4] = { std::get<0>(pair), std::get<1>(pair),
-									std::get<2>(pair), std::get<3>(pair) };
-							prInfos.emplace_back(superProd, a, b);
-						}
-					}
-					// Now that we know how current reactant reacts with
-					// current superCluster, create the production
-					// reaction(s) for them.
-					if (prInfos.size() > 0)
-						defineProductionReactions(dReactant, superCluster,
-								prInfos);
-				}
-			}
-		}
+		int shift[4] = { 0, (int) firstSize, 0, 0 };
+		defineSuperReactions(dReactant, shift, supers);
 	}
 
 	// Tritium absorption by Mixed clusters
@@ -1030,60 +933,8 @@ void PSIClusterReactionNetwork::createReactionConnectivity() {
 		}
 
 		// Consider product with each super cluster
-		for (auto const& superMapItem : getAll(ReactantType::PSISuper)) {
-			auto& superCluster =
-					static_cast<PSISuperCluster&>(*(superMapItem.second));
-			// Loop on the potential products
-			for (auto const& superMapItemProd : getAll(ReactantType::PSISuper)) {
-				auto& superProd =
-						static_cast<PSISuperCluster&>(*(superMapItemProd.second));
-
-				// Check if the reactions overlap
-				auto& tCluster = static_cast<PSICluster&>(tReactant);
-				bool overlap = checkOverlap(tCluster, superCluster, superProd);
-
-				// Skip if they don't overlap
-				if (!overlap)
-					continue;
-
-				// Check if the super clusters are full
-				if (superCluster.isFull() && superProd.isFull()) {
-					// This method will check if the reaction is possible and then add it to the list
-					defineAnaProductionReactions(tReactant, superCluster,
-							superProd);
-				} else {
-					std::vector<PendingProductionReactionInfo> prInfos;
-
-					// Get the coordinates of the reactant and loop on them
-					auto coords = superCluster.getCoordList();
-					for (auto const& pair : coords) {
-						// Assume the product can only be a super cluster here
-						int newNumHe = std::get<0>(pair);
-						int newNumD = std::get<1>(pair);
-						int newNumT = std::get<2>(pair) + firstSize;
-						int newNumV = std::get<3>(pair);
-						if (superProd.isIn(newNumHe, newNumD, newNumT, newNumV)
-								&& (tReactant.getDiffusionFactor() > 0.0
-										|| superCluster.getDiffusionFactor()
-												> 0.0)) {
-							// Note that current reactant reacts with
-							// current superCluster to produce product,
-							// according to current parameters.
-							int a[4] = { newNumHe, newNumD, newNumT, newNumV };
-							int b[4] = { std::get<0>(pair), std::get<1>(pair),
-									std::get<2>(pair), std::get<3>(pair) };
-							prInfos.emplace_back(superProd, a, b);
-						}
-					}
-					// Now that we know how current reactant reacts with
-					// current superCluster, create the production
-					// reaction(s) for them.
-					if (prInfos.size() > 0)
-						defineProductionReactions(tReactant, superCluster,
-								prInfos);
-				}
-			}
-		}
+		int shift[4] = { 0, 0, (int) firstSize, 0 };
+		defineSuperReactions(tReactant, shift, supers);
 	}
 
 	// Deuterium-Vacancy clustering
@@ -1376,12 +1227,79 @@ void PSIClusterReactionNetwork::setTemperature(double temp, int i) {
 	setTempTimer->start();
 	ReactionNetwork::setTemperature(temp, i);
 
-	computeRateConstants(i);
+	if (rateCacheBinWidth > 0.0)
+		interpolateRateConstants(temp, i);
+	else
+		computeRateConstants(i);
 	setTempTimer->stop();
 
 	return;
 }
 
+const std::vector<double>& PSIClusterReactionNetwork::getCachedRates(
+		long bin, int i, bool& computed) {
+	// Check if the rates are already known
+	auto iter = rateCache.find(bin);
+	if (iter != rateCache.end())
+		return iter->second;
+
+	// List the reactions the first time
+	if (rateCacheReactions.empty()) {
+		for (auto& currReactionInfo : productionReactionMap) {
+			rateCacheReactions.push_back(currReactionInfo.second.get());
+		}
+		for (auto& currReactionInfo : dissociationReactionMap) {
+			rateCacheReactions.push_back(currReactionInfo.second.get());
+		}
+	}
+
+	// Compute the rates at the temperature of the bin boundary,
+	// using the grid point as a scratch space
+	ReactionNetwork::setTemperature(bin * rateCacheBinWidth, i);
+	evaluateRateConstants(i);
+	computed = true;
+
+	// Save them
+	std::vector<double> rates;
+	rates.reserve(rateCacheReactions.size() + 1);
+	for (auto reaction : rateCacheReactions) {
+		rates.push_back(reaction->kConstant[i]);
+	}
+	rates.push_back(biggestRate);
+
+	return rateCache.emplace(bin, std::move(rates)).first->second;
+}
+
+void PSIClusterReactionNetwork::interpolateRateConstants(double temp, int i) {
+	// Find the bin
+	double position = temp / rateCacheBinWidth;
+	long bin = (long) std::floor(position);
+	double fraction = position - (double) bin;
+
+	// Get the rates at both ends
+	bool computed = false;
+	auto const& lowRates = getCachedRates(bin, i, computed);
+	auto const& highRates = getCachedRates(bin + 1, i, computed);
+
+	// Restore the actual temperature if it was changed to fill the cache
+	if (computed)
+		ReactionNetwork::setTemperature(temp, i);
+
+	// Interpolate
+	const int nReactions = rateCacheReactions.size();
+	for (int k = 0; k < nReactions; k++) {
+		rateCacheReactions[k]->kConstant[i] = lowRates[k]
+				+ fraction * (highRates[k] - lowRates[k]);
+	}
+	biggestRate = lowRates[nReactions]
+			+ fraction * (highRates[nReactions] - lowRates[nReactions]);
+
+	// Copy them in the table
+	reactionTable.updateRates(i);
+
+	return;
+}
+
 void PSIClusterReactionNetwork::reinitializeNetwork() {
 
 	// Reset the Ids
@@ -1419,17 +1337,208 @@ void PSIClusterReactionNetwork::reinitializeNetwork() {
 				}
 			});
 
+	// The ids are known now
+	computeTotalWeights();
+
+	return;
+}
+
+void PSIClusterReactionNetwork::computeTotalWeights() {
+	// Start from zero weights
+	int dof = getDOF();
+	for (auto& weights : totalWeights)
+		weights.assign(dof, 0.0);
+
+	// The totals of each atom (He, D, T) then of the vacancies
+	TotalType atomTypes[4] = { TotalType::HeAtom, TotalType::DAtom,
+			TotalType::TAtom, TotalType::V };
+	TotalType trappedTypes[3] = { TotalType::TrappedHeAtom,
+			TotalType::TrappedDAtom, TotalType::TrappedTAtom };
+	ReactantType reactantTypes[4] = { ReactantType::He, ReactantType::D,
+			ReactantType::T, ReactantType::V };
+
+	for (int axis = 0; axis < 4; axis++) {
+		auto& weights = totalWeights[(int) atomTypes[axis]];
+
+		// The single species clusters
+		for (auto const& currMapItem : getAll(reactantTypes[axis])) {
+			auto const& cluster = *(currMapItem.second);
+			weights[cluster.getId() - 1] += (double) cluster.getSize();
+		}
+
+		// The mixed clusters
+		auto compIdx = toCompIdx(toSpecies(reactantTypes[axis]));
+		for (auto const& currMapItem : getAll(ReactantType::PSIMixed)) {
+			auto const& cluster = *(currMapItem.second);
+			double content = cluster.getComposition()[compIdx];
+			weights[cluster.getId() - 1] += content;
+			if (axis < 3)
+				totalWeights[(int) trappedTypes[axis]][cluster.getId() - 1] +=
+						content;
+		}
+
+		// The super clusters, the concentration of each member is the
+		// zeroth moment plus the distance times the first moment on each axis
+		for (auto const& currMapItem : getAll(ReactantType::PSISuper)) {
+			auto const& cluster =
+					static_cast<PSISuperCluster&>(*(currMapItem.second));
+			double zeroth = 0.0, first[4] = { 0.0, 0.0, 0.0, 0.0 };
+			for (auto const& coords : cluster.getCoordList()) {
+				int content[4] = { std::get<0>(coords), std::get<1>(coords),
+						std::get<2>(coords), std::get<3>(coords) };
+				zeroth += (double) content[axis];
+				for (int i = 1; i < psDim; i++) {
+					int momAxis = indexList[i] - 1;
+					first[momAxis] += cluster.getDistance(content[momAxis],
+							momAxis) * (double) content[axis];
+				}
+			}
+
+			// Add them to the total, and to the trapped total for the atoms
+			auto addContent = [&](std::vector<double>& currWeights) {
+				currWeights[cluster.getId() - 1] += zeroth;
+				for (int i = 1; i < psDim; i++) {
+					int momAxis = indexList[i] - 1;
+					currWeights[cluster.getMomentId(momAxis) - 1] +=
+					first[momAxis];
+				}
+			};
+			addContent(weights);
+			if (axis < 3)
+				addContent(totalWeights[(int) trappedTypes[axis]]);
+		}
+	}
+
+	// The interstitials
+	auto& iWeights = totalWeights[(int) TotalType::I];
+	for (auto const& currMapItem : getAll(ReactantType::I)) {
+		auto const& cluster = *(currMapItem.second);
+		iWeights[cluster.getId() - 1] += (double) cluster.getSize();
+	}
+
 	return;
 }
 
 void PSIClusterReactionNetwork::reinitializeConnectivities() {
 
+	// The connectivities are computed from the reacting pairs
+	if (reactingPairsReleased) {
+		throw std::string(
+				"\nPSIClusterReactionNetwork::reinitializeConnectivities: the "
+						"reacting pairs were released by shareReadOnlyData().");
+	}
+
 	// Reset connectivities of each reactant.
 	std::for_each(allReactants.begin(), allReactants.end(),
 			[](IReactant& currReactant) {
 				currReactant.resetConnectivities();
 			});
 
+	// The reactions are final, flatten them
+	compileReactionTable();
+
+	return;
+}
+
+void PSIClusterReactionNetwork::compileReactionTable() {
+
+	// The clusters don't have their reactions anymore
+	if (reactingPairsReleased) {
+		throw std::string(
+				"\nPSIClusterReactionNetwork::compileReactionTable: the "
+						"reacting pairs were released by shareReadOnlyData().");
+	}
+
+	// The reactions may have changed
+	clearRateCache();
+	rateEvaluator.clear();
+
+	// Each cluster adds its row, in the order of the Ids
+	reactionTable.clear(psDim);
+	std::for_each(allReactants.begin(), allReactants.end(),
+			[this](IReactant& currReactant) {
+				auto const& cluster = static_cast<PSICluster&>(currReactant);
+				cluster.addToReactionTable(reactionTable);
+			});
+	reactionTable.finalize();
+
+	return;
+}
+
+void PSIClusterReactionNetwork::fillRateEvaluator() {
+	// Nothing to do if the reactions didn't change
+	if (rateEvaluator.getNProductions() == (int) productionReactionMap.size()
+			&& rateEvaluator.getNDissociations()
+					== (int) dissociationReactionMap.size())
+		return;
+
+	rateEvaluator.clear();
+	for (auto& currReactionInfo : productionReactionMap) {
+		rateEvaluator.addProduction(*(currReactionInfo.second));
+	}
+	for (auto& currReactionInfo : dissociationReactionMap) {
+		auto& currReaction = *(currReactionInfo.second);
+		rateEvaluator.addDissociation(currReaction,
+				computeBindingEnergy(currReaction));
+	}
+
+	return;
+}
+
+void PSIClusterReactionNetwork::evaluateRateConstants(int i) {
+	// Fill the evaluator if the reactions changed
+	fillRateEvaluator();
+
+	// The prefactor of the dissociations is the inverse of the atomic
+	// volume, see calculateDissociationConstant()
+	double prefactor = 0.0;
+	if (dissociationsEnabled)
+		prefactor = 1.0 / (0.5 * pow(latticeParameter, 3));
+
+	// Compute the rates in the reactions
+	biggestRate = rateEvaluator.computeRates(i, temperature, prefactor);
+
+	return;
+}
+
+void PSIClusterReactionNetwork::computeRateConstants(int i) {
+	// Compute the rates in the reactions
+	evaluateRateConstants(i);
+
+	// Copy them in the table
+	reactionTable.updateRates(i);
+
+	return;
+}
+
+void PSIClusterReactionNetwork::addGridPoints(int i) {
+	// Resize the rates in the reactions
+	ReactionNetwork::addGridPoints(i);
+
+	// Resize the table accordingly
+	reactionTable.updateAllRates();
+
+	return;
+}
+
+void PSIClusterReactionNetwork::shareReadOnlyData() {
+	// The table has to be complete to replace the clusters
+	if (!canComputeConcurrently())
+		return;
+
+	// Move the constant data to the node
+	reactionTable.shareOnNode(MPI_COMM_WORLD);
+	fillRateEvaluator();
+	rateEvaluator.shareOnNode(MPI_COMM_WORLD);
+
+	// The clusters don't need their own copy of the reactions anymore
+	std::for_each(allReactants.begin(), allReactants.end(),
+			[](IReactant& currReactant) {
+				auto& cluster = static_cast<PSICluster&>(currReactant);
+				cluster.releaseReactingPairs();
+			});
+	reactingPairsReleased = true;
+
 	return;
 }
 
@@ -1555,6 +1664,10 @@ void PSIClusterReactionNetwork::getDiagonalFill(SparseFillMap& fillMap) {
 		}
 	}
 
+	// The positions of the partial derivatives are known for the table now
+	if (reactionTable.isCompiled())
+		reactionTable.compilePartials(dFillInvMap);
+
 	return;
 }
 
@@ -1720,6 +1833,14 @@ double PSIClusterReactionNetwork::getTotalIConcentration() {
 void PSIClusterReactionNetwork::computeAllFluxes(double *updatedConcOffset,
 		int xi) {
 
+	// The clusters need their reacting pairs
+	if (reactingPairsReleased) {
+		throw std::string(
+				"\nPSIClusterReactionNetwork::computeAllFluxes: the reacting "
+						"pairs were released by shareReadOnlyData(), the "
+						"fluxes have to be computed from the concentrations.");
+	}
+
 	// ----- Compute all of the new fluxes -----
 	std::for_each(allReactants.begin(), allReactants.end(),
 			[&updatedConcOffset,&xi](IReactant& cluster) {
@@ -1750,10 +1871,37 @@ void PSIClusterReactionNetwork::computeAllFluxes(double *updatedConcOffset,
 	return;
 }
 
+void PSIClusterReactionNetwork::computeAllFluxes(double *concOffset,
+		double *updatedConcOffset, int xi) {
+
+	// Use the compiled table when it is available
+	if (reactionTable.isCompiled()) {
+		reactionTable.computeFluxes(concOffset, updatedConcOffset, xi);
+		return;
+	}
+
+	// ----- Compute all of the new fluxes, moments included -----
+	std::for_each(allReactants.begin(), allReactants.end(),
+			[&concOffset,&updatedConcOffset,&xi](IReactant& currReactant) {
+				auto const& cluster = static_cast<PSICluster&>(currReactant);
+				cluster.computeTotalFlux(concOffset, updatedConcOffset, xi);
+			});
+
+	return;
+}
+
 void PSIClusterReactionNetwork::computeAllPartials(
 		const std::vector<size_t>& startingIdx, const std::vector<int>& indices,
 		std::vector<double>& vals, int xi) const {
 
+	// The clusters need their reacting pairs
+	if (reactingPairsReleased) {
+		throw std::string(
+				"\nPSIClusterReactionNetwork::computeAllPartials: the reacting "
+						"pairs were released by shareReadOnlyData(), the "
+						"partials have to be computed from the concentrations.");
+	}
+
 	// Because we accumulate partials and we don't know which
 	// of our reactants will be first to assign a value, we must start with
 	// all partials values at zero.
@@ -1842,6 +1990,44 @@ void PSIClusterReactionNetwork::computeAllPartials(
 	return;
 }
 
+void PSIClusterReactionNetwork::computeAllPartials(double *concOffset,
+		const std::vector<size_t>& startingIdx, const std::vector<int>& indices,
+		std::vector<double>& vals, int xi) {
+
+	// Use the compiled table when it is available
+	if (reactionTable.arePartialsCompiled()) {
+		std::fill(vals.begin(), vals.end(), 0.0);
+		reactionTable.computePartials(concOffset, startingIdx, vals.data(), xi);
+		return;
+	}
+
+	// Otherwise go through the concentrations stored in the clusters
+	ReactionNetwork::computeAllPartials(concOffset, startingIdx, indices, vals,
+			xi);
+
+	return;
+}
+
+void PSIClusterReactionNetwork::computeAllPartialsAction(double *concOffset,
+		const double *vecOffset, double *resultOffset,
+		const std::vector<int>& blockIds,
+		const std::vector<size_t>& startingIdx, const std::vector<int>& indices,
+		std::vector<double>& vals, int xi) {
+
+	// Use the compiled table when it is available
+	if (canComputeConcurrently()) {
+		reactionTable.computePartialsAction(concOffset, vecOffset,
+				resultOffset, blockIds.data(), xi);
+		return;
+	}
+
+	// Otherwise multiply all the partial derivatives
+	ReactionNetwork::computeAllPartialsAction(concOffset, vecOffset,
+			resultOffset, blockIds, startingIdx, indices, vals, xi);
+
+	return;
+}
+
 double PSIClusterReactionNetwork::computeBindingEnergy(
 		const DissociationReaction& reaction) const {
 // for the dissociation A --> B + C we need A binding energy
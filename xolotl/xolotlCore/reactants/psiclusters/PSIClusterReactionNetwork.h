@@ -10,8 +10,10 @@
 #include <map>
 #include <unordered_map>
 #include <algorithm>
+#include <functional>
 #include "ReactionNetwork.h"
 #include "PSISuperCluster.h"
+#include "PSIRateEvaluator.h"
 #include "ReactantType.h"
 
 namespace xolotlCore {
@@ -60,6 +62,79 @@ private:
 	//! The indexList.
 	Array<int, 5> indexList;
 
+	//! The compiled table of all the reactions, used to compute the fluxes.
+	PSIReactionTable reactionTable;
+
+	//! The batched evaluator of the rate constants.
+	PSIRateEvaluator rateEvaluator;
+
+	/**
+	 * Were the reacting pairs of the clusters released after the read-only
+	 * data was shared?
+	 */
+	bool reactingPairsReleased = false;
+
+	/**
+	 * Fill the batched evaluator with all the reactions if they changed.
+	 */
+	void fillRateEvaluator();
+
+	/**
+	 * Compute the rate constants of all the reactions at the given grid
+	 * point with the batched evaluator, filling it first if the reactions
+	 * changed, and update the biggest rate.
+	 *
+	 * @param i The location on the grid in the depth direction
+	 */
+	void evaluateRateConstants(int i);
+
+	/**
+	 * Compute the weights of the totals from the clusters, their compositions
+	 * and, for the super clusters, the contribution of the moments to the
+	 * content of their members.
+	 */
+	void computeTotalWeights() override;
+
+	/**
+	 * The width of the temperature bins of the rate cache in K, the cache
+	 * is not used if it is not positive.
+	 */
+	double rateCacheBinWidth = 0.0;
+
+	/**
+	 * The reactions in the order of the cached rates, production then
+	 * dissociation.
+	 */
+	std::vector<Reaction*> rateCacheReactions;
+
+	/**
+	 * The rate constants of all the reactions computed at the temperature
+	 * of each bin boundary, followed by the biggest production rate. They
+	 * are shared by all the grid points.
+	 */
+	std::unordered_map<long, std::vector<double> > rateCache;
+
+	/**
+	 * Get the rate constants at a bin boundary, computing them at the given
+	 * grid point if they are not in the cache yet.
+	 *
+	 * @param bin The index of the bin boundary
+	 * @param i The location on the grid used for the computation
+	 * @param computed Set to true if the rates had to be computed
+	 * @return The cached rates
+	 */
+	const std::vector<double>& getCachedRates(long bin, int i, bool& computed);
+
+	/**
+	 * Set the rate constants at the given grid point by interpolating
+	 * linearly between the cached rates of the bin containing the
+	 * temperature, and copy them in the compiled table.
+	 *
+	 * @param temp The temperature
+	 * @param i The location on the grid in the depth direction
+	 */
+	void interpolateRateConstants(double temp, int i);
+
 	/**
 	 * Calculate the dissociation constant of the first cluster with respect to
 	 * the single-species cluster of the same type based on the current clusters
@@ -218,6 +293,62 @@ private:
 	void defineAnaDissociationReactions(ProductionReaction& forwardReaction,
 			IReactant& emitting);
 
+	/**
+	 * The number of threads used to search the reactions with the super
+	 * clusters in createReactionConnectivity().
+	 */
+	int nConnectivityThreads = 1;
+
+	/**
+	 * The reactions of a cluster with a super cluster producing another
+	 * super cluster, found by the search and waiting to be defined.
+	 */
+	struct SuperProductCandidate {
+		//! The super cluster produced
+		PSISuperCluster* product;
+		//! Whether both super clusters are full and the reaction is analytical
+		bool analytical;
+		//! The reactions of the members, if it is not analytical
+		std::vector<PendingProductionReactionInfo> prInfos;
+	};
+
+	/**
+	 * The type of the functions finding the reactions of a cluster with a
+	 * super cluster producing normal clusters.
+	 */
+	using OtherProductsFinder = std::function<void(PSISuperCluster&,
+			std::vector<PendingProductionReactionInfo>&)>;
+
+	/**
+	 * Call the given function for each index in [0, n), splitting the
+	 * indices in contiguous blocks among the connectivity threads.
+	 *
+	 * @param n The number of indices
+	 * @param body The function, it must be safe to call concurrently
+	 */
+	void parallelFor(int n, const std::function<void(int)>& body) const;
+
+	/**
+	 * Define the reactions of a mobile cluster with each super cluster
+	 * producing another super cluster, where the product members are the
+	 * members of the super cluster shifted by the given composition. The
+	 * reactions producing normal clusters can also be found by the given
+	 * function, they are defined after the ones of the same super cluster.
+	 *
+	 * The reactions are found in parallel, each thread looking at some
+	 * super clusters, and defined afterwards in the order of the super
+	 * clusters so that the network does not depend on the number of threads.
+	 *
+	 * @param reactant The mobile cluster
+	 * @param shift The change of the He, D, T and V numbers
+	 * @param supers The super clusters, in the order of the network
+	 * @param findOtherProducts The function finding the reactions with
+	 * normal products, if any
+	 */
+	void defineSuperReactions(IReactant& reactant, const int shift[4],
+			const std::vector<PSISuperCluster*>& supers,
+			const OtherProductsFinder& findOtherProducts = nullptr);
+
 	/**
 	 * Check whether dissociation reaction is allowed for
 	 * given production reaction.
@@ -379,14 +510,58 @@ public:
 	 * call the ReactionNetwork::setTemperature() operation.
 	 * @param i The location on the grid in the depth direction
 	 *
+	 * If the rate cache is used the rate constants are interpolated from
+	 * the ones computed at the closest bin boundaries.
+	 *
 	 * @param temp The new temperature
 	 */
 	void setTemperature(double temp, int i) override;
 
+	/**
+	 * Set the number of threads used to build the reaction connectivity.
+	 *
+	 * @param n The number of threads
+	 */
+	void setConnectivityThreads(int n) {
+		nConnectivityThreads = std::max(n, 1);
+	}
+
+	/**
+	 * Set the width of the temperature bins used to cache the rate
+	 * constants. The rates are then computed only once for each bin
+	 * boundary and interpolated for all the grid points in between.
+	 * This empties the cache.
+	 *
+	 * @param width The width in K, 0.0 to always compute the rates
+	 */
+	void setRateCacheBinWidth(double width) {
+		rateCacheBinWidth = width;
+		clearRateCache();
+	}
+
+	/**
+	 * Empty the rate cache. It needs to be done each time the reactions
+	 * or the parameters used to compute their rates change.
+	 */
+	void clearRateCache() {
+		rateCache.clear();
+		rateCacheReactions.clear();
+	}
+
+	/**
+	 * Get the number of temperature bin boundaries in the rate cache.
+	 *
+	 * @return The number of cached entries
+	 */
+	int getRateCacheSize() const {
+		return rateCache.size();
+	}
+
 	/**
 	 * This operation reinitializes the network.
 	 *
-	 * It computes the cluster Ids and network size from the allReactants vector.
+	 * It computes the cluster Ids and network size from the allReactants vector,
+	 * and the weights of the totals.
 	 */
 	void reinitializeNetwork() override;
 
@@ -396,6 +571,40 @@ public:
 	 */
 	void reinitializeConnectivities() override;
 
+	/**
+	 * This operation flattens all the production and dissociation reactions
+	 * into the compiled reaction table. It needs to be called once the
+	 * reaction connectivity and the Ids are set, it is done at the end of
+	 * reinitializeConnectivities().
+	 */
+	void compileReactionTable();
+
+	/**
+	 * Get the compiled reaction table.
+	 *
+	 * @return The table
+	 */
+	const PSIReactionTable& getReactionTable() const {
+		return reactionTable;
+	}
+
+	/**
+	 * Calculate all the rate constants for the reactions and dissociations
+	 * of the network with the batched evaluator and copy them in the
+	 * compiled table.
+	 *
+	 * @param i The location on the grid in the depth direction
+	 */
+	void computeRateConstants(int i) override;
+
+	/**
+	 * Add grid points to the vector of rates or remove them if the value is
+	 * negative, in the reactions and in the compiled table.
+	 *
+	 * @param i The number of grid point to add or remove
+	 */
+	void addGridPoints(int i) override;
+
 	/**
 	 * This operation updates the concentrations for all reactants in the
 	 * network from an array.
@@ -489,6 +698,21 @@ public:
 	 */
 	void computeAllFluxes(double *updatedConcOffset, int i) override;
 
+	/**
+	 * Compute the fluxes generated by all the reactions
+	 * for all the clusters and their momentums, reading the concentrations
+	 * and moments directly from the given array. No state is stored in
+	 * the clusters. The compiled reaction table is used if it is ready.
+	 *
+	 * @param concOffset The pointer to the array of the concentration at the grid
+	 * point where the fluxes are computed
+	 * @param updatedConcOffset The pointer to the array of the concentration at the grid
+	 * point where the fluxes are computed used to find the next solution
+	 * @param i The location on the grid in the depth direction
+	 */
+	void computeAllFluxes(double *concOffset, double *updatedConcOffset, int i)
+			override;
+
 	/**
 	 * Compute the partial derivatives generated by all the reactions
 	 * for all the clusters and their momentum.
@@ -503,6 +727,74 @@ public:
 			const std::vector<int>& indices, std::vector<double>& vals, int i) const
 					override;
 
+	/**
+	 * Compute the partial derivatives generated by all the reactions
+	 * for all the clusters and their momentum, reading the concentrations
+	 * directly from the given array. The compiled reaction table is used
+	 * if its partial derivative positions are known, which happens once
+	 * getDiagonalFill() has been called.
+	 *
+	 * @param concOffset The pointer to the array of the concentration at the grid
+	 * point where the partials are computed
+	 * @param startingIdx Starting index of items owned by each reactant
+	 *      within the partials values array and the indices array.
+	 * @param indices The indices of the clusters for the partial derivatives.
+	 * @param vals The values of partials for the reactions
+	 * @param i The location on the grid in the depth direction
+	 */
+	void computeAllPartials(double *concOffset,
+			const std::vector<size_t>& startingIdx,
+			const std::vector<int>& indices, std::vector<double>& vals, int i)
+					override;
+
+	/**
+	 * The stateless flux and partial derivative methods only read the
+	 * compiled reaction table, they can be called concurrently once it is
+	 * complete.
+	 *
+	 * @return True if the reaction table and its partials are compiled
+	 */
+	bool canComputeConcurrently() const override {
+		return reactionTable.isCompiled() && reactionTable.arePartialsCompiled();
+	}
+
+	/**
+	 * Compute the product of the partial derivatives generated by all the
+	 * reactions with the given vector and add it to the result, leaving out
+	 * the partial derivatives between two DOFs of the same block. The
+	 * compiled reaction table computes it without storing the partial
+	 * derivatives when it is complete.
+	 *
+	 * @param concOffset The pointer to the array of the concentration at the grid
+	 * point where the product is computed
+	 * @param vecOffset The pointer to the vector multiplied at this grid point
+	 * @param resultOffset The pointer to the array where the product is added
+	 * @param blockIds The block id of each DOF
+	 * @param startingIdx Starting index of items owned by each reactant
+	 *      within the partials values array and the indices array.
+	 * @param indices The indices of the clusters for the partial derivatives.
+	 * @param vals A workspace for the values of partials
+	 * @param i The location on the grid in the depth direction
+	 */
+	void computeAllPartialsAction(double *concOffset, const double *vecOffset,
+			double *resultOffset, const std::vector<int>& blockIds,
+			const std::vector<size_t>& startingIdx,
+			const std::vector<int>& indices, std::vector<double>& vals, int i)
+					override;
+
+	/**
+	 * Move the compiled reaction table and the constant part of the rate
+	 * evaluator to memory shared by all the processes of the node, then
+	 * release the reacting pairs of the clusters that the table replaces.
+	 * Only the rates, and the reactions receiving them, stay private to
+	 * each process. Afterwards the fluxes and partial derivatives can only
+	 * be computed from a concentration array and the reactions can't be
+	 * compiled again.
+	 *
+	 * Nothing is done if the table or its partials are not compiled.
+	 */
+	void shareReadOnlyData() override;
+
 	/**
 	 * Set the phase space to save time and memory
 	 *
@@ -0,0 +1,175 @@
+// Includes
+#include "PSIRateEvaluator.h"
+#include <cmath>
+#include <Constants.h>
+
+namespace xolotlCore {
+
+int PSIRateEvaluator::getReactantIndex(const IReactant& reactant) {
+	// Look for the reactant
+	auto iter = reactantMap.find(&reactant);
+	if (iter != reactantMap.end())
+		return iter->second;
+
+	// Add it
+	int index = reactants.size();
+	reactants.push_back(&reactant);
+	reactantMap.emplace(&reactant, index);
+
+	return index;
+}
+
+void PSIRateEvaluator::clear() {
+	reactants.clear();
+	reactantMap.clear();
+	productionMap.clear();
+	productionReactions.clear();
+	productionFirst.clear();
+	productionSecond.clear();
+	productionFactor.clear();
+	dissociationReactions.clear();
+	dissociationReverse.clear();
+	dissociationEnergy.clear();
+	// The window is freed collectively by the next shareOnNode() or by the
+	// destructor
+	shared = false;
+	updateView();
+
+	return;
+}
+
+void PSIRateEvaluator::addProduction(ProductionReaction& reaction) {
+	productionMap.emplace(&reaction, productionReactions.size());
+	productionReactions.push_back(&reaction);
+	productionFirst.push_back(getReactantIndex(reaction.first));
+	productionSecond.push_back(getReactantIndex(reaction.second));
+	productionFactor.push_back(
+			4.0 * xolotlCore::pi
+					* (reaction.first.getReactionRadius()
+							+ reaction.second.getReactionRadius()));
+	updateView();
+
+	return;
+}
+
+void PSIRateEvaluator::addDissociation(DissociationReaction& reaction,
+		double bindingEnergy) {
+	// Find the reverse reaction
+	auto iter = productionMap.find(reaction.reverseReaction);
+	if (iter == productionMap.end()) {
+		throw std::string(
+				"\nPSIRateEvaluator: the reverse reaction of the dissociation "
+						+ reaction.dissociating.getName()
+						+ " was not added to the evaluator.");
+	}
+
+	dissociationReactions.push_back(&reaction);
+	dissociationReverse.push_back(iter->second);
+	dissociationEnergy.push_back(bindingEnergy / xolotlCore::kBoltzmann);
+	updateView();
+
+	return;
+}
+
+double PSIRateEvaluator::computeRates(int i, double temp,
+		double dissociationPrefactor) {
+	const int nReactants = reactants.size();
+	const int nProductions = productionReactions.size();
+	const int nDissociations = dissociationReactions.size();
+	diffusion.resize(nReactants);
+	productionRates.resize(nProductions);
+	dissociationRates.resize(nDissociations);
+
+	// Read the diffusion coefficients once per reactant
+	for (int r = 0; r < nReactants; r++) {
+		diffusion[r] = reactants[r]->getDiffusionCoefficient(i);
+	}
+
+	// Production rates
+	double biggestRate = 0.0;
+	for (int k = 0; k < nProductions; k++) {
+		double rate = view.productionFactor[k]
+				* (diffusion[view.productionFirst[k]]
+						+ diffusion[view.productionSecond[k]]);
+		productionRates[k] = rate;
+		if (rate > biggestRate)
+			biggestRate = rate;
+	}
+
+	// All the Arrhenius factors at once
+	const double invTemp = 1.0 / temp;
+	const double *energy = view.dissociationEnergy;
+	double *dissRates = dissociationRates.data();
+	for (int k = 0; k < nDissociations; k++) {
+		dissRates[k] = std::exp(-energy[k] * invTemp);
+	}
+
+	// Dissociation rates
+	for (int k = 0; k < nDissociations; k++) {
+		dissRates[k] *= dissociationPrefactor
+				* productionRates[view.dissociationReverse[k]];
+	}
+
+	// Set them in the reactions
+	for (int k = 0; k < nProductions; k++) {
+		productionReactions[k]->kConstant[i] = productionRates[k];
+	}
+	for (int k = 0; k < nDissociations; k++) {
+		dissociationReactions[k]->kConstant[i] = dissRates[k];
+	}
+
+	return biggestRate;
+}
+
+void PSIRateEvaluator::updateView() {
+	if (shared)
+		return;
+
+	view.productionFirst = productionFirst.data();
+	view.productionSecond = productionSecond.data();
+	view.productionFactor = productionFactor.data();
+	view.dissociationReverse = dissociationReverse.data();
+	view.dissociationEnergy = dissociationEnergy.data();
+
+	return;
+}
+
+std::size_t PSIRateEvaluator::packArrays(char *base, bool write) {
+	std::size_t total = 0;
+	NodeSharedBuffer::packArray(productionFirst, view.productionFirst, total,
+			base, write);
+	NodeSharedBuffer::packArray(productionSecond, view.productionSecond,
+			total, base, write);
+	NodeSharedBuffer::packArray(productionFactor, view.productionFactor,
+			total, base, write);
+	NodeSharedBuffer::packArray(dissociationReverse, view.dissociationReverse,
+			total, base, write);
+	NodeSharedBuffer::packArray(dissociationEnergy, view.dissociationEnergy,
+			total, base, write);
+
+	return total;
+}
+
+void PSIRateEvaluator::shareOnNode(MPI_Comm comm) {
+	// Nothing to do if it already is
+	if (shared)
+		return;
+
+	// Get the size of the buffer
+	std::size_t total = packArrays(nullptr, false);
+
+	// Allocate it on each node, freeing the window of a previous filling,
+	// and let the first process fill it
+	sharedBuffer.allocate(comm, total);
+	packArrays(sharedBuffer.data(), sharedBuffer.isNodeMaster());
+	sharedBuffer.synchronize();
+	shared = true;
+
+	// The reactions can't be found anymore
+	reactantMap.clear();
+	productionMap.clear();
+
+	return;
+}
+
+} /* end namespace xolotlCore */
@@ -0,0 +1,209 @@
+#ifndef PSIRATEEVALUATOR_H
+#define PSIRATEEVALUATOR_H
+
+// Includes
+#include <vector>
+#include <unordered_map>
+#include <mpi.h>
+#include "ProductionReaction.h"
+#include "DissociationReaction.h"
+#include "NodeSharedBuffer.h"
+
+namespace xolotlCore {
+
+/**
+ * This class computes the rate constants of all the production and
+ * dissociation reactions of a PSI network at once. Everything that does
+ * not depend on the temperature (reaction radii, binding energies, which
+ * reactants and which reverse reaction are involved) is computed once
+ * when the reactions are added and stored in contiguous arrays.
+ *
+ * For a given grid point the diffusion coefficient of each reactant is
+ * read once, all the production rates are computed, then all the
+ * Arrhenius factors of the dissociations in a single loop over a
+ * contiguous array that the compiler can vectorize. The rates are then
+ * copied in the reactions.
+ *
+ * The arrays that don't depend on the temperature can be moved with
+ * shareOnNode() to a buffer shared by all the processes of a node, the
+ * reactions receiving the rates stay private to each process.
+ */
+class PSIRateEvaluator {
+
+private:
+
+	//! The reactants involved in the production reactions
+	std::vector<const IReactant*> reactants;
+
+	//! Map from the reactant to its index, only used while filling
+	std::unordered_map<const IReactant*, int> reactantMap;
+
+	//! Map from the production reaction to its index, only used while filling
+	std::unordered_map<const ProductionReaction*, int> productionMap;
+
+	//! The production reactions
+	std::vector<ProductionReaction*> productionReactions;
+
+	//! The index of the first reactant of each production reaction
+	std::vector<int> productionFirst;
+
+	//! The index of the second reactant of each production reaction
+	std::vector<int> productionSecond;
+
+	//! 4 pi times the sum of the reaction radii of each production reaction
+	std::vector<double> productionFactor;
+
+	//! The dissociation reactions
+	std::vector<DissociationReaction*> dissociationReactions;
+
+	//! The index of the reverse production reaction of each dissociation
+	std::vector<int> dissociationReverse;
+
+	//! The binding energy divided by the Boltzmann constant of each dissociation
+	std::vector<double> dissociationEnergy;
+
+	//! The diffusion coefficients at the grid point, one per reactant
+	std::vector<double> diffusion;
+
+	//! The production rates at the grid point
+	std::vector<double> productionRates;
+
+	//! The dissociation rates at the grid point
+	std::vector<double> dissociationRates;
+
+	/**
+	 * The arrays that don't depend on the temperature. They point either
+	 * to the vectors above or to the buffer shared by the node.
+	 */
+	struct View {
+		const int *productionFirst = nullptr;
+		const int *productionSecond = nullptr;
+		const double *productionFactor = nullptr;
+		const int *dissociationReverse = nullptr;
+		const double *dissociationEnergy = nullptr;
+	} view;
+
+	//! Do the arrays point to the buffer shared by the node?
+	bool shared;
+
+	//! The buffer shared by the processes of the node
+	NodeSharedBuffer sharedBuffer;
+
+	/**
+	 * Point the view to the vectors.
+	 */
+	void updateView();
+
+	/**
+	 * Compute the size of the packed arrays, and copy them in the given
+	 * buffer.
+	 *
+	 * @param base The start of the buffer, nullptr to only get the size
+	 * @param write Should the arrays be copied or only pointed to?
+	 * @return The size of the buffer in bytes
+	 */
+	std::size_t packArrays(char *base, bool write);
+
+	/**
+	 * Get the index of a reactant, adding it if needed.
+	 *
+	 * @param reactant The reactant
+	 * @return The index
+	 */
+	int getReactantIndex(const IReactant& reactant);
+
+public:
+
+	/**
+	 * The constructor.
+	 */
+	PSIRateEvaluator() :
+			shared(false) {
+	}
+
+	/**
+	 * The destructor, it frees the shared window and is thus collective on
+	 * the node if the evaluator was shared.
+	 */
+	~PSIRateEvaluator() {
+	}
+
+	/**
+	 * Empty the evaluator. It is local to the process: the window of a
+	 * shared evaluator stays allocated until the next shareOnNode() or the
+	 * destruction of the evaluator.
+	 */
+	void clear();
+
+	/**
+	 * Add a production reaction. They all need to be added before the
+	 * dissociations.
+	 *
+	 * @param reaction The reaction
+	 */
+	void addProduction(ProductionReaction& reaction);
+
+	/**
+	 * Add a dissociation reaction.
+	 *
+	 * @param reaction The reaction
+	 * @param bindingEnergy The binding energy of the dissociation in eV
+	 */
+	void addDissociation(DissociationReaction& reaction, double bindingEnergy);
+
+	/**
+	 * Get the number of production reactions.
+	 *
+	 * @return The number of production reactions
+	 */
+	int getNProductions() const {
+		return productionReactions.size();
+	}
+
+	/**
+	 * Get the number of dissociation reactions.
+	 *
+	 * @return The number of dissociation reactions
+	 */
+	int getNDissociations() const {
+		return dissociationReactions.size();
+	}
+
+	/**
+	 * Compute the rate constants of all the reactions at the given grid
+	 * point and set them in the reactions. The dissociation rate is
+	 * k- = prefactor * k+ * exp(-Eb / (kB * T)) where k+ is the rate of the
+	 * reverse reaction.
+	 *
+	 * @param i The location on the grid in the depth direction
+	 * @param temp The temperature
+	 * @param dissociationPrefactor The prefactor of the dissociation rates,
+	 * the inverse of the atomic volume or 0.0 if they are disabled
+	 * @return The biggest production rate
+	 */
+	double computeRates(int i, double temp, double dissociationPrefactor);
+
+	/**
+	 * Move the arrays that don't depend on the temperature to a buffer
+	 * shared by all the processes of each node. This method is collective
+	 * on the given communicator and the reactions have to be identical on
+	 * all the processes. No reaction can be added afterwards without
+	 * calling clear().
+	 *
+	 * @param comm The communicator of the processes sharing the evaluator
+	 */
+	void shareOnNode(MPI_Comm comm);
+
+	/**
+	 * Is the evaluator stored in a buffer shared by the node?
+	 *
+	 * @return True if shareOnNode() was called since the last clear()
+	 */
+	bool isShared() const {
+		return shared;
+	}
+};
+//end class PSIRateEvaluator
+
+} /* end namespace xolotlCore */
+#endif
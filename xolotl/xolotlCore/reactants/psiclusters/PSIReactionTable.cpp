@@ -0,0 +1,540 @@
+// Includes
+#include "PSIReactionTable.h"
+#include <algorithm>
+#include <cassert>
+
+namespace xolotlCore {
+
+int PSIReactionTable::getRateSlot(const Reaction& reaction) {
+	// Look for the reaction
+	auto iter = slotMap.find(&reaction);
+	if (iter != slotMap.end())
+		return iter->second;
+
+	// Create a new slot
+	int slot = slotReactions.size();
+	slotReactions.push_back(&reaction);
+	slotMap.emplace(&reaction, slot);
+
+	return slot;
+}
+
+void PSIReactionTable::clear(int dim) {
+	psDim = std::max(dim, 1);
+	nGrid = 0;
+	compiled = false;
+	partialsCompiled = false;
+	currentNOut = 0;
+	for (int i = 0; i < 4; i++)
+		pendingTerms[i].clear();
+	slotMap.clear();
+	slotReactions.clear();
+	rates.clear();
+	rowNOut.clear();
+	rowOutIds.clear();
+	twoBodyStart.clear();
+	oneBodyStart.clear();
+	twoBodyCoefStart.clear();
+	oneBodyCoefStart.clear();
+	twoBodySlot.clear();
+	twoBodyIdsA.clear();
+	twoBodyIdsB.clear();
+	twoBodyCoefs.clear();
+	oneBodySlot.clear();
+	oneBodyIdsA.clear();
+	oneBodyCoefs.clear();
+	twoBodyColA.clear();
+	twoBodyColB.clear();
+	oneBodyColA.clear();
+	// The window is freed collectively by the next shareOnNode() or by the
+	// destructor, the view goes back to the private arrays
+	shared = false;
+	updateView();
+
+	return;
+}
+
+void PSIReactionTable::startRow(const int outIds[5], int nOut) {
+	// Finish the previous row
+	if (currentNOut > 0)
+		flushRow();
+
+	// Save the outputs
+	rowNOut.push_back(nOut);
+	for (int k = 0; k < psDim; k++) {
+		rowOutIds.push_back((k < nOut) ? outIds[k] : -1);
+	}
+	currentNOut = nOut;
+
+	return;
+}
+
+void PSIReactionTable::addTerm(TermKind kind, const Reaction& reaction,
+		const int idsA[5], const int idsB[5], const double *coefs, int size) {
+	assert(currentNOut > 0);
+
+	// Create the term
+	PendingTerm term;
+	term.slot = getRateSlot(reaction);
+	term.coefs.assign(coefs, coefs + size);
+	bool isTwoBody = (kind == TermKind::Production
+			|| kind == TermKind::Combination);
+
+	// Absent moments don't contribute: set their coefficients to 0 and
+	// point them to the concentration so that they can be read safely
+	for (int a = 0; a < psDim; a++) {
+		term.idsA[a] = (idsA[a] < 0) ? idsA[0] : idsA[a];
+		term.idsB[a] = (idsB[a] < 0) ? idsB[0] : idsB[a];
+		for (int k = 0; k < currentNOut; k++) {
+			for (int b = 0; b < psDim; b++) {
+				if (isTwoBody) {
+					if (idsA[a] < 0 || idsB[b] < 0)
+						term.coefs[(k * psDim + a) * psDim + b] = 0.0;
+				} else if (idsA[a] < 0)
+					term.coefs[k * psDim + a] = 0.0;
+			}
+		}
+	}
+
+	pendingTerms[(int) kind].push_back(term);
+
+	return;
+}
+
+void PSIReactionTable::flushRow() {
+	// Save the starting positions
+	twoBodyCoefStart.push_back(twoBodyCoefs.size());
+	oneBodyCoefStart.push_back(oneBodyCoefs.size());
+
+	// Loop on the kinds in the order they will be computed
+	for (int kind = 0; kind < 4; kind++) {
+		bool isTwoBody = (kind < 2);
+		if (isTwoBody)
+			twoBodyStart.push_back(twoBodySlot.size());
+		else
+			oneBodyStart.push_back(oneBodySlot.size());
+
+		for (auto const& term : pendingTerms[kind]) {
+			if (isTwoBody) {
+				twoBodySlot.push_back(term.slot);
+				twoBodyIdsA.insert(twoBodyIdsA.end(), term.idsA,
+						term.idsA + psDim);
+				twoBodyIdsB.insert(twoBodyIdsB.end(), term.idsB,
+						term.idsB + psDim);
+				twoBodyCoefs.insert(twoBodyCoefs.end(), term.coefs.begin(),
+						term.coefs.end());
+			} else {
+				oneBodySlot.push_back(term.slot);
+				oneBodyIdsA.insert(oneBodyIdsA.end(), term.idsA,
+						term.idsA + psDim);
+				oneBodyCoefs.insert(oneBodyCoefs.end(), term.coefs.begin(),
+						term.coefs.end());
+			}
+		}
+		pendingTerms[kind].clear();
+	}
+
+	return;
+}
+
+void PSIReactionTable::finalize() {
+	// Finish the last row
+	if (currentNOut > 0)
+		flushRow();
+	currentNOut = 0;
+
+	// Add the end of the last row
+	twoBodyStart.push_back(twoBodySlot.size());
+	oneBodyStart.push_back(oneBodySlot.size());
+
+	// The map is not needed anymore
+	slotMap.clear();
+
+	// Release the extra memory
+	twoBodySlot.shrink_to_fit();
+	twoBodyIdsA.shrink_to_fit();
+	twoBodyIdsB.shrink_to_fit();
+	twoBodyCoefs.shrink_to_fit();
+	oneBodySlot.shrink_to_fit();
+	oneBodyIdsA.shrink_to_fit();
+	oneBodyCoefs.shrink_to_fit();
+
+	// Get the rates
+	updateAllRates();
+	compiled = true;
+	updateView();
+
+	return;
+}
+
+void PSIReactionTable::updateRates(int xi) {
+	if (xi < 0 || xi >= nGrid)
+		return;
+
+	// Copy the rates
+	const int nSlots = slotReactions.size();
+	double *rateRow = rates.data() + (size_t) xi * nSlots;
+	for (int s = 0; s < nSlots; s++) {
+		rateRow[s] = slotReactions[s]->kConstant[xi];
+	}
+
+	return;
+}
+
+void PSIReactionTable::updateAllRates() {
+	// Get the number of grid points from the reactions
+	nGrid = slotReactions.empty() ? 0 : slotReactions[0]->kConstant.size();
+	rates.assign((size_t) nGrid * slotReactions.size(), 0.0);
+
+	// Copy all the rates
+	for (int xi = 0; xi < nGrid; xi++) {
+		updateRates(xi);
+	}
+
+	return;
+}
+
+void PSIReactionTable::computeFluxes(const double *concOffset,
+		double *updatedConcOffset, int xi) const {
+	// Initial declarations
+	const int nSlots = slotReactions.size();
+	const double *rateRow = rates.data() + (size_t) xi * nSlots;
+	const int nRows = view.nRows;
+	const int blockA = psDim, blockAB = psDim * psDim;
+	double lA[5] = { }, lB[5] = { }, flux[4][5] = { };
+
+	// Loop on the rows
+	for (int r = 0; r < nRows; r++) {
+		const int nOut = view.rowNOut[r];
+
+		// Production and combination
+		const double *coefs = view.twoBodyCoefs + view.twoBodyCoefStart[r];
+		for (int kind = 0; kind < 2; kind++) {
+			double *f = flux[kind];
+			for (int k = 0; k < nOut; k++)
+				f[k] = 0.0;
+
+			for (int t = view.twoBodyStart[2 * r + kind];
+					t < view.twoBodyStart[2 * r + kind + 1]; t++) {
+				const int *idsA = &view.twoBodyIdsA[t * psDim];
+				const int *idsB = &view.twoBodyIdsB[t * psDim];
+				for (int a = 0; a < psDim; a++) {
+					lA[a] = concOffset[idsA[a]];
+					lB[a] = concOffset[idsB[a]];
+				}
+				const double rate = rateRow[view.twoBodySlot[t]];
+				for (int k = 0; k < nOut; k++) {
+					const double *c = coefs + k * blockAB;
+					double sum = 0.0;
+					for (int a = 0; a < psDim; a++) {
+						for (int b = 0; b < psDim; b++) {
+							sum += c[a * psDim + b] * lA[a] * lB[b];
+						}
+					}
+					f[k] += rate * sum;
+				}
+				coefs += nOut * blockAB;
+			}
+		}
+
+		// Dissociation and emission
+		coefs = view.oneBodyCoefs + view.oneBodyCoefStart[r];
+		for (int kind = 2; kind < 4; kind++) {
+			double *f = flux[kind];
+			for (int k = 0; k < nOut; k++)
+				f[k] = 0.0;
+
+			for (int t = view.oneBodyStart[2 * r + kind - 2];
+					t < view.oneBodyStart[2 * r + kind - 1]; t++) {
+				const int *idsA = &view.oneBodyIdsA[t * psDim];
+				for (int a = 0; a < psDim; a++) {
+					lA[a] = concOffset[idsA[a]];
+				}
+				const double rate = rateRow[view.oneBodySlot[t]];
+				for (int k = 0; k < nOut; k++) {
+					const double *c = coefs + k * blockA;
+					double sum = 0.0;
+					for (int a = 0; a < psDim; a++) {
+						sum += c[a] * lA[a];
+					}
+					f[k] += rate * sum;
+				}
+				coefs += nOut * blockA;
+			}
+		}
+
+		// Update the concentrations
+		const int *outIds = &view.rowOutIds[r * psDim];
+		for (int k = 0; k < nOut; k++) {
+			updatedConcOffset[outIds[k]] += flux[0][k] - flux[1][k]
+					+ flux[2][k] - flux[3][k];
+		}
+	}
+
+	return;
+}
+
+void PSIReactionTable::compilePartials(
+		const std::unordered_map<int, std::unordered_map<int, int> >& fillInvMap) {
+	// Initial declarations
+	const int nRows = view.nRows;
+	twoBodyColA.assign(view.nTwoBody * psDim, -1);
+	twoBodyColB.assign(view.nTwoBody * psDim, -1);
+	oneBodyColA.assign(view.nOneBody * psDim, -1);
+
+	// Get the position of a column within a row, -1 if the column is not
+	// part of the diagonal fill (the partial derivative is then dropped)
+	auto getPosition = [](const std::unordered_map<int, int>& rowMap, int col) {
+		auto iter = rowMap.find(col);
+		return (iter == rowMap.end()) ? -1 : iter->second;
+	};
+
+	// Loop on the rows
+	for (int r = 0; r < nRows; r++) {
+		auto const& rowMap = fillInvMap.at(view.rowOutIds[r * psDim]);
+
+		for (int t = view.twoBodyStart[2 * r]; t < view.twoBodyStart[2 * r + 2];
+				t++) {
+			for (int a = 0; a < psDim; a++) {
+				twoBodyColA[t * psDim + a] = getPosition(rowMap,
+						view.twoBodyIdsA[t * psDim + a]);
+				twoBodyColB[t * psDim + a] = getPosition(rowMap,
+						view.twoBodyIdsB[t * psDim + a]);
+			}
+		}
+		for (int t = view.oneBodyStart[2 * r]; t < view.oneBodyStart[2 * r + 2];
+				t++) {
+			for (int a = 0; a < psDim; a++) {
+				oneBodyColA[t * psDim + a] = getPosition(rowMap,
+						view.oneBodyIdsA[t * psDim + a]);
+			}
+		}
+	}
+
+	partialsCompiled = true;
+	updateView();
+
+	return;
+}
+
+void PSIReactionTable::computePartials(const double *concOffset,
+		const std::vector<size_t>& startingIdx, double *vals, int xi) const {
+	// Initial declarations
+	const int nSlots = slotReactions.size();
+	const double *rateRow = rates.data() + (size_t) xi * nSlots;
+	const int nRows = view.nRows;
+	const int blockA = psDim, blockAB = psDim * psDim;
+	double lA[5] = { }, lB[5] = { };
+	// The sign of each kind of term
+	const double signs[4] = { 1.0, -1.0, 1.0, -1.0 };
+
+	// Loop on the rows
+	for (int r = 0; r < nRows; r++) {
+		const int nOut = view.rowNOut[r];
+		const int *outIds = &view.rowOutIds[r * psDim];
+
+		// Production and combination
+		const double *coefs = view.twoBodyCoefs + view.twoBodyCoefStart[r];
+		for (int kind = 0; kind < 2; kind++) {
+			for (int t = view.twoBodyStart[2 * r + kind];
+					t < view.twoBodyStart[2 * r + kind + 1]; t++) {
+				const int *idsA = &view.twoBodyIdsA[t * psDim];
+				const int *idsB = &view.twoBodyIdsB[t * psDim];
+				const int *colA = &view.twoBodyColA[t * psDim];
+				const int *colB = &view.twoBodyColB[t * psDim];
+				for (int a = 0; a < psDim; a++) {
+					lA[a] = concOffset[idsA[a]];
+					lB[a] = concOffset[idsB[a]];
+				}
+				const double rate = signs[kind] * rateRow[view.twoBodySlot[t]];
+				for (int k = 0; k < nOut; k++) {
+					const double *c = coefs + k * blockAB;
+					double *rowVals = vals + startingIdx[outIds[k]];
+					for (int a = 0; a < psDim; a++) {
+						double sumA = 0.0, sumB = 0.0;
+						for (int b = 0; b < psDim; b++) {
+							sumA += c[a * psDim + b] * lB[b];
+							sumB += c[b * psDim + a] * lA[b];
+						}
+						if (colA[a] >= 0)
+							rowVals[colA[a]] += rate * sumA;
+						if (colB[a] >= 0)
+							rowVals[colB[a]] += rate * sumB;
+					}
+				}
+				coefs += nOut * blockAB;
+			}
+		}
+
+		// Dissociation and emission
+		coefs = view.oneBodyCoefs + view.oneBodyCoefStart[r];
+		for (int kind = 2; kind < 4; kind++) {
+			for (int t = view.oneBodyStart[2 * r + kind - 2];
+					t < view.oneBodyStart[2 * r + kind - 1]; t++) {
+				const int *colA = &view.oneBodyColA[t * psDim];
+				const double rate = signs[kind] * rateRow[view.oneBodySlot[t]];
+				for (int k = 0; k < nOut; k++) {
+					const double *c = coefs + k * blockA;
+					double *rowVals = vals + startingIdx[outIds[k]];
+					for (int a = 0; a < psDim; a++) {
+						if (colA[a] >= 0)
+							rowVals[colA[a]] += rate * c[a];
+					}
+				}
+				coefs += nOut * blockA;
+			}
+		}
+	}
+
+	return;
+}
+
+void PSIReactionTable::computePartialsAction(const double *concOffset,
+		const double *vecOffset, double *resultOffset, const int *blockIds,
+		int xi) const {
+	// Initial declarations
+	const int nSlots = slotReactions.size();
+	const double *rateRow = rates.data() + (size_t) xi * nSlots;
+	const int nRows = view.nRows;
+	const int blockA = psDim, blockAB = psDim * psDim;
+	double lA[5] = { }, lB[5] = { }, vA[5] = { }, vB[5] = { };
+	// The sign of each kind of term
+	const double signs[4] = { 1.0, -1.0, 1.0, -1.0 };
+
+	// Loop on the rows
+	for (int r = 0; r < nRows; r++) {
+		const int nOut = view.rowNOut[r];
+		const int *outIds = &view.rowOutIds[r * psDim];
+
+		// Production and combination
+		const double *coefs = view.twoBodyCoefs + view.twoBodyCoefStart[r];
+		for (int kind = 0; kind < 2; kind++) {
+			for (int t = view.twoBodyStart[2 * r + kind];
+					t < view.twoBodyStart[2 * r + kind + 1]; t++) {
+				const int *idsA = &view.twoBodyIdsA[t * psDim];
+				const int *idsB = &view.twoBodyIdsB[t * psDim];
+				for (int a = 0; a < psDim; a++) {
+					lA[a] = concOffset[idsA[a]];
+					lB[a] = concOffset[idsB[a]];
+				}
+				const double rate = signs[kind] * rateRow[view.twoBodySlot[t]];
+				for (int k = 0; k < nOut; k++) {
+					const double *c = coefs + k * blockAB;
+					const int outBlock = blockIds[outIds[k]];
+					// Only the reactants outside of the block of the output
+					for (int a = 0; a < psDim; a++) {
+						vA[a] = (blockIds[idsA[a]] != outBlock) ?
+								vecOffset[idsA[a]] : 0.0;
+						vB[a] = (blockIds[idsB[a]] != outBlock) ?
+								vecOffset[idsB[a]] : 0.0;
+					}
+					double sum = 0.0;
+					for (int a = 0; a < psDim; a++) {
+						for (int b = 0; b < psDim; b++) {
+							sum += c[a * psDim + b]
+									* (vA[a] * lB[b] + lA[a] * vB[b]);
+						}
+					}
+					resultOffset[outIds[k]] += rate * sum;
+				}
+				coefs += nOut * blockAB;
+			}
+		}
+
+		// Dissociation and emission
+		coefs = view.oneBodyCoefs + view.oneBodyCoefStart[r];
+		for (int kind = 2; kind < 4; kind++) {
+			for (int t = view.oneBodyStart[2 * r + kind - 2];
+					t < view.oneBodyStart[2 * r + kind - 1]; t++) {
+				const int *idsA = &view.oneBodyIdsA[t * psDim];
+				const double rate = signs[kind] * rateRow[view.oneBodySlot[t]];
+				for (int k = 0; k < nOut; k++) {
+					const double *c = coefs + k * blockA;
+					const int outBlock = blockIds[outIds[k]];
+					double sum = 0.0;
+					for (int a = 0; a < psDim; a++) {
+						if (blockIds[idsA[a]] != outBlock)
+							sum += c[a] * vecOffset[idsA[a]];
+					}
+					resultOffset[outIds[k]] += rate * sum;
+				}
+				coefs += nOut * blockA;
+			}
+		}
+	}
+
+	return;
+}
+
+void PSIReactionTable::updateView() {
+	// The counts
+	view.nRows = rowNOut.size();
+	view.nTwoBody = twoBodySlot.size();
+	view.nOneBody = oneBodySlot.size();
+
+	// The positions of the partials are the only arrays that can be computed
+	// after the table was shared
+	view.twoBodyColA = twoBodyColA.data();
+	view.twoBodyColB = twoBodyColB.data();
+	view.oneBodyColA = oneBodyColA.data();
+	if (shared)
+		return;
+
+	view.rowNOut = rowNOut.data();
+	view.rowOutIds = rowOutIds.data();
+	view.twoBodyStart = twoBodyStart.data();
+	view.oneBodyStart = oneBodyStart.data();
+	view.twoBodyCoefStart = twoBodyCoefStart.data();
+	view.oneBodyCoefStart = oneBodyCoefStart.data();
+	view.twoBodySlot = twoBodySlot.data();
+	view.twoBodyIdsA = twoBodyIdsA.data();
+	view.twoBodyIdsB = twoBodyIdsB.data();
+	view.twoBodyCoefs = twoBodyCoefs.data();
+	view.oneBodySlot = oneBodySlot.data();
+	view.oneBodyIdsA = oneBodyIdsA.data();
+	view.oneBodyCoefs = oneBodyCoefs.data();
+
+	return;
+}
+
+std::size_t PSIReactionTable::packArrays(char *base, bool write) {
+	std::size_t total = 0;
+	NodeSharedBuffer::packArray(rowNOut, view.rowNOut, total, base, write);
+	NodeSharedBuffer::packArray(rowOutIds, view.rowOutIds, total, base, write);
+	NodeSharedBuffer::packArray(twoBodyStart, view.twoBodyStart, total, base, write);
+	NodeSharedBuffer::packArray(oneBodyStart, view.oneBodyStart, total, base, write);
+	NodeSharedBuffer::packArray(twoBodyCoefStart, view.twoBodyCoefStart, total, base, write);
+	NodeSharedBuffer::packArray(oneBodyCoefStart, view.oneBodyCoefStart, total, base, write);
+	NodeSharedBuffer::packArray(twoBodySlot, view.twoBodySlot, total, base, write);
+	NodeSharedBuffer::packArray(twoBodyIdsA, view.twoBodyIdsA, total, base, write);
+	NodeSharedBuffer::packArray(twoBodyIdsB, view.twoBodyIdsB, total, base, write);
+	NodeSharedBuffer::packArray(twoBodyCoefs, view.twoBodyCoefs, total, base, write);
+	NodeSharedBuffer::packArray(oneBodySlot, view.oneBodySlot, total, base, write);
+	NodeSharedBuffer::packArray(oneBodyIdsA, view.oneBodyIdsA, total, base, write);
+	NodeSharedBuffer::packArray(oneBodyCoefs, view.oneBodyCoefs, total, base, write);
+	NodeSharedBuffer::packArray(twoBodyColA, view.twoBodyColA, total, base, write);
+	NodeSharedBuffer::packArray(twoBodyColB, view.twoBodyColB, total, base, write);
+	NodeSharedBuffer::packArray(oneBodyColA, view.oneBodyColA, total, base, write);
+
+	return total;
+}
+
+void PSIReactionTable::shareOnNode(MPI_Comm comm) {
+	// Nothing to share before the table is compiled, or if it already is
+	if (!compiled || shared)
+		return;
+
+	// Get the size of the buffer
+	std::size_t total = packArrays(nullptr, false);
+
+	// Allocate it on each node, freeing the window of a previous
+	// compilation, and let the first process fill it
+	sharedBuffer.allocate(comm, total);
+	packArrays(sharedBuffer.data(), sharedBuffer.isNodeMaster());
+	sharedBuffer.synchronize();
+	shared = true;
+
+	return;
+}
+
+} /* end namespace xolotlCore */
@@ -0,0 +1,412 @@
+#ifndef PSIREACTIONTABLE_H
+#define PSIREACTIONTABLE_H
+
+// Includes
+#include <vector>
+#include <unordered_map>
+#include <mpi.h>
+#include "Reaction.h"
+#include "NodeSharedBuffer.h"
+
+namespace xolotlCore {
+
+/**
+ * This class is a compiled, structure-of-arrays, version of all the
+ * production and dissociation terms of a PSI network. It is filled once
+ * the reaction connectivity is known, each cluster adding one row with all
+ * the terms contributing to its flux (and to the flux of its moments for
+ * super clusters).
+ *
+ * The terms of a row are stored contiguously and in the order production,
+ * combination, dissociation, and emission. The fluxes are computed by a
+ * single linear sweep over the rows that reads the concentrations directly
+ * from the array at the grid point.
+ *
+ * The rate constants are copied in a flat array indexed by grid point and
+ * rate slot, they need to be updated with updateRates() each time the rate
+ * constants of the reactions change.
+ *
+ * Everything except the rates is read-only once the table is compiled and
+ * can be moved with shareOnNode() to a buffer shared by all the processes
+ * of a node. The rates stay private to each process.
+ */
+class PSIReactionTable {
+
+public:
+
+	//! The different kinds of terms
+	enum class TermKind {
+		Production, Combination, Dissociation, Emission
+	};
+
+private:
+
+	/**
+	 * A term waiting for its row to be finished.
+	 */
+	struct PendingTerm {
+		//! The rate slot
+		int slot;
+		//! The DOF indices of the first reactant
+		int idsA[5];
+		//! The DOF indices of the second reactant (two-body terms only)
+		int idsB[5];
+		//! The coefficients
+		std::vector<double> coefs;
+	};
+
+	//! The dimension of the phase space
+	int psDim;
+
+	//! The number of grid points for the rates
+	int nGrid;
+
+	//! Was the table finished with finalize()?
+	bool compiled;
+
+	//! Were the partial derivative positions computed?
+	bool partialsCompiled;
+
+	//! Do the read-only arrays point to the buffer shared by the node?
+	bool shared;
+
+	//! The number of outputs of the row being filled
+	int currentNOut;
+
+	//! The pending terms of the row being filled, one list per kind
+	std::vector<PendingTerm> pendingTerms[4];
+
+	//! Map from the reaction to its rate slot, only used while filling
+	std::unordered_map<const Reaction*, int> slotMap;
+
+	//! The reactions corresponding to each rate slot
+	std::vector<const Reaction*> slotReactions;
+
+	//! The rates, indexed by grid point then rate slot
+	std::vector<double> rates;
+
+	//! The number of outputs for each row (1, or psDim for super clusters)
+	std::vector<int> rowNOut;
+
+	//! The DOF indices of the outputs for each row, psDim per row
+	std::vector<int> rowOutIds;
+
+	/**
+	 * The start of each kind of two-body terms in each row,
+	 * production then combination, plus the end.
+	 */
+	std::vector<int> twoBodyStart;
+
+	/**
+	 * The start of each kind of one-body terms in each row,
+	 * dissociation then emission, plus the end.
+	 */
+	std::vector<int> oneBodyStart;
+
+	//! The start of the two-body coefficients of each row
+	std::vector<size_t> twoBodyCoefStart;
+
+	//! The start of the one-body coefficients of each row
+	std::vector<size_t> oneBodyCoefStart;
+
+	//! The rate slot of each two-body term
+	std::vector<int> twoBodySlot;
+
+	//! The DOF indices of the first reactant, psDim per two-body term
+	std::vector<int> twoBodyIdsA;
+
+	//! The DOF indices of the second reactant, psDim per two-body term
+	std::vector<int> twoBodyIdsB;
+
+	//! The coefficients of the two-body terms, nOut * psDim * psDim per term
+	std::vector<double> twoBodyCoefs;
+
+	//! The rate slot of each one-body term
+	std::vector<int> oneBodySlot;
+
+	//! The DOF indices of the reactant, psDim per one-body term
+	std::vector<int> oneBodyIdsA;
+
+	//! The coefficients of the one-body terms, nOut * psDim per term
+	std::vector<double> oneBodyCoefs;
+
+	/**
+	 * The positions of the partial derivatives with respect to the first
+	 * reactant within the row of each output, psDim per two-body term.
+	 * The position is the same for all the outputs of a row because
+	 * the moments share the connectivity of their super cluster.
+	 */
+	std::vector<int> twoBodyColA;
+
+	//! Same for the second reactant, psDim per two-body term
+	std::vector<int> twoBodyColB;
+
+	//! Same for the reactant of the one-body terms, psDim per term
+	std::vector<int> oneBodyColA;
+
+	/**
+	 * The read-only arrays used by the computations. They point either
+	 * to the vectors above or to the buffer shared by the node.
+	 */
+	struct View {
+		int nRows = 0;
+		int nTwoBody = 0;
+		int nOneBody = 0;
+		const int *rowNOut = nullptr;
+		const int *rowOutIds = nullptr;
+		const int *twoBodyStart = nullptr;
+		const int *oneBodyStart = nullptr;
+		const size_t *twoBodyCoefStart = nullptr;
+		const size_t *oneBodyCoefStart = nullptr;
+		const int *twoBodySlot = nullptr;
+		const int *twoBodyIdsA = nullptr;
+		const int *twoBodyIdsB = nullptr;
+		const double *twoBodyCoefs = nullptr;
+		const int *oneBodySlot = nullptr;
+		const int *oneBodyIdsA = nullptr;
+		const double *oneBodyCoefs = nullptr;
+		const int *twoBodyColA = nullptr;
+		const int *twoBodyColB = nullptr;
+		const int *oneBodyColA = nullptr;
+	} view;
+
+	//! The buffer shared by the processes of the node
+	NodeSharedBuffer sharedBuffer;
+
+	/**
+	 * Point the view to the vectors.
+	 */
+	void updateView();
+
+	/**
+	 * Compute the size of the packed read-only arrays, and copy them in
+	 * the given buffer.
+	 *
+	 * @param base The start of the buffer, nullptr to only get the size
+	 * @param write Should the arrays be copied or only pointed to?
+	 * @return The size of the buffer in bytes
+	 */
+	std::size_t packArrays(char *base, bool write);
+
+	/**
+	 * Get the rate slot of a reaction, creating it if needed.
+	 *
+	 * @param reaction The reaction
+	 * @return The slot
+	 */
+	int getRateSlot(const Reaction& reaction);
+
+	/**
+	 * Move the pending terms of the current row to the flat arrays.
+	 */
+	void flushRow();
+
+	/**
+	 * Add a term to the row being filled.
+	 *
+	 * @param kind The kind of term
+	 * @param reaction The reaction giving the rate
+	 * @param idsA The DOF indices of the first reactant, -1 for absent moments
+	 * @param idsB The DOF indices of the second reactant, -1 for absent moments
+	 * @param coefs The coefficients
+	 * @param size The number of coefficients
+	 */
+	void addTerm(TermKind kind, const Reaction& reaction, const int idsA[5],
+			const int idsB[5], const double *coefs, int size);
+
+public:
+
+	/**
+	 * The constructor.
+	 */
+	PSIReactionTable() :
+			psDim(1), nGrid(0), compiled(false), partialsCompiled(false), shared(
+					false), currentNOut(0) {
+	}
+
+	/**
+	 * The destructor, it frees the shared window and is thus collective on
+	 * the node if the table was shared.
+	 */
+	~PSIReactionTable() {
+	}
+
+	/**
+	 * Empty the table and get it ready to be filled. It is local to the
+	 * process: the window of a shared table stays allocated until the next
+	 * shareOnNode() or the destruction of the table.
+	 *
+	 * @param dim The dimension of the phase space
+	 */
+	void clear(int dim);
+
+	/**
+	 * Start a new row.
+	 *
+	 * @param outIds The DOF indices of the outputs
+	 * @param nOut The number of outputs
+	 */
+	void startRow(const int outIds[5], int nOut);
+
+	/**
+	 * Add a two-body term (production or combination) to the current row.
+	 * The coefficients are ordered [out][a][b] where out is the output,
+	 * a the moment of the first reactant, and b of the second one.
+	 *
+	 * @param kind The kind of term
+	 * @param reaction The reaction giving the rate
+	 * @param idsA The DOF indices of the first reactant, -1 for absent moments
+	 * @param idsB The DOF indices of the second reactant, -1 for absent moments
+	 * @param coefs The nOut * psDim * psDim coefficients
+	 */
+	void addTwoBodyTerm(TermKind kind, const Reaction& reaction,
+			const int idsA[5], const int idsB[5], const double *coefs) {
+		addTerm(kind, reaction, idsA, idsB, coefs,
+				currentNOut * psDim * psDim);
+	}
+
+	/**
+	 * Add a one-body term (dissociation or emission) to the current row.
+	 * The coefficients are ordered [out][a] where out is the output and
+	 * a the moment of the reactant.
+	 *
+	 * @param kind The kind of term
+	 * @param reaction The reaction giving the rate
+	 * @param idsA The DOF indices of the reactant, -1 for absent moments
+	 * @param coefs The nOut * psDim coefficients
+	 */
+	void addOneBodyTerm(TermKind kind, const Reaction& reaction,
+			const int idsA[5], const double *coefs) {
+		addTerm(kind, reaction, idsA, idsA, coefs, currentNOut * psDim);
+	}
+
+	/**
+	 * Finish filling the table and copy the rates.
+	 */
+	void finalize();
+
+	/**
+	 * Was the table compiled?
+	 *
+	 * @return True if finalize() was called since the last clear()
+	 */
+	bool isCompiled() const {
+		return compiled;
+	}
+
+	/**
+	 * Copy the rate constants of all the reactions at the given grid point.
+	 *
+	 * @param xi The location on the grid in the depth direction
+	 */
+	void updateRates(int xi);
+
+	/**
+	 * Copy the rate constants of all the reactions at all the grid points,
+	 * resizing the rate array if the number of grid points changed.
+	 */
+	void updateAllRates();
+
+	/**
+	 * Compute the fluxes of all the rows and add them to the updated
+	 * concentrations.
+	 *
+	 * @param concOffset The array of concentrations at the grid point
+	 * @param updatedConcOffset The array where the fluxes are added
+	 * @param xi The location on the grid in the depth direction
+	 */
+	void computeFluxes(const double *concOffset, double *updatedConcOffset,
+			int xi) const;
+
+	/**
+	 * Compute the positions of all the partial derivatives using the
+	 * inverse of the diagonal fill of the Jacobian.
+	 *
+	 * @param fillInvMap For each row, the map from the column id to its
+	 * position within the row
+	 */
+	void compilePartials(
+			const std::unordered_map<int, std::unordered_map<int, int> >& fillInvMap);
+
+	/**
+	 * Were the partial derivative positions computed?
+	 *
+	 * @return True if compilePartials() was called since the last clear()
+	 */
+	bool arePartialsCompiled() const {
+		return partialsCompiled;
+	}
+
+	/**
+	 * Compute the partial derivatives of all the rows and add them to the
+	 * values array.
+	 *
+	 * @param concOffset The array of concentrations at the grid point
+	 * @param startingIdx Starting index of items owned by each row
+	 *      within the partials values array.
+	 * @param vals The values of partials
+	 * @param xi The location on the grid in the depth direction
+	 */
+	void computePartials(const double *concOffset,
+			const std::vector<size_t>& startingIdx, double *vals,
+			int xi) const;
+
+	/**
+	 * Compute the product of the partial derivatives of all the rows with
+	 * the given vector, without storing them, and add it to the result.
+	 * The partial derivatives between two DOFs with the same block id are
+	 * skipped.
+	 *
+	 * @param concOffset The array of concentrations at the grid point
+	 * @param vecOffset The vector multiplied by the partial derivatives
+	 * @param resultOffset The array where the product is added
+	 * @param blockIds The block id of each DOF
+	 * @param xi The location on the grid in the depth direction
+	 */
+	void computePartialsAction(const double *concOffset,
+			const double *vecOffset, double *resultOffset, const int *blockIds,
+			int xi) const;
+
+	/**
+	 * Move the read-only arrays to a buffer shared by all the processes of
+	 * each node, each process keeps its own rates. This method is collective
+	 * on the given communicator and the table has to be identical on all
+	 * the processes. It should be called once the partials are compiled.
+	 * The window of a previous compilation is freed here, where all the
+	 * processes are.
+	 *
+	 * @param comm The communicator of the processes sharing the table
+	 */
+	void shareOnNode(MPI_Comm comm);
+
+	/**
+	 * Is the table stored in a buffer shared by the node?
+	 *
+	 * @return True if shareOnNode() was called since the last clear()
+	 */
+	bool isShared() const {
+		return shared;
+	}
+
+	/**
+	 * Get the number of rows.
+	 *
+	 * @return The number of rows
+	 */
+	int getNRows() const {
+		return view.nRows;
+	}
+
+	/**
+	 * Get the number of terms.
+	 *
+	 * @return The number of two-body plus one-body terms
+	 */
+	int getNTerms() const {
+		return view.nTwoBody + view.nOneBody;
+	}
+};
+//end class PSIReactionTable
+
+} /* end namespace xolotlCore */
+#endif
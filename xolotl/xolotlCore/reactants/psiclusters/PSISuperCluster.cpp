@@ -1136,6 +1136,181 @@ void PSISuperCluster::resetConnectivities() {
 	return;
 }
 
+void PSISuperCluster::computeTotalFlux(double *concOffset,
+		double *updatedConcOffset, int xi) const {
+	// Initial declarations
+	double lA[5] = { }, lB[5] = { }, lSelf[5] = { }, sum[5] = { };
+	double productionFlux = 0.0, combinationFlux = 0.0, dissociationFlux = 0.0,
+			emissionFlux = 0.0;
+	double moments[5] = { };
+
+	// Get our own concentration and moments
+	getMomentsFromArray(*this, concOffset, lSelf);
+
+	// Sum over all the reacting pairs
+	for (auto const& currPair : effReactingList) {
+		getMomentsFromArray(currPair.first, concOffset, lA);
+		getMomentsFromArray(currPair.second, concOffset, lB);
+		std::fill(sum, sum + 5, 0.0);
+		for (int k = 0; k < psDim; k++) {
+			for (int j = 0; j < psDim; j++) {
+				for (int i = 0; i < psDim; i++) {
+					sum[k] += currPair.coefs[j][i][k] * lA[j] * lB[i];
+				}
+			}
+		}
+		auto value = currPair.reaction.kConstant[xi] / (double) nTot;
+		productionFlux += value * sum[0];
+		for (int i = 1; i < psDim; i++) {
+			moments[i] += value * sum[i];
+		}
+	}
+
+	// Sum over all the combining clusters
+	for (auto const& currComb : effCombiningList) {
+		getMomentsFromArray(currComb.first, concOffset, lB);
+		std::fill(sum, sum + 5, 0.0);
+		for (int k = 0; k < psDim; k++) {
+			for (int j = 0; j < psDim; j++) {
+				for (int i = 0; i < psDim; i++) {
+					sum[k] += currComb.coefs[i][j][k] * lSelf[i] * lB[j];
+				}
+			}
+		}
+		auto value = currComb.reaction.kConstant[xi] / (double) nTot;
+		combinationFlux += value * sum[0];
+		for (int i = 1; i < psDim; i++) {
+			moments[i] -= value * sum[i];
+		}
+	}
+
+	// Sum over all the dissociating pairs
+	for (auto const& currPair : effDissociatingList) {
+		getMomentsFromArray(currPair.first, concOffset, lA);
+		std::fill(sum, sum + 5, 0.0);
+		for (int j = 0; j < psDim; j++) {
+			for (int i = 0; i < psDim; i++) {
+				sum[j] += currPair.coefs[i][j] * lA[i];
+			}
+		}
+		auto value = currPair.reaction.kConstant[xi] / (double) nTot;
+		dissociationFlux += value * sum[0];
+		for (int i = 1; i < psDim; i++) {
+			moments[i] += value * sum[i];
+		}
+	}
+
+	// Loop over all the emission pairs
+	for (auto const& currPair : effEmissionList) {
+		std::fill(sum, sum + 5, 0.0);
+		for (int j = 0; j < psDim; j++) {
+			for (int i = 0; i < psDim; i++) {
+				sum[j] += currPair.coefs[i][j] * lSelf[i];
+			}
+		}
+		auto value = currPair.reaction.kConstant[xi] / (double) nTot;
+		emissionFlux += value * sum[0];
+		for (int i = 1; i < psDim; i++) {
+			moments[i] -= value * sum[i];
+		}
+	}
+
+	// Update the concentration of the cluster and of its moments
+	updatedConcOffset[id - 1] += productionFlux - combinationFlux
+			+ dissociationFlux - emissionFlux;
+	for (int i = 1; i < psDim; i++) {
+		updatedConcOffset[momId[indexList[i] - 1] - 1] += moments[i];
+	}
+
+	return;
+}
+
+void PSISuperCluster::releaseReactingPairs() {
+	// The maps point into the lists
+	ProductionPairListMap().swap(effReactingListMap);
+	CombiningClusterListMap().swap(effCombiningListMap);
+	DissociationPairListMap().swap(effDissociatingListMap);
+	DissociationPairListMap().swap(effEmissionListMap);
+
+	// Swap with empty lists to give the memory back
+	ProductionPairList().swap(effReactingList);
+	CombiningClusterList().swap(effCombiningList);
+	DissociationPairList().swap(effDissociatingList);
+	DissociationPairList().swap(effEmissionList);
+
+	// And the vectors of the base class
+	PSICluster::releaseReactingPairs();
+
+	return;
+}
+
+void PSISuperCluster::addToReactionTable(PSIReactionTable& table) const {
+	// Initial declarations
+	int selfIds[5] = { }, idsA[5] = { }, idsB[5] = { };
+	double coefs[125] = { };
+	const int dim = psDim;
+	getMomentIds(*this, selfIds);
+
+	// The cluster and all its moments are outputs
+	table.startRow(selfIds, dim);
+
+	// Production: coefs[k][a][b] = coefs[a][b][k]
+	for (auto const& currPair : effReactingList) {
+		getMomentIds(currPair.first, idsA);
+		getMomentIds(currPair.second, idsB);
+		for (int k = 0; k < dim; k++) {
+			for (int a = 0; a < dim; a++) {
+				for (int b = 0; b < dim; b++) {
+					coefs[(k * dim + a) * dim + b] = currPair.coefs[a][b][k]
+							/ (double) nTot;
+				}
+			}
+		}
+		table.addTwoBodyTerm(PSIReactionTable::TermKind::Production,
+				currPair.reaction, idsA, idsB, coefs);
+	}
+
+	// Combination: this cluster is the first reactant
+	for (auto const& currComb : effCombiningList) {
+		getMomentIds(currComb.first, idsB);
+		for (int k = 0; k < dim; k++) {
+			for (int a = 0; a < dim; a++) {
+				for (int b = 0; b < dim; b++) {
+					coefs[(k * dim + a) * dim + b] = currComb.coefs[a][b][k]
+							/ (double) nTot;
+				}
+			}
+		}
+		table.addTwoBodyTerm(PSIReactionTable::TermKind::Combination,
+				currComb.reaction, selfIds, idsB, coefs);
+	}
+
+	// Dissociation: coefs[k][a] = coefs[a][k]
+	for (auto const& currPair : effDissociatingList) {
+		getMomentIds(currPair.first, idsA);
+		for (int k = 0; k < dim; k++) {
+			for (int a = 0; a < dim; a++) {
+				coefs[k * dim + a] = currPair.coefs[a][k] / (double) nTot;
+			}
+		}
+		table.addOneBodyTerm(PSIReactionTable::TermKind::Dissociation,
+				currPair.reaction, idsA, coefs);
+	}
+
+	// Emission: this cluster is the reactant
+	for (auto const& currPair : effEmissionList) {
+		for (int k = 0; k < dim; k++) {
+			for (int a = 0; a < dim; a++) {
+				coefs[k * dim + a] = currPair.coefs[a][k] / (double) nTot;
+			}
+		}
+		table.addOneBodyTerm(PSIReactionTable::TermKind::Emission,
+				currPair.reaction, selfIds, coefs);
+	}
+
+	return;
+}
+
 double PSISuperCluster::getDissociationFlux(int xi) {
 	// Initial declarations
 	double flux = 0.0;
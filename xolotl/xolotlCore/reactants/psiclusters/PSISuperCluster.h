@@ -843,6 +843,35 @@ public:
 				+ getDissociationFlux(i) - getEmissionFlux(i);
 	}
 
+	/**
+	 * This operation computes the total flux of this cluster and of its
+	 * moments using the concentrations from the given array, and adds them
+	 * to the updated concentrations. It doesn't modify the state of any
+	 * cluster, the moment fluxes are not saved in momentFlux.
+	 *
+	 * @param concOffset The array of concentrations at the grid point
+	 * @param updatedConcOffset The array where the fluxes are added
+	 * @param i The location on the grid in the depth direction
+	 */
+	void computeTotalFlux(double *concOffset, double *updatedConcOffset,
+			int i) const override;
+
+	/**
+	 * This operation adds the row corresponding to this cluster and its
+	 * moments to the compiled reaction table. The coefficients are
+	 * divided by the number of clusters in the group.
+	 *
+	 * @param table The table to fill
+	 */
+	void addToReactionTable(PSIReactionTable& table) const override;
+
+	/**
+	 * This operation releases the effective production and dissociation
+	 * lists, and the maps into them, once the compiled reaction table holds
+	 * their content.
+	 */
+	void releaseReactingPairs() override;
+
 	/**
 	 * This operation returns the total change in this cluster due to
 	 * other clusters dissociating into it. Compute the contributions to
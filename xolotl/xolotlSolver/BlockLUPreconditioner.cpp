@@ -0,0 +1,374 @@
+// Includes
+#include "BlockLUPreconditioner.h"
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+namespace xolotlSolver {
+
+//! The pivots smaller than this are replaced by it
+static const PetscReal zeroPivot = 1.0e-12;
+
+BlockLUPreconditioner::BlockLUPreconditioner(int _nThreads) :
+		nThreads(_nThreads), nSweeps(1), maxDenseSize(128), dof(0), nPoints(
+				0), rowStart(0), nonzeroState(0), residual(nullptr) {
+}
+
+PetscErrorCode BlockLUPreconditioner::attach(PC pc) {
+	PetscErrorCode ierr;
+
+	PetscFunctionBeginUser;
+	ierr = PCSetType(pc, PCSHELL);
+	CHKERRQ(ierr);
+	ierr = PCShellSetContext(pc, this);
+	CHKERRQ(ierr);
+	ierr = PCShellSetSetUp(pc, setUpShell);
+	CHKERRQ(ierr);
+	ierr = PCShellSetApply(pc, applyShell);
+	CHKERRQ(ierr);
+	ierr = PCShellSetDestroy(pc, destroyShell);
+	CHKERRQ(ierr);
+	ierr = PCShellSetName(pc, "xolotl block LU");
+	CHKERRQ(ierr);
+
+	// Read the number of corrections and the largest dense block
+	ierr = PetscOptionsGetInt(NULL, NULL, "-blocklu_sweeps", &nSweeps, NULL);
+	CHKERRQ(ierr);
+	ierr = PetscOptionsGetInt(NULL, NULL, "-blocklu_dense_max", &maxDenseSize,
+			NULL);
+	CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+
+PetscErrorCode BlockLUPreconditioner::setUp(PC pc) {
+	PetscErrorCode ierr;
+
+	PetscFunctionBeginUser;
+
+	// Get the preconditioner matrix, its blocks are the grid points
+	Mat P;
+	ierr = PCGetOperators(pc, NULL, &P);
+	CHKERRQ(ierr);
+	ierr = MatGetBlockSize(P, &dof);
+	CHKERRQ(ierr);
+	PetscInt rowEnd;
+	ierr = MatGetOwnershipRange(P, &rowStart, &rowEnd);
+	CHKERRQ(ierr);
+	nPoints = (rowEnd - rowStart) / dof;
+
+	if (!residual) {
+		ierr = MatCreateVecs(P, NULL, &residual);
+		CHKERRQ(ierr);
+	}
+
+	// The symbolic factorization is kept until the structure changes
+	if (!isDense()) {
+		PetscObjectState state;
+		ierr = MatGetNonzeroState(P, &state);
+		CHKERRQ(ierr);
+		if (luRowPtr.empty() || state != nonzeroState) {
+			ierr = computeSymbolic(P);
+			CHKERRQ(ierr);
+			nonzeroState = state;
+		}
+	}
+
+	// Get the values of the blocks
+	ierr = extractBlocks(P);
+	CHKERRQ(ierr);
+
+	// Factor them
+	if (isDense()) {
+		const std::size_t blockSize = dof * dof;
+#pragma omp parallel for num_threads(nThreads) schedule(static)
+		for (PetscInt p = 0; p < nPoints; p++) {
+			factorDense(&factors[p * blockSize], &pivots[p * dof]);
+		}
+	} else {
+		const std::size_t blockSize = luCols.size();
+#pragma omp parallel num_threads(nThreads)
+		{
+			std::vector<PetscScalar> work(dof, 0.0);
+#pragma omp for schedule(static)
+			for (PetscInt p = 0; p < nPoints; p++) {
+				factorSparse(&factors[p * blockSize], work.data());
+			}
+		}
+	}
+
+	PetscFunctionReturn(0);
+}
+
+PetscErrorCode BlockLUPreconditioner::computeSymbolic(Mat P) {
+	PetscErrorCode ierr;
+
+	PetscFunctionBeginUser;
+
+	// The union of the patterns of the blocks, with the diagonal
+	std::vector<std::set<int> > rows(dof);
+	for (int i = 0; i < dof; i++) {
+		rows[i].insert(i);
+	}
+	for (PetscInt p = 0; p < nPoints; p++) {
+		PetscInt blockStart = rowStart + p * dof;
+		for (int i = 0; i < dof; i++) {
+			PetscInt nCols;
+			const PetscInt *cols;
+			ierr = MatGetRow(P, blockStart + i, &nCols, &cols, NULL);
+			CHKERRQ(ierr);
+			for (PetscInt k = 0; k < nCols; k++) {
+				PetscInt j = cols[k] - blockStart;
+				if (j >= 0 && j < dof)
+					rows[i].insert(j);
+			}
+			ierr = MatRestoreRow(P, blockStart + i, &nCols, &cols, NULL);
+			CHKERRQ(ierr);
+		}
+	}
+
+	// Add the fill-in of the elimination, row after row: the row i gets
+	// the upper part of each row k < i in its pattern
+	luRowPtr.assign(1, 0);
+	luCols.clear();
+	luDiag.assign(dof, 0);
+	for (int i = 0; i < dof; i++) {
+		auto& row = rows[i];
+		for (auto it = row.begin(); *it < i; ++it) {
+			int k = *it;
+			row.insert(luCols.begin() + luDiag[k] + 1,
+					luCols.begin() + luRowPtr[k + 1]);
+		}
+		luDiag[i] = luCols.size() + std::distance(row.begin(), row.find(i));
+		luCols.insert(luCols.end(), row.begin(), row.end());
+		luRowPtr.push_back(luCols.size());
+	}
+
+	PetscFunctionReturn(0);
+}
+
+PetscErrorCode BlockLUPreconditioner::extractBlocks(Mat P) {
+	PetscErrorCode ierr;
+
+	PetscFunctionBeginUser;
+
+	const std::size_t blockSize = isDense() ? dof * dof : luCols.size();
+	factors.assign(nPoints * blockSize, 0.0);
+	if (isDense())
+		pivots.assign(nPoints * dof, 0);
+
+	// Loop on the local grid points, MatGetRow can't be called concurrently
+	for (PetscInt p = 0; p < nPoints; p++) {
+		PetscInt blockStart = rowStart + p * dof;
+		PetscScalar *a = &factors[p * blockSize];
+		for (int i = 0; i < dof; i++) {
+			PetscInt nCols;
+			const PetscInt *cols;
+			const PetscScalar *vals;
+			ierr = MatGetRow(P, blockStart + i, &nCols, &cols, &vals);
+			CHKERRQ(ierr);
+			for (PetscInt k = 0; k < nCols; k++) {
+				PetscInt j = cols[k] - blockStart;
+				if (j < 0 || j >= dof)
+					continue;
+				if (isDense()) {
+					a[i * dof + j] = vals[k];
+				} else {
+					auto pos = std::lower_bound(
+							luCols.begin() + luRowPtr[i],
+							luCols.begin() + luRowPtr[i + 1], j);
+					a[pos - luCols.begin()] = vals[k];
+				}
+			}
+			ierr = MatRestoreRow(P, blockStart + i, &nCols, &cols, &vals);
+			CHKERRQ(ierr);
+		}
+	}
+
+	PetscFunctionReturn(0);
+}
+
+void BlockLUPreconditioner::factorDense(PetscScalar *a, int *piv) const {
+	for (int k = 0; k < dof; k++) {
+		// Exchange the row with the largest pivot
+		int p = k;
+		for (int i = k + 1; i < dof; i++) {
+			if (std::fabs(a[i * dof + k]) > std::fabs(a[p * dof + k]))
+				p = i;
+		}
+		piv[k] = p;
+		if (p != k)
+			std::swap_ranges(a + k * dof, a + (k + 1) * dof, a + p * dof);
+		if (std::fabs(a[k * dof + k]) < zeroPivot)
+			a[k * dof + k] = zeroPivot;
+
+		// Eliminate below
+		for (int i = k + 1; i < dof; i++) {
+			PetscScalar lik = a[i * dof + k] / a[k * dof + k];
+			a[i * dof + k] = lik;
+			if (lik == 0.0)
+				continue;
+			for (int j = k + 1; j < dof; j++) {
+				a[i * dof + j] -= lik * a[k * dof + j];
+			}
+		}
+	}
+
+	return;
+}
+
+void BlockLUPreconditioner::factorSparse(PetscScalar *a,
+		PetscScalar *work) const {
+	for (int i = 0; i < dof; i++) {
+		const int start = luRowPtr[i], end = luRowPtr[i + 1], diag =
+				luDiag[i];
+		for (int q = start; q < end; q++) {
+			work[luCols[q]] = a[q];
+		}
+
+		// Eliminate with the previous rows
+		for (int q = start; q < diag; q++) {
+			int k = luCols[q];
+			PetscScalar lik = work[k] / a[luDiag[k]];
+			work[k] = lik;
+			if (lik == 0.0)
+				continue;
+			for (int r = luDiag[k] + 1; r < luRowPtr[k + 1]; r++) {
+				work[luCols[r]] -= lik * a[r];
+			}
+		}
+
+		for (int q = start; q < end; q++) {
+			a[q] = work[luCols[q]];
+			work[luCols[q]] = 0.0;
+		}
+		if (std::fabs(a[diag]) < zeroPivot)
+			a[diag] = zeroPivot;
+	}
+
+	return;
+}
+
+void BlockLUPreconditioner::solveBlocks(PetscScalar *b) const {
+	const bool dense = isDense();
+	const std::size_t blockSize = dense ? dof * dof : luCols.size();
+
+#pragma omp parallel for num_threads(nThreads) schedule(static)
+	for (PetscInt p = 0; p < nPoints; p++) {
+		const PetscScalar *a = &factors[p * blockSize];
+		PetscScalar *x = b + p * dof;
+		if (dense) {
+			// Exchange the rows, then solve with L and U
+			const int *piv = &pivots[p * dof];
+			for (int k = 0; k < dof; k++) {
+				if (piv[k] != k)
+					std::swap(x[k], x[piv[k]]);
+			}
+			for (int i = 1; i < dof; i++) {
+				for (int j = 0; j < i; j++) {
+					x[i] -= a[i * dof + j] * x[j];
+				}
+			}
+			for (int i = dof - 1; i >= 0; i--) {
+				for (int j = i + 1; j < dof; j++) {
+					x[i] -= a[i * dof + j] * x[j];
+				}
+				x[i] /= a[i * dof + i];
+			}
+		} else {
+			for (int i = 0; i < dof; i++) {
+				for (int q = luRowPtr[i]; q < luDiag[i]; q++) {
+					x[i] -= a[q] * x[luCols[q]];
+				}
+			}
+			for (int i = dof - 1; i >= 0; i--) {
+				for (int q = luDiag[i] + 1; q < luRowPtr[i + 1]; q++) {
+					x[i] -= a[q] * x[luCols[q]];
+				}
+				x[i] /= a[luDiag[i]];
+			}
+		}
+	}
+
+	return;
+}
+
+PetscErrorCode BlockLUPreconditioner::apply(PC pc, Vec x, Vec y) {
+	PetscErrorCode ierr;
+
+	PetscFunctionBeginUser;
+
+	// Solve with the blocks
+	ierr = VecCopy(x, y);
+	CHKERRQ(ierr);
+	PetscScalar *array;
+	ierr = VecGetArray(y, &array);
+	CHKERRQ(ierr);
+	solveBlocks(array);
+	ierr = VecRestoreArray(y, &array);
+	CHKERRQ(ierr);
+
+	// Correct with the residual for the coupling between grid points
+	Mat P;
+	ierr = PCGetOperators(pc, NULL, &P);
+	CHKERRQ(ierr);
+	for (PetscInt n = 0; n < nSweeps; n++) {
+		ierr = MatMult(P, y, residual);
+		CHKERRQ(ierr);
+		ierr = VecAYPX(residual, -1.0, x);
+		CHKERRQ(ierr);
+		ierr = VecGetArray(residual, &array);
+		CHKERRQ(ierr);
+		solveBlocks(array);
+		ierr = VecRestoreArray(residual, &array);
+		CHKERRQ(ierr);
+		ierr = VecAXPY(y, 1.0, residual);
+		CHKERRQ(ierr);
+	}
+
+	PetscFunctionReturn(0);
+}
+
+PetscErrorCode BlockLUPreconditioner::setUpShell(PC pc) {
+	PetscErrorCode ierr;
+
+	PetscFunctionBeginUser;
+	void *ctx;
+	ierr = PCShellGetContext(pc, &ctx);
+	CHKERRQ(ierr);
+	ierr = static_cast<BlockLUPreconditioner*>(ctx)->setUp(pc);
+	CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+
+PetscErrorCode BlockLUPreconditioner::applyShell(PC pc, Vec x, Vec y) {
+	PetscErrorCode ierr;
+
+	PetscFunctionBeginUser;
+	void *ctx;
+	ierr = PCShellGetContext(pc, &ctx);
+	CHKERRQ(ierr);
+	ierr = static_cast<BlockLUPreconditioner*>(ctx)->apply(pc, x, y);
+	CHKERRQ(ierr);
+
+	PetscFunctionReturn(0);
+}
+
+PetscErrorCode BlockLUPreconditioner::destroyShell(PC pc) {
+	PetscErrorCode ierr;
+
+	PetscFunctionBeginUser;
+	void *ctx;
+	ierr = PCShellGetContext(pc, &ctx);
+	CHKERRQ(ierr);
+	auto self = static_cast<BlockLUPreconditioner*>(ctx);
+	ierr = VecDestroy(&self->residual);
+	CHKERRQ(ierr);
+	self->factors.clear();
+	self->pivots.clear();
+
+	PetscFunctionReturn(0);
+}
+
+} /* end namespace xolotlSolver */
@@ -0,0 +1,170 @@
+#ifndef XSOLVER_BLOCKLUPRECONDITIONER_H
+#define XSOLVER_BLOCKLUPRECONDITIONER_H
+
+// Includes
+#include <petscksp.h>
+#include <vector>
+
+namespace xolotlSolver {
+
+/**
+ * This class is a preconditioner (a PETSc PCSHELL) using that the reactions
+ * only couple the clusters at the same grid point.
+ *
+ * At each setup it extracts, from the preconditioner matrix, the block of
+ * the degrees of freedom of each local grid point (the reactions, shifted
+ * by the time stepper, and the part of the other physics within the grid
+ * point) and factors them. Applying it solves with every block (block
+ * Jacobi), then corrects the result with the residual a given number of
+ * times (-blocklu_sweeps, default 1). Only the rows of the mobile clusters
+ * couple the grid points, through diffusion and advection, so these
+ * corrections take the coupling between grid points into account.
+ *
+ * The blocks of up to -blocklu_dense_max rows (default 128) are factored
+ * with a dense LU with partial pivoting. The bigger ones are factored with
+ * a sparse LU without pivoting, whose symbolic factorization is computed for
+ * the union of the patterns of the blocks and kept as long as the nonzero
+ * structure of the matrix does not change. Zero pivots are replaced by a
+ * small value. The grid points are factored and solved on the same threads
+ * as the reactions.
+ */
+class BlockLUPreconditioner {
+private:
+
+	//! The number of threads
+	int nThreads;
+
+	//! The number of corrections with the residual
+	PetscInt nSweeps;
+
+	//! The size above which the blocks are factored with the sparse LU
+	PetscInt maxDenseSize;
+
+	//! The number of degrees of freedom at each grid point
+	PetscInt dof;
+
+	//! The number of local grid points
+	PetscInt nPoints;
+
+	//! The first local row
+	PetscInt rowStart;
+
+	//! The nonzero state of the matrix of the symbolic factorization
+	PetscObjectState nonzeroState;
+
+	//! The start of each row of the sparse factors in luCols
+	std::vector<int> luRowPtr;
+
+	//! The columns of the sparse factors, sorted within each row
+	std::vector<int> luCols;
+
+	//! The position of the diagonal of each row of the sparse factors
+	std::vector<int> luDiag;
+
+	//! The factors of all the grid points, one after the other
+	std::vector<PetscScalar> factors;
+
+	//! The row exchanges of the dense factors of all the grid points
+	std::vector<int> pivots;
+
+	//! The residual of the corrections
+	Vec residual;
+
+	/**
+	 * Whether the blocks are factored with the dense LU.
+	 *
+	 * @return True if they are
+	 */
+	bool isDense() const {
+		return dof <= maxDenseSize;
+	}
+
+	/**
+	 * Compute the symbolic factorization of the sparse blocks from the
+	 * pattern of the local rows of the matrix.
+	 *
+	 * @param P The preconditioner matrix
+	 * @return A standard PETSc error code
+	 */
+	PetscErrorCode computeSymbolic(Mat P);
+
+	/**
+	 * Copy the blocks of the local grid points from the matrix to the
+	 * factors.
+	 *
+	 * @param P The preconditioner matrix
+	 * @return A standard PETSc error code
+	 */
+	PetscErrorCode extractBlocks(Mat P);
+
+	/**
+	 * Factor the dense block of a grid point in place.
+	 *
+	 * @param a The block, row after row
+	 * @param piv The row exchanges
+	 */
+	void factorDense(PetscScalar *a, int *piv) const;
+
+	/**
+	 * Factor the sparse block of a grid point in place.
+	 *
+	 * @param a The block, with the pattern of the factors
+	 * @param work A work array of dof zeros, zeros again on return
+	 */
+	void factorSparse(PetscScalar *a, PetscScalar *work) const;
+
+	/**
+	 * Solve with the factors of all the local grid points.
+	 *
+	 * @param b The right-hand side, overwritten by the solution
+	 */
+	void solveBlocks(PetscScalar *b) const;
+
+	/**
+	 * The PETSc callbacks of the shell.
+	 */
+	static PetscErrorCode setUpShell(PC pc);
+	static PetscErrorCode applyShell(PC pc, Vec x, Vec y);
+	static PetscErrorCode destroyShell(PC pc);
+
+public:
+
+	/**
+	 * The constructor.
+	 *
+	 * @param _nThreads The number of threads
+	 */
+	BlockLUPreconditioner(int _nThreads);
+
+	/**
+	 * Make the given preconditioner a shell using this one. It must stay
+	 * alive as long as the preconditioner.
+	 *
+	 * @param pc The PETSc preconditioner
+	 * @return A standard PETSc error code
+	 */
+	PetscErrorCode attach(PC pc);
+
+	/**
+	 * Extract and factor the blocks of the local grid points.
+	 *
+	 * @param pc The PETSc preconditioner
+	 * @return A standard PETSc error code
+	 */
+	PetscErrorCode setUp(PC pc);
+
+	/**
+	 * Apply the preconditioner.
+	 *
+	 * @param pc The PETSc preconditioner
+	 * @param x The vector to precondition
+	 * @param y The result
+	 * @return A standard PETSc error code
+	 */
+	PetscErrorCode apply(PC pc, Vec x, Vec y);
+};
+//end class BlockLUPreconditioner
+
+} /* end namespace xolotlSolver */
+
+#endif // XSOLVER_BLOCKLUPRECONDITIONER_H
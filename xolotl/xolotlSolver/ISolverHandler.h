@@ -98,6 +98,18 @@ public:
 	virtual void computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 			PetscReal ftime) = 0;
 
+	/**
+	 * Compute the product of the reaction partial derivatives that are left
+	 * out of the Jacobian matrix in matrix-free mode with the given vector,
+	 * and add it to the result. The concentrations and the grid points are
+	 * the ones of the last call to computeDiagonalJacobian().
+	 *
+	 * @param C The PETSc global solution vector where the Jacobian was computed
+	 * @param v The PETSc global vector to multiply
+	 * @param y The PETSc global vector where the product is added
+	 */
+	virtual void computeJacobianAction(Vec &C, Vec &v, Vec &y) = 0;
+
 	/**
 	 * Get the grid in the x direction.
 	 *
@@ -285,6 +297,43 @@ public:
 	 */
 	virtual std::vector<std::tuple<int, int, int> > getGBVector() const = 0;
 
+	/**
+	 * Get the way the Jacobian is given to PETSc.
+	 *
+	 * @return The type of Jacobian: "assembled", "matrixFreeDiagonal",
+	 * or "matrixFreeBlock"
+	 */
+	virtual std::string getJacobianType() const = 0;
+
+	/**
+	 * Get the policy used to reuse the Jacobian between evaluations.
+	 *
+	 * @return The largest relative change of the solution, the largest
+	 * temperature change, and the maximum number of consecutive reuses
+	 */
+	virtual std::tuple<double, double, int> getJacobianReuse() const = 0;
+
+	/**
+	 * Get the preconditioner of the linear solves.
+	 *
+	 * @return The preconditioner: "petsc" or "blockLU"
+	 */
+	virtual std::string getPreconditioner() const = 0;
+
+	/**
+	 * Get the number of threads used on this process.
+	 *
+	 * @return The number of threads
+	 */
+	virtual int getNThreads() const = 0;
+
+	/**
+	 * Get the temperature last used by the network at each grid point.
+	 *
+	 * @return The temperatures
+	 */
+	virtual const std::vector<double>& getLastTemperature() const = 0;
+
 };
 //end class ISolverHandler
 
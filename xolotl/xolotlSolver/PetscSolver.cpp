@@ -1,9 +1,12 @@
 // Includes
 #include <cassert>
+#include <cmath>
 #include <PetscSolver.h>
 #include <fstream>
 #include <iostream>
 #include "xolotlCore/io/XFile.h"
+#include "xolotlSolver/monitor/Monitor.h"
+#include "xolotlSolver/BlockLUPreconditioner.h"
 
 using namespace xolotlCore;
 
@@ -32,6 +35,12 @@ std::shared_ptr<xolotlPerf::ITimer> RHSFunctionTimer;
 ////Timer for RHSJacobian()
 std::shared_ptr<xolotlPerf::ITimer> RHSJacobianTimer;
 
+//! Counter for the Jacobian evaluations
+std::shared_ptr<xolotlPerf::IEventCounter> JacobianEvaluationCounter;
+
+//! Counter for the Jacobian reuses
+std::shared_ptr<xolotlPerf::IEventCounter> JacobianReuseCounter;
+
 //! Help message
 static char help[] =
 		"Solves C_t =  -D*C_xx + A*C_x + F(C) + R(C) + D(C) from Brian Wirth's SciDAC project.\n";
@@ -43,6 +52,63 @@ extern PetscErrorCode setupPetsc1DMonitor(TS,
 extern PetscErrorCode setupPetsc2DMonitor(TS);
 extern PetscErrorCode setupPetsc3DMonitor(TS);
 
+/**
+ * The context of the matrix-free Jacobian. The products are the ones of a
+ * copy of the assembled matrix, taken before PETSc shifts and scales it,
+ * plus the reaction partial derivatives left out of the matrix computed
+ * from the concentrations.
+ */
+struct JacobianShellContext {
+	//! The copy of the assembled part of the Jacobian
+	Mat rhsJacobian = nullptr;
+
+	//! The nonzero state of the assembled matrix when it was copied
+	PetscObjectState nonzeroState = 0;
+
+	//! The concentrations where the Jacobian was computed
+	Vec state = nullptr;
+};
+
+/**
+ * The state of the Jacobian reuse policy. The Jacobian is reused as long as
+ * the solution and the temperature stay close to the ones of its last
+ * evaluation, for a limited number of consecutive times, and as long as
+ * no nonlinear solve failed since. When the Jacobian is recomputed, it can
+ * also keep the nonzero pattern of its first evaluation and only refresh
+ * its values.
+ */
+struct JacobianReuseContext {
+	//! The largest relative change of the solution
+	double maxStateChange = 0.0;
+
+	//! The largest temperature change
+	double maxTemperatureChange = 0.0;
+
+	//! The maximum number of consecutive reuses, 0 to always recompute
+	int maxReuses = 0;
+
+	//! The number of consecutive reuses so far
+	int nReuses = 0;
+
+	//! The number of nonlinear solve failures at the last evaluation
+	PetscInt nFailures = 0;
+
+	//! The solution at the last evaluation
+	Vec lastState = nullptr;
+
+	//! A work vector for the difference of the solutions
+	Vec work = nullptr;
+
+	//! The temperature of each grid point at the last evaluation
+	std::vector<double> lastTemperature;
+
+	//! Should the nonzero pattern be kept after the first evaluation?
+	PetscBool keepPattern = PETSC_FALSE;
+
+	//! Was the nonzero pattern of the Jacobian fixed?
+	bool patternFixed = false;
+};
+
 void PetscSolver::setupInitialConditions(DM da, Vec C) {
 	// Initialize the concentrations in the solution vector
 	auto& solverHandler = Solver::getSolverHandler();
@@ -110,22 +176,107 @@ PetscErrorCode RHSFunction(TS ts, PetscReal ftime, Vec C, Vec F, void *) {
 	PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "checkJacobianReuse")
+/*
+ Decide if the last Jacobian can be kept for the given solution, and save
+ the solution and temperature otherwise
+ */
+PetscErrorCode checkJacobianReuse(TS ts, Vec C, JacobianReuseContext &reuse,
+		bool &canReuse) {
+	PetscErrorCode ierr;
+
+	PetscFunctionBeginUser;
+	canReuse = false;
+	auto& solverHandler = Solver::getSolverHandler();
+	auto const& temperature = solverHandler.getLastTemperature();
+	PetscInt nFailures = 0;
+	ierr = TSGetSNESFailures(ts, &nFailures);
+	CHKERRQ(ierr);
+
+	// Look at everything that would force a new evaluation
+	if (reuse.lastState && reuse.nReuses < reuse.maxReuses
+			&& nFailures == reuse.nFailures
+			&& temperature.size() == reuse.lastTemperature.size()) {
+		canReuse = true;
+		for (int i = 0; i < temperature.size() && canReuse; i++) {
+			canReuse = std::fabs(temperature[i] - reuse.lastTemperature[i])
+					<= reuse.maxTemperatureChange;
+		}
+	}
+	// The temperatures are only the ones of the local grid points, all the
+	// processes have to agree before the collective norms below and to take
+	// the same branch in RHSJacobian
+	int localCanReuse = canReuse, allCanReuse = 0;
+	MPI_Allreduce(&localCanReuse, &allCanReuse, 1, MPI_INT, MPI_LAND,
+			PetscObjectComm((PetscObject) ts));
+	canReuse = allCanReuse;
+	if (canReuse) {
+		PetscReal stateNorm, changeNorm;
+		ierr = VecNorm(reuse.lastState, NORM_2, &stateNorm);
+		CHKERRQ(ierr);
+		ierr = VecWAXPY(reuse.work, -1.0, reuse.lastState, C);
+		CHKERRQ(ierr);
+		ierr = VecNorm(reuse.work, NORM_2, &changeNorm);
+		CHKERRQ(ierr);
+		canReuse = changeNorm <= reuse.maxStateChange * stateNorm;
+	}
+
+	if (canReuse) {
+		reuse.nReuses++;
+		PetscFunctionReturn(0);
+	}
+
+	// Save the state of this evaluation
+	if (!reuse.lastState) {
+		ierr = VecDuplicate(C, &reuse.lastState);
+		CHKERRQ(ierr);
+		ierr = VecDuplicate(C, &reuse.work);
+		CHKERRQ(ierr);
+	}
+	ierr = VecCopy(C, reuse.lastState);
+	CHKERRQ(ierr);
+	reuse.lastTemperature = temperature;
+	reuse.nFailures = nFailures;
+	reuse.nReuses = 0;
+
+	PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ Actual__FUNCT__("xolotlSolver", "RHSJacobian")
 /*
  Compute the Jacobian entries based on IFunction() and insert them into the matrix
  */
 PetscErrorCode RHSJacobian(TS ts, PetscReal ftime, Vec C, Mat A, Mat J,
-		void *) {
+		void *ctx) {
 	// Start the RHSJacobian timer
 	RHSJacobianTimer->start();
 
 	PetscErrorCode ierr;
 
-	// Get the matrix from PETSc
+	// Keep the last Jacobian if the solution barely changed since
 	PetscFunctionBeginUser;
+	auto reuse = static_cast<JacobianReuseContext*>(ctx);
+	if (reuse && reuse->maxReuses > 0) {
+		bool canReuse = false;
+		ierr = checkJacobianReuse(ts, C, *reuse, canReuse);
+		CHKERRQ(ierr);
+		if (canReuse) {
+			JacobianReuseCounter->increment();
+			RHSJacobianTimer->stop();
+			PetscFunctionReturn(0);
+		}
+	}
+	JacobianEvaluationCounter->increment();
+
+	// Get the matrix from PETSc
 	ierr = MatZeroEntries(J);
 	CHKERRQ(ierr);
+	// All the entries are set on rows owned by this process, the assembly
+	// doesn't need to communicate
+	ierr = MatSetOption(J, MAT_NO_OFF_PROC_ENTRIES, PETSC_TRUE);
+	CHKERRQ(ierr);
 	DM da;
 	ierr = TSGetDM(ts, &da);
 	CHKERRQ(ierr);
@@ -162,11 +313,51 @@ PetscErrorCode RHSJacobian(TS ts, PetscReal ftime, Vec C, Mat A, Mat J,
 	ierr = MatAssemblyEnd(J, MAT_FINAL_ASSEMBLY);
 	CHKERRQ(ierr);
 
+	// The next evaluations only refresh the values: entries outside of
+	// this pattern are dropped, the nonzero state doesn't change anymore
+	// and the preconditioner keeps its symbolic factorization
+	if (reuse && reuse->keepPattern && !reuse->patternFixed) {
+		ierr = MatSetOption(J, MAT_NEW_NONZERO_LOCATIONS, PETSC_FALSE);
+		CHKERRQ(ierr);
+		reuse->patternFixed = true;
+	}
+
 	if (A != J) {
 		ierr = MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY);
 		CHKERRQ(ierr);
 		ierr = MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY);
 		CHKERRQ(ierr);
+
+		// Save what the matrix-free Jacobian needs for its products
+		PetscBool isShell;
+		ierr = PetscObjectTypeCompare((PetscObject) A, MATSHELL, &isShell);
+		CHKERRQ(ierr);
+		if (isShell) {
+			JacobianShellContext *shellContext = nullptr;
+			ierr = MatShellGetContext(A, &shellContext);
+			CHKERRQ(ierr);
+			ierr = VecCopy(C, shellContext->state);
+			CHKERRQ(ierr);
+
+			// The nonzero pattern changes when entries are set for the
+			// first time
+			PetscObjectState nonzeroState;
+			ierr = MatGetNonzeroState(J, &nonzeroState);
+			CHKERRQ(ierr);
+			if (shellContext->rhsJacobian
+					&& nonzeroState == shellContext->nonzeroState) {
+				ierr = MatCopy(J, shellContext->rhsJacobian,
+						SAME_NONZERO_PATTERN);
+				CHKERRQ(ierr);
+			} else {
+				ierr = MatDestroy(&shellContext->rhsJacobian);
+				CHKERRQ(ierr);
+				ierr = MatDuplicate(J, MAT_COPY_VALUES,
+						&shellContext->rhsJacobian);
+				CHKERRQ(ierr);
+				shellContext->nonzeroState = nonzeroState;
+			}
+		}
 	}
 
 //	ierr = MatView(J, PETSC_VIEWER_STDOUT_WORLD);
@@ -177,11 +368,40 @@ PetscErrorCode RHSJacobian(TS ts, PetscReal ftime, Vec C, Mat A, Mat J,
 	PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "JacobianAction")
+/*
+ Compute the product of the matrix-free Jacobian with a vector
+ */
+PetscErrorCode JacobianAction(Mat A, Vec v, Vec y) {
+	PetscErrorCode ierr;
+
+	// Get the context of the shell matrix
+	PetscFunctionBeginUser;
+	JacobianShellContext *shellContext = nullptr;
+	ierr = MatShellGetContext(A, &shellContext);
+	CHKERRQ(ierr);
+
+	// The assembled part of the Jacobian
+	ierr = MatMult(shellContext->rhsJacobian, v, y);
+	CHKERRQ(ierr);
+
+	// Add the reaction partial derivatives that are not assembled
+	auto& solverHandler = Solver::getSolverHandler();
+	solverHandler.computeJacobianAction(shellContext->state, v, y);
+
+	PetscFunctionReturn(0);
+}
+
 PetscSolver::PetscSolver(ISolverHandler& _solverHandler,
 		std::shared_ptr<xolotlPerf::IHandlerRegistry> registry) :
 		Solver(_solverHandler, registry) {
 	RHSFunctionTimer = handlerRegistry->getTimer("RHSFunctionTimer");
 	RHSJacobianTimer = handlerRegistry->getTimer("RHSJacobianTimer");
+	JacobianEvaluationCounter = handlerRegistry->getEventCounter(
+			"JacobianEvaluationCounter");
+	JacobianReuseCounter = handlerRegistry->getEventCounter(
+			"JacobianReuseCounter");
 }
 
 PetscSolver::~PetscSolver() {
@@ -246,8 +466,56 @@ void PetscSolver::solve() {
 	checkPetscError(ierr, "PetscSolver::solve: TSSetProblemType failed.");
 	ierr = TSSetRHSFunction(ts, NULL, RHSFunction, NULL);
 	checkPetscError(ierr, "PetscSolver::solve: TSSetRHSFunction failed.");
-	ierr = TSSetRHSJacobian(ts, NULL, NULL, RHSJacobian, NULL);
+
+	// In matrix-free mode, the Jacobian is a shell matrix and the assembled
+	// matrix, restricted to the reaction partial derivatives within blocks,
+	// is only used as the preconditioner
+	Mat A = NULL, J = NULL;
+	JacobianShellContext shellContext;
+	if (getSolverHandler().getJacobianType() != "assembled") {
+		ierr = DMCreateMatrix(da, &J);
+		checkPetscError(ierr, "PetscSolver::solve: DMCreateMatrix failed.");
+		// The entries of the other physics handlers outside of the
+		// fill are allocated when they are first set
+		ierr = MatSetOption(J, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE);
+		checkPetscError(ierr, "PetscSolver::solve: MatSetOption failed.");
+
+		// Create the shell matrix with the same layout
+		PetscInt m, n, M, N;
+		ierr = MatGetLocalSize(J, &m, &n);
+		checkPetscError(ierr, "PetscSolver::solve: MatGetLocalSize failed.");
+		ierr = MatGetSize(J, &M, &N);
+		checkPetscError(ierr, "PetscSolver::solve: MatGetSize failed.");
+		ierr = MatCreateShell(PETSC_COMM_WORLD, m, n, M, N, &shellContext,
+				&A);
+		checkPetscError(ierr, "PetscSolver::solve: MatCreateShell failed.");
+		ierr = MatShellSetOperation(A, MATOP_MULT,
+				(void (*)(void)) JacobianAction);
+		checkPetscError(ierr,
+				"PetscSolver::solve: MatShellSetOperation failed.");
+		ierr = VecDuplicate(C, &shellContext.state);
+		checkPetscError(ierr, "PetscSolver::solve: VecDuplicate failed.");
+	}
+	// Set the Jacobian reuse policy
+	JacobianReuseContext reuseContext;
+	std::tie(reuseContext.maxStateChange, reuseContext.maxTemperatureChange,
+			reuseContext.maxReuses) = getSolverHandler().getJacobianReuse();
+	// Keep the nonzero pattern of the first Jacobian, the physics handlers
+	// can set new entries when the surface moves so it is only an option
+	ierr = PetscOptionsHasName(NULL, NULL, "-jacobian_keep_pattern",
+			&reuseContext.keepPattern);
+	checkPetscError(ierr,
+			"PetscSolver::solve: PetscOptionsHasName (-jacobian_keep_pattern) failed.");
+	ierr = TSSetRHSJacobian(ts, A, J, RHSJacobian, &reuseContext);
 	checkPetscError(ierr, "PetscSolver::solve: TSSetRHSJacobian failed.");
+	if (A || reuseContext.maxReuses > 0) {
+		// The shell matrix can't be reset by RHSJacobian, and a reused
+		// matrix must be the one RHSJacobian computed: TS has to undo its
+		// shift and scaling before each new evaluation
+		ierr = TSRHSJacobianSetReuse(ts, PETSC_TRUE);
+		checkPetscError(ierr,
+				"PetscSolver::solve: TSRHSJacobianSetReuse failed.");
+	}
 	ierr = TSSetSolution(ts, C);
 	checkPetscError(ierr, "PetscSolver::solve: TSSetSolution failed.");
 
@@ -276,6 +544,24 @@ void PetscSolver::solve() {
 	ierr = TSSetFromOptions(ts);
 	checkPetscError(ierr, "PetscSolver::solve: TSSetFromOptions failed.");
 
+	// Replace the preconditioner set in the options by the block LU one
+	BlockLUPreconditioner blockPreconditioner(
+			getSolverHandler().getNThreads());
+	if (getSolverHandler().getPreconditioner() == "blockLU") {
+		SNES snes;
+		ierr = TSGetSNES(ts, &snes);
+		checkPetscError(ierr, "PetscSolver::solve: TSGetSNES failed.");
+		KSP ksp;
+		ierr = SNESGetKSP(snes, &ksp);
+		checkPetscError(ierr, "PetscSolver::solve: SNESGetKSP failed.");
+		PC pc;
+		ierr = KSPGetPC(ksp, &pc);
+		checkPetscError(ierr, "PetscSolver::solve: KSPGetPC failed.");
+		ierr = blockPreconditioner.attach(pc);
+		checkPetscError(ierr,
+				"PetscSolver::solve: BlockLUPreconditioner::attach failed.");
+	}
+
 	// Switch on the number of dimensions to set the monitors
 	int dim = getSolverHandler().getDimension();
 	switch (dim) {
@@ -321,6 +607,9 @@ void PetscSolver::solve() {
 	 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 	if (ts != NULL && C != NULL) {
 		ierr = TSSolve(ts, C);
+		// Complete the asynchronous checkpoint before anything else
+		finalizeCheckpointWriter();
+		finalizeObservablesSink();
 		checkPetscError(ierr, "PetscSolver::solve: TSSolve failed.");
 
 		/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -365,6 +654,20 @@ void PetscSolver::solve() {
 	checkPetscError(ierr, "PetscSolver::solve: VecDestroy failed.");
 	ierr = TSDestroy(&ts);
 	checkPetscError(ierr, "PetscSolver::solve: TSDestroy failed.");
+	ierr = MatDestroy(&A);
+	checkPetscError(ierr, "PetscSolver::solve: MatDestroy (A) failed.");
+	ierr = MatDestroy(&J);
+	checkPetscError(ierr, "PetscSolver::solve: MatDestroy (J) failed.");
+	ierr = MatDestroy(&shellContext.rhsJacobian);
+	checkPetscError(ierr,
+			"PetscSolver::solve: MatDestroy (rhsJacobian) failed.");
+	ierr = VecDestroy(&shellContext.state);
+	checkPetscError(ierr, "PetscSolver::solve: VecDestroy (state) failed.");
+	ierr = VecDestroy(&reuseContext.lastState);
+	checkPetscError(ierr,
+			"PetscSolver::solve: VecDestroy (lastState) failed.");
+	ierr = VecDestroy(&reuseContext.work);
+	checkPetscError(ierr, "PetscSolver::solve: VecDestroy (work) failed.");
 	ierr = DMDestroy(&da);
 	checkPetscError(ierr, "PetscSolver::solve: DMDestroy failed.");
 
@@ -0,0 +1,141 @@
+// Includes
+#include "CheckpointWriter.h"
+#include <iostream>
+
+namespace xolotlSolver {
+
+CheckpointWriter::CheckpointWriter(MPI_Comm _comm, bool _async,
+		std::shared_ptr<xolotlPerf::IHandlerRegistry> registry) :
+		async(_async), comm(_comm), busy(false), stopping(false) {
+	writeTimer = registry->getTimer("checkpoint:write");
+	waitTimer = registry->getTimer("checkpoint:wait");
+
+	if (!async)
+		return;
+
+	// The writes call MPI from the background thread
+	int provided = MPI_THREAD_SINGLE;
+	MPI_Query_thread(&provided);
+	if (provided < MPI_THREAD_MULTIPLE) {
+		int procId;
+		MPI_Comm_rank(_comm, &procId);
+		if (procId == 0) {
+			std::cout << "CheckpointWriter: MPI_THREAD_MULTIPLE is not "
+					"available, the checkpoints will be written synchronously."
+					<< std::endl;
+		}
+		async = false;
+		return;
+	}
+
+	// Use a duplicate of the communicator so the collective operations of
+	// the writes never match the ones of the solver
+	MPI_Comm_dup(_comm, &comm);
+	thread = std::thread(&CheckpointWriter::run, this);
+}
+
+CheckpointWriter::~CheckpointWriter() {
+	if (!async)
+		return;
+
+	// Let the last write complete and stop the thread
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		condition.wait(lock, [this] {return !pending && !busy;});
+		stopping = true;
+	}
+	condition.notify_all();
+	thread.join();
+	MPI_Comm_free(&comm);
+
+	// Destructors must not throw, report the last error
+	if (error) {
+		try {
+			std::rethrow_exception(error);
+		} catch (const std::string& message) {
+			std::cerr << message << std::endl;
+		} catch (const std::exception& e) {
+			std::cerr << e.what() << std::endl;
+		} catch (...) {
+			std::cerr << "CheckpointWriter: the last write failed."
+					<< std::endl;
+		}
+	}
+}
+
+void CheckpointWriter::run() {
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		condition.wait(lock, [this] {return pending || stopping;});
+		if (!pending)
+			break;
+
+		// Run the write without holding the lock
+		WriteOperation operation;
+		std::swap(operation, pending);
+		busy = true;
+		lock.unlock();
+		std::exception_ptr writeError;
+		try {
+			xolotlPerf::ScopedTimer myTimer(writeTimer);
+			operation(comm);
+		} catch (...) {
+			writeError = std::current_exception();
+		}
+
+		// Free the snapshot before signaling the completion
+		operation = nullptr;
+		lock.lock();
+		error = writeError;
+		busy = false;
+		condition.notify_all();
+	}
+
+	return;
+}
+
+void CheckpointWriter::waitLocked(std::unique_lock<std::mutex>& lock) {
+	{
+		xolotlPerf::ScopedTimer myTimer(waitTimer);
+		condition.wait(lock, [this] {return !pending && !busy;});
+	}
+
+	// Rethrow the error of the previous write
+	if (error) {
+		std::exception_ptr writeError;
+		std::swap(writeError, error);
+		std::rethrow_exception(writeError);
+	}
+
+	return;
+}
+
+void CheckpointWriter::submit(WriteOperation operation) {
+	// Write right away in the synchronous mode
+	if (!async) {
+		xolotlPerf::ScopedTimer myTimer(writeTimer);
+		operation(comm);
+		return;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		waitLocked(lock);
+		pending = std::move(operation);
+	}
+	condition.notify_all();
+
+	return;
+}
+
+void CheckpointWriter::wait() {
+	if (!async)
+		return;
+
+	std::unique_lock<std::mutex> lock(mutex);
+	waitLocked(lock);
+
+	return;
+}
+
+} /* end namespace xolotlSolver */
@@ -0,0 +1,136 @@
+#ifndef XSOLVER_CHECKPOINTWRITER_H
+#define XSOLVER_CHECKPOINTWRITER_H
+
+// Includes
+#include <mpi.h>
+#include <memory>
+#include <functional>
+#include <exception>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <xolotlPerf.h>
+
+namespace xolotlSolver {
+
+/**
+ * This class runs the HDF5 writes of the startStop monitors.
+ *
+ * In the synchronous mode a write is run as soon as it is submitted, as
+ * before. In the asynchronous mode the monitor copies what it needs in the
+ * write operation (the staging buffer) and submits it; a background thread
+ * runs it on a duplicate of the communicator while the solver keeps
+ * stepping. At most one write is in flight: submitting the next one, or
+ * finishing, first waits for the previous one to complete, so there are at
+ * most two snapshots in memory.
+ *
+ * The asynchronous mode needs MPI_THREAD_MULTIPLE, main always requests it
+ * and the writer falls back on the synchronous mode if MPI does not
+ * provide it. No other HDF5 call may
+ * happen on the main thread while a write is in flight: during the time
+ * loop the other HDF5 writes (the 1D TRIDYN files) are submitted to the
+ * writer as well.
+ *
+ * Two timers are added to the performance registry: "checkpoint:write"
+ * measures the writes and "checkpoint:wait" the time the solver waited for
+ * them. In the asynchronous mode the difference is the time during which
+ * the writes overlapped the solve.
+ */
+class CheckpointWriter {
+public:
+
+	//! The type of the write operations, they get the communicator to use
+	using WriteOperation = std::function<void(MPI_Comm)>;
+
+private:
+
+	//! Whether the writes run on the background thread
+	bool async;
+
+	//! The communicator used by the writes
+	MPI_Comm comm;
+
+	//! The background thread
+	std::thread thread;
+
+	//! The mutex protecting the members below
+	std::mutex mutex;
+
+	//! The condition variable to signal the changes of the members below
+	std::condition_variable condition;
+
+	//! The write operation to run next, empty if there is none
+	WriteOperation pending;
+
+	//! Whether a write operation is running
+	bool busy;
+
+	//! Whether the thread should stop
+	bool stopping;
+
+	//! The exception thrown by the last write operation, if any
+	std::exception_ptr error;
+
+	//! The timer of the write operations
+	std::shared_ptr<xolotlPerf::ITimer> writeTimer;
+
+	//! The timer of the waits for their completion
+	std::shared_ptr<xolotlPerf::ITimer> waitTimer;
+
+	/**
+	 * The loop of the background thread.
+	 */
+	void run();
+
+	/**
+	 * Wait for the write in flight to complete, the mutex must be locked.
+	 *
+	 * @param lock The lock on the mutex
+	 */
+	void waitLocked(std::unique_lock<std::mutex>& lock);
+
+public:
+
+	/**
+	 * The constructor.
+	 *
+	 * @param _comm The communicator of the processes writing the file
+	 * @param _async Whether the writes should be asynchronous
+	 * @param registry The performance handler registry
+	 */
+	CheckpointWriter(MPI_Comm _comm, bool _async,
+			std::shared_ptr<xolotlPerf::IHandlerRegistry> registry);
+
+	/**
+	 * The destructor. It waits for the last write and stops the thread, it
+	 * must be called before MPI_Finalize.
+	 */
+	~CheckpointWriter();
+
+	/**
+	 * Is the writer asynchronous?
+	 *
+	 * @return True if the writes run on the background thread
+	 */
+	bool isAsync() const {
+		return async;
+	}
+
+	/**
+	 * Submit a write operation. This waits for the previous one to
+	 * complete, and rethrows its exception if it failed.
+	 *
+	 * @param operation The write operation
+	 */
+	void submit(WriteOperation operation);
+
+	/**
+	 * Wait for the write in flight, if any, to complete and rethrow its
+	 * exception if it failed.
+	 */
+	void wait();
+};
+//end class CheckpointWriter
+
+} /* end namespace xolotlSolver */
+#endif
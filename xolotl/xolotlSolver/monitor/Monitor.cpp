@@ -12,8 +12,12 @@
 #include <iomanip>
 #include <vector>
 #include <memory>
+#include <cmath>
+#include <algorithm>
 #include "xolotlCore/io/XFile.h"
 #include "xolotlSolver/monitor/Monitor.h"
+#include "xolotlSolver/monitor/CheckpointWriter.h"
+#include "xolotlSolver/monitor/ObservablesSink.h"
 
 namespace xolotlSolver {
 
@@ -24,6 +28,10 @@ std::shared_ptr<xolotlViz::IPlot> perfPlot;
 double previousTime = 0.0;
 //! The variable to store the threshold on time step defined by the user.
 double timeStepThreshold = 0.0;
+//! The writer of the checkpoints of the startStop monitor.
+std::unique_ptr<CheckpointWriter> checkpointWriter;
+//! The sink of the observable files.
+std::unique_ptr<ObservablesSink> observablesSink;
 
 #undef __FUNCT__
 #define __FUNCT__ Actual__FUNCT__("xolotlSolver", "checkTimeStep")
@@ -234,5 +242,74 @@ void writeNetwork(MPI_Comm _comm, std::string srcFileName,
 	}
 }
 
+bool hasChangedSinceBase(const double *concs, const double *baseConcs,
+		int dof, double tolerance) {
+	// The temperature
+	if (std::fabs(concs[dof - 1] - baseConcs[dof - 1])
+			> tolerance * std::fabs(baseConcs[dof - 1]))
+		return true;
+
+	// The concentrations
+	double maxConc = 0.0, maxChange = 0.0;
+	for (int l = 0; l < dof - 1; l++) {
+		maxConc = std::max(maxConc, std::fabs(baseConcs[l]));
+		maxChange = std::max(maxChange, std::fabs(concs[l] - baseConcs[l]));
+	}
+
+	return maxChange > tolerance * maxConc;
+}
+
+void finalizeCheckpointWriter() {
+	if (!checkpointWriter)
+		return;
+
+	// Take the writer so that it is freed even if the last write failed
+	std::unique_ptr<CheckpointWriter> writer(std::move(checkpointWriter));
+	writer->wait();
+}
+
+void initializeObservablesSink() {
+	if (observablesSink)
+		return;
+
+	// To check PETSc errors
+	PetscErrorCode ierr;
+
+	// Check the option -observables_binary
+	PetscBool flagBinary;
+	ierr = PetscOptionsHasName(NULL, NULL, "-observables_binary", &flagBinary);
+	checkPetscError(ierr,
+			"initializeObservablesSink: PetscOptionsHasName (-observables_binary) failed.");
+
+	// Check the option -observables_flush_time
+	PetscBool flagTime;
+	PetscReal flushTime = 10.0;
+	ierr = PetscOptionsGetReal(NULL, NULL, "-observables_flush_time",
+			&flushTime, &flagTime);
+	checkPetscError(ierr,
+			"initializeObservablesSink: PetscOptionsGetReal (-observables_flush_time) failed.");
+
+	// Check the option -observables_flush_size
+	PetscBool flagSize;
+	PetscInt flushSize = 1 << 20;
+	ierr = PetscOptionsGetInt(NULL, NULL, "-observables_flush_size",
+			&flushSize, &flagSize);
+	checkPetscError(ierr,
+			"initializeObservablesSink: PetscOptionsGetInt (-observables_flush_size) failed.");
+
+	observablesSink = std::unique_ptr<ObservablesSink>(
+			new ObservablesSink(flagBinary, flushTime, flushSize));
+
+	return;
+}
+
+void finalizeObservablesSink() {
+	if (!observablesSink)
+		return;
+
+	observablesSink->flush();
+	observablesSink.reset();
+}
+
 }
 /* end namespace xolotlSolver */
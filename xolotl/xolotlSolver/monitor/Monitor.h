@@ -22,6 +22,43 @@ namespace xolotlSolver {
 void writeNetwork(MPI_Comm _comm, std::string srcFileName,
 		std::string targetFileName, IReactionNetwork& network);
 
+/**
+ * Wait for the last checkpoint of the startStop monitor to be written and
+ * free the checkpoint writer. It must be called after the solve, before
+ * MPI is finalized.
+ */
+void finalizeCheckpointWriter();
+
+/**
+ * Create the sink of the observable files (retentionOut.txt, surface.txt,
+ * ...) if it does not exist yet, from the options -observables_binary,
+ * -observables_flush_time (in seconds) and -observables_flush_size
+ * (in bytes). Each process has its own sink.
+ */
+void initializeObservablesSink();
+
+/**
+ * Append the buffered records of the observable files to the files and
+ * free the sink. It must be called after the solve.
+ */
+void finalizeObservablesSink();
+
+/**
+ * Check if the solution at a grid point changed since the last full
+ * checkpoint, for the incremental checkpoints. It changed if the temperature,
+ * which is the last degree of freedom, changed by more than the relative
+ * tolerance, or if the biggest change of a concentration is more than the
+ * tolerance times the biggest concentration of the full checkpoint.
+ *
+ * @param concs The solution at the grid point
+ * @param baseConcs The solution at the grid point in the full checkpoint
+ * @param dof The number of degrees of freedom
+ * @param tolerance The relative tolerance
+ * @return True if it changed
+ */
+bool hasChangedSinceBase(const double *concs, const double *baseConcs,
+		int dof, double tolerance);
+
 } // namespace xolotlSolver
 
 #endif // XSOLVER_MONITOR_H
@@ -25,6 +25,8 @@
 #include <AlloySuperCluster.h>
 #include "xolotlCore/io/XFile.h"
 #include "xolotlSolver/monitor/Monitor.h"
+#include "xolotlSolver/monitor/CheckpointWriter.h"
+#include "xolotlSolver/monitor/ObservablesSink.h"
 
 namespace xolotlSolver {
 
@@ -41,6 +43,8 @@ extern PetscErrorCode monitorPerf(TS ts, PetscInt timestep, PetscReal time,
 extern std::shared_ptr<xolotlViz::IPlot> perfPlot;
 extern double previousTime;
 extern double timeStepThreshold;
+extern std::unique_ptr<CheckpointWriter> checkpointWriter;
+extern std::unique_ptr<ObservablesSink> observablesSink;
 
 //! The pointer to the plot used in monitorScatter0D.
 std::shared_ptr<xolotlViz::IPlot> scatterPlot0D;
@@ -50,6 +54,20 @@ PetscReal hdf5Stride0D = 0.0;
 PetscInt hdf5Previous0D = 0;
 //! HDF5 output file name
 std::string hdf5OutputName0D = "xolotlStop.h5";
+//! Whether the HDF5 concentrations are compressed
+PetscBool hdf5Compress0D = PETSC_FALSE;
+//! The relative tolerance on the compressed HDF5 concentrations
+PetscReal hdf5Tolerance0D = 0.0;
+//! How many HDF5 snapshots between the full ones, 0 if they are all full
+PetscInt hdf5BaseStride0D = 0;
+//! The relative change above which a grid point is in an incremental snapshot
+PetscReal hdf5IncrementalTol0D = 1.0e-4;
+//! The number of HDF5 snapshots since the last full one
+PetscInt hdf5SinceBase0D = 0;
+//! The time step of the last full HDF5 snapshot, -1 if there is none yet
+PetscInt hdf5BaseTimeStep0D = -1;
+//! The solution at the grid points we own in the last full HDF5 snapshot
+std::vector<double> hdf5BaseConcs0D;
 // Declare the vector that will store the Id of the helium clusters
 std::vector<int> indices0D;
 // Declare the vector that will store the weight of the helium clusters
@@ -99,49 +117,79 @@ PetscErrorCode startStop0D(TS ts, PetscInt timestep, PetscReal time,
 	auto& network = solverHandler.getNetwork();
 	const int dof = network.getDOF();
 
-	// Create an array for the concentration
-	double concArray[dof][2];
-
-	// Open the existing HDF5 file
-	xolotlCore::XFile checkpointFile(hdf5OutputName0D, PETSC_COMM_WORLD,
-			xolotlCore::XFile::AccessMode::OpenReadWrite);
-
 	// Get the current time step
 	double currentTimeStep;
 	ierr = TSGetTimeStep(ts, &currentTimeStep);
 	CHKERRQ(ierr);
 
-	// Add a concentration time step group for the current time step.
-	auto concGroup = checkpointFile.getGroup<
-			xolotlCore::XFile::ConcentrationGroup>();
-	assert(concGroup);
-	auto tsGroup = concGroup->addTimestepGroup(timestep, time, previousTime,
-			currentTimeStep);
-
 	// Determine the concentration values we will write.
 	// We only examine and collect the grid points we own.
 	// TODO measure impact of us building the flattened representation
 	// rather than a ragged 2D representation.
-	XFile::TimestepGroup::Concs1DType concs(1);
+	auto concs = std::make_shared<XFile::TimestepGroup::Concs1DType>(1);
 
 	// Access the solution data for the current grid point.
 	gridPointSolution = solutionArray[0];
 
-	for (auto l = 0; l < dof; ++l) {
-		if (std::fabs(gridPointSolution[l]) > 1.0e-16) {
-			concs[0].emplace_back(l, gridPointSolution[l]);
+	// Decide if this snapshot is a full or an incremental one
+	bool incremental = (hdf5BaseStride0D > 0) && (hdf5BaseTimeStep0D >= 0)
+			&& (hdf5SinceBase0D < hdf5BaseStride0D);
+	int baseTimeStep = incremental ? hdf5BaseTimeStep0D : -1;
+	if (hdf5BaseStride0D > 0 && !incremental) {
+		// Keep the full snapshot
+		hdf5BaseTimeStep0D = timestep;
+		hdf5SinceBase0D = 0;
+		hdf5BaseConcs0D.assign(gridPointSolution, gridPointSolution + dof);
+	}
+	hdf5SinceBase0D++;
+
+	// The grid point is skipped if it did not change since the full snapshot
+	if (!incremental
+			|| hasChangedSinceBase(gridPointSolution, hdf5BaseConcs0D.data(),
+					dof, hdf5IncrementalTol0D)) {
+		for (auto l = 0; l < dof; ++l) {
+			if (std::fabs(gridPointSolution[l]) > 1.0e-16) {
+				(*concs)[0].emplace_back(l, gridPointSolution[l]);
+			}
 		}
 	}
 
-	// Write our concentration data to the current timestep group
-	// in the HDF5 file.
-	// We only write the data for the grid points we own.
-	tsGroup->writeConcentrations(checkpointFile, 0, concs);
-
 	// Restore the solutionArray
 	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
+	// Copy everything else that is written, the write can happen while
+	// the solver keeps going
+	double previousT = previousTime;
+	std::string fileName = hdf5OutputName0D;
+	bool compress = hdf5Compress0D;
+	double tolerance = hdf5Tolerance0D;
+
+	// Write the checkpoint
+	checkpointWriter->submit([=](MPI_Comm comm) {
+		// Open the existing HDF5 file
+		xolotlCore::XFile checkpointFile(fileName, comm,
+				xolotlCore::XFile::AccessMode::OpenReadWrite);
+
+		// Add a concentration time step group for the current time step.
+		auto concGroup = checkpointFile.getGroup<
+				xolotlCore::XFile::ConcentrationGroup>();
+		assert(concGroup);
+		auto tsGroup = concGroup->addTimestepGroup(timestep, time, previousT,
+				currentTimeStep);
+
+		// Write our concentration data to the current timestep group
+		// in the HDF5 file.
+		// We only write the data for the grid points we own.
+		if (compress)
+			tsGroup->writeCompressedConcentrations(checkpointFile, 0, *concs,
+					tolerance);
+		else
+			tsGroup->writeConcentrations(checkpointFile, 0, *concs);
+		if (baseTimeStep >= 0)
+			tsGroup->writeBaseTimeStep(baseTimeStep);
+	});
+
 	PetscFunctionReturn(0);
 }
 
@@ -235,13 +283,9 @@ PetscErrorCode computeXenonRetention0D(TS ts, PetscInt, PetscReal time,
 		averagePartialRadius = minRadius;
 
 	// Uncomment to write the retention and the fluence in a file
-	std::ofstream outputFile;
-	outputFile.open("retentionOut.txt", ios::app);
-	outputFile << time << " " << xeConcentration << " "
-			<< radii / bubbleConcentration << " " << averagePartialRadius << " "
-			<< partialBubbleConcentration << " "
-			<< partialSize / partialBubbleConcentration << std::endl;
-	outputFile.close();
+	observablesSink->addRecord("retentionOut.txt", { time, xeConcentration,
+			radii / bubbleConcentration, averagePartialRadius,
+			partialBubbleConcentration, partialSize / partialBubbleConcentration });
 
 	// Restore the solutionArray
 	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
@@ -452,24 +496,14 @@ PetscErrorCode computeAlloy0D(TS ts, PetscInt timestep, PetscReal time,
 	faultedPartialDiameter = faultedPartialDiameter / faultedPartialDensity;
 	frankPartialDiameter = frankPartialDiameter / frankPartialDensity;
 
-	// Open the output file
-	std::fstream outputFile;
-	outputFile.open("Alloy.dat", std::fstream::out | std::fstream::app);
-	outputFile << std::setprecision(outputPrecision);
-
 	// Output the data
-	outputFile << timestep << " " << time << " " << iDensity << " " << iDiameter
-			<< " " << vDensity << " " << vDiameter << " " << voidDensity << " "
-			<< voidDiameter << " " << faultedDensity << " " << faultedDiameter
-			<< " " << perfectDensity << " " << perfectDiameter << " "
-			<< frankDensity << " " << frankDiameter << " " << voidPartialDensity
-			<< " " << voidPartialDiameter << " " << faultedPartialDensity << " "
-			<< faultedPartialDiameter << " " << perfectPartialDensity << " "
-			<< perfectPartialDiameter << " " << frankPartialDensity << " "
-			<< frankPartialDiameter << std::endl;
-
-	// Close the output file
-	outputFile.close();
+	observablesSink->addRecord("Alloy.dat", { (double) timestep, time,
+			iDensity, iDiameter, vDensity, vDiameter, voidDensity, voidDiameter,
+			faultedDensity, faultedDiameter, perfectDensity, perfectDiameter,
+			frankDensity, frankDiameter, voidPartialDensity, voidPartialDiameter,
+			faultedPartialDensity, faultedPartialDiameter, perfectPartialDensity,
+			perfectPartialDiameter, frankPartialDensity, frankPartialDiameter },
+			outputPrecision, 1);
 
 	// Restore the PETSC solution array
 	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
@@ -721,6 +755,9 @@ PetscErrorCode setupPetsc0DMonitor(TS ts) {
 	checkPetscError(ierr,
 			"setupPetsc0DMonitor: PetscOptionsHasName (-xenon_retention) failed.");
 
+	// Create the sink of the observable files
+	initializeObservablesSink();
+
 	// Get the solver handler
 	auto& solverHandler = PetscSolver::getSolverHandler();
 
@@ -772,6 +809,39 @@ PetscErrorCode setupPetsc0DMonitor(TS ts) {
 		if (!flag)
 			hdf5Stride0D = 1.0;
 
+		// Check the option -start_stop_async
+		PetscBool flagAsync;
+		ierr = PetscOptionsHasName(NULL, NULL, "-start_stop_async", &flagAsync);
+		checkPetscError(ierr,
+				"setupPetsc0DMonitor: PetscOptionsHasName (-start_stop_async) failed.");
+
+		// Check the option -start_stop_compress, its optional value is the
+		// relative tolerance on the concentrations
+		ierr = PetscOptionsHasName(NULL, NULL, "-start_stop_compress",
+				&hdf5Compress0D);
+		checkPetscError(ierr,
+				"setupPetsc0DMonitor: PetscOptionsHasName (-start_stop_compress) failed.");
+		ierr = PetscOptionsGetReal(NULL, NULL, "-start_stop_compress",
+				&hdf5Tolerance0D, &flag);
+		checkPetscError(ierr,
+				"setupPetsc0DMonitor: PetscOptionsGetReal (-start_stop_compress) failed.");
+
+		// Check the option -start_stop_incremental, its value is the number
+		// of snapshots between the full ones
+		ierr = PetscOptionsGetInt(NULL, NULL, "-start_stop_incremental",
+				&hdf5BaseStride0D, &flag);
+		checkPetscError(ierr,
+				"setupPetsc0DMonitor: PetscOptionsGetInt (-start_stop_incremental) failed.");
+		ierr = PetscOptionsGetReal(NULL, NULL, "-start_stop_incremental_tol",
+				&hdf5IncrementalTol0D, &flag);
+		checkPetscError(ierr,
+				"setupPetsc0DMonitor: PetscOptionsGetReal (-start_stop_incremental_tol) failed.");
+
+		// Create the writer of the checkpoints
+		checkpointWriter.reset(
+				new CheckpointWriter(PETSC_COMM_WORLD, flagAsync,
+						xolotlPerf::getHandlerRegistry()));
+
 		// Compute the correct hdf5Previous0D for a restart
 		// Get the last time step written in the HDF5 file
 		if (hasConcentrations) {
@@ -906,9 +976,7 @@ PetscErrorCode setupPetsc0DMonitor(TS ts) {
 	// Set the monitor to output data for Alloy
 	if (flagAlloy) {
 		// Create/open the output files
-		std::fstream outputFile;
-		outputFile.open("Alloy.dat", std::fstream::out);
-		outputFile.close();
+		observablesSink->create("Alloy.dat");
 
 		// computeAlloy0D will be called at each timestep
 		ierr = TSMonitorSet(ts, computeAlloy0D, NULL, NULL);
@@ -960,9 +1028,7 @@ PetscErrorCode setupPetsc0DMonitor(TS ts) {
 				"setupPetsc0DMonitor: TSMonitorSet (computeXenonRetention0D) failed.");
 
 		// Uncomment to clear the file where the retention will be written
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt");
-		outputFile.close();
+		observablesSink->create("retentionOut.txt");
 	}
 
 	// Set the monitor to simply change the previous time to the new time
@@ -14,7 +14,9 @@
 #include <iostream>
 #include <iomanip>
 #include <vector>
+#include <array>
 #include <memory>
+#include <algorithm>
 #include <NESuperCluster.h>
 #include <PSISuperCluster.h>
 #include <FeSuperCluster.h>
@@ -27,6 +29,9 @@
 #include "RandomNumberGenerator.h"
 #include "xolotlCore/io/XFile.h"
 #include "xolotlSolver/monitor/Monitor.h"
+#include "xolotlSolver/monitor/CheckpointWriter.h"
+#include "xolotlSolver/monitor/ObservablesSink.h"
+#include "xolotlSolver/monitor/ObservablesReducer.h"
 
 namespace xperf = xolotlPerf;
 
@@ -45,6 +50,8 @@ extern PetscErrorCode monitorPerf(TS ts, PetscInt timestep, PetscReal time,
 extern std::shared_ptr<xolotlViz::IPlot> perfPlot;
 extern double previousTime;
 extern double timeStepThreshold;
+extern std::unique_ptr<CheckpointWriter> checkpointWriter;
+extern std::unique_ptr<ObservablesSink> observablesSink;
 
 //! The pointer to the plot used in monitorScatter1D.
 std::shared_ptr<xolotlViz::IPlot> scatterPlot1D;
@@ -86,6 +93,20 @@ PetscReal hdf5Stride1D = 0.0;
 PetscInt hdf5Previous1D = 0;
 //! HDF5 output file name
 std::string hdf5OutputName1D = "xolotlStop.h5";
+//! Whether the HDF5 concentrations are compressed
+PetscBool hdf5Compress1D = PETSC_FALSE;
+//! The relative tolerance on the compressed HDF5 concentrations
+PetscReal hdf5Tolerance1D = 0.0;
+//! How many HDF5 snapshots between the full ones, 0 if they are all full
+PetscInt hdf5BaseStride1D = 0;
+//! The relative change above which a grid point is in an incremental snapshot
+PetscReal hdf5IncrementalTol1D = 1.0e-4;
+//! The number of HDF5 snapshots since the last full one
+PetscInt hdf5SinceBase1D = 0;
+//! The time step of the last full HDF5 snapshot, -1 if there is none yet
+PetscInt hdf5BaseTimeStep1D = -1;
+//! The solution at the grid points we own in the last full HDF5 snapshot
+std::vector<double> hdf5BaseConcs1D;
 // Declare the vector that will store the Id of the helium clusters
 std::vector<int> indices1D;
 // Declare the vector that will store the weight of the helium clusters
@@ -95,14 +116,52 @@ std::vector<int> weights1D;
 std::vector<double> radii1D;
 // The vector of depths at which bursting happens
 std::vector<int> depthPositions1D;
+//! The number of values per grid point in the TRIDYN files
+constexpr int numTRIDYNValues1D = 7;
+//! The type of the TRIDYN data of the local grid points
+using TRIDYNConcs1DType = xolotlCore::HDF5File::DataSet<double>::DataType2D<
+		numTRIDYNValues1D>;
+//! The observables computed in a single sweep by computeObservables1D
+ObservablesReducer observables1D;
+/**
+ * The data of the current time step used by the observables of
+ * computeObservables1D.
+ */
+struct ObservablesStep1D {
+	//! The process ID
+	int procId = 0;
+	//! The first local grid point
+	PetscInt xs = 0;
+	//! The total size of the grid
+	PetscInt Mx = 0;
+	//! The position of the surface
+	int surfacePos = 0;
+	//! The current time
+	PetscReal time = 0.0;
+	//! The physical grid
+	std::vector<double> grid;
+	//! Whether the network concentrations are updated at the grid points
+	bool networkUpdate = false;
+	//! Whether the total concentrations at the grid points are needed
+	bool pointTotals = false;
+	//! Whether the TRIDYN file is written
+	bool tridyn = false;
+	//! The first grid point of the TRIDYN file
+	int tridynFirstIdx = 0;
+	//! The first local grid point of the TRIDYN file
+	int tridynMyFirstIdx = 0;
+} observablesStep1D;
+//! The total concentrations at the current grid point of the sweep
+std::array<double, 5> pointTotals1D;
+//! The TRIDYN data of the local grid points, filled during the sweep
+TRIDYNConcs1DType tridynConcs1D;
 
 // Timers
 std::shared_ptr<xperf::ITimer> initTimer;
 std::shared_ptr<xperf::ITimer> checkNegativeTimer;
 std::shared_ptr<xperf::ITimer> tridynTimer;
 std::shared_ptr<xperf::ITimer> startStopTimer;
-std::shared_ptr<xperf::ITimer> heRetentionTimer;
-std::shared_ptr<xperf::ITimer> xeRetentionTimer;
+std::shared_ptr<xperf::ITimer> observablesTimer;
 std::shared_ptr<xperf::ITimer> scatterTimer;
 std::shared_ptr<xperf::ITimer> seriesTimer;
 std::shared_ptr<xperf::ITimer> surfaceTimer;
@@ -176,13 +235,83 @@ PetscErrorCode checkNegative1D(TS ts, PetscInt timestep, PetscReal time,
 	PetscFunctionReturn(0);
 }
 
+/**
+ * Compute the total helium, deuterium, tritium, vacancy and interstitial
+ * concentrations at a grid point from the weights of the network.
+ *
+ * @param network The network
+ * @param concs The solution at the grid point
+ * @param totals The total concentrations
+ */
+void computePointTotals1D(const IReactionNetwork& network, const double *concs,
+		std::array<double, 5>& totals) {
+	using TotalType = IReactionNetwork::TotalType;
+	totals[0] = network.getTotal(TotalType::HeAtom, concs);
+	totals[1] = network.getTotal(TotalType::DAtom, concs);
+	totals[2] = network.getTotal(TotalType::TAtom, concs);
+	totals[3] = network.getTotal(TotalType::V, concs);
+	totals[4] = network.getTotal(TotalType::I, concs);
+
+	return;
+}
+
+/**
+ * Write the TRIDYN file of the given time step. No other HDF5 write may run
+ * at the same time, the callers running with asynchronous checkpoints go
+ * through the checkpoint writer.
+ *
+ * @param comm The communicator of the processes writing the file
+ * @param timestep The time step
+ * @param Mx The total size of the grid
+ * @param firstIdxToWrite The first grid point of the file
+ * @param myFirstIdxToWrite The first grid point we write
+ * @param myConcs The data of the grid points we write
+ */
+void writeTRIDYN1D(MPI_Comm comm, PetscInt timestep, PetscInt Mx,
+		int firstIdxToWrite, int myFirstIdxToWrite,
+		const TRIDYNConcs1DType& myConcs) {
+	// Save current concentrations as an HDF5 file.
+	//
+	// First create the file for parallel file access.
+	std::ostringstream tdFileStr;
+	tdFileStr << "TRIDYN_" << timestep << ".h5";
+	xolotlCore::HDF5File tdFile(tdFileStr.str(),
+			xolotlCore::HDF5File::AccessMode::CreateOrTruncateIfExists, comm,
+			true);
+
+	// Define a dataset for concentrations.
+	// Everyone must create the dataset with the same shape.
+	const auto numGridpointsWithConcs = (Mx - firstIdxToWrite);
+	xolotlCore::HDF5File::SimpleDataSpace<2>::Dimensions concsDsetDims = {
+			(hsize_t) numGridpointsWithConcs, numTRIDYNValues1D };
+	xolotlCore::HDF5File::SimpleDataSpace<2> concsDsetSpace(concsDsetDims);
+
+	const std::string concsDsetName = "concs";
+	xolotlCore::HDF5File::DataSet<double> concsDset(tdFile, concsDsetName,
+			concsDsetSpace);
+
+	// Write the concs dataset in parallel.
+	// (We write only our part.)
+	concsDset.parWrite2D<numTRIDYNValues1D>(comm,
+			myFirstIdxToWrite - firstIdxToWrite, myConcs);
+
+	return;
+}
+
 #undef __FUNCT__
 #define __FUNCT__ Actual__FUNCT__("xolotlSolver", "computeTRIDYN1D")
 /**
- * This is a monitoring method that will compute the data to send to TRIDYN
+ * Compute the data to send to TRIDYN from the grid points of this process,
+ * without writing it.
+ *
+ * @param ts The time stepper
+ * @param solution The solution
+ * @param firstIdxToWrite The first grid point of the file
+ * @param myFirstIdxToWrite The first grid point we write
+ * @param myConcs The data of the grid points we write
  */
-PetscErrorCode computeTRIDYN1D(TS ts, PetscInt timestep, PetscReal time,
-		Vec solution, void *ictx) {
+PetscErrorCode computeTRIDYN1D(TS ts, Vec solution, int& firstIdxToWrite,
+		int& myFirstIdxToWrite, TRIDYNConcs1DType& myConcs) {
 
 	xperf::ScopedTimer myTimer(tridynTimer);
 
@@ -192,14 +321,6 @@ PetscErrorCode computeTRIDYN1D(TS ts, PetscInt timestep, PetscReal time,
 
 	PetscFunctionBeginUser;
 
-	// Get the number of processes
-	int worldSize;
-	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
-
-	// Gets the process ID
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
-
 	// Get the solver handler
 	auto& solverHandler = PetscSolver::getSolverHandler();
 
@@ -219,14 +340,6 @@ PetscErrorCode computeTRIDYN1D(TS ts, PetscInt timestep, PetscReal time,
 	ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
 	CHKERRQ(ierr);
 
-	// Get the total size of the grid
-	PetscInt Mx;
-	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE);
-	CHKERRQ(ierr);
-
 	// Get the physical grid
 	auto grid = solverHandler.getXGrid();
 
@@ -235,38 +348,16 @@ PetscErrorCode computeTRIDYN1D(TS ts, PetscInt timestep, PetscReal time,
 	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
-	// Save current concentrations as an HDF5 file.
-	//
-	// First create the file for parallel file access.
-	std::ostringstream tdFileStr;
-	tdFileStr << "TRIDYN_" << timestep << ".h5";
-	xolotlCore::HDF5File tdFile(tdFileStr.str(),
-			xolotlCore::HDF5File::AccessMode::CreateOrTruncateIfExists,
-			PETSC_COMM_WORLD, true);
-
-	// Define a dataset for concentrations.
-	// Everyone must create the dataset with the same shape.
-	constexpr auto numConcSpecies = 5;
-	constexpr auto numValsPerGridpoint = numConcSpecies + 2;
-	const auto firstIdxToWrite = (surfacePos + solverHandler.getLeftOffset());
-	const auto numGridpointsWithConcs = (Mx - firstIdxToWrite);
-	xolotlCore::HDF5File::SimpleDataSpace<2>::Dimensions concsDsetDims = {
-			(hsize_t) numGridpointsWithConcs, numValsPerGridpoint };
-	xolotlCore::HDF5File::SimpleDataSpace<2> concsDsetSpace(concsDsetDims);
-
-	const std::string concsDsetName = "concs";
-	xolotlCore::HDF5File::DataSet<double> concsDset(tdFile, concsDsetName,
-			concsDsetSpace);
-
 	// Specify the concentrations we will write.
 	// We only consider our own grid points.
-	const auto myFirstIdxToWrite = std::max(xs, firstIdxToWrite);
+	firstIdxToWrite = (surfacePos + solverHandler.getLeftOffset());
+	myFirstIdxToWrite = std::max(xs, firstIdxToWrite);
 	auto myEndIdx = (xs + xm);  // "end" in the C++ sense; i.e., one-past-last
 	auto myNumPointsToWrite =
 			(myEndIdx > myFirstIdxToWrite) ? (myEndIdx - myFirstIdxToWrite) : 0;
-	xolotlCore::HDF5File::DataSet<double>::DataType2D<numValsPerGridpoint> myConcs(
-			myNumPointsToWrite);
+	myConcs.resize(myNumPointsToWrite);
 
+	std::array<double, 5> totals;
 	for (auto xi = myFirstIdxToWrite; xi < myEndIdx; ++xi) {
 
 		if (xi >= firstIdxToWrite) {
@@ -277,26 +368,15 @@ PetscErrorCode computeTRIDYN1D(TS ts, PetscInt timestep, PetscReal time,
 			// Access the solution data for this grid point.
 			auto gridPointSolution = solutionArray[xi];
 
-			// Update the concentration in the network
-			network.updateConcentrationsFromArray(gridPointSolution);
-
 			// Get the total concentrations at this grid point
+			computePointTotals1D(network, gridPointSolution, totals);
 			auto currIdx = xi - myFirstIdxToWrite;
 			myConcs[currIdx][0] = (x - (grid[surfacePos + 1] - grid[1]));
-			myConcs[currIdx][1] = network.getTotalAtomConcentration(0);
-			myConcs[currIdx][2] = network.getTotalAtomConcentration(1);
-			myConcs[currIdx][3] = network.getTotalAtomConcentration(2);
-			myConcs[currIdx][4] = network.getTotalVConcentration();
-			myConcs[currIdx][5] = network.getTotalIConcentration();
+			std::copy(totals.begin(), totals.end(), myConcs[currIdx].begin() + 1);
 			myConcs[currIdx][6] = gridPointSolution[dof - 1];
 		}
 	}
 
-	// Write the concs dataset in parallel.
-	// (We write only our part.)
-	concsDset.parWrite2D<numValsPerGridpoint>(PETSC_COMM_WORLD,
-			myFirstIdxToWrite - firstIdxToWrite, myConcs);
-
 	// Restore the solutionArray
 	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
@@ -368,482 +448,470 @@ PetscErrorCode startStop1D(TS ts, PetscInt timestep, PetscReal time,
 	auto& network = solverHandler.getNetwork();
 	const int dof = network.getDOF();
 
-	// Create an array for the concentration
-	double concArray[dof][2];
-
 	// Get the position of the surface
 	int surfacePos = solverHandler.getSurfacePosition();
 
-	// Open the existing HDF5 file
-	xolotlCore::XFile checkpointFile(hdf5OutputName1D, PETSC_COMM_WORLD,
-			xolotlCore::XFile::AccessMode::OpenReadWrite);
-
 	// Get the current time step
 	double currentTimeStep;
 	ierr = TSGetTimeStep(ts, &currentTimeStep);
 	CHKERRQ(ierr);
 
-	// Add a concentration time step group for the current time step.
-	auto concGroup = checkpointFile.getGroup<
-			xolotlCore::XFile::ConcentrationGroup>();
-	assert(concGroup);
-	auto tsGroup = concGroup->addTimestepGroup(timestep, time, previousTime,
-			currentTimeStep);
-
-	if (solverHandler.moveSurface()) {
-		// Write the surface positions and the associated interstitial quantities
-		// in the concentration sub group
-		tsGroup->writeSurface1D(surfacePos, nInterstitial1D, previousIFlux1D);
-	}
-
-	// Write the bottom impurity information if the bottom is a free surface
-	if (solverHandler.getRightOffset() == 1)
-		tsGroup->writeBottom1D(nHelium1D, previousHeFlux1D, nDeuterium1D,
-				previousDFlux1D, nTritium1D, previousTFlux1D, nVacancy1D,
-				previousVFlux1D, nIBulk1D, previousIBulkFlux1D);
-
 	// Determine the concentration values we will write.
 	// We only examine and collect the grid points we own.
 	// TODO measure impact of us building the flattened representation
 	// rather than a ragged 2D representation.
-	XFile::TimestepGroup::Concs1DType concs(xm);
+	auto concs = std::make_shared<XFile::TimestepGroup::Concs1DType>(xm);
+
+	// Decide if this snapshot is a full or an incremental one
+	bool incremental = (hdf5BaseStride1D > 0) && (hdf5BaseTimeStep1D >= 0)
+			&& (hdf5SinceBase1D < hdf5BaseStride1D);
+	int baseTimeStep = incremental ? hdf5BaseTimeStep1D : -1;
+	if (hdf5BaseStride1D > 0 && !incremental) {
+		hdf5BaseTimeStep1D = timestep;
+		hdf5SinceBase1D = 0;
+		hdf5BaseConcs1D.resize(xm * dof);
+	}
+	hdf5SinceBase1D++;
+
 	for (auto i = 0; i < xm; ++i) {
 
 		// Access the solution data for the current grid point.
 		auto gridPointSolution = solutionArray[xs + i];
 
+		if (incremental) {
+			// Skip the grid points that did not change since the full snapshot
+			if (!hasChangedSinceBase(gridPointSolution,
+					&hdf5BaseConcs1D[i * dof], dof, hdf5IncrementalTol1D))
+				continue;
+		} else if (hdf5BaseStride1D > 0) {
+			// Keep the full snapshot
+			std::copy(gridPointSolution, gridPointSolution + dof,
+					hdf5BaseConcs1D.begin() + i * dof);
+		}
+
 		for (auto l = 0; l < dof; ++l) {
 			if (std::fabs(gridPointSolution[l]) > 1.0e-16) {
-				concs[i].emplace_back(l, gridPointSolution[l]);
+				(*concs)[i].emplace_back(l, gridPointSolution[l]);
 			}
 		}
 	}
 
-	// Write our concentration data to the current timestep group
-	// in the HDF5 file.
-	// We only write the data for the grid points we own.
-	tsGroup->writeConcentrations(checkpointFile, xs, concs);
-
 	// Restore the solutionArray
 	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
-	ierr = computeTRIDYN1D(ts, timestep, time, solution, NULL);
-	CHKERRQ(ierr);
+	// Copy everything else that is written, the write can happen while
+	// the solver keeps going
+	bool moveSurface = solverHandler.moveSurface();
+	bool freeBottom = (solverHandler.getRightOffset() == 1);
+	double previousT = previousTime;
+	double nInter = nInterstitial1D, previousIFlux = previousIFlux1D;
+	double nHe = nHelium1D, previousHeFlux = previousHeFlux1D;
+	double nD = nDeuterium1D, previousDFlux = previousDFlux1D;
+	double nT = nTritium1D, previousTFlux = previousTFlux1D;
+	double nV = nVacancy1D, previousVFlux = previousVFlux1D;
+	double nI = nIBulk1D, previousIBulkFlux = previousIBulkFlux1D;
+	std::string fileName = hdf5OutputName1D;
+	bool compress = hdf5Compress1D;
+	double tolerance = hdf5Tolerance1D;
+
+	// Compute the TRIDYN data now, it is written with the checkpoint
+	int tridynFirstIdx = 0, tridynMyFirstIdx = 0;
+	auto tridynConcs = std::make_shared<TRIDYNConcs1DType>();
+	ierr = computeTRIDYN1D(ts, solution, tridynFirstIdx, tridynMyFirstIdx,
+			*tridynConcs);
+	CHKERRQ(ierr);
+
+	// Write the checkpoint and the TRIDYN file
+	checkpointWriter->submit([=](MPI_Comm comm) {
+		// Open the existing HDF5 file
+		xolotlCore::XFile checkpointFile(fileName, comm,
+				xolotlCore::XFile::AccessMode::OpenReadWrite);
+
+		// Add a concentration time step group for the current time step.
+		auto concGroup = checkpointFile.getGroup<
+				xolotlCore::XFile::ConcentrationGroup>();
+		assert(concGroup);
+		auto tsGroup = concGroup->addTimestepGroup(timestep, time, previousT,
+				currentTimeStep);
+
+		if (moveSurface) {
+			// Write the surface positions and the associated interstitial quantities
+			// in the concentration sub group
+			tsGroup->writeSurface1D(surfacePos, nInter, previousIFlux);
+		}
+
+		// Write the bottom impurity information if the bottom is a free surface
+		if (freeBottom)
+			tsGroup->writeBottom1D(nHe, previousHeFlux, nD, previousDFlux, nT,
+					previousTFlux, nV, previousVFlux, nI, previousIBulkFlux);
+
+		// Write our concentration data to the current timestep group
+		// in the HDF5 file.
+		// We only write the data for the grid points we own.
+		if (compress)
+			tsGroup->writeCompressedConcentrations(checkpointFile, xs, *concs,
+					tolerance);
+		else
+			tsGroup->writeConcentrations(checkpointFile, xs, *concs);
+		if (baseTimeStep >= 0)
+			tsGroup->writeBaseTimeStep(baseTimeStep);
+
+		writeTRIDYN1D(comm, timestep, Mx, tridynFirstIdx, tridynMyFirstIdx,
+				*tridynConcs);
+	});
 
 	PetscFunctionReturn(0);
 }
 
-#undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "computeHeliumDesorption1D")
 /**
- * This is a monitoring method that will compute the helium desorption at the surface
+ * Add the contribution of a grid point to the helium desorption.
+ *
+ * @param xi The grid point
+ * @param concs The solution at the grid point
+ * @param localValues The flux factor of this process
  */
-PetscErrorCode computeHeliumDesorption1D(TS ts, PetscInt, PetscReal time,
-		Vec solution, void *) {
-
-	// Initial declarations
-	PetscErrorCode ierr;
-	PetscInt xs, xm;
-
-	PetscFunctionBeginUser;
-
-	// Get the solver handler
-	auto& solverHandler = PetscSolver::getSolverHandler();
-
-	// Get the flux handler that will be used to know the fluence
-	auto fluxHandler = solverHandler.getFluxHandler();
-
-	// Get the da from ts
-	DM da;
-	ierr = TSGetDM(ts, &da);
-	CHKERRQ(ierr);
-
-	// Get the corners of the grid
-	ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
-	CHKERRQ(ierr);
-
-	// Get the total size of the grid
-	PetscInt Mx;
-	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE);
-	CHKERRQ(ierr);
-
-	// Get the physical grid
-	auto grid = solverHandler.getXGrid();
-	// Get the position of the surface
-	int surfacePos = solverHandler.getSurfacePosition();
+void accumulateHeliumDesorption1D(int xi, const double *concs,
+		double *localValues) {
+	// Check if we are next to the surface
+	if (xi != observablesStep1D.surfacePos + 1)
+		return;
 
 	// Get the network
-	auto& network = solverHandler.getNetwork();
+	auto& network = PetscSolver::getSolverHandler().getNetwork();
+	auto heCluster = network.get(Species::He, 1);
 
-	// Get the array of concentration
-	PetscReal **solutionArray;
-	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
-	// Store the He concentration at the surface
-	double heConc = 0.0, diffCoeff = 0.0;
-	int heIndex = network.get(Species::He, 1)->getId() - 1;
+	// Store the He concentration times its diffusion coefficient at the surface
+	localValues[0] += concs[heCluster->getId() - 1]
+			* heCluster->getDiffusionCoefficient(xi - observablesStep1D.xs);
 
-	// Declare the pointer for the concentrations at a specific grid point
-	PetscReal *gridPointSolution;
+	return;
+}
 
-	// Loop on the grid
-	for (PetscInt xi = xs; xi < xs + xm; xi++) {
-		// Get the pointer to the beginning of the solution data for this grid point
-		gridPointSolution = solutionArray[xi];
+/**
+ * Write the helium desorption at the surface.
+ *
+ * @param totalValues The flux factor over all the processes
+ */
+void finalizeHeliumDesorption1D(const double *totalValues) {
+	// Master process
+	if (observablesStep1D.procId != 0)
+		return;
 
-		// Check if we are next to the surface
-		if (xi == surfacePos + 1) {
-			heConc = gridPointSolution[heIndex];
-			diffCoeff = network.get(Species::He, 1)->getDiffusionCoefficient(
-					xi - xs);
-		}
+	// Get the network
+	auto& network = PetscSolver::getSolverHandler().getNetwork();
+
+	auto& grid = observablesStep1D.grid;
+	int surfacePos = observablesStep1D.surfacePos;
+	double hxLeft = 0.0;
+	if (surfacePos < 0) {
+		hxLeft = grid[surfacePos + 2] - grid[surfacePos + 1];
+	} else {
+		hxLeft = (grid[surfacePos + 2] - grid[surfacePos]) / 2.0;
 	}
+	double surfaceFlux = totalValues[0] * hxLeft;
+	// Write the flux at the boundary and temperature in a file
+	observablesSink->addRecord("thds.txt",
+			{ network.getTemperature(), surfaceFlux });
 
-	// Get the current process ID
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
-
-	// Send the concentration to proc Id 0
-	double localFactor = heConc * diffCoeff, factor = 0.0;
-	MPI_Reduce(&localFactor, &factor, 1, MPI_DOUBLE, MPI_SUM, 0,
-			PETSC_COMM_WORLD);
+	return;
+}
 
-	// Master process
-	if (procId == 0) {
-		double hxLeft = 0.0;
-		if (surfacePos < 0) {
-			hxLeft = grid[surfacePos + 2] - grid[surfacePos + 1];
-		} else {
-			hxLeft = (grid[surfacePos + 2] - grid[surfacePos]) / 2.0;
-		}
-		double surfaceFlux = factor * hxLeft;
-		// Write the flux at the boundary and temperature in a file
-		std::ofstream outputFile;
-		outputFile.open("thds.txt", ios::app);
-		outputFile << network.getTemperature() << " " << surfaceFlux
-				<< std::endl;
-		outputFile.close();
+/**
+ * Compute the flux of the given clusters going in the bulk at the bottom
+ * grid point.
+ *
+ * @param clusters The clusters
+ * @param xi The bottom grid point
+ * @param concs The solution at the bottom grid point
+ * @param factor The finite difference factor
+ * @param hxRight The step on the right of the bottom grid point
+ * @param skipImmobile Whether to skip the clusters that do not diffuse
+ * @return The flux
+ */
+double computeBulkFlux1D(const IReactionNetwork::ReactantMap& clusters,
+		int xi, const double *concs, double factor, double hxRight,
+		bool skipImmobile = false) {
+	// Initialize the value for the flux
+	double newFlux = 0.0;
+	// Consider each cluster.
+	for (auto const& mapItem : clusters) {
+		// Get the cluster
+		auto const& cluster = *(mapItem.second);
+		// Get its diffusion coefficient
+		double coef = cluster.getDiffusionCoefficient(
+				xi - observablesStep1D.xs);
+		if (skipImmobile && coef <= 0.0)
+			continue;
+		// Get its id and concentration
+		int id = cluster.getId() - 1;
+		double conc = concs[id];
+		// Get its size
+		int size = cluster.getSize();
+		// Compute the flux going to the right
+		newFlux += (double) size * factor * coef * conc * hxRight;
 	}
 
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
-	PetscFunctionReturn(0);
+	return newFlux;
 }
 
-#undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "computeHeliumRetention1D")
 /**
- * This is a monitoring method that will compute the helium retention
+ * Add the contribution of a grid point to the helium retention and, on
+ * the process owning the bottom grid point, the impurities going in the
+ * bulk if the bottom is a free surface.
+ *
+ * @param xi The grid point
+ * @param concs The solution at the grid point
+ * @param localValues The contents of this process followed by the bulk data
  */
-PetscErrorCode computeHeliumRetention1D(TS ts, PetscInt, PetscReal time,
-		Vec solution, void *) {
-
-	xperf::ScopedTimer myTimer(heRetentionTimer);
-
-	// Initial declarations
-	PetscErrorCode ierr;
-	PetscInt xs, xm;
-
-	PetscFunctionBeginUser;
-
+void accumulateHeliumRetention1D(int xi, const double *concs,
+		double *localValues) {
 	// Get the solver handler
 	auto& solverHandler = PetscSolver::getSolverHandler();
+	auto& grid = observablesStep1D.grid;
+	PetscInt Mx = observablesStep1D.Mx;
 
-	// Get the flux handler that will be used to know the fluence
-	auto fluxHandler = solverHandler.getFluxHandler();
-
-	// Get the da from ts
-	DM da;
-	ierr = TSGetDM(ts, &da);
-	CHKERRQ(ierr);
-
-	// Get the corners of the grid
-	ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
-	CHKERRQ(ierr);
-
-	// Get the total size of the grid
-	PetscInt Mx;
-	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE);
-	CHKERRQ(ierr);
-
-	// Get the physical grid
-	auto grid = solverHandler.getXGrid();
-	// Get the position of the surface
-	int surfacePos = solverHandler.getSurfacePosition();
-
-	// Get the network
-	auto& network = solverHandler.getNetwork();
-
-	// Get the array of concentration
-	PetscReal **solutionArray;
-	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
-	// Store the concentration over the grid
-	double heConcentration = 0.0, dConcentration = 0.0, tConcentration = 0.0,
-			vConcentration = 0.0, iConcentration = 0.0;
+	// Boundary conditions
+	if (xi < observablesStep1D.surfacePos + solverHandler.getLeftOffset()
+			|| xi >= Mx - solverHandler.getRightOffset())
+		return;
 
-	// Declare the pointer for the concentrations at a specific grid point
-	PetscReal *gridPointSolution;
-
-	// Loop on the grid
-	for (PetscInt xi = xs; xi < xs + xm; xi++) {
-
-		// Boundary conditions
-		if (xi < surfacePos + solverHandler.getLeftOffset()
-				|| xi >= Mx - solverHandler.getRightOffset())
-			continue;
+	double hx = grid[xi + 1] - grid[xi];
 
-		// Get the pointer to the beginning of the solution data for this grid point
-		gridPointSolution = solutionArray[xi];
+	// Get the total atoms concentration at this grid point
+	for (int i = 0; i < 5; i++)
+		localValues[i] += pointTotals1D[i] * hx;
 
-		// Update the concentration in the network
-		network.updateConcentrationsFromArray(gridPointSolution);
-
-		double hx = grid[xi + 1] - grid[xi];
+	// Look at the fluxes going in the bulk if the bottom is a free surface
+	if (solverHandler.getRightOffset() != 1 || xi != Mx - 2)
+		return;
 
-		// Get the total atoms concentration at this grid point
-		heConcentration += network.getTotalAtomConcentration(0) * hx;
-		dConcentration += network.getTotalAtomConcentration(1) * hx;
-		tConcentration += network.getTotalAtomConcentration(2) * hx;
-		vConcentration += network.getTotalVConcentration() * hx;
-		iConcentration += network.getTotalIConcentration() * hx;
+	// Get the delta time from the previous timestep to this timestep
+	double dt = observablesStep1D.time - previousTime;
+	// Compute the total number of impurities that went in the bulk
+	nHelium1D += previousHeFlux1D * dt;
+	nDeuterium1D += previousDFlux1D * dt;
+	nTritium1D += previousTFlux1D * dt;
+	nVacancy1D += previousVFlux1D * dt;
+	nIBulk1D += previousIBulkFlux1D * dt;
+
+	// Factor for finite difference
+	double hxLeft = 0.0, hxRight = 0.0;
+	if (xi - 1 >= 0 && xi < Mx) {
+		hxLeft = (grid[xi + 1] - grid[xi - 1]) / 2.0;
+		hxRight = (grid[xi + 2] - grid[xi]) / 2.0;
+	} else if (xi - 1 < 0) {
+		hxLeft = grid[xi + 1] - grid[xi];
+		hxRight = (grid[xi + 2] - grid[xi]) / 2.0;
+	} else {
+		hxLeft = (grid[xi + 1] - grid[xi - 1]) / 2.0;
+		hxRight = grid[xi + 1] - grid[xi];
 	}
+	double factor = 2.0 / (hxRight * (hxLeft + hxRight));
 
-	// Get the current process ID
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
-
-	// Determine total concentrations for He, D, T.
-	std::array<double, 5> myConcData { heConcentration, dConcentration,
-			tConcentration, vConcentration, iConcentration };
-	std::array<double, 5> totalConcData;
-
-	MPI_Reduce(myConcData.data(), totalConcData.data(), myConcData.size(),
-	MPI_DOUBLE,
-	MPI_SUM, 0, PETSC_COMM_WORLD);
+	// Update the fluxes
+	auto& network = solverHandler.getNetwork();
+	previousHeFlux1D = computeBulkFlux1D(network.getAll(ReactantType::He), xi,
+			concs, factor, hxRight);
+	previousDFlux1D = computeBulkFlux1D(network.getAll(ReactantType::D), xi,
+			concs, factor, hxRight);
+	previousTFlux1D = computeBulkFlux1D(network.getAll(ReactantType::T), xi,
+			concs, factor, hxRight);
+	previousVFlux1D = computeBulkFlux1D(network.getAll(ReactantType::V), xi,
+			concs, factor, hxRight, true);
+	previousIBulkFlux1D = computeBulkFlux1D(network.getAll(ReactantType::I),
+			xi, concs, factor, hxRight);
+
+	// Only this process contributes to the sums, so every process gets
+	// the information about impurities
+	double countFluxData[10] = { nHelium1D, previousHeFlux1D, nDeuterium1D,
+			previousDFlux1D, nTritium1D, previousTFlux1D, nVacancy1D,
+			previousVFlux1D, nIBulk1D, previousIBulkFlux1D };
+	std::copy(countFluxData, countFluxData + 10, localValues + 5);
+
+	return;
+}
 
-	// Extract total He, D, T concentrations.  Values are valid only on rank 0.
-	double totalHeConcentration = totalConcData[0];
-	double totalDConcentration = totalConcData[1];
-	double totalTConcentration = totalConcData[2];
-	double totalVConcentration = totalConcData[3];
-	double totalIConcentration = totalConcData[4];
+/**
+ * Write the helium retention.
+ *
+ * @param totalValues The contents over all the processes followed by the bulk data
+ */
+void finalizeHeliumRetention1D(const double *totalValues) {
+	// Get the solver handler
+	auto& solverHandler = PetscSolver::getSolverHandler();
 
-	// Look at the fluxes going in the bulk if the bottom is a free surface
+	// Extract inpurity data from the sums
 	if (solverHandler.getRightOffset() == 1) {
-		// Set the bottom surface position
-		int xi = Mx - 2;
+		nHelium1D = totalValues[5];
+		previousHeFlux1D = totalValues[6];
+		nDeuterium1D = totalValues[7];
+		previousDFlux1D = totalValues[8];
+		nTritium1D = totalValues[9];
+		previousTFlux1D = totalValues[10];
+		nVacancy1D = totalValues[11];
+		previousVFlux1D = totalValues[12];
+		nIBulk1D = totalValues[13];
+		previousIBulkFlux1D = totalValues[14];
+	}
 
-		// Value to know on which processor is the bottom
-		int bottomProc = 0;
+	// Master process
+	if (observablesStep1D.procId != 0)
+		return;
+
+	// Extract total He, D, T concentrations.
+	double totalHeConcentration = totalValues[0];
+	double totalDConcentration = totalValues[1];
+	double totalTConcentration = totalValues[2];
+	double totalVConcentration = totalValues[3];
+	double totalIConcentration = totalValues[4];
+
+	// Get the fluence
+	double fluence = solverHandler.getFluxHandler()->getFluence();
+
+	// Print the result
+	std::cout << "\nTime: " << observablesStep1D.time << std::endl;
+	std::cout << "Helium content = " << totalHeConcentration << std::endl;
+	std::cout << "Deuterium content = " << totalDConcentration << std::endl;
+	std::cout << "Tritium content = " << totalTConcentration << std::endl;
+	std::cout << "Vacancy content = " << totalVConcentration << std::endl;
+	std::cout << "Interstitial content = " << totalIConcentration << std::endl;
+	std::cout << "Fluence = " << fluence << "\n" << std::endl;
+
+	// Uncomment to write the retention and the fluence in a file
+	observablesSink->addRecord("retentionOut.txt", { fluence,
+			totalHeConcentration, totalDConcentration, totalTConcentration,
+			totalVConcentration, totalIConcentration, nHelium1D, nDeuterium1D,
+			nTritium1D, nVacancy1D, nIBulk1D });
+
+	return;
+}
 
-		// Check we are on the right proc
-		if (xi >= xs && xi < xs + xm) {
-			// Get the delta time from the previous timestep to this timestep
-			double dt = time - previousTime;
-			// Compute the total number of impurities that went in the bulk
-			nHelium1D += previousHeFlux1D * dt;
-			nDeuterium1D += previousDFlux1D * dt;
-			nTritium1D += previousTFlux1D * dt;
-			nVacancy1D += previousVFlux1D * dt;
-			nIBulk1D += previousIBulkFlux1D * dt;
+/**
+ * Add the contribution of a grid point to the xenon retention.
+ *
+ * @param xi The grid point
+ * @param concs The solution at the grid point
+ * @param localValues The xenon concentration, bubble concentration, radii,
+ * partial bubble concentration and partial radii of this process
+ */
+void accumulateXenonRetention1D(int xi, const double *concs,
+		double *localValues) {
+	// Get the solver handler
+	auto& solverHandler = PetscSolver::getSolverHandler();
+	auto& network = solverHandler.getNetwork();
+	auto& grid = observablesStep1D.grid;
 
-			// Get the pointer to the beginning of the solution data for this grid point
-			gridPointSolution = solutionArray[xi];
+	// Get the minimum size for the radius
+	auto minSizes = solverHandler.getMinSizes();
 
-			// Factor for finite difference
-			double hxLeft = 0.0, hxRight = 0.0;
-			if (xi - 1 >= 0 && xi < Mx) {
-				hxLeft = (grid[xi + 1] - grid[xi - 1]) / 2.0;
-				hxRight = (grid[xi + 2] - grid[xi]) / 2.0;
-			} else if (xi - 1 < 0) {
-				hxLeft = grid[xi + 1] - grid[xi];
-				hxRight = (grid[xi + 2] - grid[xi]) / 2.0;
-			} else {
-				hxLeft = (grid[xi + 1] - grid[xi - 1]) / 2.0;
-				hxRight = grid[xi + 1] - grid[xi];
-			}
-			double factor = 2.0 / (hxRight * (hxLeft + hxRight));
+	double hx = grid[xi + 1] - grid[xi];
 
-			// Initialize the value for the flux
-			double newFlux = 0.0;
-			// Consider each helium cluster.
-			for (auto const& heMapItem : network.getAll(ReactantType::He)) {
-				// Get the cluster
-				auto const& cluster = *(heMapItem.second);
-				// Get its id and concentration
-				int id = cluster.getId() - 1;
-				double conc = gridPointSolution[id];
-				// Get its size and diffusion coefficient
-				int size = cluster.getSize();
-				double coef = cluster.getDiffusionCoefficient(xi - xs);
-				// Compute the flux going to the right
-				newFlux += (double) size * factor * coef * conc * hxRight;
-			}
-			// Update the helium flux
-			previousHeFlux1D = newFlux;
+	// Loop on all the indices
+	for (unsigned int i = 0; i < indices1D.size(); i++) {
+		// Add the current concentration times the number of xenon in the cluster
+		// (from the weight vector)
+		double conc = concs[indices1D[i]];
+		localValues[0] += conc * weights1D[i] * hx;
+		localValues[1] += conc * hx;
+		localValues[2] += conc * radii1D[i] * hx;
+		if (weights1D[i] >= minSizes[0] && conc > 1.0e-16) {
+			localValues[3] += conc * hx;
+			localValues[4] += conc * radii1D[i] * hx;
+		}
+	}
 
-			// Initialize the value for the flux
-			newFlux = 0.0;
-			// Consider each deuterium cluster.
-			for (auto const& dMapItem : network.getAll(ReactantType::D)) {
-				// Get the cluster
-				auto const& cluster = *(dMapItem.second);
-				// Get its id and concentration
-				int id = cluster.getId() - 1;
-				double conc = gridPointSolution[id];
-				// Get its size and diffusion coefficient
-				int size = cluster.getSize();
-				double coef = cluster.getDiffusionCoefficient(xi - xs);
-				// Compute the flux going to the right
-				newFlux += (double) size * factor * coef * conc * hxRight;
-			}
-			// Update the deuterium flux
-			previousDFlux1D = newFlux;
+	// Loop on all the super clusters
+	for (auto const& superMapItem : network.getAll(ReactantType::NESuper)) {
+		auto const& cluster =
+				static_cast<NESuperCluster&>(*(superMapItem.second));
+		double conc = cluster.getTotalConcentration();
+		localValues[0] += cluster.getTotalXenonConcentration() * hx;
+		localValues[1] += conc * hx;
+		localValues[2] += conc * cluster.getReactionRadius() * hx;
+		if (cluster.getSize() >= minSizes[0] && conc > 1.0e-16) {
+			localValues[3] += conc * hx;
+			localValues[4] += conc * cluster.getReactionRadius() * hx;
+		}
+	}
 
-			// Initialize the value for the flux
-			newFlux = 0.0;
-			// Consider each tritium cluster.
-			for (auto const& tMapItem : network.getAll(ReactantType::T)) {
-				// Get the cluster
-				auto const& cluster = *(tMapItem.second);
-				// Get its id and concentration
-				int id = cluster.getId() - 1;
-				double conc = gridPointSolution[id];
-				// Get its size and diffusion coefficient
-				int size = cluster.getSize();
-				double coef = cluster.getDiffusionCoefficient(xi - xs);
-				// Compute the flux going to the right
-				newFlux += (double) size * factor * coef * conc * hxRight;
-			}
-			// Update the tritium flux
-			previousTFlux1D = newFlux;
+	return;
+}
 
-			// Initialize the value for the flux
-			newFlux = 0.0;
-			// Consider each vacancy cluster.
-			for (auto const& vMapItem : network.getAll(ReactantType::V)) {
-				// Get the cluster
-				auto const& cluster = *(vMapItem.second);
-				// Get it diffusion coefficient
-				double coef = cluster.getDiffusionCoefficient(xi - xs);
-				if (coef <= 0.0)
-					continue;
-				// Get its id and concentration
-				int id = cluster.getId() - 1;
-				double conc = gridPointSolution[id];
-				// Get its size
-				int size = cluster.getSize();
-				// Compute the flux going to the right
-				newFlux += (double) size * factor * coef * conc * hxRight;
-			}
-			// Update the tritium flux
-			previousVFlux1D = newFlux;
+/**
+ * Write the xenon retention.
+ *
+ * @param totalConcData The sums over all the processes
+ */
+void finalizeXenonRetention1D(const double *totalConcData) {
+	// Master process
+	if (observablesStep1D.procId != 0)
+		return;
 
-			// Initialize the value for the flux
-			newFlux = 0.0;
-			// Consider each int cluster.
-			for (auto const& iMapItem : network.getAll(ReactantType::I)) {
-				// Get the cluster
-				auto const& cluster = *(iMapItem.second);
-				// Get its id and concentration
-				int id = cluster.getId() - 1;
-				double conc = gridPointSolution[id];
-				// Get its size and diffusion coefficient
-				int size = cluster.getSize();
-				double coef = cluster.getDiffusionCoefficient(xi - xs);
-				// Compute the flux going to the right
-				newFlux += (double) size * factor * coef * conc * hxRight;
-			}
-			// Update the tritium flux
-			previousIBulkFlux1D = newFlux;
+	// Get the solver handler
+	auto& solverHandler = PetscSolver::getSolverHandler();
+	auto& network = solverHandler.getNetwork();
+	auto minSizes = solverHandler.getMinSizes();
 
-			// Set the bottom processor
-			bottomProc = procId;
-		}
+	// Print the result
+	std::cout << "\nTime: " << observablesStep1D.time << std::endl;
+	std::cout << "Xenon concentration = " << totalConcData[0] << std::endl
+			<< std::endl;
+
+	// Make sure the average partial radius makes sense
+	double averagePartialRadius = totalConcData[4] / totalConcData[3];
+	double minRadius = pow(
+			(3.0 * (double) minSizes[0])
+					/ (4.0 * xolotlCore::pi * network.getDensity()),
+			(1.0 / 3.0));
+	if (totalConcData[4] < 1.e-16 || averagePartialRadius < minRadius)
+		averagePartialRadius = minRadius;
+
+	// Uncomment to write the retention and the fluence in a file
+	observablesSink->addRecord("retentionOut.txt", { observablesStep1D.time,
+			totalConcData[0], totalConcData[2] / totalConcData[1],
+			averagePartialRadius });
+
+	return;
+}
 
-		// Get which processor will send the information
-		// TODO do we need to do this allreduce just to figure out
-		// who owns the data?
-		// And is it supposed to be a sum?   Why not a min?
-		int bottomId = 0;
-		MPI_Allreduce(&bottomProc, &bottomId, 1, MPI_INT, MPI_SUM,
-				PETSC_COMM_WORLD);
+/**
+ * Keep the TRIDYN data of a grid point.
+ *
+ * @param xi The grid point
+ * @param concs The solution at the grid point
+ */
+void accumulateTRIDYN1D(int xi, const double *concs, double *) {
+	if (xi < observablesStep1D.tridynFirstIdx)
+		return;
 
-		// Send the information about impurities
-		// to the other processes
-		std::array<double, 10> countFluxData { nHelium1D, previousHeFlux1D,
-				nDeuterium1D, previousDFlux1D, nTritium1D, previousTFlux1D,
-				nVacancy1D, previousVFlux1D, nIBulk1D, previousIBulkFlux1D };
-		MPI_Bcast(countFluxData.data(), countFluxData.size(), MPI_DOUBLE,
-				bottomId, PETSC_COMM_WORLD);
-
-		// Extract inpurity data from broadcast buffer.
-		nHelium1D = countFluxData[0];
-		previousHeFlux1D = countFluxData[1];
-		nDeuterium1D = countFluxData[2];
-		previousDFlux1D = countFluxData[3];
-		nTritium1D = countFluxData[4];
-		previousTFlux1D = countFluxData[5];
-		nVacancy1D = countFluxData[6];
-		previousVFlux1D = countFluxData[7];
-		nIBulk1D = countFluxData[8];
-		previousIBulkFlux1D = countFluxData[9];
-	}
+	auto& grid = observablesStep1D.grid;
+	int surfacePos = observablesStep1D.surfacePos;
+	int dof = PetscSolver::getSolverHandler().getNetwork().getDOF();
 
-	// Master process
-	if (procId == 0) {
-		// Get the fluence
-		double fluence = fluxHandler->getFluence();
-
-		// Print the result
-		std::cout << "\nTime: " << time << std::endl;
-		std::cout << "Helium content = " << totalHeConcentration << std::endl;
-		std::cout << "Deuterium content = " << totalDConcentration << std::endl;
-		std::cout << "Tritium content = " << totalTConcentration << std::endl;
-		std::cout << "Vacancy content = " << totalVConcentration << std::endl;
-		std::cout << "Interstitial content = " << totalIConcentration
-				<< std::endl;
-		std::cout << "Fluence = " << fluence << "\n" << std::endl;
-
-		// Uncomment to write the retention and the fluence in a file
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt", ios::app);
-		outputFile << fluence << " " << totalHeConcentration << " "
-				<< totalDConcentration << " " << totalTConcentration << " "
-				<< totalVConcentration << " " << totalIConcentration << " "
-				<< nHelium1D << " " << nDeuterium1D << " " << nTritium1D << " "
-				<< nVacancy1D << " " << nIBulk1D << std::endl;
-		outputFile.close();
-	}
+	// Determine current gridpoint value.
+	double x = (grid[xi] + grid[xi + 1]) / 2.0 - grid[1];
 
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
+	// Get the total concentrations at this grid point
+	auto& values = tridynConcs1D[xi - observablesStep1D.tridynMyFirstIdx];
+	values[0] = (x - (grid[surfacePos + 1] - grid[1]));
+	std::copy(pointTotals1D.begin(), pointTotals1D.end(), values.begin() + 1);
+	values[6] = concs[dof - 1];
 
-	PetscFunctionReturn(0);
+	return;
 }
 
 #undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "computeXenonRetention1D")
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "computeObservables1D")
 /**
- * This is a monitoring method that will compute the xenon retention
+ * This is a monitoring method that will compute the helium desorption, the
+ * helium or xenon retention and the TRIDYN data in a single sweep over the
+ * grid, with a single reduction.
  */
-PetscErrorCode computeXenonRetention1D(TS ts, PetscInt, PetscReal time,
+PetscErrorCode computeObservables1D(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *) {
 
-	xperf::ScopedTimer myTimer(xeRetentionTimer);
+	xperf::ScopedTimer myTimer(observablesTimer);
 
 	// Initial declarations
 	PetscErrorCode ierr;
@@ -871,102 +939,55 @@ PetscErrorCode computeXenonRetention1D(TS ts, PetscInt, PetscReal time,
 	PETSC_IGNORE);
 	CHKERRQ(ierr);
 
-	// Get the physical grid
-	auto grid = solverHandler.getXGrid();
+	// Set the data of this time step used by the observables
+	MPI_Comm_rank(PETSC_COMM_WORLD, &observablesStep1D.procId);
+	observablesStep1D.xs = xs;
+	observablesStep1D.Mx = Mx;
+	observablesStep1D.surfacePos = solverHandler.getSurfacePosition();
+	observablesStep1D.time = time;
+	observablesStep1D.grid = solverHandler.getXGrid();
 
-	// Get the network
-	auto& network = solverHandler.getNetwork();
+	// Specify the TRIDYN concentrations we will write.
+	// We only consider our own grid points.
+	if (observablesStep1D.tridyn) {
+		observablesStep1D.tridynFirstIdx = observablesStep1D.surfacePos
+				+ solverHandler.getLeftOffset();
+		observablesStep1D.tridynMyFirstIdx = std::max(xs,
+				observablesStep1D.tridynFirstIdx);
+		auto myEndIdx = (xs + xm);
+		tridynConcs1D.resize(
+				(myEndIdx > observablesStep1D.tridynMyFirstIdx) ?
+						(myEndIdx - observablesStep1D.tridynMyFirstIdx) : 0);
+	}
 
 	// Get the array of concentration
 	PetscReal **solutionArray;
 	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
-	// Store the concentration and other values over the grid
-	double xeConcentration = 0.0, bubbleConcentration = 0.0, radii = 0.0,
-			partialBubbleConcentration = 0.0, partialRadii = 0.0;
-
-	// Declare the pointer for the concentrations at a specific grid point
-	PetscReal *gridPointSolution;
-
-	// Get the minimum size for the radius
-	auto minSizes = solverHandler.getMinSizes();
-
-	// Loop on the grid
-	for (PetscInt xi = xs; xi < xs + xm; xi++) {
-
-		// Get the pointer to the beginning of the solution data for this grid point
-		gridPointSolution = solutionArray[xi];
-
-		// Update the concentration in the network
-		network.updateConcentrationsFromArray(gridPointSolution);
-
-		double hx = grid[xi + 1] - grid[xi];
-
-		// Loop on all the indices
-		for (unsigned int i = 0; i < indices1D.size(); i++) {
-			// Add the current concentration times the number of xenon in the cluster
-			// (from the weight vector)
-			double conc = gridPointSolution[indices1D[i]];
-			xeConcentration += conc * weights1D[i] * hx;
-			bubbleConcentration += conc * hx;
-			radii += conc * radii1D[i] * hx;
-			if (weights1D[i] >= minSizes[0] && conc > 1.0e-16) {
-				partialBubbleConcentration += conc * hx;
-				partialRadii += conc * radii1D[i] * hx;
-			}
-		}
-
-		// Loop on all the super clusters
-		for (auto const& superMapItem : network.getAll(ReactantType::NESuper)) {
-			auto const& cluster =
-					static_cast<NESuperCluster&>(*(superMapItem.second));
-			double conc = cluster.getTotalConcentration();
-			xeConcentration += cluster.getTotalXenonConcentration() * hx;
-			bubbleConcentration += conc * hx;
-			radii += conc * cluster.getReactionRadius() * hx;
-			if (cluster.getSize() >= minSizes[0] && conc > 1.0e-16) {
-				partialBubbleConcentration += conc * hx;
-				partialRadii += conc * cluster.getReactionRadius() * hx;
-			}
-		}
+	// Sweep over the grid and start the reduction
+	observables1D.start(PETSC_COMM_WORLD, xs, xm, solutionArray);
+
+	// Write the TRIDYN file while the reduction is in flight
+	if (observablesStep1D.tridyn) {
+		xperf::ScopedTimer tridynTimerGuard(tridynTimer);
+		int firstIdx = observablesStep1D.tridynFirstIdx;
+		int myFirstIdx = observablesStep1D.tridynMyFirstIdx;
+		if (checkpointWriter) {
+			// Go through the checkpoint writer, no HDF5 write may run with
+			// the one of a checkpoint
+			auto myConcs = std::make_shared<TRIDYNConcs1DType>(tridynConcs1D);
+			checkpointWriter->submit([=](MPI_Comm comm) {
+				writeTRIDYN1D(comm, timestep, Mx, firstIdx, myFirstIdx,
+						*myConcs);
+			});
+		} else
+			writeTRIDYN1D(PETSC_COMM_WORLD, timestep, Mx, firstIdx, myFirstIdx,
+					tridynConcs1D);
 	}
 
-	// Get the current process ID
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
-
-	// Sum all the concentrations through MPI reduce
-	std::array<double, 5> myConcData { xeConcentration, bubbleConcentration,
-			radii, partialBubbleConcentration, partialRadii };
-	std::array<double, 5> totalConcData { 0.0, 0.0, 0.0, 0.0, 0.0 };
-	MPI_Reduce(myConcData.data(), totalConcData.data(), myConcData.size(),
-	MPI_DOUBLE, MPI_SUM, 0, PETSC_COMM_WORLD);
-
-	// Master process
-	if (procId == 0) {
-		// Print the result
-		std::cout << "\nTime: " << time << std::endl;
-		std::cout << "Xenon concentration = " << totalConcData[0] << std::endl
-				<< std::endl;
-
-		// Make sure the average partial radius makes sense
-		double averagePartialRadius = totalConcData[4] / totalConcData[3];
-		double minRadius = pow(
-				(3.0 * (double) minSizes[0])
-						/ (4.0 * xolotlCore::pi * network.getDensity()),
-				(1.0 / 3.0));
-		if (totalConcData[4] < 1.e-16 || averagePartialRadius < minRadius)
-			averagePartialRadius = minRadius;
-
-		// Uncomment to write the retention and the fluence in a file
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt", ios::app);
-		outputFile << time << " " << totalConcData[0] << " "
-				<< totalConcData[2] / totalConcData[1] << " "
-				<< averagePartialRadius << std::endl;
-		outputFile.close();
-	}
+	// Complete the reduction and write the observables
+	observables1D.finish();
 
 	// Restore the solutionArray
 	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
@@ -1034,11 +1055,10 @@ PetscErrorCode profileTemperature1D(TS ts, PetscInt timestep, PetscReal time,
 	// Declare the pointer for the concentrations at a specific grid point
 	PetscReal *gridPointSolution;
 
-	// Create the output file
-	std::ofstream outputFile;
+	// Create the output record
+	std::vector<double> record;
 	if (procId == 0) {
-		outputFile.open("tempProf.txt", ios::app);
-		outputFile << time;
+		record.push_back(time);
 	}
 
 	// Loop on the entire grid
@@ -1064,14 +1084,13 @@ PetscErrorCode profileTemperature1D(TS ts, PetscInt timestep, PetscReal time,
 
 		// The master process writes in the file
 		if (procId == 0) {
-			outputFile << " " << temperature;
+			record.push_back(temperature);
 		}
 	}
 
-	// Close the file
+	// Write the record
 	if (procId == 0) {
-		outputFile << std::endl;
-		outputFile.close();
+		observablesSink->addRecord("tempProf.txt", record);
 	}
 
 	// Restore the solutionArray
@@ -1396,28 +1415,16 @@ PetscErrorCode computeAlloy1D(TS ts, PetscInt timestep, PetscReal time,
 		// Set the output precision
 		const int outputPrecision = 5;
 
-		// Open the output file
-		std::fstream outputFile;
-		outputFile.open("Alloy.dat", std::fstream::out | std::fstream::app);
-		outputFile << std::setprecision(outputPrecision);
-
 		// Output the data
-		outputFile << timestep << " " << time << " " << iTotalDensity << " "
-				<< iTotalDiameter << " " << vTotalDensity << " "
-				<< vTotalDiameter << " " << voidTotalDensity << " "
-				<< voidTotalDiameter << " " << faultedTotalDensity << " "
-				<< faultedTotalDiameter << " " << perfectTotalDensity << " "
-				<< perfectTotalDiameter << " " << frankTotalDensity << " "
-				<< frankTotalDiameter << " " << voidPartialTotalDensity << " "
-				<< voidPartialTotalDiameter << " " << faultedPartialTotalDensity
-				<< " " << faultedPartialTotalDiameter << " "
-				<< perfectPartialTotalDensity << " "
-				<< perfectPartialTotalDiameter << " "
-				<< frankPartialTotalDensity << " " << frankPartialTotalDiameter
-				<< std::endl;
-
-		// Close the output file
-		outputFile.close();
+		observablesSink->addRecord("Alloy.dat", { (double) timestep, time,
+				iTotalDensity, iTotalDiameter, vTotalDensity, vTotalDiameter,
+				voidTotalDensity, voidTotalDiameter, faultedTotalDensity,
+				faultedTotalDiameter, perfectTotalDensity, perfectTotalDiameter,
+				frankTotalDensity, frankTotalDiameter, voidPartialTotalDensity,
+				voidPartialTotalDiameter, faultedPartialTotalDensity,
+				faultedPartialTotalDiameter, perfectPartialTotalDensity,
+				perfectPartialTotalDiameter, frankPartialTotalDensity,
+				frankPartialTotalDiameter }, outputPrecision, 1);
 	}
 
 	// Restore the PETSC solution array
@@ -2061,11 +2068,8 @@ PetscErrorCode eventFunction1D(TS ts, PetscReal time, Vec solution,
 	if (solverHandler.moveSurface()) {
 		// Write the initial surface position
 		if (procId == 0 && xolotlCore::equal(time, 0.0)) {
-			std::ofstream outputFile;
-			outputFile.open("surface.txt", ios::app);
-			outputFile << time << " " << grid[surfacePos + 1] - grid[1]
-					<< std::endl;
-			outputFile.close();
+			observablesSink->addRecord("surface.txt",
+					{ time, grid[surfacePos + 1] - grid[1] });
 		}
 
 		// Value to know on which processor is the location of the surface,
@@ -2305,10 +2309,7 @@ PetscErrorCode postEventFunction1D(TS ts, PetscInt nevents,
 				+ grid[depthPositions1D[i] + 1]) / 2.0 - grid[surfacePos + 1];
 
 		// Write the bursting information
-		std::ofstream outputFile;
-		outputFile.open("bursting.txt", ios::app);
-		outputFile << time << " " << distance << std::endl;
-		outputFile.close();
+		observablesSink->addRecord("bursting.txt", { time, distance });
 
 		// Pinhole case
 		// Consider each He to reset their concentration at this grid point
@@ -2541,11 +2542,8 @@ PetscErrorCode postEventFunction1D(TS ts, PetscInt nevents,
 
 	// Write the updated surface position
 	if (procId == 0) {
-		std::ofstream outputFile;
-		outputFile.open("surface.txt", ios::app);
-		outputFile << time << " " << grid[surfacePos + 1] - grid[1]
-				<< std::endl;
-		outputFile.close();
+		observablesSink->addRecord("surface.txt",
+				{ time, grid[surfacePos + 1] - grid[1] });
 	}
 
 	// Restore the solutionArray
@@ -2572,8 +2570,7 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 	checkNegativeTimer = handlerRegistry->getTimer("monitor1D:checkNeg");
 	tridynTimer = handlerRegistry->getTimer("monitor1D:tridyn");
 	startStopTimer = handlerRegistry->getTimer("monitor1D:startStop");
-	heRetentionTimer = handlerRegistry->getTimer("monitor1D:heRet");
-	xeRetentionTimer = handlerRegistry->getTimer("monitor1D:xeRet");
+	observablesTimer = handlerRegistry->getTimer("monitor1D:observables");
 	scatterTimer = handlerRegistry->getTimer("monitor1D:scatter");
 	seriesTimer = handlerRegistry->getTimer("monitor1D:series");
 	surfaceTimer = handlerRegistry->getTimer("monitor1D:surface");
@@ -2660,6 +2657,9 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 	checkPetscError(ierr,
 			"setupPetsc1DMonitor: PetscOptionsHasName (-temp_profile) failed.");
 
+	// Create the sink of the observable files
+	initializeObservablesSink();
+
 	// Get the solver handler
 	auto& solverHandler = PetscSolver::getSolverHandler();
 
@@ -2728,6 +2728,39 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 		if (!flag)
 			hdf5Stride1D = 1.0;
 
+		// Check the option -start_stop_async
+		PetscBool flagAsync;
+		ierr = PetscOptionsHasName(NULL, NULL, "-start_stop_async", &flagAsync);
+		checkPetscError(ierr,
+				"setupPetsc1DMonitor: PetscOptionsHasName (-start_stop_async) failed.");
+
+		// Check the option -start_stop_compress, its optional value is the
+		// relative tolerance on the concentrations
+		ierr = PetscOptionsHasName(NULL, NULL, "-start_stop_compress",
+				&hdf5Compress1D);
+		checkPetscError(ierr,
+				"setupPetsc1DMonitor: PetscOptionsHasName (-start_stop_compress) failed.");
+		ierr = PetscOptionsGetReal(NULL, NULL, "-start_stop_compress",
+				&hdf5Tolerance1D, &flag);
+		checkPetscError(ierr,
+				"setupPetsc1DMonitor: PetscOptionsGetReal (-start_stop_compress) failed.");
+
+		// Check the option -start_stop_incremental, its value is the number
+		// of snapshots between the full ones
+		ierr = PetscOptionsGetInt(NULL, NULL, "-start_stop_incremental",
+				&hdf5BaseStride1D, &flag);
+		checkPetscError(ierr,
+				"setupPetsc1DMonitor: PetscOptionsGetInt (-start_stop_incremental) failed.");
+		ierr = PetscOptionsGetReal(NULL, NULL, "-start_stop_incremental_tol",
+				&hdf5IncrementalTol1D, &flag);
+		checkPetscError(ierr,
+				"setupPetsc1DMonitor: PetscOptionsGetReal (-start_stop_incremental_tol) failed.");
+
+		// Create the writer of the checkpoints
+		checkpointWriter.reset(
+				new CheckpointWriter(PETSC_COMM_WORLD, flagAsync,
+						handlerRegistry));
+
 		// Compute the correct hdf5Previous1D for a restart
 		// Get the last time step written in the HDF5 file
 		if (hasConcentrations) {
@@ -2817,9 +2850,7 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 			// Master process
 			if (procId == 0) {
 				// Clear the file where the surface will be written
-				std::ofstream outputFile;
-				outputFile.open("surface.txt");
-				outputFile.close();
+				observablesSink->create("surface.txt");
 			}
 		}
 
@@ -2844,9 +2875,7 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 		// Master process
 		if (procId == 0) {
 			// Uncomment to clear the file where the bursting info will be written
-			std::ofstream outputFile;
-			outputFile.open("bursting.txt");
-			outputFile.close();
+			observablesSink->create("bursting.txt");
 		}
 	}
 
@@ -3019,17 +3048,14 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 
 	// Set the monitor to compute the helium desorption
 	if (flagHeDesorption) {
-		// computeHeliumDesorption1D will be called at each timestep
-		ierr = TSMonitorSet(ts, computeHeliumDesorption1D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc1DMonitor: TSMonitorSet (computeHeliumDesorption1D) failed.");
+		// The helium desorption will be computed at each timestep
+		observables1D.add(1, false, accumulateHeliumDesorption1D,
+				finalizeHeliumDesorption1D);
 
 		// Master process
 		if (procId == 0) {
 			// Uncomment to clear the file where the desorption
-			std::ofstream outputFile;
-			outputFile.open("thds.txt");
-			outputFile.close();
+			observablesSink->create("thds.txt");
 		}
 	}
 
@@ -3076,17 +3102,15 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 		checkPetscError(ierr,
 				"setupPetsc1DMonitor: TSMonitorSet (computeFluence) failed.");
 
-		// computeHeliumRetention1D will be called at each timestep
-		ierr = TSMonitorSet(ts, computeHeliumRetention1D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc1DMonitor: TSMonitorSet (computeHeliumRetention1D) failed.");
+		// The helium retention will be computed at each timestep
+		observables1D.add(15, true, accumulateHeliumRetention1D,
+				finalizeHeliumRetention1D);
+		observablesStep1D.pointTotals = true;
 
 		// Master process
 		if (procId == 0) {
 			// Uncomment to clear the file where the retention will be written
-			std::ofstream outputFile;
-			outputFile.open("retentionOut.txt");
-			outputFile.close();
+			observablesSink->create("retentionOut.txt");
 		}
 	}
 
@@ -3128,35 +3152,51 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 		checkPetscError(ierr,
 				"setupPetsc1DMonitor: TSMonitorSet (computeFluence) failed.");
 
-		// computeXenonRetention1D will be called at each timestep
-		ierr = TSMonitorSet(ts, computeXenonRetention1D, NULL, NULL);
-		checkPetscError(ierr,
-				"setupPetsc1DMonitor: TSMonitorSet (computeXenonRetention1D) failed.");
+		// The xenon retention will be computed at each timestep
+		observables1D.add(5, true, accumulateXenonRetention1D,
+				finalizeXenonRetention1D);
+		observablesStep1D.networkUpdate = true;
 
 		// Master process
 		if (procId == 0) {
 			// Uncomment to clear the file where the retention will be written
-			std::ofstream outputFile;
-			outputFile.open("retentionOut.txt");
-			outputFile.close();
+			observablesSink->create("retentionOut.txt");
 		}
 	}
 
 	// Set the monitor to output data for TRIDYN
 	if (flagTRIDYN) {
-		// computeTRIDYN1D will be called at each timestep
-		ierr = TSMonitorSet(ts, computeTRIDYN1D, NULL, NULL);
+		// The TRIDYN data will be computed at each timestep
+		observables1D.add(0, true, accumulateTRIDYN1D,
+				[](const double *) {});
+		observablesStep1D.pointTotals = true;
+		observablesStep1D.tridyn = true;
+	}
+
+	// Set the monitor computing all the observables above in a single sweep
+	if (!observables1D.empty()) {
+		// Update the network and compute the totals once per grid point
+		// for all the observables
+		observables1D.setPointUpdate([](int, const double *concs) {
+			auto& network = PetscSolver::getSolverHandler().getNetwork();
+			if (observablesStep1D.networkUpdate)
+				network.updateConcentrationsFromArray(
+						const_cast<double *>(concs));
+			if (observablesStep1D.pointTotals)
+				computePointTotals1D(network, concs, pointTotals1D);
+		});
+
+		// computeObservables1D will be called at each timestep
+		ierr = TSMonitorSet(ts, computeObservables1D, NULL, NULL);
 		checkPetscError(ierr,
-				"setupPetsc1DMonitor: TSMonitorSet (computeTRIDYN1D) failed.");
+				"setupPetsc1DMonitor: TSMonitorSet (computeObservables1D) failed.");
 	}
 
 	// Set the monitor to output data for Alloy
 	if (flagAlloy) {
 		if (procId == 0) {
 			// Create/open the output files
-			std::fstream outputFile;
-			outputFile.open("Alloy.dat", std::fstream::out);
-			outputFile.close();
+			observablesSink->create("Alloy.dat");
 		}
 
 		// computeAlloy1D will be called at each timestep
@@ -3170,8 +3210,8 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 
 		if (procId == 0) {
 			// Uncomment to clear the file where the retention will be written
-			std::ofstream outputFile;
-			outputFile.open("tempProf.txt");
+			observablesSink->create("tempProf.txt");
+			std::vector<double> record;
 
 			// Get the da from ts
 			DM da;
@@ -3196,11 +3236,9 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 					xi < Mx - solverHandler.getRightOffset(); xi++) {
 				// Set x
 				double x = (grid[xi] + grid[xi + 1]) / 2.0 - grid[1];
-				outputFile << x << " ";
-
+				record.push_back(x);
 			}
-			outputFile << std::endl;
-			outputFile.close();
+			observablesSink->addRecord("tempProf.txt", record, 6, 0, true);
 		}
 
 		// computeCumulativeHelium1D will be called at each timestep
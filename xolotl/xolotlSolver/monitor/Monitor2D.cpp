@@ -14,6 +14,7 @@
 #include <iostream>
 #include <iomanip>
 #include <vector>
+#include <array>
 #include <memory>
 #include <PSISuperCluster.h>
 #include <NESuperCluster.h>
@@ -21,6 +22,8 @@
 #include "RandomNumberGenerator.h"
 #include "xolotlCore/io/XFile.h"
 #include "xolotlSolver/monitor/Monitor.h"
+#include "xolotlSolver/monitor/CheckpointWriter.h"
+#include "xolotlSolver/monitor/ObservablesSink.h"
 
 namespace xolotlSolver {
 
@@ -37,6 +40,8 @@ extern PetscErrorCode monitorPerf(TS ts, PetscInt timestep, PetscReal time,
 extern std::shared_ptr<xolotlViz::IPlot> perfPlot;
 extern double previousTime;
 extern double timeStepThreshold;
+extern std::unique_ptr<CheckpointWriter> checkpointWriter;
+extern std::unique_ptr<ObservablesSink> observablesSink;
 
 //! How often HDF5 file is written
 PetscReal hdf5Stride2D = 0.0;
@@ -135,101 +140,119 @@ PetscErrorCode startStop2D(TS ts, PetscInt timestep, PetscReal time,
 	// Network size
 	const int dof = network.getDOF();
 
-	// Create an array for the concentration
-	double concArray[dof][2];
-
 	// Get the vector of positions of the surface
 	std::vector<int> surfaceIndices;
 	for (PetscInt i = 0; i < My; i++) {
 		surfaceIndices.push_back(solverHandler.getSurfacePosition(i));
 	}
 
-	// Open the existing checkpoint file.
-	xolotlCore::XFile checkpointFile(hdf5OutputName2D, PETSC_COMM_WORLD,
-			xolotlCore::XFile::AccessMode::OpenReadWrite);
-
 	// Get the current time step
 	double currentTimeStep;
 	ierr = TSGetTimeStep(ts, &currentTimeStep);
 	CHKERRQ(ierr);
 
-	// Add a concentration sub group
-	auto concGroup = checkpointFile.getGroup<
-			xolotlCore::XFile::ConcentrationGroup>();
-	assert(concGroup);
-	auto tsGroup = concGroup->addTimestepGroup(timestep, time, previousTime,
-			currentTimeStep);
-
-	if (solverHandler.moveSurface()) {
-		// Write the surface positions and the associated interstitial quantities
-		// in the concentration sub group
-		tsGroup->writeSurface2D(surfaceIndices, nInterstitial2D,
-				previousIFlux2D);
+	// Copy the concentrations of the grid points we own, the write can
+	// happen while the solver keeps going
+	auto concs = std::make_shared<
+			std::vector<std::vector<std::array<double, 2> > > >(xm * ym);
+	for (PetscInt j = ys; j < ys + ym; j++) {
+		for (PetscInt i = xs; i < xs + xm; i++) {
+			// Get the pointer to the beginning of the solution data for this grid point
+			gridPointSolution = solutionArray[j][i];
+			auto& gridPointConcs = (*concs)[(j - ys) * xm + (i - xs)];
+
+			// Loop on the concentrations
+			for (int l = 0; l < dof; l++) {
+				if (std::fabs(gridPointSolution[l]) > 1.0e-16) {
+					gridPointConcs.push_back( { (double) l,
+							gridPointSolution[l] });
+				}
+			}
+		}
 	}
 
-	// Write the bottom impurity information if the bottom is a free surface
-	if (solverHandler.getRightOffset() == 1)
-		tsGroup->writeBottom2D(nHelium2D, previousHeFlux2D, nDeuterium2D,
-				previousDFlux2D, nTritium2D, previousTFlux2D);
-
-	// Loop on the full grid
-	for (PetscInt j = 0; j < My; j++) {
-		for (PetscInt i = 0; i < Mx; i++) {
-			// Wait for all the processes
-			MPI_Barrier(PETSC_COMM_WORLD);
+	// Restore the solutionArray
+	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
+	CHKERRQ(ierr);
 
-			// Size of the concentration that will be stored
-			int concSize = -1;
-			// To save which proc has the information
-			int concId = 0;
-			// To know which process should write
-			bool write = false;
+	// Copy everything else that is written
+	bool moveSurface = solverHandler.moveSurface();
+	bool freeBottom = (solverHandler.getRightOffset() == 1);
+	double previousT = previousTime;
+	auto nInter = nInterstitial2D, previousIFlux = previousIFlux2D;
+	auto nHe = nHelium2D, previousHeFlux = previousHeFlux2D;
+	auto nD = nDeuterium2D, previousDFlux = previousDFlux2D;
+	auto nT = nTritium2D, previousTFlux = previousTFlux2D;
+	std::string fileName = hdf5OutputName2D;
+
+	// Write the checkpoint
+	checkpointWriter->submit([=](MPI_Comm comm) {
+		// Open the existing checkpoint file.
+		xolotlCore::XFile checkpointFile(fileName, comm,
+				xolotlCore::XFile::AccessMode::OpenReadWrite);
+
+		// Add a concentration sub group
+		auto concGroup = checkpointFile.getGroup<
+				xolotlCore::XFile::ConcentrationGroup>();
+		assert(concGroup);
+		auto tsGroup = concGroup->addTimestepGroup(timestep, time, previousT,
+				currentTimeStep);
+
+		if (moveSurface) {
+			// Write the surface positions and the associated interstitial quantities
+			// in the concentration sub group
+			tsGroup->writeSurface2D(surfaceIndices, nInter, previousIFlux);
+		}
 
-			// If it is the locally owned part of the grid
-			if (i >= xs && i < xs + xm && j >= ys && j < ys + ym) {
-				write = true;
-				// Get the pointer to the beginning of the solution data for this grid point
-				gridPointSolution = solutionArray[j][i];
+		// Write the bottom impurity information if the bottom is a free surface
+		if (freeBottom)
+			tsGroup->writeBottom2D(nHe, previousHeFlux, nD, previousDFlux, nT,
+					previousTFlux);
 
-				// Loop on the concentrations
-				for (int l = 0; l < dof; l++) {
-					if (std::fabs(gridPointSolution[l]) > 1.0e-16) {
-						// Increase concSize
-						concSize++;
-						// Fill the concArray
-						concArray[concSize][0] = (double) l;
-						concArray[concSize][1] = gridPointSolution[l];
-					}
+		// Loop on the full grid
+		for (PetscInt j = 0; j < My; j++) {
+			for (PetscInt i = 0; i < Mx; i++) {
+				// Wait for all the processes
+				MPI_Barrier(comm);
+
+				// Size of the concentration that will be stored
+				int concSize = -1;
+				// To save which proc has the information
+				int concId = 0;
+				// To know which process should write
+				bool write = false;
+				// The concentrations to write
+				double (*concArray)[2] = nullptr;
+
+				// If it is the locally owned part of the grid
+				if (i >= xs && i < xs + xm && j >= ys && j < ys + ym) {
+					write = true;
+					auto& gridPointConcs = (*concs)[(j - ys) * xm + (i - xs)];
+					concSize = gridPointConcs.size();
+					concArray = reinterpret_cast<double (*)[2]>(
+							gridPointConcs.data());
+
+					// Save the procId
+					concId = procId;
 				}
 
-				// Increase concSize one last time
-				concSize++;
-
-				// Save the procId
-				concId = procId;
-			}
-
-			// Get which processor will send the information
-			int concProc = 0;
-			MPI_Allreduce(&concId, &concProc, 1, MPI_INT, MPI_SUM,
-					PETSC_COMM_WORLD);
+				// Get which processor will send the information
+				int concProc = 0;
+				MPI_Allreduce(&concId, &concProc, 1, MPI_INT, MPI_SUM, comm);
 
-			// Broadcast the size
-			MPI_Bcast(&concSize, 1, MPI_INT, concProc, PETSC_COMM_WORLD);
+				// Broadcast the size
+				MPI_Bcast(&concSize, 1, MPI_INT, concProc, comm);
 
-			// Skip the grid point if the size is 0
-			if (concSize == 0)
-				continue;
+				// Skip the grid point if the size is 0
+				if (concSize == 0)
+					continue;
 
-			// All processes create the dataset and fill it
-			tsGroup->writeConcentrationDataset(concSize, concArray, write, i,
-					j);
+				// All processes create the dataset and fill it
+				tsGroup->writeConcentrationDataset(concSize, concArray, write,
+						i, j);
+			}
 		}
-	}
-
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
+	});
 
 	PetscFunctionReturn(0);
 }
@@ -281,6 +304,9 @@ PetscErrorCode computeHeliumRetention2D(TS ts, PetscInt, PetscReal time,
 	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
+	// The species of the totals
+	using TotalType = IReactionNetwork::TotalType;
+
 	// Store the concentration over the grid
 	double heConcentration = 0.0, dConcentration = 0.0, tConcentration = 0.0;
 
@@ -301,13 +327,13 @@ PetscErrorCode computeHeliumRetention2D(TS ts, PetscInt, PetscReal time,
 
 			double hx = grid[xi + 1] - grid[xi];
 
-			// Update the concentration in the network
-			network.updateConcentrationsFromArray(gridPointSolution);
-
 			// Get the total atom concentrations at this grid point
-			heConcentration += network.getTotalAtomConcentration(0) * hx * hy;
-			dConcentration += network.getTotalAtomConcentration(1) * hx * hy;
-			tConcentration += network.getTotalAtomConcentration(2) * hx * hy;
+			heConcentration += network.getTotal(TotalType::HeAtom,
+					gridPointSolution) * hx * hy;
+			dConcentration += network.getTotal(TotalType::DAtom,
+					gridPointSolution) * hx * hy;
+			tConcentration += network.getTotal(TotalType::TAtom,
+					gridPointSolution) * hx * hy;
 		}
 	}
 
@@ -486,13 +512,9 @@ PetscErrorCode computeHeliumRetention2D(TS ts, PetscInt, PetscReal time,
 		std::cout << "Fluence = " << fluence << "\n" << std::endl;
 
 		// Uncomment to write the retention and the fluence in a file
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt", ios::app);
-		outputFile << fluence << " " << totalHeConcentration << " "
-				<< totalDConcentration << " " << totalTConcentration << " "
-				<< totalHeBulk << " " << totalDBulk << " " << totalTBulk
-				<< std::endl;
-		outputFile.close();
+		observablesSink->addRecord("retentionOut.txt", { fluence,
+				totalHeConcentration, totalDConcentration, totalTConcentration,
+				totalHeBulk, totalDBulk, totalTBulk });
 	}
 
 	// Restore the solutionArray
@@ -635,12 +657,9 @@ PetscErrorCode computeXenonRetention2D(TS ts, PetscInt timestep, PetscReal time,
 			averagePartialRadius = minRadius;
 
 		// Uncomment to write the retention and the fluence in a file
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt", ios::app);
-		outputFile << time << " " << totalConcData[0] << " "
-				<< totalConcData[2] / totalConcData[1] << " "
-				<< averagePartialRadius << std::endl;
-		outputFile.close();
+		observablesSink->addRecord("retentionOut.txt", { time,
+				totalConcData[0], totalConcData[2] / totalConcData[1],
+				averagePartialRadius });
 	}
 
 	// Restore the solutionArray
@@ -701,6 +720,9 @@ PetscErrorCode computeTRIDYN2D(TS ts, PetscInt timestep, PetscReal time,
 	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
+	// The species of the totals
+	using TotalType = IReactionNetwork::TotalType;
+
 	// Create the output file
 	std::ofstream outputFile;
 	if (procId == 0) {
@@ -732,15 +754,15 @@ PetscErrorCode computeTRIDYN2D(TS ts, PetscInt timestep, PetscReal time,
 				// Get the pointer to the beginning of the solution data for this grid point
 				gridPointSolution = solutionArray[yj][xi];
 
-				// Update the concentration in the network
-				network.updateConcentrationsFromArray(gridPointSolution);
-
 				// Get the total helium concentration at this grid point
-				heLocalConc += network.getTotalAtomConcentration(0);
-				dLocalConc += network.getTotalAtomConcentration(1);
-				tLocalConc += network.getTotalAtomConcentration(2);
-				vLocalConc += network.getTotalVConcentration();
-				iLocalConc += network.getTotalIConcentration();
+				heLocalConc += network.getTotal(TotalType::HeAtom,
+						gridPointSolution);
+				dLocalConc += network.getTotal(TotalType::DAtom,
+						gridPointSolution);
+				tLocalConc += network.getTotal(TotalType::TAtom,
+						gridPointSolution);
+				vLocalConc += network.getTotal(TotalType::V, gridPointSolution);
+				iLocalConc += network.getTotal(TotalType::I, gridPointSolution);
 			}
 		}
 
@@ -1002,18 +1024,15 @@ PetscErrorCode eventFunction2D(TS ts, PetscReal time, Vec solution,
 	if (solverHandler.moveSurface()) {
 		// Write the initial surface positions
 		if (procId == 0 && xolotlCore::equal(time, 0.0)) {
-			std::ofstream outputFile;
-			outputFile.open("surface.txt", ios::app);
-			outputFile << time << " ";
+			std::vector<double> record = { time };
 
 			// Loop on the possible yj
 			for (yj = 0; yj < My; yj++) {
 				// Get the position of the surface at yj
 				int surfacePos = solverHandler.getSurfacePosition(yj);
-				outputFile << grid[surfacePos + 1] - grid[1] << " ";
+				record.push_back(grid[surfacePos + 1] - grid[1]);
 			}
-			outputFile << std::endl;
-			outputFile.close();
+			observablesSink->addRecord("surface.txt", record, 6, 0, true);
 		}
 
 		// Get the initial vacancy concentration
@@ -1543,18 +1562,15 @@ PetscErrorCode postEventFunction2D(TS ts, PetscInt nevents,
 
 	// Write the surface positions
 	if (procId == 0) {
-		std::ofstream outputFile;
-		outputFile.open("surface.txt", ios::app);
-		outputFile << time << " ";
+		std::vector<double> record = { time };
 
 		// Loop on the possible yj
 		for (yj = 0; yj < My; yj++) {
 			// Get the position of the surface at yj
 			int surfacePos = solverHandler.getSurfacePosition(yj);
-			outputFile << grid[surfacePos + 1] - grid[1] << " ";
+			record.push_back(grid[surfacePos + 1] - grid[1]);
 		}
-		outputFile << std::endl;
-		outputFile.close();
+		observablesSink->addRecord("surface.txt", record, 6, 0, true);
 	}
 
 	// Restore the solutionArray
@@ -1567,6 +1583,8 @@ PetscErrorCode postEventFunction2D(TS ts, PetscInt nevents,
 /**
  * This operation sets up different monitors
  *  depending on the options.
+ * The incremental checkpoints (-start_stop_incremental) are not available
+ * in 2D, the option is rejected.
  * @param ts The time stepper
  * @return A standard PETSc error code
  */
@@ -1621,6 +1639,9 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 	checkPetscError(ierr,
 			"setupPetsc2DMonitor: PetscOptionsHasName (-tridyn) failed.");
 
+	// Create the sink of the observable files
+	initializeObservablesSink();
+
 	// Get the solver handler
 	auto& solverHandler = PetscSolver::getSolverHandler();
 
@@ -1685,6 +1706,30 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 		if (!flag)
 			hdf5Stride2D = 1.0;
 
+		// Check the option -start_stop_async
+		PetscBool flagAsync;
+		ierr = PetscOptionsHasName(NULL, NULL, "-start_stop_async", &flagAsync);
+		checkPetscError(ierr,
+				"setupPetsc2DMonitor: PetscOptionsHasName (-start_stop_async) failed.");
+
+		// The incremental checkpoints are only written in 0D and 1D, the
+		// 2D restart can't read them
+		PetscBool flagIncremental;
+		ierr = PetscOptionsHasName(NULL, NULL, "-start_stop_incremental",
+				&flagIncremental);
+		checkPetscError(ierr,
+				"setupPetsc2DMonitor: PetscOptionsHasName (-start_stop_incremental) failed.");
+		if (flagIncremental) {
+			throw std::string(
+					"\nxolotlSolver::Monitor2D: -start_stop_incremental is only "
+							"available in 0D and 1D.");
+		}
+
+		// Create the writer of the checkpoints
+		checkpointWriter.reset(
+				new CheckpointWriter(PETSC_COMM_WORLD, flagAsync,
+						xolotlPerf::getHandlerRegistry()));
+
 		if (hasConcentrations) {
 			// Get the previous time from the HDF5 file
 			previousTime = lastTsGroup->readPreviousTime();
@@ -1763,9 +1808,7 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 			// Master process
 			if (procId == 0) {
 				// Clear the file where the surface will be written
-				std::ofstream outputFile;
-				outputFile.open("surface.txt");
-				outputFile.close();
+				observablesSink->create("surface.txt");
 			}
 		}
 
@@ -1875,9 +1918,7 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 		// Master process
 		if (procId == 0) {
 			// Uncomment to clear the file where the retention will be written
-			std::ofstream outputFile;
-			outputFile.open("retentionOut.txt");
-			outputFile.close();
+			observablesSink->create("retentionOut.txt");
 		}
 	}
 
@@ -1927,9 +1968,7 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 		// Master process
 		if (procId == 0) {
 			// Uncomment to clear the file where the retention will be written
-			std::ofstream outputFile;
-			outputFile.open("retentionOut.txt");
-			outputFile.close();
+			observablesSink->create("retentionOut.txt");
 		}
 	}
 
@@ -14,6 +14,7 @@
 #include <iostream>
 #include <iomanip>
 #include <vector>
+#include <array>
 #include <memory>
 #include <PSISuperCluster.h>
 #include <NESuperCluster.h>
@@ -21,6 +22,8 @@
 #include "RandomNumberGenerator.h"
 #include "xolotlCore/io/XFile.h"
 #include "xolotlSolver/monitor/Monitor.h"
+#include "xolotlSolver/monitor/CheckpointWriter.h"
+#include "xolotlSolver/monitor/ObservablesSink.h"
 
 namespace xolotlSolver {
 
@@ -37,6 +40,8 @@ extern PetscErrorCode monitorPerf(TS ts, PetscInt timestep, PetscReal time,
 extern std::shared_ptr<xolotlViz::IPlot> perfPlot;
 extern double previousTime;
 extern double timeStepThreshold;
+extern std::unique_ptr<CheckpointWriter> checkpointWriter;
+extern std::unique_ptr<ObservablesSink> observablesSink;
 
 //! How often HDF5 file is written
 PetscReal hdf5Stride3D = 0.0;
@@ -125,9 +130,6 @@ PetscErrorCode startStop3D(TS ts, PetscInt timestep, PetscReal time,
 	// Network size
 	const int dof = network.getDOF();
 
-	// Create an array for the concentration
-	double concArray[dof][2];
-
 	// Get the vector of positions of the surface
 	std::vector<std::vector<int> > surfaceIndices;
 	for (PetscInt i = 0; i < My; i++) {
@@ -140,89 +142,112 @@ PetscErrorCode startStop3D(TS ts, PetscInt timestep, PetscReal time,
 		surfaceIndices.push_back(temp);
 	}
 
-	// Open the existing HDF5 file.
-	xolotlCore::XFile checkpointFile(hdf5OutputName3D, PETSC_COMM_WORLD,
-			xolotlCore::XFile::AccessMode::OpenReadWrite);
-
 	// Get the current time step
 	double currentTimeStep;
 	ierr = TSGetTimeStep(ts, &currentTimeStep);
 	CHKERRQ(ierr);
 
-	// Add a concentration sub group
-	auto concGroup = checkpointFile.getGroup<
-			xolotlCore::XFile::ConcentrationGroup>();
-	assert(concGroup);
-	auto tsGroup = concGroup->addTimestepGroup(timestep, time, previousTime,
-			currentTimeStep);
-
-	if (solverHandler.moveSurface()) {
-		// Write the surface positions in the concentration sub group
-		tsGroup->writeSurface3D(surfaceIndices, nInterstitial3D,
-				previousIFlux3D);
+	// Copy the concentrations of the grid points we own, the write can
+	// happen while the solver keeps going
+	auto concs = std::make_shared<
+			std::vector<std::vector<std::array<double, 2> > > >(xm * ym * zm);
+	for (PetscInt k = zs; k < zs + zm; k++) {
+		for (PetscInt j = ys; j < ys + ym; j++) {
+			for (PetscInt i = xs; i < xs + xm; i++) {
+				// Get the pointer to the beginning of the solution data for this grid point
+				gridPointSolution = solutionArray[k][j][i];
+				auto& gridPointConcs = (*concs)[((k - zs) * ym + (j - ys)) * xm
+						+ (i - xs)];
+
+				// Loop on the concentrations
+				for (int l = 0; l < dof; l++) {
+					if (std::fabs(gridPointSolution[l]) > 1.0e-16) {
+						gridPointConcs.push_back( { (double) l,
+								gridPointSolution[l] });
+					}
+				}
+			}
+		}
 	}
 
-	// Loop on the full grid
-	for (PetscInt k = 0; k < Mz; k++) {
-		for (PetscInt j = 0; j < My; j++) {
-			for (PetscInt i = 0; i < Mx; i++) {
-				// Wait for all the processes
-				MPI_Barrier(PETSC_COMM_WORLD);
-
-				// Size of the concentration that will be stored
-				int concSize = -1;
-				// To save which proc has the information
-				int concId = 0;
-				// To know which process should write
-				bool write = false;
-
-				// If it is the locally owned part of the grid
-				if (i >= xs && i < xs + xm && j >= ys && j < ys + ym && k >= zs
-						&& k < zs + zm) {
-					write = true;
-					// Get the pointer to the beginning of the solution data for this grid point
-					gridPointSolution = solutionArray[k][j][i];
+	// Restore the solutionArray
+	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
+	CHKERRQ(ierr);
 
-					// Loop on the concentrations
-					for (int l = 0; l < dof; l++) {
-						if (std::fabs(gridPointSolution[l]) > 1.0e-16) {
-							// Increase concSize
-							concSize++;
-							// Fill the concArray
-							concArray[concSize][0] = (double) l;
-							concArray[concSize][1] = gridPointSolution[l];
-						}
-					}
+	// Copy everything else that is written
+	bool moveSurface = solverHandler.moveSurface();
+	double previousT = previousTime;
+	auto nInter = nInterstitial3D;
+	auto previousIFlux = previousIFlux3D;
+	std::string fileName = hdf5OutputName3D;
+
+	// Write the checkpoint
+	checkpointWriter->submit([=](MPI_Comm comm) {
+		// Open the existing HDF5 file.
+		xolotlCore::XFile checkpointFile(fileName, comm,
+				xolotlCore::XFile::AccessMode::OpenReadWrite);
+
+		// Add a concentration sub group
+		auto concGroup = checkpointFile.getGroup<
+				xolotlCore::XFile::ConcentrationGroup>();
+		assert(concGroup);
+		auto tsGroup = concGroup->addTimestepGroup(timestep, time, previousT,
+				currentTimeStep);
 
-					// Increase concSize one last time
-					concSize++;
+		if (moveSurface) {
+			// Write the surface positions in the concentration sub group
+			tsGroup->writeSurface3D(surfaceIndices, nInter, previousIFlux);
+		}
 
-					// Save the procId
-					concId = procId;
-				}
+		// Loop on the full grid
+		for (PetscInt k = 0; k < Mz; k++) {
+			for (PetscInt j = 0; j < My; j++) {
+				for (PetscInt i = 0; i < Mx; i++) {
+					// Wait for all the processes
+					MPI_Barrier(comm);
+
+					// Size of the concentration that will be stored
+					int concSize = -1;
+					// To save which proc has the information
+					int concId = 0;
+					// To know which process should write
+					bool write = false;
+					// The concentrations to write
+					double (*concArray)[2] = nullptr;
+
+					// If it is the locally owned part of the grid
+					if (i >= xs && i < xs + xm && j >= ys && j < ys + ym
+							&& k >= zs && k < zs + zm) {
+						write = true;
+						auto& gridPointConcs = (*concs)[((k - zs) * ym
+								+ (j - ys)) * xm + (i - xs)];
+						concSize = gridPointConcs.size();
+						concArray = reinterpret_cast<double (*)[2]>(
+								gridPointConcs.data());
+
+						// Save the procId
+						concId = procId;
+					}
 
-				// Get which processor will send the information
-				int concProc = 0;
-				MPI_Allreduce(&concId, &concProc, 1, MPI_INT, MPI_SUM,
-						PETSC_COMM_WORLD);
+					// Get which processor will send the information
+					int concProc = 0;
+					MPI_Allreduce(&concId, &concProc, 1, MPI_INT, MPI_SUM,
+							comm);
 
-				// Broadcast the size
-				MPI_Bcast(&concSize, 1, MPI_INT, concProc, PETSC_COMM_WORLD);
+					// Broadcast the size
+					MPI_Bcast(&concSize, 1, MPI_INT, concProc, comm);
 
-				// Skip the grid point if the size is 0
-				if (concSize == 0)
-					continue;
+					// Skip the grid point if the size is 0
+					if (concSize == 0)
+						continue;
 
-				// All processes create the dataset and fill it
-				tsGroup->writeConcentrationDataset(concSize, concArray, write,
-						i, j, k);
+					// All processes create the dataset and fill it
+					tsGroup->writeConcentrationDataset(concSize, concArray,
+							write, i, j, k);
+				}
 			}
 		}
-	}
-
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
+	});
 
 	PetscFunctionReturn(0);
 }
@@ -275,6 +300,9 @@ PetscErrorCode computeHeliumRetention3D(TS ts, PetscInt, PetscReal time,
 	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
+	// The species of the totals
+	using TotalType = IReactionNetwork::TotalType;
+
 	// Store the concentration over the grid
 	double heConcentration = 0.0, dConcentration = 0.0, tConcentration = 0.0;
 
@@ -298,16 +326,13 @@ PetscErrorCode computeHeliumRetention3D(TS ts, PetscInt, PetscReal time,
 
 				double hx = grid[xi + 1] - grid[xi];
 
-				// Update the concentration in the network
-				network.updateConcentrationsFromArray(gridPointSolution);
-
 				// Get the total helium concentration at this grid point
-				heConcentration += network.getTotalAtomConcentration(0) * hx
-						* hy * hz;
-				dConcentration += network.getTotalAtomConcentration(1) * hx * hy
-						* hz;
-				tConcentration += network.getTotalAtomConcentration(2) * hx * hy
-						* hz;
+				heConcentration += network.getTotal(TotalType::HeAtom,
+						gridPointSolution) * hx * hy * hz;
+				dConcentration += network.getTotal(TotalType::DAtom,
+						gridPointSolution) * hx * hy * hz;
+				tConcentration += network.getTotal(TotalType::TAtom,
+						gridPointSolution) * hx * hy * hz;
 			}
 		}
 	}
@@ -359,12 +384,8 @@ PetscErrorCode computeHeliumRetention3D(TS ts, PetscInt, PetscReal time,
 		std::cout << "Fluence = " << fluence << "\n" << std::endl;
 
 		// Uncomment to write the retention and the fluence in a file
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt", ios::app);
-		outputFile << fluence << " " << totalHeConcentration << " "
-				<< totalDConcentration << " " << totalTConcentration
-				<< std::endl;
-		outputFile.close();
+		observablesSink->addRecord("retentionOut.txt", { fluence,
+				totalHeConcentration, totalDConcentration, totalTConcentration });
 	}
 
 	// Restore the solutionArray
@@ -510,12 +531,9 @@ PetscErrorCode computeXenonRetention3D(TS ts, PetscInt timestep, PetscReal time,
 			averagePartialRadius = minRadius;
 
 		// Uncomment to write the retention and the fluence in a file
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt", ios::app);
-		outputFile << time << " " << totalConcData[0] << " "
-				<< totalConcData[2] / totalConcData[1] << " "
-				<< averagePartialRadius << std::endl;
-		outputFile.close();
+		observablesSink->addRecord("retentionOut.txt", { time,
+				totalConcData[0], totalConcData[2] / totalConcData[1],
+				averagePartialRadius });
 	}
 
 	// Restore the solutionArray
@@ -576,6 +594,9 @@ PetscErrorCode computeTRIDYN3D(TS ts, PetscInt timestep, PetscReal time,
 	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
 	CHKERRQ(ierr);
 
+	// The species of the totals
+	using TotalType = IReactionNetwork::TotalType;
+
 	// Create the output file
 	std::ofstream outputFile;
 	if (procId == 0) {
@@ -609,15 +630,17 @@ PetscErrorCode computeTRIDYN3D(TS ts, PetscInt timestep, PetscReal time,
 					// Get the pointer to the beginning of the solution data for this grid point
 					gridPointSolution = solutionArray[zk][yj][xi];
 
-					// Update the concentration in the network
-					network.updateConcentrationsFromArray(gridPointSolution);
-
 					// Get the total helium concentration at this grid point
-					heLocalConc += gridPointSolution[0];
-					dLocalConc += gridPointSolution[1];
-					tLocalConc += network.getTotalAtomConcentration(2);
-					vLocalConc += network.getTotalVConcentration();
-					iLocalConc += network.getTotalIConcentration();
+					heLocalConc += network.getTotal(TotalType::HeAtom,
+							gridPointSolution);
+					dLocalConc += network.getTotal(TotalType::DAtom,
+							gridPointSolution);
+					tLocalConc += network.getTotal(TotalType::TAtom,
+							gridPointSolution);
+					vLocalConc += network.getTotal(TotalType::V,
+							gridPointSolution);
+					iLocalConc += network.getTotal(TotalType::I,
+							gridPointSolution);
 				}
 			}
 		}
@@ -1006,21 +1029,19 @@ PetscErrorCode eventFunction3D(TS ts, PetscReal time, Vec solution,
 	if (solverHandler.moveSurface()) {
 		// Write the initial surface positions
 		if (procId == 0 && xolotlCore::equal(time, 0.0)) {
-			std::ofstream outputFile;
-			outputFile.open("surface.txt", ios::app);
-			outputFile << time << " ";
+			std::vector<double> record = { time };
 
 			// Loop on the possible yj
 			for (yj = 0; yj < My; yj++) {
 				for (zk = 0; zk < Mz; zk++) {
 					// Get the position of the surface at yj, zk
 					int surfacePos = solverHandler.getSurfacePosition(yj, zk);
-					outputFile << (double) yj * hy << " " << (double) zk * hz
-							<< " " << grid[surfacePos + 1] - grid[1] << " ";
+					record.push_back((double) yj * hy);
+					record.push_back((double) zk * hz);
+					record.push_back(grid[surfacePos + 1] - grid[1]);
 				}
 			}
-			outputFile << std::endl;
-			outputFile.close();
+			observablesSink->addRecord("surface.txt", record, 6, 0, true);
 		}
 
 		// Get the initial vacancy concentration
@@ -1522,21 +1543,19 @@ PetscErrorCode postEventFunction3D(TS ts, PetscInt nevents,
 
 	// Write the surface positions
 	if (procId == 0) {
-		std::ofstream outputFile;
-		outputFile.open("surface.txt", ios::app);
-		outputFile << time << " ";
+		std::vector<double> record = { time };
 
 		// Loop on the possible yj
 		for (yj = 0; yj < My; yj++) {
 			for (zk = 0; zk < Mz; zk++) {
 				// Get the position of the surface at yj, zk
 				int surfacePos = solverHandler.getSurfacePosition(yj, zk);
-				outputFile << (double) yj * hy << " " << (double) zk * hz << " "
-						<< grid[surfacePos + 1] - grid[1] << " ";
+				record.push_back((double) yj * hy);
+				record.push_back((double) zk * hz);
+				record.push_back(grid[surfacePos + 1] - grid[1]);
 			}
 		}
-		outputFile << std::endl;
-		outputFile.close();
+		observablesSink->addRecord("surface.txt", record, 6, 0, true);
 	}
 
 	// Restore the solutionArray
@@ -1549,6 +1568,8 @@ PetscErrorCode postEventFunction3D(TS ts, PetscInt nevents,
 /**
  * This operation sets up different monitors
  *  depending on the options.
+ * The incremental checkpoints (-start_stop_incremental) are not available
+ * in 3D, the option is rejected.
  * @param ts The time stepper
  * @return A standard PETSc error code
  */
@@ -1608,6 +1629,9 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 	checkPetscError(ierr,
 			"setupPetsc3DMonitor: PetscOptionsHasName (-tridyn) failed.");
 
+	// Create the sink of the observable files
+	initializeObservablesSink();
+
 	// Get the solver handler
 	auto& solverHandler = PetscSolver::getSolverHandler();
 
@@ -1672,6 +1696,30 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 		if (!flag)
 			hdf5Stride3D = 1.0;
 
+		// Check the option -start_stop_async
+		PetscBool flagAsync;
+		ierr = PetscOptionsHasName(NULL, NULL, "-start_stop_async", &flagAsync);
+		checkPetscError(ierr,
+				"setupPetsc3DMonitor: PetscOptionsHasName (-start_stop_async) failed.");
+
+		// The incremental checkpoints are only written in 0D and 1D, the
+		// 3D restart can't read them
+		PetscBool flagIncremental;
+		ierr = PetscOptionsHasName(NULL, NULL, "-start_stop_incremental",
+				&flagIncremental);
+		checkPetscError(ierr,
+				"setupPetsc3DMonitor: PetscOptionsHasName (-start_stop_incremental) failed.");
+		if (flagIncremental) {
+			throw std::string(
+					"\nxolotlSolver::Monitor3D: -start_stop_incremental is only "
+							"available in 0D and 1D.");
+		}
+
+		// Create the writer of the checkpoints
+		checkpointWriter.reset(
+				new CheckpointWriter(PETSC_COMM_WORLD, flagAsync,
+						xolotlPerf::getHandlerRegistry()));
+
 		// Compute the correct hdf5Previous3D for a restart
 		if (hasConcentrations) {
 			assert(lastTsGroup);
@@ -1759,9 +1807,7 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 			// Master process
 			if (procId == 0) {
 				// Clear the file where the surface will be written
-				std::ofstream outputFile;
-				outputFile.open("surface.txt");
-				outputFile.close();
+				observablesSink->create("surface.txt");
 			}
 		}
 
@@ -1845,9 +1891,7 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 		// Master process
 		if (procId == 0) {
 			// Uncomment to clear the file where the retention will be written
-			std::ofstream outputFile;
-			outputFile.open("retentionOut.txt");
-			outputFile.close();
+			observablesSink->create("retentionOut.txt");
 		}
 	}
 
@@ -1897,9 +1941,7 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 		// Master process
 		if (procId == 0) {
 			// Uncomment to clear the file where the retention will be written
-			std::ofstream outputFile;
-			outputFile.open("retentionOut.txt");
-			outputFile.close();
+			observablesSink->create("retentionOut.txt");
 		}
 	}
 
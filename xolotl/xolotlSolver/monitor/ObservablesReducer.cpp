@@ -0,0 +1,77 @@
+// Includes
+#include "ObservablesReducer.h"
+#include <algorithm>
+#include <string>
+
+namespace xolotlSolver {
+
+ObservablesReducer::ObservablesReducer() :
+		needsUpdate(false), request(MPI_REQUEST_NULL), pending(false) {
+}
+
+void ObservablesReducer::setPointUpdate(PointUpdate _update) {
+	update = _update;
+
+	return;
+}
+
+void ObservablesReducer::add(int size, bool _needsUpdate,
+		Accumulator accumulate, Finalizer finalize) {
+	Observable observable;
+	observable.offset = localValues.size();
+	observable.size = size;
+	observable.accumulate = accumulate;
+	observable.finalize = finalize;
+	observables.push_back(observable);
+
+	needsUpdate = needsUpdate || _needsUpdate;
+	localValues.resize(localValues.size() + size, 0.0);
+	totalValues.resize(localValues.size(), 0.0);
+
+	return;
+}
+
+void ObservablesReducer::start(MPI_Comm comm, int xs, int xm,
+		double **solutionArray) {
+	if (pending)
+		throw std::string(
+				"\nxolotlSolver::ObservablesReducer: the previous reduction is not finished.");
+
+	std::fill(localValues.begin(), localValues.end(), 0.0);
+
+	// Loop on the local grid points
+	for (int xi = xs; xi < xs + xm; xi++) {
+		const double *concs = solutionArray[xi];
+
+		if (needsUpdate && update)
+			update(xi, concs);
+
+		for (auto& observable : observables) {
+			observable.accumulate(xi, concs,
+					localValues.data() + observable.offset);
+		}
+	}
+
+	// Sum all the values at once
+	MPI_Iallreduce(localValues.data(), totalValues.data(), localValues.size(),
+			MPI_DOUBLE, MPI_SUM, comm, &request);
+	pending = true;
+
+	return;
+}
+
+void ObservablesReducer::finish() {
+	if (!pending)
+		return;
+
+	MPI_Wait(&request, MPI_STATUS_IGNORE);
+	pending = false;
+
+	for (auto& observable : observables) {
+		observable.finalize(totalValues.data() + observable.offset);
+	}
+
+	return;
+}
+
+} /* end namespace xolotlSolver */
@@ -0,0 +1,128 @@
+#ifndef XSOLVER_OBSERVABLESREDUCER_H
+#define XSOLVER_OBSERVABLESREDUCER_H
+
+// Includes
+#include <mpi.h>
+#include <vector>
+#include <functional>
+
+namespace xolotlSolver {
+
+/**
+ * This class computes the observables of the monitors that are sums over
+ * the grid (retention, desorption, ...) in a single sweep over the local
+ * grid points, followed by a single reduction.
+ *
+ * Each observable registers the number of values it sums, a function that
+ * adds the contribution of a grid point to its values, and a function
+ * that gets the sums over all the processes. The point update, if it is
+ * set, is called once per grid point before the observables, only if one
+ * of them needs it; it is where the network concentrations are updated.
+ *
+ * The reduction is an MPI_Iallreduce started at the end of the sweep, the
+ * caller can do other work (like writing files) before finishing it.
+ */
+class ObservablesReducer {
+public:
+
+	//! The type of the functions adding the contribution of a grid point
+	using Accumulator = std::function<void(int xi, const double *concs,
+			double *localValues)>;
+
+	//! The type of the functions getting the sums over all the processes
+	using Finalizer = std::function<void(const double *totalValues)>;
+
+	//! The type of the function called once per grid point
+	using PointUpdate = std::function<void(int xi, const double *concs)>;
+
+private:
+
+	/**
+	 * The description of an observable.
+	 */
+	struct Observable {
+		//! The index of its first value in the buffers
+		int offset;
+		//! The number of its values
+		int size;
+		//! The function adding the contribution of a grid point
+		Accumulator accumulate;
+		//! The function getting the sums
+		Finalizer finalize;
+	};
+
+	//! The registered observables
+	std::vector<Observable> observables;
+
+	//! The function called once per grid point
+	PointUpdate update;
+
+	//! Whether one of the observables needs the point update
+	bool needsUpdate;
+
+	//! The values of this process
+	std::vector<double> localValues;
+
+	//! The sums over all the processes
+	std::vector<double> totalValues;
+
+	//! The request of the reduction in flight
+	MPI_Request request;
+
+	//! Whether a reduction is in flight
+	bool pending;
+
+public:
+
+	/**
+	 * The constructor.
+	 */
+	ObservablesReducer();
+
+	/**
+	 * Set the function called once per grid point before the observables.
+	 *
+	 * @param _update The function
+	 */
+	void setPointUpdate(PointUpdate _update);
+
+	/**
+	 * Register an observable.
+	 *
+	 * @param size The number of values it sums
+	 * @param _needsUpdate Whether it needs the point update
+	 * @param accumulate The function adding the contribution of a grid point
+	 * @param finalize The function getting the sums, called on all the processes
+	 */
+	void add(int size, bool _needsUpdate, Accumulator accumulate,
+			Finalizer finalize);
+
+	/**
+	 * Whether no observable is registered.
+	 *
+	 * @return True if there is none
+	 */
+	bool empty() const {
+		return observables.empty();
+	}
+
+	/**
+	 * Sweep over the local grid points and start the reduction.
+	 *
+	 * @param comm The communicator of the reduction
+	 * @param xs The first local grid point
+	 * @param xm The number of local grid points
+	 * @param solutionArray The solution, indexed by grid point
+	 */
+	void start(MPI_Comm comm, int xs, int xm, double **solutionArray);
+
+	/**
+	 * Wait for the reduction and give the sums to the observables,
+	 * in the order they were registered.
+	 */
+	void finish();
+};
+//end class ObservablesReducer
+
+} /* end namespace xolotlSolver */
+#endif
@@ -0,0 +1,94 @@
+// Includes
+#include "ObservablesSink.h"
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+
+namespace xolotlSolver {
+
+ObservablesSink::ObservablesSink(bool _binary, double _flushInterval,
+		std::size_t _flushSize) :
+		binary(_binary), flushInterval(_flushInterval), flushSize(_flushSize), bufferedSize(
+				0), lastFlush(std::chrono::steady_clock::now()) {
+}
+
+ObservablesSink::~ObservablesSink() {
+	flush();
+}
+
+std::string ObservablesSink::getPath(const std::string& fileName) const {
+	return binary ? fileName + ".bin" : fileName;
+}
+
+void ObservablesSink::create(const std::string& fileName) {
+	// Drop the buffered records
+	auto iter = buffers.find(fileName);
+	if (iter != buffers.end()) {
+		bufferedSize -= iter->second.size();
+		buffers.erase(iter);
+	}
+
+	// Create or empty the file
+	std::ofstream outputFile(getPath(fileName),
+			std::ios::out | std::ios::trunc | std::ios::binary);
+
+	return;
+}
+
+void ObservablesSink::addRecord(const std::string& fileName,
+		const std::vector<double>& values, int precision, int nIntegers,
+		bool trailingSpace) {
+	auto& buffer = buffers[fileName];
+	auto previousSize = buffer.size();
+
+	if (binary) {
+		// The number of values then the values
+		uint32_t nValues = values.size();
+		buffer.append(reinterpret_cast<const char*>(&nValues),
+				sizeof(nValues));
+		buffer.append(reinterpret_cast<const char*>(values.data()),
+				values.size() * sizeof(double));
+	} else {
+		std::ostringstream line;
+		line.precision(precision);
+		for (std::size_t i = 0; i < values.size(); i++) {
+			if (i > 0 && !trailingSpace)
+				line << " ";
+			if ((int) i < nIntegers)
+				line << (long long) values[i];
+			else
+				line << values[i];
+			if (trailingSpace)
+				line << " ";
+		}
+		line << "\n";
+		buffer.append(line.str());
+	}
+	bufferedSize += buffer.size() - previousSize;
+
+	// Flush if one of the budgets is exceeded
+	double elapsed = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - lastFlush).count();
+	if (bufferedSize >= flushSize || elapsed >= flushInterval)
+		flush();
+
+	return;
+}
+
+void ObservablesSink::flush() {
+	for (auto& pair : buffers) {
+		if (pair.second.empty())
+			continue;
+
+		std::ofstream outputFile(getPath(pair.first),
+				std::ios::out | std::ios::app | std::ios::binary);
+		outputFile.write(pair.second.data(), pair.second.size());
+		pair.second.clear();
+	}
+	bufferedSize = 0;
+	lastFlush = std::chrono::steady_clock::now();
+
+	return;
+}
+
+} /* end namespace xolotlSolver */
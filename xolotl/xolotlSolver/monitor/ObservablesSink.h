@@ -0,0 +1,105 @@
+#ifndef XSOLVER_OBSERVABLESSINK_H
+#define XSOLVER_OBSERVABLESSINK_H
+
+// Includes
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+
+namespace xolotlSolver {
+
+/**
+ * This class buffers the records the monitors write in their observable
+ * files (retentionOut.txt, surface.txt, ...) instead of opening and closing
+ * the files at each time step.
+ *
+ * The records are kept in memory and appended to the files when the
+ * buffered size exceeds the size budget, when the time since the last
+ * flush exceeds the time budget, and when the sink is flushed at the end
+ * of the solve or destroyed.
+ *
+ * In the text format a record is a line of space separated values,
+ * formatted as the monitors used to write them. In the binary format it is appended to
+ * "<file name>.bin" as the number of values (a 32 bits unsigned integer)
+ * followed by the values (64 bits floats), in the native byte order.
+ */
+class ObservablesSink {
+private:
+
+	//! Whether the records are written in the binary format
+	bool binary;
+
+	//! The time budget in seconds
+	double flushInterval;
+
+	//! The size budget in bytes
+	std::size_t flushSize;
+
+	//! The buffered records of each file, in the format of the file
+	std::map<std::string, std::string> buffers;
+
+	//! The total size of the buffered records
+	std::size_t bufferedSize;
+
+	//! The time of the last flush
+	std::chrono::steady_clock::time_point lastFlush;
+
+	/**
+	 * Get the name of the file actually written.
+	 *
+	 * @param fileName The name of the observable file
+	 * @return The name of the file in the current format
+	 */
+	std::string getPath(const std::string& fileName) const;
+
+public:
+
+	/**
+	 * The constructor.
+	 *
+	 * @param _binary Whether the records are written in the binary format
+	 * @param _flushInterval The time budget in seconds
+	 * @param _flushSize The size budget in bytes
+	 */
+	ObservablesSink(bool _binary = false, double _flushInterval = 10.0,
+			std::size_t _flushSize = 1 << 20);
+
+	/**
+	 * The destructor, it flushes the buffered records.
+	 */
+	~ObservablesSink();
+
+	/**
+	 * Create the given file, or empty it if it exists, and drop its
+	 * buffered records.
+	 *
+	 * @param fileName The name of the observable file
+	 */
+	void create(const std::string& fileName);
+
+	/**
+	 * Add a record to the given file. In the text format the values are
+	 * written as the output stream writes doubles, except the leading
+	 * integer values, like the time step, that are written as integers.
+	 *
+	 * @param fileName The name of the observable file
+	 * @param values The values of the record
+	 * @param precision The precision of the values in the text format
+	 * @param nIntegers The number of leading integer values
+	 * @param trailingSpace Whether every value is followed by a space in
+	 * the text format, including the last one
+	 */
+	void addRecord(const std::string& fileName,
+			const std::vector<double>& values, int precision = 6,
+			int nIntegers = 0, bool trailingSpace = false);
+
+	/**
+	 * Append all the buffered records to their files.
+	 */
+	void flush();
+};
+//end class ObservablesSink
+
+} /* end namespace xolotlSolver */
+#endif
@@ -57,12 +57,8 @@ void PetscSolver0DHandler::createSolverContext(DM &da) {
 	// Get the diagonal fill
 	network.getDiagonalFill(dfill);
 
-	// Load up the block fills
-	auto dfillsparse = ConvertToPetscSparseFillMap(dof, dfill);
-	auto ofillsparse = ConvertToPetscSparseFillMap(dof, ofill);
-	ierr = DMDASetBlockFillsSparse(da, dfillsparse.data(), ofillsparse.data());
-	checkPetscError(ierr, "PetscSolver0DHandler::createSolverContext: "
-			"DMDASetBlockFills failed.");
+	// The reaction data doesn't change anymore, keep a single copy per node
+	network.shareReadOnlyData();
 
 	// Initialize the arrays for the reaction partial derivatives
 	reactionSize.resize(dof);
@@ -75,6 +71,16 @@ void PetscSolver0DHandler::createSolverContext(DM &da) {
 			reactionIndices);
 	reactionVals.resize(nPartials);
 
+	// Choose the reaction partial derivatives going in the matrix
+	initializeJacobianEntries(dfill);
+
+	// Load up the block fills
+	auto dfillsparse = ConvertToPetscSparseFillMap(dof, dfill);
+	auto ofillsparse = ConvertToPetscSparseFillMap(dof, ofill);
+	ierr = DMDASetBlockFillsSparse(da, dfillsparse.data(), ofillsparse.data());
+	checkPetscError(ierr, "PetscSolver0DHandler::createSolverContext: "
+			"DMDASetBlockFills failed.");
+
 	return;
 }
 
@@ -143,16 +149,15 @@ void PetscSolver0DHandler::initializeConcentration(DM &da, Vec &C) {
 		assert(concGroup);
 		auto tsGroup = concGroup->getLastTimestepGroup();
 		assert(tsGroup);
-		auto myConcs = tsGroup->readConcentrations(*xfile, 0, 1);
-
-		// Apply the concentrations we just read.
-		concOffset = concentrations[0];
+		// They are streamed directly in the concentration array.
+		tsGroup->readConcentrations(*xfile, 0, 1,
+				[concentrations](int x, int index, double value) {
+					concentrations[x][index] = value;
+				});
 
-		for (auto const &currConcData : myConcs[0]) {
-			concOffset[currConcData.first] = currConcData.second;
-		}
 		// Set the temperature in the network
-		double temp = myConcs[0][myConcs[0].size() - 1].second;
+		concOffset = concentrations[0];
+		double temp = concOffset[dof - 1];
 		network.setTemperature(temp, 0);
 		lastTemperature[0] = temp;
 	}
@@ -240,7 +245,7 @@ void PetscSolver0DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 	// ----- Compute the reaction fluxes over the locally owned part of the grid -----
 	fluxCounter->increment();
 	fluxTimer->start();
-	network.computeAllFluxes(updatedConcOffset);
+	network.computeAllFluxes(concOffset, updatedConcOffset, 0);
 	fluxTimer->stop();
 
 	/*
@@ -315,10 +320,20 @@ void PetscSolver0DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 	// Compute all the partial derivatives for the reactions
 	partialDerivativeCounter->increment();
 	partialDerivativeTimer->start();
-	network.computeAllPartials(reactionStartingIdx, reactionIndices,
-			reactionVals);
+	network.computeAllPartials(concOffset, reactionStartingIdx,
+			reactionIndices, reactionVals, 0);
 	partialDerivativeTimer->stop();
 
+	// Keep the grid point for the matrix-free products
+	ReactionPoint point { 0, 0, temperature };
+	jacobianLines.assign(1, std::vector<ReactionPoint>(1, point));
+
+	// Get the partial derivatives going in the matrix
+	std::vector<PetscInt> cols(reactionIndices.size());
+	std::vector<double> selectedVals;
+	auto partialsVals = selectJacobianEntries(0, reactionVals, cols,
+			selectedVals);
+
 	// Update the column in the Jacobian that represents each DOF
 	for (int i = 0; i < dof - 1; i++) {
 		// Set grid coordinate and component number for the row
@@ -326,16 +341,16 @@ void PetscSolver0DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 		rowId.c = i;
 
 		// Number of partial derivatives
-		pdColIdsVectorSize = reactionSize[i];
-		auto startingIdx = reactionStartingIdx[i];
+		pdColIdsVectorSize = jacobianSize[i];
+		auto startingIdx = jacobianStartingIdx[i];
 
 		// Loop over the list of column ids
 		for (int j = 0; j < pdColIdsVectorSize; j++) {
 			// Set grid coordinate and component number for a column in the list
 			colIds[j].i = 0;
-			colIds[j].c = reactionIndices[startingIdx + j];
+			colIds[j].c = cols[startingIdx + j];
 			// Get the partial derivative from the array of all of the partials
-			reactingPartialsForCluster[j] = reactionVals[startingIdx + j];
+			reactingPartialsForCluster[j] = partialsVals[startingIdx + j];
 		}
 		// Update the matrix
 		ierr = MatSetValuesStencil(J, 1, &rowId, pdColIdsVectorSize, colIds,
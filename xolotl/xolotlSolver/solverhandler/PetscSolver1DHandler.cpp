@@ -111,12 +111,8 @@ void PetscSolver1DHandler::createSolverContext(DM &da) {
 	// Get the diagonal fill
 	network.getDiagonalFill(dfill);
 
-	// Load up the block fills
-	auto ofillsparse = ConvertToPetscSparseFillMap(dof, ofill);
-	auto dfillsparse = ConvertToPetscSparseFillMap(dof, dfill);
-	ierr = DMDASetBlockFillsSparse(da, dfillsparse.data(), ofillsparse.data());
-	checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: "
-			"DMDASetBlockFills failed.");
+	// The reaction data doesn't change anymore, keep a single copy per node
+	network.shareReadOnlyData();
 
 	// Initialize the arrays for the reaction partial derivatives
 	reactionSize.resize(dof);
@@ -129,6 +125,16 @@ void PetscSolver1DHandler::createSolverContext(DM &da) {
 			reactionIndices);
 	reactionVals.resize(nPartials);
 
+	// Choose the reaction partial derivatives going in the matrix
+	initializeJacobianEntries(dfill);
+
+	// Load up the block fills
+	auto ofillsparse = ConvertToPetscSparseFillMap(dof, ofill);
+	auto dfillsparse = ConvertToPetscSparseFillMap(dof, dfill);
+	ierr = DMDASetBlockFillsSparse(da, dfillsparse.data(), ofillsparse.data());
+	checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: "
+			"DMDASetBlockFills failed.");
+
 	return;
 }
 
@@ -221,17 +227,18 @@ void PetscSolver1DHandler::initializeConcentration(DM &da, Vec &C) {
 		assert(concGroup);
 		auto tsGroup = concGroup->getLastTimestepGroup();
 		assert(tsGroup);
-		auto myConcs = tsGroup->readConcentrations(*xfile, xs, xm);
+		// They are streamed directly in the concentration array.
+		tsGroup->readConcentrations(*xfile, xs, xm,
+				[concentrations](int x, int index, double value) {
+					concentrations[x][index] = value;
+				});
 
-		// Apply the concentrations we just read.
+		// Apply the temperatures we just read.
 		for (auto i = 0; i < xm; ++i) {
 			concOffset = concentrations[xs + i];
 
-			for (auto const &currConcData : myConcs[i]) {
-				concOffset[currConcData.first] = currConcData.second;
-			}
 			// Set the temperature in the network
-			double temp = myConcs[i][myConcs[i].size() - 1].second;
+			double temp = concOffset[dof - 1];
 			network.setTemperature(temp, i);
 			// Update the modified trap-mutation rate
 			// that depends on the network reaction rates
@@ -307,11 +314,10 @@ void PetscSolver1DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 
 			// Get the concentrations at this grid point
 			concOffset = concs[xi];
-			// Copy data into the PSIClusterReactionNetwork
-			network.updateConcentrationsFromArray(concOffset);
-
-			// Sum the total atom concentration
-			atomConc += network.getTotalTrappedAtomConcentration()
+			// Sum the total atom concentration, directly from the array
+			atomConc += network.getTotal(
+					xolotlCore::IReactionNetwork::TotalType::TrappedHeAtom,
+					concOffset)
 					* (grid[xi + 1] - grid[xi]);
 		}
 
@@ -327,6 +333,9 @@ void PetscSolver1DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 	// Declarations for variables used in the loop
 	double **concVector = new double*[3];
 	xolotlCore::Point<3> gridPosition { 0.0, 0.0, 0.0 };
+	// The grid points where the reactions need to be computed
+	std::vector<ReactionPoint> reactionPoints;
+	reactionPoints.reserve(xm);
 
 	// Loop over grid points computing ODE terms for each grid point
 	for (PetscInt xi = xs; xi < xs + xm; xi++) {
@@ -405,13 +414,6 @@ void PetscSolver1DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 			lastTemperature[xi + 1 - xs] = temperature;
 		}
 
-		// Copy data into the ReactionNetwork so that it can
-		// compute the fluxes properly. The network is only used to compute the
-		// fluxes and hold the state data from the last time step. I'm reusing
-		// it because it cuts down on memory significantly (about 400MB per
-		// grid point) at the expense of being a little tricky to comprehend.
-		network.updateConcentrationsFromArray(concOffset);
-
 		// ----- Account for flux of incoming particles -----
 		fluxHandler->computeIncidentFlux(ftime, updatedConcOffset, xi,
 				surfacePosition);
@@ -440,13 +442,17 @@ void PetscSolver1DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 		resolutionHandler->computeReSolution(network, concOffset,
 				updatedConcOffset, xi, xs);
 
-		// ----- Compute the reaction fluxes over the locally owned part of the grid -----
+		// The reaction fluxes are computed below, once all the state shared
+		// between grid points is up to date
 		fluxCounter->increment();
-		fluxTimer->start();
-		network.computeAllFluxes(updatedConcOffset, xi + 1 - xs);
-		fluxTimer->stop();
+		reactionPoints.push_back( { xi - xs, xi + 1 - xs, temperature });
 	}
 
+	// ----- Compute the reaction fluxes over the locally owned part of the grid -----
+	fluxTimer->start();
+	computeLineFluxes(reactionPoints, concs, updatedConcs, xs);
+	fluxTimer->stop();
+
 	/*
 	 Restore vectors
 	 */
@@ -752,11 +758,10 @@ void PetscSolver1DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 
 			// Get the concentrations at this grid point
 			concOffset = concs[xi];
-			// Copy data into the PSIClusterReactionNetwork
-			network.updateConcentrationsFromArray(concOffset);
-
-			// Sum the total atom concentration
-			atomConc += network.getTotalTrappedAtomConcentration()
+			// Sum the total atom concentration, directly from the array
+			atomConc += network.getTotal(
+					xolotlCore::IReactionNetwork::TotalType::TrappedHeAtom,
+					concOffset)
 					* (grid[xi + 1] - grid[xi]);
 		}
 
@@ -770,12 +775,13 @@ void PetscSolver1DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 	}
 
 	// Arguments for MatSetValuesStencil called below
-	MatStencil rowId;
 	MatStencil colIds[dof];
-	int pdColIdsVectorSize = 0;
 
 	// Declarations for variables used in the loop
 	xolotlCore::Point<3> gridPosition { 0.0, 0.0, 0.0 };
+	// The grid points where the reactions need to be computed
+	std::vector<ReactionPoint> reactionPoints;
+	reactionPoints.reserve(xm);
 
 	// Loop over the grid points
 	for (PetscInt xi = xs; xi < xs + xm; xi++) {
@@ -818,40 +824,10 @@ void PetscSolver1DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 		// compute the new concentrations.
 		network.updateConcentrationsFromArray(concOffset);
 
-		// ----- Take care of the reactions for all the reactants -----
-
-		// Compute all the partial derivatives for the reactions
+		// The partial derivatives from the reactions are computed below, once
+		// all the state shared between grid points is up to date
 		partialDerivativeCounter->increment();
-		partialDerivativeTimer->start();
-		network.computeAllPartials(reactionStartingIdx, reactionIndices,
-				reactionVals, xi + 1 - xs);
-		partialDerivativeTimer->stop();
-
-		// Update the column in the Jacobian that represents each DOF
-		for (int i = 0; i < dof - 1; i++) {
-			// Set grid coordinate and component number for the row
-			rowId.i = xi;
-			rowId.c = i;
-
-			// Number of partial derivatives
-			pdColIdsVectorSize = reactionSize[i];
-			auto startingIdx = reactionStartingIdx[i];
-
-			// Loop over the list of column ids
-			for (int j = 0; j < pdColIdsVectorSize; j++) {
-				// Set grid coordinate and component number for a column in the list
-				colIds[j].i = xi;
-				colIds[j].c = reactionIndices[startingIdx + j];
-				// Get the partial derivative from the array of all of the partials
-				reactingPartialsForCluster[j] = reactionVals[startingIdx + j];
-			}
-			// Update the matrix
-			ierr = MatSetValuesStencil(J, 1, &rowId, pdColIdsVectorSize, colIds,
-					reactingPartialsForCluster.data(), ADD_VALUES);
-			checkPetscError(ierr,
-					"PetscSolver1DHandler::computeDiagonalJacobian: "
-							"MatSetValuesStencil (reactions) failed.");
-		}
+		reactionPoints.push_back( { xi - xs, xi + 1 - xs, temperature });
 
 		// ----- Take care of the modified trap-mutation for all the reactants -----
 
@@ -860,7 +836,7 @@ void PetscSolver1DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 		int nHelium = mutationHandler->getNumberOfMutating();
 
 		// Arguments for MatSetValuesStencil called below
-		MatStencil row, col;
+		MatStencil rows[3], col;
 		PetscScalar mutationVals[3 * nHelium];
 		PetscInt mutationIndices[3 * nHelium];
 
@@ -871,38 +847,23 @@ void PetscSolver1DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 		// Loop on the number of helium undergoing trap-mutation to set the values
 		// in the Jacobian
 		for (int i = 0; i < nMutating; i++) {
-			// Set grid coordinate and component number for the row and column
-			// corresponding to the helium cluster
-			row.i = xi;
-			row.c = mutationIndices[3 * i];
+			// Set grid coordinate and component number for the rows
+			// corresponding to the helium cluster, the HeV cluster created
+			// through trap-mutation, and the interstitial
+			for (int n = 0; n < 3; n++) {
+				rows[n].i = xi;
+				rows[n].c = mutationIndices[(3 * i) + n];
+			}
+			// The column corresponds to the helium cluster
 			col.i = xi;
 			col.c = mutationIndices[3 * i];
 
-			ierr = MatSetValuesStencil(J, 1, &row, 1, &col,
+			// Set the three values at once
+			ierr = MatSetValuesStencil(J, 3, rows, 1, &col,
 					mutationVals + (3 * i), ADD_VALUES);
 			checkPetscError(ierr,
 					"PetscSolver1DHandler::computeDiagonalJacobian: "
-							"MatSetValuesStencil (He trap-mutation) failed.");
-
-			// Set component number for the row
-			// corresponding to the HeV cluster created through trap-mutation
-			row.c = mutationIndices[(3 * i) + 1];
-
-			ierr = MatSetValuesStencil(J, 1, &row, 1, &col,
-					mutationVals + (3 * i) + 1, ADD_VALUES);
-			checkPetscError(ierr,
-					"PetscSolver1DHandler::computeDiagonalJacobian: "
-							"MatSetValuesStencil (HeV trap-mutation) failed.");
-
-			// Set component number for the row
-			// corresponding to the interstitial created through trap-mutation
-			row.c = mutationIndices[(3 * i) + 2];
-
-			ierr = MatSetValuesStencil(J, 1, &row, 1, &col,
-					mutationVals + (3 * i) + 2, ADD_VALUES);
-			checkPetscError(ierr,
-					"PetscSolver1DHandler::computeDiagonalJacobian: "
-							"MatSetValuesStencil (I trap-mutation) failed.");
+							"MatSetValuesStencil (trap-mutation) failed.");
 		}
 
 		// ----- Take care of the re-solution for all the reactants -----
@@ -945,6 +906,18 @@ void PetscSolver1DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 		}
 	}
 
+	// ----- Take care of the reactions for all the reactants -----
+	// The rows of the grid points owned by this process are contiguous,
+	// directly use their global indices
+	PetscInt rowStart = 0;
+	ierr = MatGetOwnershipRange(J, &rowStart, NULL);
+	checkPetscError(ierr, "PetscSolver1DHandler::computeDiagonalJacobian: "
+			"MatGetOwnershipRange failed.");
+	jacobianLines.clear();
+	partialDerivativeTimer->start();
+	computeLinePartials(reactionPoints, concs, xs, J, rowStart);
+	partialDerivativeTimer->stop();
+
 	/*
 	 Restore vectors
 	 */
@@ -116,12 +116,8 @@ void PetscSolver2DHandler::createSolverContext(DM &da) {
 	// Get the diagonal fill
 	network.getDiagonalFill(dfill);
 
-	// Load up the block fills
-	auto dfillsparse = ConvertToPetscSparseFillMap(dof, dfill);
-	auto ofillsparse = ConvertToPetscSparseFillMap(dof, ofill);
-	ierr = DMDASetBlockFillsSparse(da, dfillsparse.data(), ofillsparse.data());
-	checkPetscError(ierr, "PetscSolver2DHandler::createSolverContext: "
-			"DMDASetBlockFills failed.");
+	// The reaction data doesn't change anymore, keep a single copy per node
+	network.shareReadOnlyData();
 
 	// Initialize the arrays for the reaction partial derivatives
 	reactionSize.resize(dof);
@@ -134,6 +130,16 @@ void PetscSolver2DHandler::createSolverContext(DM &da) {
 			reactionIndices);
 	reactionVals.resize(nPartials);
 
+	// Choose the reaction partial derivatives going in the matrix
+	initializeJacobianEntries(dfill);
+
+	// Load up the block fills
+	auto dfillsparse = ConvertToPetscSparseFillMap(dof, dfill);
+	auto ofillsparse = ConvertToPetscSparseFillMap(dof, ofill);
+	ierr = DMDASetBlockFillsSparse(da, dfillsparse.data(), ofillsparse.data());
+	checkPetscError(ierr, "PetscSolver2DHandler::createSolverContext: "
+			"DMDASetBlockFills failed.");
+
 	return;
 }
 
@@ -307,6 +313,10 @@ void PetscSolver2DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 	xolotlCore::Point<3> gridPosition { 0.0, 0.0, 0.0 };
 	std::vector<double> incidentFluxVector;
 	double atomConc = 0.0, totalAtomConc = 0.0;
+	// The grid points of the current row where the reactions need to be
+	// computed
+	std::vector<ReactionPoint> reactionPoints;
+	reactionPoints.reserve(xm);
 
 	// Degrees of freedom is the total number of clusters in the network
 	const int dof = network.getDOF();
@@ -331,11 +341,10 @@ void PetscSolver2DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 				if (xi >= xs && xi < xs + xm && yj >= ys && yj < ys + ym) {
 					// Get the concentrations at this grid point
 					concOffset = concs[yj][xi];
-					// Copy data into the PSIClusterReactionNetwork
-					network.updateConcentrationsFromArray(concOffset);
-
-					// Sum the total atom concentration
-					atomConc += network.getTotalTrappedAtomConcentration()
+					// Sum the total atom concentration, directly from the array
+					atomConc += network.getTotal(
+							xolotlCore::IReactionNetwork::TotalType::TrappedHeAtom,
+							concOffset)
 							* (grid[xi + 1] - grid[xi]);
 				}
 			}
@@ -444,13 +453,6 @@ void PetscSolver2DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 				lastTemperature[xi + 1 - xs] = temperature;
 			}
 
-			// Copy data into the ReactionNetwork so that it can
-			// compute the fluxes properly. The network is only used to compute the
-			// fluxes and hold the state data from the last time step. I'm reusing
-			// it because it cuts down on memory significantly (about 400MB per
-			// grid point) at the expense of being a little tricky to comprehend.
-			network.updateConcentrationsFromArray(concOffset);
-
 			// ----- Account for flux of incoming particles -----
 			fluxHandler->computeIncidentFlux(ftime, updatedConcOffset, xi,
 					surfacePosition[yj]);
@@ -480,9 +482,16 @@ void PetscSolver2DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 			resolutionHandler->computeReSolution(network, concOffset,
 					updatedConcOffset, xi, xs, yj);
 
-			// ----- Compute the reaction fluxes over the locally owned part of the grid -----
-			network.computeAllFluxes(updatedConcOffset, xi + 1 - xs);
+			// The reaction fluxes are computed below, once all the state shared
+			// between grid points is up to date
+			reactionPoints.push_back( { (yj - ys) * xm + xi - xs, xi + 1 - xs,
+					temperature });
 		}
+
+		// ----- Compute the reaction fluxes over the row -----
+		// Before the next row because the rates are only stored by depth
+		computeLineFluxes(reactionPoints, concs[yj], updatedConcs[yj], xs);
+		reactionPoints.clear();
 	}
 
 	/*
@@ -826,13 +835,23 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 	PetscScalar *concOffset = nullptr;
 
 	// Arguments for MatSetValuesStencil called below
-	MatStencil rowId;
 	MatStencil colIds[dof];
-	int pdColIdsVectorSize = 0;
 
 	// Declarations for variables used in the loop
 	double atomConc = 0.0, totalAtomConc = 0.0;
 	xolotlCore::Point<3> gridPosition { 0.0, 0.0, 0.0 };
+	// The grid points of the current row where the reactions need to be
+	// computed
+	std::vector<ReactionPoint> reactionPoints;
+	reactionPoints.reserve(xm);
+
+	// The rows of the grid points owned by this process are contiguous,
+	// directly use their global indices
+	PetscInt rowStart = 0;
+	ierr = MatGetOwnershipRange(J, &rowStart, NULL);
+	checkPetscError(ierr, "PetscSolver2DHandler::computeDiagonalJacobian: "
+			"MatGetOwnershipRange failed.");
+	jacobianLines.clear();
 
 	// Loop over the grid points
 	for (PetscInt yj = bottomOffset; yj < nY - topOffset; yj++) {
@@ -854,11 +873,10 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 				if (xi >= xs && xi < xs + xm && yj >= ys && yj < ys + ym) {
 					// Get the concentrations at this grid point
 					concOffset = concs[yj][xi];
-					// Copy data into the PSIClusterReactionNetwork
-					network.updateConcentrationsFromArray(concOffset);
-
-					// Sum the total atom concentration
-					atomConc += network.getTotalTrappedAtomConcentration()
+					// Sum the total atom concentration, directly from the array
+					atomConc += network.getTotal(
+							xolotlCore::IReactionNetwork::TotalType::TrappedHeAtom,
+							concOffset)
 							* (grid[xi + 1] - grid[xi]);
 				}
 			}
@@ -921,40 +939,10 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 			// compute the new concentrations.
 			network.updateConcentrationsFromArray(concOffset);
 
-			// ----- Take care of the reactions for all the reactants -----
-
-			// Compute all the partial derivatives for the reactions
-			network.computeAllPartials(reactionStartingIdx, reactionIndices,
-					reactionVals, xi + 1 - xs);
-
-			// Update the column in the Jacobian that represents each DOF
-			for (int i = 0; i < dof - 1; i++) {
-				// Set grid coordinate and component number for the row
-				rowId.i = xi;
-				rowId.j = yj;
-				rowId.c = i;
-
-				// Number of partial derivatives
-				pdColIdsVectorSize = reactionSize[i];
-				auto startingIdx = reactionStartingIdx[i];
-
-				// Loop over the list of column ids
-				for (int j = 0; j < pdColIdsVectorSize; j++) {
-					// Set grid coordinate and component number for a column in the list
-					colIds[j].i = xi;
-					colIds[j].j = yj;
-					colIds[j].c = reactionIndices[startingIdx + j];
-					// Get the partial derivative from the array of all of the partials
-					reactingPartialsForCluster[j] =
-							reactionVals[startingIdx + j];
-				}
-				// Update the matrix
-				ierr = MatSetValuesStencil(J, 1, &rowId, pdColIdsVectorSize,
-						colIds, reactingPartialsForCluster.data(), ADD_VALUES);
-				checkPetscError(ierr,
-						"PetscSolver2DHandler::computeDiagonalJacobian: "
-								"MatSetValuesStencil (reactions) failed.");
-			}
+			// The partial derivatives from the reactions are computed below,
+			// once all the state shared between grid points is up to date
+			reactionPoints.push_back( { (yj - ys) * xm + xi - xs, xi + 1 - xs,
+					temperature });
 
 			// ----- Take care of the modified trap-mutation for all the reactants -----
 
@@ -963,7 +951,7 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 			int nHelium = mutationHandler->getNumberOfMutating();
 
 			// Arguments for MatSetValuesStencil called below
-			MatStencil row, col;
+			MatStencil rows[3], col;
 			PetscScalar mutationVals[3 * nHelium];
 			PetscInt mutationIndices[3 * nHelium];
 
@@ -974,40 +962,25 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 			// Loop on the number of helium undergoing trap-mutation to set the values
 			// in the Jacobian
 			for (int i = 0; i < nMutating; i++) {
-				// Set grid coordinate and component number for the row and column
-				// corresponding to the helium cluster
-				row.i = xi;
-				row.j = yj;
-				row.c = mutationIndices[3 * i];
+				// Set grid coordinate and component number for the rows
+				// corresponding to the helium cluster, the HeV cluster created
+				// through trap-mutation, and the interstitial
+				for (int n = 0; n < 3; n++) {
+					rows[n].i = xi;
+					rows[n].j = yj;
+					rows[n].c = mutationIndices[(3 * i) + n];
+				}
+				// The column corresponds to the helium cluster
 				col.i = xi;
 				col.j = yj;
 				col.c = mutationIndices[3 * i];
 
-				ierr = MatSetValuesStencil(J, 1, &row, 1, &col,
+				// Set the three values at once
+				ierr = MatSetValuesStencil(J, 3, rows, 1, &col,
 						mutationVals + (3 * i), ADD_VALUES);
 				checkPetscError(ierr,
 						"PetscSolver2DHandler::computeDiagonalJacobian: "
-								"MatSetValuesStencil (He trap-mutation) failed.");
-
-				// Set component number for the row
-				// corresponding to the HeV cluster created through trap-mutation
-				row.c = mutationIndices[(3 * i) + 1];
-
-				ierr = MatSetValuesStencil(J, 1, &row, 1, &col,
-						mutationVals + (3 * i) + 1, ADD_VALUES);
-				checkPetscError(ierr,
-						"PetscSolver2DHandler::computeDiagonalJacobian: "
-								"MatSetValuesStencil (HeV trap-mutation) failed.");
-
-				// Set component number for the row
-				// corresponding to the interstitial created through trap-mutation
-				row.c = mutationIndices[(3 * i) + 2];
-
-				ierr = MatSetValuesStencil(J, 1, &row, 1, &col,
-						mutationVals + (3 * i) + 2, ADD_VALUES);
-				checkPetscError(ierr,
-						"PetscSolver2DHandler::computeDiagonalJacobian: "
-								"MatSetValuesStencil (I trap-mutation) failed.");
+								"MatSetValuesStencil (trap-mutation) failed.");
 			}
 
 			// ----- Take care of the re-solution for all the reactants -----
@@ -1056,6 +1029,11 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 								"MatSetValuesStencil (Xe re-solution) failed.");
 			}
 		}
+
+		// ----- Take care of the reactions for all the reactants of the row -----
+		// Before the next row because the rates are only stored by depth
+		computeLinePartials(reactionPoints, concs[yj], xs, J, rowStart);
+		reactionPoints.clear();
 	}
 
 	/*
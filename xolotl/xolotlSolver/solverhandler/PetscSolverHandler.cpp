@@ -1,4 +1,6 @@
 #include "xolotlSolver/solverhandler/PetscSolverHandler.h"
+#include <algorithm>
+#include <cmath>
 
 namespace xolotlSolver {
 
@@ -39,4 +41,231 @@ std::vector<PetscInt> PetscSolverHandler::ConvertToPetscSparseFillMap(
 	return ret;
 }
 
+void PetscSolverHandler::initializeJacobianEntries(
+		xolotlCore::IReactionNetwork::SparseFillMap& dfill) {
+	const int dof = network.getDOF();
+
+	// Everything goes in the matrix when the Jacobian is assembled
+	if (jacobianType == "assembled") {
+		reactionBlockIds.clear();
+		jacobianPositions.clear();
+		jacobianSize = reactionSize;
+		jacobianStartingIdx = reactionStartingIdx;
+		return;
+	}
+
+	// Each DOF is its own block
+	reactionBlockIds.resize(dof);
+	for (int i = 0; i < dof; i++) {
+		reactionBlockIds[i] = i;
+	}
+	// Or the moments are in the block of their cluster
+	if (jacobianType == "matrixFreeBlock") {
+		for (auto const& currReactant : network.getAll()) {
+			int blockId = currReactant.get().getId() - 1;
+			for (int axis = 0; axis < 4; axis++) {
+				int momId = currReactant.get().getMomentId(axis) - 1;
+				if (momId >= 0 && momId < dof)
+					reactionBlockIds[momId] = blockId;
+			}
+		}
+	}
+
+	// Select the reaction partial derivatives within the blocks
+	jacobianSize.assign(dof, 0);
+	jacobianStartingIdx.assign(dof, 0);
+	jacobianPositions.clear();
+	for (int i = 0; i < dof; i++) {
+		jacobianStartingIdx[i] = jacobianPositions.size();
+		auto startingIdx = reactionStartingIdx[i];
+		for (int j = 0; j < reactionSize[i]; j++) {
+			if (reactionBlockIds[reactionIndices[startingIdx + j]]
+					== reactionBlockIds[i])
+				jacobianPositions.push_back(startingIdx + j);
+		}
+		jacobianSize[i] = jacobianPositions.size() - jacobianStartingIdx[i];
+	}
+
+	// Restrict the fill the same way, always keeping the diagonal
+	for (int i = 0; i < dof; i++) {
+		auto& row = dfill[i];
+		row.erase(
+				std::remove_if(row.begin(), row.end(),
+						[this, i](int j) {
+							return reactionBlockIds[j] != reactionBlockIds[i];
+						}), row.end());
+		if (std::find(row.begin(), row.end(), i) == row.end())
+			row.push_back(i);
+	}
+
+	return;
+}
+
+const PetscScalar *PetscSolverHandler::selectJacobianEntries(PetscInt offset,
+		const std::vector<PetscScalar>& vals, std::vector<PetscInt>& cols,
+		std::vector<PetscScalar>& selectedVals) const {
+
+	// All the partial derivatives go in the matrix
+	if (reactionBlockIds.empty()) {
+		for (int k = 0; k < reactionIndices.size(); k++) {
+			cols[k] = offset + reactionIndices[k];
+		}
+		return vals.data();
+	}
+
+	// Only the ones within the blocks
+	selectedVals.resize(jacobianPositions.size());
+	for (int k = 0; k < jacobianPositions.size(); k++) {
+		cols[k] = offset + reactionIndices[jacobianPositions[k]];
+		selectedVals[k] = vals[jacobianPositions[k]];
+	}
+
+	return selectedVals.data();
+}
+
+void PetscSolverHandler::setLineTemperatures(
+		const std::vector<ReactionPoint>& line) {
+	// Update the network where the temperature changed
+	for (auto const& point : line) {
+		if (std::fabs(lastTemperature[point.gridIndex] - point.temperature)
+				> 0.1) {
+			network.setTemperature(point.temperature, point.gridIndex);
+			lastTemperature[point.gridIndex] = point.temperature;
+		}
+	}
+
+	return;
+}
+
+void PetscSolverHandler::computeLineFluxes(
+		const std::vector<ReactionPoint>& line, PetscScalar **concs,
+		PetscScalar **updatedConcs, PetscInt xs) {
+	// The rates of the line
+	setLineTemperatures(line);
+
+	const int nReactionThreads =
+			network.canComputeConcurrently() ? nThreads : 1;
+	const int nReactionPoints = line.size();
+#pragma omp parallel for num_threads(nReactionThreads) schedule(static)
+	for (int p = 0; p < nReactionPoints; p++) {
+		PetscInt xi = xs + line[p].gridIndex - 1;
+		network.computeAllFluxes(concs[xi], updatedConcs[xi],
+				line[p].gridIndex);
+	}
+
+	return;
+}
+
+void PetscSolverHandler::computeLinePartials(
+		const std::vector<ReactionPoint>& line, PetscScalar **concs,
+		PetscInt xs, Mat &J, PetscInt rowStart) {
+	// The rates of the line
+	setLineTemperatures(line);
+
+	// Keep the line for the matrix-free products
+	jacobianLines.push_back(line);
+
+	// Degrees of freedom is the total number of clusters in the network
+	const int dof = network.getDOF();
+
+	const int nReactionThreads =
+			network.canComputeConcurrently() ? nThreads : 1;
+	const int nReactionPoints = line.size();
+	PetscErrorCode reactionIerr = 0;
+#pragma omp parallel num_threads(nReactionThreads)
+	{
+		// The workspace of this thread
+		std::vector<double> vals(reactionVals.size(), 0.0);
+		std::vector<PetscInt> cols(reactionIndices.size());
+		std::vector<double> selectedVals;
+
+#pragma omp for schedule(static)
+		for (int p = 0; p < nReactionPoints; p++) {
+			PetscInt xi = xs + line[p].gridIndex - 1;
+
+			// Compute all the partial derivatives for the reactions
+			network.computeAllPartials(concs[xi], reactionStartingIdx,
+					reactionIndices, vals, line[p].gridIndex);
+
+			// Shift the columns of the reactions going in the matrix to
+			// this grid point
+			PetscInt offset = rowStart + line[p].localIndex * dof;
+			auto rowVals = selectJacobianEntries(offset, vals, cols,
+					selectedVals);
+
+#pragma omp critical (xolotlJacobianInsert)
+			{
+				// Update the row in the Jacobian that represents each DOF
+				for (int i = 0; i < dof - 1 && reactionIerr == 0; i++) {
+					PetscInt row = offset + i;
+					auto startingIdx = jacobianStartingIdx[i];
+					reactionIerr = MatSetValues(J, 1, &row, jacobianSize[i],
+							&cols[startingIdx], rowVals + startingIdx,
+							ADD_VALUES);
+				}
+			}
+		}
+	}
+	checkPetscError(reactionIerr, "PetscSolverHandler::computeLinePartials: "
+			"MatSetValues (reactions) failed.");
+
+	return;
+}
+
+void PetscSolverHandler::computeJacobianAction(Vec &C, Vec &v, Vec &y) {
+	PetscErrorCode ierr;
+
+	// Get the local part of the vectors, the reactions don't need the ghosts
+	PetscScalar *concs = nullptr, *results = nullptr;
+	const PetscScalar *vecs = nullptr;
+	ierr = VecGetArray(C, &concs);
+	checkPetscError(ierr, "PetscSolverHandler::computeJacobianAction: "
+			"VecGetArray (C) failed.");
+	ierr = VecGetArrayRead(v, &vecs);
+	checkPetscError(ierr, "PetscSolverHandler::computeJacobianAction: "
+			"VecGetArrayRead (v) failed.");
+	ierr = VecGetArray(y, &results);
+	checkPetscError(ierr, "PetscSolverHandler::computeJacobianAction: "
+			"VecGetArray (y) failed.");
+
+	// Degrees of freedom is the total number of clusters in the network
+	const int dof = network.getDOF();
+
+	// Each grid point only updates its own rows
+	const int nActionThreads = network.canComputeConcurrently() ? nThreads : 1;
+	for (auto const& line : jacobianLines) {
+		// The rates of the line
+		setLineTemperatures(line);
+
+		const int nPoints = line.size();
+#pragma omp parallel num_threads(nActionThreads)
+		{
+			// The workspace of this thread
+			std::vector<double> vals(reactionVals.size(), 0.0);
+
+#pragma omp for schedule(static)
+			for (int p = 0; p < nPoints; p++) {
+				PetscInt offset = line[p].localIndex * dof;
+				network.computeAllPartialsAction(concs + offset,
+						vecs + offset, results + offset, reactionBlockIds,
+						reactionStartingIdx, reactionIndices, vals,
+						line[p].gridIndex);
+			}
+		}
+	}
+
+	// Restore the vectors
+	ierr = VecRestoreArray(C, &concs);
+	checkPetscError(ierr, "PetscSolverHandler::computeJacobianAction: "
+			"VecRestoreArray (C) failed.");
+	ierr = VecRestoreArrayRead(v, &vecs);
+	checkPetscError(ierr, "PetscSolverHandler::computeJacobianAction: "
+			"VecRestoreArrayRead (v) failed.");
+	ierr = VecRestoreArray(y, &results);
+	checkPetscError(ierr, "PetscSolverHandler::computeJacobianAction: "
+			"VecRestoreArray (y) failed.");
+
+	return;
+}
+
 } // nmaespace xolotlSolver
@@ -79,6 +79,61 @@ protected:
 	 */
 	std::vector<PetscScalar> reactionVals;
 
+	/**
+	 * The block id of each DOF in matrix-free mode. The reaction partial
+	 * derivatives between two DOFs of the same block go in the matrix, the
+	 * other ones are only applied through computeJacobianAction(). It is
+	 * empty when the Jacobian is assembled.
+	 */
+	std::vector<int> reactionBlockIds;
+
+	/**
+	 * Number of reaction partial derivatives going in the matrix for each
+	 * reactant.
+	 */
+	std::vector<PetscInt> jacobianSize;
+
+	/**
+	 * Starting index of the reaction partial derivatives going in the matrix
+	 * for each reactant, within the arrays returned by
+	 * selectJacobianEntries().
+	 */
+	std::vector<size_t> jacobianStartingIdx;
+
+	/**
+	 * The positions within reactionVals of the partial derivatives going in
+	 * the matrix, empty if all of them do.
+	 */
+	std::vector<size_t> jacobianPositions;
+
+	/**
+	 * A grid point where the reactions are computed.
+	 */
+	struct ReactionPoint {
+		/**
+		 * The position of the grid point within the local part of the
+		 * global vectors
+		 */
+		PetscInt localIndex;
+
+		/**
+		 * The location of the grid point on the grid for the rates, shifted
+		 * by one for the ghost point
+		 */
+		int gridIndex;
+
+		/**
+		 * The temperature at the grid point
+		 */
+		double temperature;
+	};
+
+	/**
+	 * The grid points where the reaction partial derivatives were last
+	 * computed, line by line in the depth direction.
+	 */
+	std::vector<std::vector<ReactionPoint> > jacobianLines;
+
 	/**
 	 * Convert a C++ sparse fill map representation to the one that
 	 * PETSc's DMDASetBlockFillsSparse() expects.
@@ -91,6 +146,78 @@ protected:
 	static std::vector<PetscInt> ConvertToPetscSparseFillMap(size_t dof,
 			const xolotlCore::IReactionNetwork::SparseFillMap &fillMap);
 
+	/**
+	 * Choose the reaction partial derivatives going in the matrix, all of
+	 * them if the Jacobian is assembled, only the ones within the blocks of
+	 * DOFs otherwise. The diagonal fill is restricted accordingly. It needs
+	 * to be called once the arrays for the reaction partial derivatives are
+	 * initialized, and before the fill is given to PETSc.
+	 *
+	 * @param dfill The diagonal fill, updated in matrix-free mode.
+	 */
+	void initializeJacobianEntries(
+			xolotlCore::IReactionNetwork::SparseFillMap &dfill);
+
+	/**
+	 * Get the reaction partial derivatives of one grid point that go in the
+	 * matrix and their global column indices. The values and columns of
+	 * reactant i then start at jacobianStartingIdx[i] and there are
+	 * jacobianSize[i] of them.
+	 *
+	 * @param offset The global index of the first DOF of the grid point
+	 * @param vals The values of all the reaction partial derivatives
+	 * @param cols The global column indices, of the same size as
+	 *      reactionIndices
+	 * @param selectedVals A workspace for the chosen values
+	 * @return The values going in the matrix
+	 */
+	const PetscScalar *selectJacobianEntries(PetscInt offset,
+			const std::vector<PetscScalar> &vals, std::vector<PetscInt> &cols,
+			std::vector<PetscScalar> &selectedVals) const;
+
+	/**
+	 * Set the temperature of the grid points of a line in the network where
+	 * it changed. The rates are only stored by location in the depth
+	 * direction, and the neighbors of a grid point can set them too, so this
+	 * is called right before computing the reactions of each line.
+	 *
+	 * @param line The grid points of the line
+	 */
+	void setLineTemperatures(const std::vector<ReactionPoint> &line);
+
+	/**
+	 * Compute the reaction fluxes of a line of grid points in parallel. The
+	 * concentrations are read directly from the arrays and each grid point
+	 * only writes its own values, so the result doesn't depend on the number
+	 * of threads.
+	 *
+	 * @param line The grid points of the line
+	 * @param concs The concentrations of the line, by position in the depth
+	 *      direction
+	 * @param updatedConcs The updated concentrations of the line
+	 * @param xs The first position of the line owned by this process
+	 */
+	void computeLineFluxes(const std::vector<ReactionPoint> &line,
+			PetscScalar **concs, PetscScalar **updatedConcs, PetscInt xs);
+
+	/**
+	 * Compute the reaction partial derivatives of a line of grid points in
+	 * parallel and add the ones going in the matrix to the Jacobian. Each
+	 * thread uses its own workspace, only the insertion in the matrix is
+	 * serialized. Each grid point only sets its own rows so the result
+	 * doesn't depend on the number of threads. The line is kept for the
+	 * matrix-free products.
+	 *
+	 * @param line The grid points of the line
+	 * @param concs The concentrations of the line, by position in the depth
+	 *      direction
+	 * @param xs The first position of the line owned by this process
+	 * @param J The Jacobian
+	 * @param rowStart The global index of the first row owned by this process
+	 */
+	void computeLinePartials(const std::vector<ReactionPoint> &line,
+			PetscScalar **concs, PetscInt xs, Mat &J, PetscInt rowStart);
+
 public:
 
 	/**
@@ -113,6 +240,21 @@ public:
 							"Partial Derivatives")) {
 	}
 
+	/**
+	 * Compute the product of the reaction partial derivatives that are left
+	 * out of the Jacobian matrix with the given vector.
+	 * \see ISolverHandler.h
+	 */
+	void computeJacobianAction(Vec &C, Vec &v, Vec &y) override;
+
+	/**
+	 * Get the temperature last used by the network at each grid point.
+	 * \see ISolverHandler.h
+	 */
+	const std::vector<double>& getLastTemperature() const override {
+		return lastTemperature;
+	}
+
 };
 //end class PetscSolverHandler
 
@@ -112,6 +112,18 @@ protected:
 	//! The value to use to seed the random number generator.
 	unsigned int rngSeed;
 
+	//! The number of threads to use for the loops on the grid points.
+	int nThreads;
+
+	//! The way the Jacobian is given to PETSc.
+	std::string jacobianType;
+
+	//! The Jacobian reuse policy.
+	std::tuple<double, double, int> jacobianReuse;
+
+	//! The preconditioner of the linear solves.
+	std::string preconditioner;
+
 	//! The minimum sizes for average radius computation.
 	xolotlCore::Array<int, 4> minRadiusSizes;
 
@@ -393,7 +405,8 @@ protected:
 					0.0), fluxHandler(nullptr), temperatureHandler(nullptr), diffusionHandler(
 					nullptr), mutationHandler(nullptr), resolutionHandler(
 					nullptr), nucleationHandler(nullptr), tauBursting(10.0), rngSeed(
-					0) {
+					0), nThreads(1), jacobianType("assembled"), jacobianReuse(
+					0.0, 0.0, 0), preconditioner("petsc") {
 	}
 
 public:
@@ -503,6 +516,18 @@ public:
 		// Set the number of dimension
 		dimension = options.getDimensionNumber();
 
+		// Set the number of threads for the grid point loops
+		nThreads = options.getNThreads();
+
+		// Set the way the Jacobian is given to PETSc
+		jacobianType = options.getJacobianType();
+
+		// Set the Jacobian reuse policy
+		jacobianReuse = options.getJacobianReuse();
+
+		// Set the preconditioner
+		preconditioner = options.getPreconditioner();
+
 		// Set the void portion
 		portion = options.getVoidPortion();
 
@@ -766,6 +791,38 @@ public:
 	std::vector<std::tuple<int, int, int> > getGBVector() const override {
 		return gbVector;
 	}
+
+	/**
+	 * Get the way the Jacobian is given to PETSc.
+	 * \see ISolverHandler.h
+	 */
+	std::string getJacobianType() const override {
+		return jacobianType;
+	}
+
+	/**
+	 * Get the Jacobian reuse policy.
+	 * \see ISolverHandler.h
+	 */
+	std::tuple<double, double, int> getJacobianReuse() const override {
+		return jacobianReuse;
+	}
+
+	/**
+	 * Get the preconditioner.
+	 * \see ISolverHandler.h
+	 */
+	std::string getPreconditioner() const override {
+		return preconditioner;
+	}
+
+	/**
+	 * Get the number of threads.
+	 * \see ISolverHandler.h
+	 */
+	int getNThreads() const override {
+		return nThreads;
+	}
 }
 ;
 //end class SolverHandler